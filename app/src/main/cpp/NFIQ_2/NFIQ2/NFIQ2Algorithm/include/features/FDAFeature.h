@@ -1,6 +1,7 @@
 #ifndef FDAFEATURE_H
 #define FDAFEATURE_H
 #include <features/Module.h>
+#include <nfiq2_cancellation.hpp>
 #include <nfiq2_constants.hpp>
 #include <nfiq2_fingerprintimagedata.hpp>
 
@@ -20,7 +21,8 @@ static double FDAHISTLIMITS[9] = { 0.268, 0.304, 0.33, 0.355, 0.38, 0.407, 0.44,
 
 class FDAFeature : public Module {
     public:
-	FDAFeature(const NFIQ2::FingerprintImageData &fingerprintImage);
+	FDAFeature(const NFIQ2::FingerprintImageData &fingerprintImage,
+	    const NFIQ2::CancellationToken &cancellation = {});
 	virtual ~FDAFeature();
 
 	std::string getModuleName() const override;
@@ -30,7 +32,8 @@ class FDAFeature : public Module {
 
     private:
 	std::unordered_map<std::string, double> computeFeatureData(
-	    const NFIQ2::FingerprintImageData &fingerprintImage);
+	    const NFIQ2::FingerprintImageData &fingerprintImage,
+	    const NFIQ2::CancellationToken &cancellation);
 
 	const int blocksize { 32 };
 	const double threshold { .1 };
@@ -3,6 +3,7 @@
 
 #include <features/FingerJetFXFeature.h>
 #include <features/Module.h>
+#include <nfiq2_cancellation.hpp>
 #include <nfiq2_constants.hpp>
 #include <nfiq2_fingerprintimagedata.hpp>
 #include <opencv2/core/core.hpp>
@@ -30,7 +31,8 @@ class FJFXMinutiaeQualityFeature : public Module {
 
 	FJFXMinutiaeQualityFeature(
 	    const NFIQ2::FingerprintImageData &fingerprintImage,
-	    const std::vector<FingerJetFXFeature::Minutia> &minutiaData);
+	    const std::vector<FingerJetFXFeature::Minutia> &minutiaData,
+	    const NFIQ2::CancellationToken &cancellation = {});
 
 	virtual ~FJFXMinutiaeQualityFeature();
 
@@ -45,7 +47,8 @@ class FJFXMinutiaeQualityFeature : public Module {
 
     private:
 	std::unordered_map<std::string, double> computeFeatureData(
-	    const NFIQ2::FingerprintImageData &fingerprintImage);
+	    const NFIQ2::FingerprintImageData &fingerprintImage,
+	    const NFIQ2::CancellationToken &cancellation);
 
 	std::vector<FingerJetFXFeature::Minutia> minutiaData_ {};
 	std::vector<MinutiaData> computeMuMinQuality(
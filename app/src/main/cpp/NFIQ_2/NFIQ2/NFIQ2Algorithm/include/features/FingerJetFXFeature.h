@@ -2,6 +2,7 @@
 #define FINGERJETFXFEATURE_H
 
 #include <features/Module.h>
+#include <nfiq2_cancellation.hpp>
 #include <nfiq2_constants.hpp>
 #include <nfiq2_fingerprintimagedata.hpp>
 
@@ -99,7 +100,8 @@ class FingerJetFXFeature : public Module {
 					     ///< the defined circle
 	};
 
-	FingerJetFXFeature(const NFIQ2::FingerprintImageData &fingerprintImage);
+	FingerJetFXFeature(const NFIQ2::FingerprintImageData &fingerprintImage,
+	    const NFIQ2::CancellationToken &cancellation = {});
 	virtual ~FingerJetFXFeature();
 
 	std::string getModuleName() const override;
@@ -115,7 +117,8 @@ class FingerJetFXFeature : public Module {
 
     private:
 	std::unordered_map<std::string, double> computeFeatureData(
-	    const NFIQ2::FingerprintImageData &fingerprintImage);
+	    const NFIQ2::FingerprintImageData &fingerprintImage,
+	    const NFIQ2::CancellationToken &cancellation);
 
 	FRFXLL_RESULT
 	createContext(FRFXLL_HANDLE_PT phContext);
@@ -2,6 +2,7 @@
 #define IMGPROCROIFEATURE_H
 
 #include <features/Module.h>
+#include <nfiq2_cancellation.hpp>
 #include <nfiq2_constants.hpp>
 #include <nfiq2_fingerprintimagedata.hpp>
 #include <opencv2/core.hpp>
@@ -35,14 +36,16 @@ class ImgProcROIFeature : public Module {
 		double stdDevOfROIPixels {};
 	};
 
-	ImgProcROIFeature(const NFIQ2::FingerprintImageData &fingerprintImage);
+	ImgProcROIFeature(const NFIQ2::FingerprintImageData &fingerprintImage,
+	    const NFIQ2::CancellationToken &cancellation = {});
 	virtual ~ImgProcROIFeature();
 
 	std::string getModuleName() const override;
 
 	static std::vector<std::string> getQualityFeatureIDs();
 
-	static ImgProcROIResults computeROI(cv::Mat &img, unsigned int bs);
+	static ImgProcROIResults computeROI(cv::Mat &img, unsigned int bs,
+	    const NFIQ2::CancellationToken &cancellation = {});
 
 	/** @throw NFIQ2::Exception
 	 * Img Proc Results could not be computed.
@@ -51,7 +54,8 @@ class ImgProcROIFeature : public Module {
 
     private:
 	std::unordered_map<std::string, double> computeFeatureData(
-	    const NFIQ2::FingerprintImageData &fingerprintImage);
+	    const NFIQ2::FingerprintImageData &fingerprintImage,
+	    const NFIQ2::CancellationToken &cancellation);
 
 	ImgProcROIResults imgProcResults_ {};
 	bool imgProcComputed_ { false };
@@ -2,6 +2,7 @@
 #define LCSFEATURE_H
 
 #include <features/Module.h>
+#include <nfiq2_cancellation.hpp>
 #include <nfiq2_constants.hpp>
 #include <nfiq2_fingerprintimagedata.hpp>
 
@@ -15,7 +16,8 @@ static double LCSHISTLIMITS[9] = { 0, 0.70, 0.74, 0.77, 0.79, 0.81, 0.83, 0.85,
 
 class LCSFeature : public Module {
     public:
-	LCSFeature(const NFIQ2::FingerprintImageData &fingerprintImage);
+	LCSFeature(const NFIQ2::FingerprintImageData &fingerprintImage,
+	    const NFIQ2::CancellationToken &cancellation = {});
 	virtual ~LCSFeature();
 
 	std::string getModuleName() const override;
@@ -24,7 +26,8 @@ class LCSFeature : public Module {
 
     private:
 	std::unordered_map<std::string, double> computeFeatureData(
-	    const NFIQ2::FingerprintImageData &fingerprintImage);
+	    const NFIQ2::FingerprintImageData &fingerprintImage,
+	    const NFIQ2::CancellationToken &cancellation);
 
 	const int blocksize { 32 };
 	const double threshold { .1 };
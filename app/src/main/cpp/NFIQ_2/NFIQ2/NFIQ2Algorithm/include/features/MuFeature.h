@@ -2,6 +2,7 @@
 #define MUFEATURE_H
 
 #include <features/Module.h>
+#include <nfiq2_cancellation.hpp>
 #include <nfiq2_constants.hpp>
 #include <nfiq2_fingerprintimagedata.hpp>
 
@@ -12,7 +13,8 @@ namespace NFIQ2 { namespace QualityFeatures {
 
 class MuFeature : public Module {
     public:
-	MuFeature(const NFIQ2::FingerprintImageData &fingerprintImage);
+	MuFeature(const NFIQ2::FingerprintImageData &fingerprintImage,
+	    const NFIQ2::CancellationToken &cancellation = {});
 	virtual ~MuFeature();
 
 	std::string getModuleName() const override;
@@ -26,7 +28,8 @@ class MuFeature : public Module {
 
     private:
 	std::unordered_map<std::string, double> computeFeatureData(
-	    const NFIQ2::FingerprintImageData &fingerprintImage);
+	    const NFIQ2::FingerprintImageData &fingerprintImage,
+	    const NFIQ2::CancellationToken &cancellation);
 
 	bool sigmaComputed { false };
 	double sigma {};
@@ -4,6 +4,7 @@
 #define BS_OCL 32 // block size for OCL
 
 #include <features/Module.h>
+#include <nfiq2_cancellation.hpp>
 #include <nfiq2_constants.hpp>
 #include <nfiq2_fingerprintimagedata.hpp>
 #include <opencv2/core.hpp>
@@ -18,8 +19,8 @@ static double OCLPHISTLIMITS[9] = { 0.337, 0.479, 0.579, 0.655, 0.716, 0.766,
 
 class OCLHistogramFeature : public Module {
     public:
-	OCLHistogramFeature(
-	    const NFIQ2::FingerprintImageData &fingerprintImage);
+	OCLHistogramFeature(const NFIQ2::FingerprintImageData &fingerprintImage,
+	    const NFIQ2::CancellationToken &cancellation = {});
 	virtual ~OCLHistogramFeature();
 
 	std::string getModuleName() const override;
@@ -31,7 +32,8 @@ class OCLHistogramFeature : public Module {
 
     private:
 	std::unordered_map<std::string, double> computeFeatureData(
-	    const NFIQ2::FingerprintImageData &fingerprintImage);
+	    const NFIQ2::FingerprintImageData &fingerprintImage,
+	    const NFIQ2::CancellationToken &cancellation);
 };
 
 }}
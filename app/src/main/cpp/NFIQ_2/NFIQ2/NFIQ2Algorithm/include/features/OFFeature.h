@@ -2,6 +2,7 @@
 #define OF_FEATURE_H
 
 #include <features/Module.h>
+#include <nfiq2_cancellation.hpp>
 #include <nfiq2_constants.hpp>
 #include <nfiq2_fingerprintimagedata.hpp>
 
@@ -21,7 +22,8 @@ static double OFHISTLIMITS[9] = { 1.715e-2, 3.5e-2, 5.57e-2, 8.1e-2, 1.15e-1,
 
 class OFFeature : public Module {
     public:
-	OFFeature(const NFIQ2::FingerprintImageData &fingerprintImage);
+	OFFeature(const NFIQ2::FingerprintImageData &fingerprintImage,
+	    const NFIQ2::CancellationToken &cancellation = {});
 	virtual ~OFFeature();
 
 	std::string getModuleName() const override;
@@ -30,7 +32,8 @@ class OFFeature : public Module {
 
     private:
 	std::unordered_map<std::string, double> computeFeatureData(
-	    const NFIQ2::FingerprintImageData &fingerprintImage);
+	    const NFIQ2::FingerprintImageData &fingerprintImage,
+	    const NFIQ2::CancellationToken &cancellation);
 
 	/** Processing is done in subblocks of this size. */
 	const int blocksize { 16 };
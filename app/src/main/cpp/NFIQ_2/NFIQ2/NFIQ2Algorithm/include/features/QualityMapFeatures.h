@@ -2,6 +2,7 @@
 #define QUALITYMAPFEATURES_H
 
 #include <features/Module.h>
+#include <nfiq2_cancellation.hpp>
 #include <nfiq2_constants.hpp>
 #include <nfiq2_fingerprintimagedata.hpp>
 #include <opencv2/core.hpp>
@@ -20,7 +21,8 @@ namespace NFIQ2 { namespace QualityFeatures {
 class QualityMapFeatures : public Module {
     public:
 	QualityMapFeatures(const NFIQ2::FingerprintImageData &fingerprintImage,
-	    const ImgProcROIFeature::ImgProcROIResults &imgProcResults);
+	    const ImgProcROIFeature::ImgProcROIResults &imgProcResults,
+	    const NFIQ2::CancellationToken &cancellation = {});
 	virtual ~QualityMapFeatures();
 
 	std::string getModuleName() const override;
@@ -44,7 +46,8 @@ class QualityMapFeatures : public Module {
 	// compute orientation map
 	static cv::Mat computeOrientationMap(cv::Mat &img, bool bFilterByROI,
 	    double &coherenceSum, double &coherenceRel, unsigned int bs,
-	    ImgProcROIFeature::ImgProcROIResults roiResults);
+	    ImgProcROIFeature::ImgProcROIResults roiResults,
+	    const NFIQ2::CancellationToken &cancellation = {});
 
 	// static helper functions for numberical gradient computation
 	static cv::Mat computeNumericalGradientX(const cv::Mat &mat);
@@ -53,7 +56,8 @@ class QualityMapFeatures : public Module {
 
     private:
 	std::unordered_map<std::string, double> computeFeatureData(
-	    const NFIQ2::FingerprintImageData &fingerprintImage);
+	    const NFIQ2::FingerprintImageData &fingerprintImage,
+	    const NFIQ2::CancellationToken &cancellation);
 
 	ImgProcROIFeature::ImgProcROIResults imgProcResults_ {};
 };
@@ -2,6 +2,7 @@
 #define RVUPHISTOGRAMFEATURE_H
 
 #include <features/Module.h>
+#include <nfiq2_cancellation.hpp>
 #include <nfiq2_constants.hpp>
 #include <nfiq2_fingerprintimagedata.hpp>
 
@@ -14,8 +15,8 @@ static double RVUPHISTLIMITS[9] = { 0.5, 0.667, 0.8, 1, 1.25, 1.5, 2, 24, 30 };
 
 class RVUPHistogramFeature : public Module {
     public:
-	RVUPHistogramFeature(
-	    const NFIQ2::FingerprintImageData &fingerprintImage);
+	RVUPHistogramFeature(const NFIQ2::FingerprintImageData &fingerprintImage,
+	    const NFIQ2::CancellationToken &cancellation = {});
 	virtual ~RVUPHistogramFeature();
 
 	std::string getModuleName() const override;
@@ -24,7 +25,8 @@ class RVUPHistogramFeature : public Module {
 
     private:
 	std::unordered_map<std::string, double> computeFeatureData(
-	    const NFIQ2::FingerprintImageData &fingerprintImage);
+	    const NFIQ2::FingerprintImageData &fingerprintImage,
+	    const NFIQ2::CancellationToken &cancellation);
 
 	const int blocksize { 32 };
 	const double threshold { .1 };
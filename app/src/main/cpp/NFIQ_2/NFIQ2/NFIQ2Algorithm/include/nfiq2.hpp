@@ -12,6 +12,7 @@
 #define NFIQ2_HPP_
 
 #include "nfiq2_algorithm.hpp"
+#include "nfiq2_cancellation.hpp"
 #include "nfiq2_constants.hpp"
 #include "nfiq2_data.hpp"
 #include "nfiq2_exception.hpp"
@@ -11,14 +11,17 @@
 #ifndef NFIQ2_ALGORITHM_HPP_
 #define NFIQ2_ALGORITHM_HPP_
 
+#include "nfiq2_cancellation.hpp"
 #include "nfiq2_constants.hpp"
 #include "nfiq2_fingerprintimagedata.hpp"
 #include "nfiq2_modelinfo.hpp"
 #include "nfiq2_qualityfeatures.hpp"
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace NFIQ2 {
 
@@ -91,6 +94,25 @@ class Algorithm {
 	unsigned int computeQualityScore(
 	    const NFIQ2::FingerprintImageData &rawImage) const;
 
+	/**
+	 * @brief
+	 * Compute a NFIQ 2 quality score, stopping early if cancelled.
+	 * @param rawImage
+	 * Fingerprint image.
+	 * @param cancellation
+	 * Checked between blocks of work within each quality module.
+	 * @return
+	 * Computed NFIQ 2 quality score.
+	 * @throw Exception
+	 * Called before random forest parameters were loaded, or
+	 * ErrorCode::Timeout or ErrorCode::Cancelled if `cancellation` expired
+	 * before the score was computed.
+	 * @ingroup compute
+	 */
+	unsigned int computeQualityScore(
+	    const NFIQ2::FingerprintImageData &rawImage,
+	    const NFIQ2::CancellationToken &cancellation) const;
+
 	/**
 	 * @brief
 	 * Compute a NFIQ 2 quality score.
@@ -130,6 +152,122 @@ class Algorithm {
 	unsigned int computeQualityScore(
 	    const std::unordered_map<std::string, double> &features) const;
 
+	/**
+	 * @brief
+	 * Compute NFIQ 2 quality scores with several sets of random forest
+	 * parameters.
+	 *
+	 * @details
+	 * Quality modules are computed once and evaluated by every model.
+	 * Models loaded from identical parameters share one random forest
+	 * in memory.
+	 *
+	 * @param algorithms
+	 * Models with which to compute scores.
+	 * @param modules
+	 * Computed quality modules.
+	 *
+	 * @return
+	 * Computed NFIQ 2 quality score from each of `algorithms`, in order.
+	 *
+	 * @throw Exception
+	 * Called before random forest parameters were loaded into any of
+	 * `algorithms`.
+	 *
+	 * @ingroup compute
+	 * @see QualityFeatures::computeQualityModules
+	 */
+	static std::vector<unsigned int> computeQualityScores(
+	    const std::vector<std::reference_wrapper<const Algorithm>>
+		&algorithms,
+	    const std::vector<std::shared_ptr<NFIQ2::QualityFeatures::Module>>
+		&modules);
+
+	/**
+	 * @brief
+	 * Compute NFIQ 2 quality scores with several sets of random forest
+	 * parameters.
+	 *
+	 * @details
+	 * Features are ordered once and evaluated by every model. Models
+	 * loaded from identical parameters share one random forest in
+	 * memory.
+	 *
+	 * @param algorithms
+	 * Models with which to compute scores.
+	 * @param features
+	 * Map of quality feature identifiers to quality feature values.
+	 *
+	 * @return
+	 * Computed NFIQ 2 quality score from each of `algorithms`, in order.
+	 *
+	 * @throw Exception
+	 * Called before random forest parameters were loaded into any of
+	 * `algorithms`.
+	 *
+	 * @ingroup compute
+	 * @see QualityFeatures::computeQualityFeatures
+	 */
+	static std::vector<unsigned int> computeQualityScores(
+	    const std::vector<std::reference_wrapper<const Algorithm>>
+		&algorithms,
+	    const std::unordered_map<std::string, double> &features);
+
+	/**
+	 * @brief
+	 * Determine whether a NFIQ 2 quality score is at least a threshold.
+	 *
+	 * @details
+	 * Trees of the random forest are evaluated in an order chosen to
+	 * decide quickly, stopping once the remaining trees cannot change
+	 * the answer. The result is always the same as comparing
+	 * computeQualityScore(features) to `threshold`.
+	 *
+	 * @param features
+	 * Map of quality feature identifiers to quality feature values.
+	 * @param threshold
+	 * Least acceptable NFIQ 2 quality score.
+	 *
+	 * @return
+	 * true if the NFIQ 2 quality score of `features` is at least
+	 * `threshold`, false otherwise.
+	 *
+	 * @throw Exception
+	 * Called before random forest parameters were loaded.
+	 *
+	 * @ingroup compute
+	 * @see QualityFeatures::computeQualityFeatures
+	 */
+	bool meetsQualityThreshold(
+	    const std::unordered_map<std::string, double> &features,
+	    const unsigned int threshold) const;
+
+	/**
+	 * @brief
+	 * Determine whether each of several NFIQ 2 quality scores is at
+	 * least a threshold.
+	 *
+	 * @param features
+	 * Maps of quality feature identifiers to quality feature values,
+	 * one for each fingerprint image.
+	 * @param threshold
+	 * Least acceptable NFIQ 2 quality score.
+	 *
+	 * @return
+	 * Whether the NFIQ 2 quality score of each of `features` is at least
+	 * `threshold`, in order.
+	 *
+	 * @throw Exception
+	 * Called before random forest parameters were loaded.
+	 *
+	 * @ingroup compute
+	 * @see QualityFeatures::computeQualityFeatures
+	 */
+	std::vector<bool> meetsQualityThreshold(
+	    const std::vector<std::unordered_map<std::string, double>>
+		&features,
+	    const unsigned int threshold) const;
+
 	/**
 	 * @brief
 	 * Obtain MD5 checksum of random forest parameter file loaded.
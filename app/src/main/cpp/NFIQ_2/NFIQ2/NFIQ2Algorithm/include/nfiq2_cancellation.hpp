@@ -0,0 +1,67 @@
+/*
+ * This file is part of NIST Fingerprint Image Quality (NFIQ) 2. For more
+ * information on this project, refer to:
+ *   - https://nist.gov/services-resources/software/nfiq2
+ *   - https://github.com/usnistgov/NFIQ2
+ *
+ * This work is in the public domain. For complete licensing details, refer to:
+ *   - https://github.com/usnistgov/NFIQ2/blob/master/LICENSE.md
+ */
+
+#ifndef NFIQ2_CANCELLATION_HPP_
+#define NFIQ2_CANCELLATION_HPP_
+
+#include <chrono>
+#include <memory>
+
+namespace NFIQ2 {
+
+/**
+ * @brief
+ * Deadline and cancellation flag checked while computing quality.
+ *
+ * @details
+ * Quality modules check the token between blocks of work and throw
+ * NFIQ2::Exception when it has expired, releasing anything computed so far.
+ * Copies share state, so a copy may be cancelled from another thread.
+ */
+class CancellationToken {
+    public:
+	/** Token without a deadline, cancelled only by cancel(). */
+	CancellationToken();
+
+	/**
+	 * @brief
+	 * Token that expires after a timeout.
+	 *
+	 * @param timeout
+	 * Time from now after which the token expires.
+	 */
+	explicit CancellationToken(std::chrono::steady_clock::duration timeout);
+
+	/** Expire the token, and all copies of it, immediately. */
+	void cancel();
+
+	/** @return Whether cancel() was called on this token or a copy. */
+	bool isCancelled() const;
+
+	/** @return Whether the token's deadline has passed. */
+	bool isExpired() const;
+
+	/**
+	 * @brief
+	 * Stop computation if the token was cancelled or its deadline passed.
+	 *
+	 * @throw Exception
+	 * ErrorCode::Cancelled if cancel() was called, ErrorCode::Timeout if
+	 * the deadline passed.
+	 */
+	void throwIfCancelled() const;
+
+    private:
+	struct State;
+	std::shared_ptr<State> state;
+};
+} // namespace NFIQ
+
+#endif /* NFIQ2_CANCELLATION_HPP_ */
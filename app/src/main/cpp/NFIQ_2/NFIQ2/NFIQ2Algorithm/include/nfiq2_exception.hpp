@@ -32,7 +32,9 @@ enum class ErrorCode {
 	FJFX_CannotCreateFeatureSet,
 	FJFX_NoFeatureSetCreated,
 	InvalidNFIQ2Score,
-	InvalidImageSize
+	InvalidImageSize,
+	Timeout,
+	Cancelled
 };
 
 /** Exceptions thrown from NFIQ2 functions. */
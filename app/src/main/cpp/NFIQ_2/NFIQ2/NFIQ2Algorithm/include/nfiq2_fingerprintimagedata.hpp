@@ -92,6 +92,35 @@ class FingerprintImageData : public Data {
 	 * after cropping.
 	 */
 	NFIQ2::FingerprintImageData copyRemovingNearWhiteFrame() const;
+
+	/**
+	 * @brief
+	 * Obtain a copy of an image owned by the caller with near-white lines
+	 * surrounding the fingerprint removed.
+	 *
+	 * @param pData
+	 * Pointer to decompressed 8 bit-per-pixel grayscale image data,
+	 * canonically encoded as per ISO/IEC 19794-4:2005. Only the cropped
+	 * region is copied.
+	 * @param width
+	 * Width of the image in pixels.
+	 * @param height
+	 * Height of the image in pixels.
+	 * @param fingerCode
+	 * Finger position of the fingerprint in the image.
+	 * @param ppi
+	 * Resolution of the image in pixels per inch.
+	 *
+	 * @return
+	 * Cropped fingerprint image.
+	 *
+	 * @throws NFIQ2::Exception
+	 * Error performing the crop, or the image is too small to be processed
+	 * after cropping.
+	 */
+	static NFIQ2::FingerprintImageData copyRemovingNearWhiteFrame(
+	    const uint8_t *pData, uint32_t width, uint32_t height,
+	    uint8_t fingerCode, uint16_t ppi);
 };
 } // namespace NFIQ
 
@@ -11,6 +11,7 @@
 #ifndef NFIQ2_QUALITYFEATURES_HPP_
 #define NFIQ2_QUALITYFEATURES_HPP_
 
+#include "nfiq2_cancellation.hpp"
 #include "nfiq2_constants.hpp"
 #include "nfiq2_fingerprintimagedata.hpp"
 
@@ -90,6 +91,57 @@ std::vector<std::string> getQualityFeatureIDs();
 std::vector<std::shared_ptr<NFIQ2::QualityFeatures::Module>>
 computeQualityModules(const NFIQ2::FingerprintImageData &rawImage);
 
+/**
+ * @brief
+ * Compute quality modules, stopping early if cancelled.
+ *
+ * @param rawImage
+ * Fingerprint image in raw format.
+ * @param cancellation
+ * Checked between blocks of work within each module.
+ *
+ * @return
+ * A vector of quality modules containing computed feature values.
+ *
+ * @throw Exception
+ * ErrorCode::Timeout or ErrorCode::Cancelled if `cancellation` expired
+ * before all modules were computed. Modules computed so far are released.
+ */
+std::vector<std::shared_ptr<NFIQ2::QualityFeatures::Module>>
+computeQualityModules(const NFIQ2::FingerprintImageData &rawImage,
+    const NFIQ2::CancellationToken &cancellation);
+
+/**
+ * @brief
+ * Compute quality modules from pixels owned by the caller.
+ *
+ * @param pixels
+ * Decompressed 8 bit-per-pixel grayscale image data, canonically encoded as
+ * per ISO/IEC 19794-4:2005. Only the region remaining after near-white lines
+ * are removed is copied, and `pixels` is not referenced after returning.
+ * @param width
+ * Width of the image in pixels.
+ * @param height
+ * Height of the image in pixels.
+ * @param fingerCode
+ * Finger position of the fingerprint in the image.
+ * @param ppi
+ * Resolution of the image in pixels per inch.
+ * @param cancellation
+ * Checked between blocks of work within each module.
+ *
+ * @return
+ * A vector of quality modules containing computed feature values.
+ *
+ * @throw Exception
+ * ErrorCode::Timeout or ErrorCode::Cancelled if `cancellation` expired
+ * before all modules were computed.
+ */
+std::vector<std::shared_ptr<NFIQ2::QualityFeatures::Module>>
+computeQualityModules(const uint8_t *pixels, uint32_t width, uint32_t height,
+    uint8_t fingerCode, uint16_t ppi,
+    const NFIQ2::CancellationToken &cancellation);
+
 /**
  * @brief
  * Compute quality feature values.
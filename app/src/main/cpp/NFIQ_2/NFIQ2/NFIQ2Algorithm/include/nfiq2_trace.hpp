@@ -0,0 +1,158 @@
+/*
+ * This file is part of NIST Fingerprint Image Quality (NFIQ) 2. For more
+ * information on this project, refer to:
+ *   - https://nist.gov/services-resources/software/nfiq2
+ *   - https://github.com/usnistgov/NFIQ2
+ *
+ * This work is in the public domain. For complete licensing details, refer to:
+ *   - https://github.com/usnistgov/NFIQ2/blob/master/LICENSE.md
+ */
+
+#ifndef NFIQ2_TRACE_HPP_
+#define NFIQ2_TRACE_HPP_
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @def NFIQ2_TRACE_SPAN(var, name)
+ * Open the span `var` named `name`, which must be a string with static
+ * storage duration. The span closes at NFIQ2_TRACE_END(var) or when `var`
+ * goes out of scope.
+ *
+ * @def NFIQ2_TRACE_END(var)
+ * Close the span `var` opened with NFIQ2_TRACE_SPAN.
+ *
+ * @note
+ * Both expand to nothing unless NFIQ2 is built with NFIQ2_TRACING defined.
+ */
+#ifdef NFIQ2_TRACING
+#define NFIQ2_TRACE_SPAN(var, name) NFIQ2::Trace::Span var { name }
+#define NFIQ2_TRACE_END(var) var.end()
+#else
+#define NFIQ2_TRACE_SPAN(var, name)
+#define NFIQ2_TRACE_END(var)
+#endif
+
+namespace NFIQ2 { namespace Trace {
+
+/** A completed span. */
+struct Event {
+	/** Name of the span. */
+	const char *name;
+	/** Name of the enclosing span on the same thread, or nullptr. */
+	const char *parent;
+	/** Start time, in nanoseconds since the process started tracing. */
+	uint64_t start;
+	/** Duration in nanoseconds. */
+	uint64_t duration;
+	/** Sequential identifier of the thread that recorded the span. */
+	uint32_t thread;
+	/** Number of spans enclosing this span on the same thread. */
+	uint32_t depth;
+};
+
+/** Aggregated durations of all spans with the same parent and name. */
+struct Summary {
+	/** "parent/name", or "name" for top-level spans. */
+	std::string name;
+	/** Number of spans. */
+	uint64_t count;
+	/** Sum of durations, in milliseconds. */
+	double total;
+	/** Nearest-rank percentiles of durations, in milliseconds. */
+	double p50, p90, p99;
+	/** Longest duration, in milliseconds. */
+	double max;
+};
+
+/**
+ * Number of events each thread keeps. Once full, a thread's oldest events
+ * are overwritten.
+ */
+static const uint32_t BufferCapacity { 8192 };
+
+/**
+ * @brief
+ * Scoped, nested timing of a region of code.
+ *
+ * @details
+ * Spans are recorded into a buffer owned by the calling thread, without
+ * locking. Use through NFIQ2_TRACE_SPAN so that instrumentation is removed
+ * from builds without NFIQ2_TRACING.
+ */
+class Span {
+    public:
+	/**
+	 * @brief
+	 * Open a span.
+	 *
+	 * @param name
+	 * Name of the span. Must have static storage duration.
+	 */
+	explicit Span(const char *name);
+
+	/** Close the span, if still open. */
+	~Span();
+
+	/** Close the span and record it. Later calls have no effect. */
+	void end();
+
+	Span(const Span &) = delete;
+	Span &operator=(const Span &) = delete;
+
+    private:
+	const char *name;
+	const char *parent;
+	uint32_t depth;
+	uint64_t start;
+	bool open;
+};
+
+/**
+ * @return
+ * Whether NFIQ 2 was built with NFIQ2_TRACING, i.e., whether its modules
+ * record spans.
+ */
+bool isEnabled();
+
+/**
+ * @brief
+ * Obtain the events currently held by all threads' buffers.
+ *
+ * @return
+ * Events ordered by thread, then by completion.
+ *
+ * @note
+ * May be called while other threads are recording. Events overwritten during
+ * the call are left out.
+ */
+std::vector<Event> collect();
+
+/** Discard all events recorded so far. */
+void clear();
+
+/**
+ * @brief
+ * Aggregate events by parent and name.
+ *
+ * @return
+ * One Summary per distinct parent and name, sorted by name.
+ */
+std::vector<Summary> summarize(const std::vector<Event> &events);
+
+/**
+ * @brief
+ * Write events in the Chrome trace event format, readable by
+ * chrome://tracing and Perfetto.
+ */
+void writeChromeTrace(std::ostream &out, const std::vector<Event> &events);
+
+/** Write the summary of events as a table. */
+void writeSummary(std::ostream &out, const std::vector<Event> &events);
+
+}}
+
+#endif /* NFIQ2_TRACE_HPP_ */
@@ -42,13 +42,63 @@ class RandomForestML {
 	void evaluate(const std::unordered_map<std::string, double> &features,
 	    double &qualityValue) const;
 
+	/**
+	 * Order QualityFeatureData as the random forest expects, so that it
+	 * can be evaluated by any number of models.
+	 */
+	static cv::Mat getFeatureVector(
+	    const std::unordered_map<std::string, double> &features);
+
+	/**
+	 * Compute NFIQ2 quality score based on model and a feature vector
+	 * from getFeatureVector().
+	 */
+	void evaluate(const cv::Mat &sample, double &qualityValue) const;
+
+	/**
+	 * Determine whether the NFIQ2 quality score of a feature vector from
+	 * getFeatureVector() is at least threshold. Trees are evaluated
+	 * only until the remaining trees cannot change the answer, which is
+	 * always the same as comparing the result of evaluate().
+	 */
+	bool meetsThreshold(
+	    const cv::Mat &sample, const unsigned int threshold) const;
+
     private:
-	/** OpenCV shared smart pointer referring to the RF model itself. */
+	/**
+	 * OpenCV shared smart pointer referring to the RF model itself.
+	 * Shared with every other RandomForestML loaded from the same
+	 * parameters.
+	 */
 	cv::Ptr<cv::ml::RTrees> m_pTrainedRF;
 	/** Calculates the hash of the RandomForest parameters. */
 	std::string calculateHashString(const std::string &s);
-	/** Initialize model using string parameters. */
-	void initModule(const std::string &params);
+	/**
+	 * Initialize model using string parameters, reusing the model of
+	 * any live RandomForestML with the same parameters.
+	 * Returns the hash of the parameters.
+	 */
+	std::string initModule(const std::string &params);
+
+	/** Whether meetsThreshold() can traverse the trees itself. */
+	bool m_earlyExit { false };
+	/** Roots of trees with several leaf values, in evaluation order. */
+	std::vector<int> m_treeOrder {};
+	/**
+	 * Least and greatest sum of leaf values of the trees in
+	 * m_treeOrder from each position onward.
+	 */
+	std::vector<double> m_remainingMin {}, m_remainingMax {};
+	/** Sum of the values of trees with only one leaf value. */
+	double m_constantSum { 0 };
+	/** Bound on rounding error in any sum of leaf values. */
+	double m_sumTolerance { 0 };
+	/**
+	 * Order the trees of the loaded forest for meetsThreshold().
+	 * Trees that differ most between leaves, relative to their depth,
+	 * are evaluated first.
+	 */
+	void initTreeOrder(const bool traversable);
 
 #ifdef NFIQ2_EMBED_RANDOM_FOREST_PARAMETERS
 	/** Extracts string parameters when model is embedded. */
@@ -0,0 +1,119 @@
+/******************************************************************************
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ ******************************************************************************/
+
+#ifndef NFIQ2_UI_CACHE_H_
+#define NFIQ2_UI_CACHE_H_
+
+#include <be_io_recordstore.h>
+#include <nfiq2_fingerprintimagedata.hpp>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace NFIQ2UI {
+
+/**
+ *  @brief
+ *  Persistent cache of quality scores and feature values.
+ *
+ *  @details
+ *  Entries are keyed on a hash of the pixels, dimensions, and resolution of
+ *  the image being scored, combined with the hash of the random forest
+ *  parameters used to score it. Entries are stored in a RecordStore so that
+ *  they persist between executions of the tool. All methods may be called
+ *  concurrently from multiple threads.
+ */
+class ScoreCache {
+    public:
+	/** Values stored for each scored image */
+	struct Entry {
+		/** Quality score */
+		unsigned int score {};
+		/** Quality feature values, keyed by feature ID */
+		std::unordered_map<std::string, double> features {};
+		/** Actionable quality feedback, keyed by feedback ID */
+		std::unordered_map<std::string, double> actionable {};
+	};
+
+	/**
+	 *  @brief
+	 *  Open a cache, creating it if it does not exist.
+	 *
+	 *  @param[in] pathname
+	 *      Path to the RecordStore backing the cache.
+	 *  @param[in] parameterHash
+	 *      Hash of the random forest parameters that will produce
+	 *      scores (i.e., NFIQ2::Algorithm::getParameterHash()).
+	 *
+	 *  @throws NFIQ2UI::CacheError
+	 *      Could not open or create the RecordStore.
+	 */
+	ScoreCache(
+	    const std::string &pathname, const std::string &parameterHash);
+
+	/**
+	 *  @brief
+	 *  Compute the cache key for an image.
+	 *
+	 *  @param[in] image
+	 *      Image exactly as it will be passed to
+	 *      NFIQ2::QualityFeatures::computeQualityModules().
+	 *
+	 *  @return
+	 *      Key under which the image's entry is stored.
+	 */
+	std::string computeKey(const NFIQ2::FingerprintImageData &image) const;
+
+	/**
+	 *  @brief
+	 *  Look up a cached entry.
+	 *
+	 *  @param[in] key
+	 *      Key returned from computeKey().
+	 *  @param[out] entry
+	 *      Populated with the cached values when found.
+	 *
+	 *  @return
+	 *      true if an entry for key was found, false otherwise.
+	 */
+	bool find(const std::string &key, Entry &entry) const;
+
+	/**
+	 *  @brief
+	 *  Store an entry.
+	 *
+	 *  @details
+	 *  Entries that already exist are left unchanged. Failures to write
+	 *  are not fatal to scoring and are silently ignored.
+	 *
+	 *  @param[in] key
+	 *      Key returned from computeKey().
+	 *  @param[in] entry
+	 *      Values to store.
+	 */
+	void insert(const std::string &key, const Entry &entry);
+
+	/** Sync the cache to persistent storage */
+	virtual ~ScoreCache();
+
+    private:
+	/** RecordStore backing the cache */
+	std::shared_ptr<BiometricEvaluation::IO::RecordStore> rs {};
+	/** Hash of the random forest parameters, mixed into every key */
+	std::string parameterHash {};
+	/** RecordStores are not safe for concurrent use */
+	mutable std::mutex mutex {};
+};
+
+} // namespace NFIQ2UI
+
+#endif /* NFIQ2_UI_CACHE_H_ */
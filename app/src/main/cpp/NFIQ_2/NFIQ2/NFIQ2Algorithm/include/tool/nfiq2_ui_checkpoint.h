@@ -0,0 +1,156 @@
+/******************************************************************************
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ ******************************************************************************/
+
+#ifndef NFIQ2_UI_CHECKPOINT_H_
+#define NFIQ2_UI_CHECKPOINT_H_
+
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace NFIQ2UI {
+
+/**
+ *  @brief
+ *  Log of completed work, used to resume interrupted runs.
+ *
+ *  @details
+ *  Each unit of work is identified by its source (a batch file or
+ *  RecordStore) and an item within that source (a path or a record key).
+ *  Completed items are buffered and appended to the log on flush(). Output
+ *  for an item must be flushed before the item is flushed to the log, so
+ *  that a resumed run never skips an item whose output was lost.
+ *
+ *  All methods may be called concurrently from multiple threads.
+ */
+class Checkpoint {
+    public:
+	/** Number of completed items buffered before a flush is due */
+	static const unsigned int FlushInterval { 256 };
+
+	/**
+	 *  @brief
+	 *  Open a checkpoint log.
+	 *
+	 *  @param[in] pathname
+	 *      Path to the checkpoint log.
+	 *  @param[in] resume
+	 *      When true, items recorded in an existing log are treated as
+	 *      complete and new items are appended. When false, any
+	 *      existing log is overwritten.
+	 *
+	 *  @throws NFIQ2UI::CheckpointError
+	 *      Could not open the checkpoint log.
+	 */
+	Checkpoint(const std::string &pathname, const bool resume);
+
+	/**
+	 *  @brief
+	 *  Determine if an item was completed by a previous run.
+	 *
+	 *  @param[in] source
+	 *      Batch file or RecordStore containing item.
+	 *  @param[in] item
+	 *      Path or record key.
+	 *
+	 *  @return
+	 *      true if item was recorded in the log when it was opened.
+	 */
+	bool isComplete(
+	    const std::string &source, const std::string &item) const;
+
+	/**
+	 *  @brief
+	 *  Determine if any item from a source was completed by a previous
+	 *  run.
+	 *
+	 *  @param[in] source
+	 *      Batch file or RecordStore.
+	 *
+	 *  @return
+	 *      true if any item from source was recorded in the log when it
+	 *      was opened.
+	 */
+	bool hasCompleted(const std::string &source) const;
+
+	/**
+	 *  @brief
+	 *  Record an item as complete.
+	 *
+	 *  @details
+	 *  The item is buffered until the next flush().
+	 *
+	 *  @param[in] source
+	 *      Batch file or RecordStore containing item.
+	 *  @param[in] item
+	 *      Path or record key.
+	 */
+	void markComplete(const std::string &source, const std::string &item);
+
+	/**
+	 *  @return
+	 *      true if FlushInterval or more items are buffered.
+	 */
+	bool flushDue() const;
+
+	/**
+	 *  @brief
+	 *  Remove and return all buffered items.
+	 *
+	 *  @details
+	 *  Used with commit() when output for buffered items must be
+	 *  flushed between the time items are selected and the time they
+	 *  are written to the log.
+	 *
+	 *  @return
+	 *      Buffered items, in log format.
+	 */
+	std::vector<std::string> takePending();
+
+	/**
+	 *  @brief
+	 *  Append items to the log and flush it to disk.
+	 *
+	 *  @param[in] entries
+	 *      Items returned from takePending().
+	 */
+	void commit(const std::vector<std::string> &entries);
+
+	/** Append all buffered items to the log */
+	void flush();
+
+	/** Flush buffered items */
+	virtual ~Checkpoint();
+
+    private:
+	/**
+	 *  @return
+	 *      Log entry for item from source.
+	 */
+	static std::string makeEntry(
+	    const std::string &source, const std::string &item);
+
+	/** Items recorded when the log was opened */
+	std::unordered_set<std::string> completed {};
+	/** Sources with at least one item in completed */
+	std::unordered_set<std::string> sources {};
+	/** Items completed, but not yet written */
+	std::vector<std::string> pending {};
+	/** Checkpoint log */
+	std::ofstream log {};
+	/** Protects pending and log */
+	mutable std::mutex mutex {};
+};
+
+} // namespace NFIQ2UI
+
+#endif /* NFIQ2_UI_CHECKPOINT_H_ */
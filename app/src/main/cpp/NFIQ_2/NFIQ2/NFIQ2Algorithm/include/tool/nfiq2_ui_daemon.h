@@ -0,0 +1,198 @@
+/******************************************************************************
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ ******************************************************************************/
+
+#ifndef NFIQ2_UI_DAEMON_H_
+#define NFIQ2_UI_DAEMON_H_
+
+#include <nfiq2_algorithm.hpp>
+#include <tool/nfiq2_ui_log.h>
+#include <tool/nfiq2_ui_types.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace NFIQ2UI {
+
+/**
+ *  @brief
+ *  Scores images sent over a UNIX domain socket with a model loaded once.
+ *
+ *  @details
+ *  Clients send framed requests and receive framed responses. All integers
+ *  are unsigned and big-endian.
+ *
+ *  Request:
+ *  - uint32: number of bytes that follow
+ *  - uint32: request identifier, echoed in the response
+ *  - uint8: RequestType
+ *  - uint8: finger position
+ *  - uint16: PPI, or 0 to use the PPI of an encoded image (500 for raw)
+ *  - RequestType::Raw: uint32 width, uint32 height, then width * height
+ *    8-bit grayscale pixels
+ *  - RequestType::Encoded: any image format libbiomeval can decode
+ *
+ *  Response:
+ *  - uint32: number of bytes that follow
+ *  - uint32: request identifier
+ *  - uint8: Status
+ *  - Status::OK: "Name=Value" lines with the quality score, the quantized
+ *    and resampled flags, quality features, and actionable quality
+ *    feedback. Otherwise, an error message.
+ *
+ *  Clients may send further requests without waiting for responses.
+ *  Requests are scored concurrently, so responses may arrive in a
+ *  different order and are matched by identifier. When QueueDepth
+ *  requests per worker are already waiting, new requests are answered
+ *  immediately with Status::Busy.
+ */
+class Daemon {
+    public:
+	/** Kind of image in a request */
+	enum class RequestType : uint8_t { Raw = 0, Encoded = 1 };
+
+	/** Outcome of a request */
+	enum class Status : uint8_t {
+		OK = 0,
+		Error = 1,
+		Busy = 2,
+		Timeout = 3,
+		BadRequest = 4
+	};
+
+	/** Largest request accepted, in bytes */
+	static const uint32_t MaxRequestSize { 64 * 1024 * 1024 };
+
+	/** Requests that may wait for each worker before rejecting more */
+	static const unsigned int QueueDepth { 4 };
+
+	/**
+	 *  @brief
+	 *  Listen on a UNIX domain socket.
+	 *
+	 *  @param[in] socketPath
+	 *      Path of the socket. An existing socket at this path is
+	 *      replaced.
+	 *  @param[in] flags
+	 *      Values of optional flag command line arguments. force,
+	 *      timeout, and scoreCache apply to every request.
+	 *  @param[in] model
+	 *      Initialized model used for every request.
+	 *  @param[in] logger
+	 *      Logger used for debug statements.
+	 *
+	 *  @throws NFIQ2UI::DaemonError
+	 *      Could not create the socket.
+	 */
+	Daemon(const std::string &socketPath, const Flags &flags,
+	    const NFIQ2::Algorithm &model, std::shared_ptr<NFIQ2UI::Log> logger);
+
+	/**
+	 *  @brief
+	 *  Accept and score requests until SIGINT or SIGTERM is received.
+	 *
+	 *  @details
+	 *  Requests already received are scored and answered before
+	 *  returning.
+	 */
+	void run();
+
+	/** Close the socket and remove it from the filesystem */
+	~Daemon();
+
+	Daemon(const Daemon &) = delete;
+	Daemon &operator=(const Daemon &) = delete;
+
+    private:
+	/** A client connection, closed when the last reference is released */
+	struct Connection;
+
+	/** A request waiting for a worker */
+	struct Job {
+		std::shared_ptr<Connection> connection {};
+		uint32_t id {};
+		RequestType type {};
+		uint8_t fingerPosition {};
+		uint16_t ppi {};
+		std::vector<uint8_t> payload {};
+	};
+
+	/** Read requests from a client and queue them */
+	void readRequests(std::shared_ptr<Connection> connection);
+
+	/**
+	 *  @brief
+	 *  Join readers whose clients have disconnected, and forget
+	 *  connections that have been closed.
+	 *
+	 *  @param[in,out] readers
+	 *      Threads running readRequests().
+	 */
+	void reapReaders(std::vector<std::thread> &readers);
+
+	/** Score queued requests until the daemon stops */
+	void work();
+
+	/**
+	 *  @brief
+	 *  Score the image in a request.
+	 *
+	 *  @param[in] job
+	 *      Request to score.
+	 *  @param[out] body
+	 *      Features for Status::OK, otherwise an error message.
+	 *
+	 *  @return
+	 *      Outcome of the request.
+	 */
+	Status score(const Job &job, std::string &body) const;
+
+	/** Send a response to a client */
+	static void respond(Connection &connection, const uint32_t id,
+	    const Status status, const std::string &body);
+
+	/** Path of the listening socket */
+	std::string socketPath {};
+	/** Listening socket */
+	int listener { -1 };
+	/** Values of optional flag command line arguments */
+	Flags flags {};
+	/** Model used for every request */
+	const NFIQ2::Algorithm &model;
+	/** Logger used for debug statements */
+	std::shared_ptr<NFIQ2UI::Log> logger {};
+
+	/** Requests waiting for a worker */
+	std::deque<Job> queue {};
+	/** Most requests that may wait in queue */
+	size_t queueCapacity {};
+	/** Set when no more requests will be queued */
+	bool stopping { false };
+	/** Protects queue and stopping */
+	std::mutex queueMutex {};
+	/** Signals changes to queue and stopping */
+	std::condition_variable queueChanged {};
+
+	/** Open client connections, to be shut down when stopping */
+	std::vector<std::weak_ptr<Connection>> connections {};
+	/** Readers that have returned and may be joined */
+	std::vector<std::thread::id> finishedReaders {};
+	/** Protects connections and finishedReaders */
+	std::mutex connectionsMutex {};
+};
+
+} // namespace NFIQ2UI
+
+#endif /* NFIQ2_UI_DAEMON_H_ */
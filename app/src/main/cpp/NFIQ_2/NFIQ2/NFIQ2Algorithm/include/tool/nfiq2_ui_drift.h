@@ -0,0 +1,109 @@
+/******************************************************************************
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ ******************************************************************************/
+
+#ifndef NFIQ2_UI_DRIFT_H_
+#define NFIQ2_UI_DRIFT_H_
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+namespace NFIQ2UI {
+
+/**
+ *  @brief
+ *  Comparison of scores from reduced-resolution decoding against scores
+ *  from decoding at full resolution and resampling.
+ *
+ *  @details
+ *  Each image decoded at reduced resolution is also scored as if it had
+ *  been decoded at its native resolution and resampled to 500 PPI. Both
+ *  scores and their difference are written to a CSV file as they are
+ *  recorded, and a summary of the differences is available once scoring
+ *  is complete.
+ *
+ *  All methods may be called concurrently from multiple threads.
+ */
+class DriftReport {
+    public:
+	/** Largest absolute difference with its own histogram bin */
+	static const unsigned int HistogramLimit { 10 };
+
+	/**
+	 *  @brief
+	 *  Create a drift report.
+	 *
+	 *  @param[in] pathname
+	 *      Path to the CSV file to write. Overwritten if it exists.
+	 *
+	 *  @throws NFIQ2UI::DriftError
+	 *      Could not open pathname.
+	 */
+	DriftReport(const std::string &pathname);
+
+	/**
+	 *  @brief
+	 *  Record the scores of one image.
+	 *
+	 *  @param[in] name
+	 *      Name of the image.
+	 *  @param[in] fingerPosition
+	 *      Finger position of the image.
+	 *  @param[in] resampledScore
+	 *      Score after decoding at full resolution and resampling.
+	 *  @param[in] reducedScore
+	 *      Score after decoding at reduced resolution.
+	 */
+	void record(const std::string &name, const uint8_t fingerPosition,
+	    const unsigned int resampledScore, const unsigned int reducedScore);
+
+	/**
+	 *  @brief
+	 *  Write a summary of the differences recorded so far.
+	 *
+	 *  @details
+	 *  Includes the number of images, the mean and mean absolute
+	 *  difference, the largest absolute difference, and a histogram of
+	 *  absolute differences.
+	 *
+	 *  @param[in] out
+	 *      Stream to write to.
+	 */
+	void writeSummary(std::ostream &out) const;
+
+	/** Flush recorded scores */
+	virtual ~DriftReport();
+
+    private:
+	/** Per-image scores */
+	std::ofstream csv {};
+	/** Number of images recorded */
+	uint64_t count { 0 };
+	/** Sum of reduced minus resampled scores */
+	int64_t sumDrift { 0 };
+	/** Sum of absolute differences */
+	uint64_t sumAbsDrift { 0 };
+	/** Largest absolute difference */
+	unsigned int maxAbsDrift { 0 };
+	/**
+	 *  Images by absolute difference, with the final bin counting
+	 *  differences greater than HistogramLimit
+	 */
+	std::array<uint64_t, HistogramLimit + 2> histogram {};
+	/** Protects all members */
+	mutable std::mutex mutex {};
+};
+
+} // namespace NFIQ2UI
+
+#endif /* NFIQ2_UI_DRIFT_H_ */
@@ -215,6 +215,86 @@ class ResampleError : public Exception {
 	bool _errorHandled { false };
 };
 
+/**
+ *  @brief
+ *  The score cache could not be opened
+ */
+class CacheError : public Exception {
+    public:
+	/**
+	 *  Construct a CacheError object with
+	 *  the default information string.
+	 */
+	CacheError();
+
+	/**
+	 *  Construct a CacheError object with
+	 *  an information string appended to the
+	 *  default information string.
+	 */
+	CacheError(const std::string &info);
+};
+
+/**
+ *  @brief
+ *  The checkpoint log could not be opened
+ */
+class CheckpointError : public Exception {
+    public:
+	/**
+	 *  Construct a CheckpointError object with
+	 *  the default information string.
+	 */
+	CheckpointError();
+
+	/**
+	 *  Construct a CheckpointError object with
+	 *  an information string appended to the
+	 *  default information string.
+	 */
+	CheckpointError(const std::string &info);
+};
+
+/**
+ *  @brief
+ *  The scoring daemon could not listen for requests
+ */
+class DaemonError : public Exception {
+    public:
+	/**
+	 *  Construct a DaemonError object with
+	 *  the default information string.
+	 */
+	DaemonError();
+
+	/**
+	 *  Construct a DaemonError object with
+	 *  an information string appended to the
+	 *  default information string.
+	 */
+	DaemonError(const std::string &info);
+};
+
+/**
+ *  @brief
+ *  The drift report could not be written
+ */
+class DriftError : public Exception {
+    public:
+	/**
+	 *  Construct a DriftError object with
+	 *  the default information string.
+	 */
+	DriftError();
+
+	/**
+	 *  Construct a DriftError object with
+	 *  an information string appended to the
+	 *  default information string.
+	 */
+	DriftError(const std::string &info);
+};
+
 } // namespace NFIQ2UI
 
 #endif /* NFIQ2_UI_EXCEPTION_H_ */
@@ -18,6 +18,7 @@
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <vector>
 
 namespace NFIQ2UI {
 
@@ -58,6 +59,8 @@ class Log {
 	 *    Finger position of the image. Valid values: 0-12.
 	 *  @param[in] score
 	 *    Calculated NFIQ2 Score.
+	 *  @param[in] comparisonScores
+	 *    Scores from each comparison model, in the order of -m.
 	 *  @param[in] errmsg
 	 *    Error message if applicable. Will be "NA" otherwise.
 	 *  @param[in] quantized
@@ -70,8 +73,8 @@ class Log {
 	 *    Prints featureTimings information if verbose flag is enabled.
 	 */
 	void printScore(const std::string &name, uint8_t fingerCode,
-	    unsigned int score, const std::string &errmsg, const bool quantized,
-	    const bool resampled,
+	    unsigned int score, const std::vector<unsigned int> &comparisonScores,
+	    const std::string &errmsg, const bool quantized, const bool resampled,
 	    const std::unordered_map<std::string, double> &features,
 	    const std::unordered_map<std::string, double> &speed,
 	    const std::unordered_map<std::string, double> &actionable) const;
@@ -137,8 +140,11 @@ class Log {
 	 *
 	 *  @param[in] qualityScore
 	 *    The qualityScore to be printed out.
+	 *  @param[in] comparisonScores
+	 *    Scores from each comparison model, printed after qualityScore.
 	 */
-	void printSingle(unsigned int qualityScore) const;
+	void printSingle(unsigned int qualityScore,
+	    const std::vector<unsigned int> &comparisonScores) const;
 
 	/**
 	 *  @brief
@@ -180,6 +186,12 @@ class Log {
 	 */
 	void printCSVHeader() const;
 
+	/**
+	 *  @brief
+	 *  Flushes the output stream.
+	 */
+	void flush() const;
+
 	virtual ~Log();
 
     protected:
@@ -195,6 +207,8 @@ class Log {
 	bool speed;
 	/** Value of the actionable flag */
 	bool actionable;
+	/** Number of models compared against the first */
+	unsigned int comparisons;
 	/** Used if a specified file will be the output stream */
 	std::ofstream logFile {};
 };
@@ -0,0 +1,137 @@
+/******************************************************************************
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ ******************************************************************************/
+
+#ifndef NFIQ2_UI_MPI_H_
+#define NFIQ2_UI_MPI_H_
+
+#include <be_io_logsheet.h>
+#include <be_io_recordstore.h>
+#include <be_memory_autoarray.h>
+#include <be_mpi_recordprocessor.h>
+#include <be_mpi_workpackage.h>
+#include <nfiq2_algorithm.hpp>
+
+#include "nfiq2_ui_types.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace NFIQ2UI {
+
+/**
+ *  @brief
+ *  Scores RecordStore work packages distributed by the libbiomeval MPI
+ *  framework.
+ *
+ *  @details
+ *  Each receiving task loads the model once, in performInitialization(),
+ *  before its worker processes are forked. Each worker process scores the
+ *  records of a work package on Flags::numthreads threads and writes the
+ *  output for each record to its own RecordStore, named
+ *  "<Output Record Store>-<rank>-<process ID>". Output for a record is
+ *  one CSV line per image, in the format of the nfiq2 tool, and the
+ *  output stores may be merged once every task has finished.
+ *
+ *  In addition to the properties read by
+ *  BiometricEvaluation::MPI::RecordStoreResources, the properties file
+ *  must contain OUTPUTRSPROPERTY.
+ */
+class MPIRecordProcessor : public BiometricEvaluation::MPI::RecordProcessor {
+    public:
+	/** Property naming the prefix of output RecordStores */
+	static const std::string OUTPUTRSPROPERTY;
+
+	/**
+	 *  @brief
+	 *  Constructor.
+	 *
+	 *  @param[in] propertiesFileName
+	 *      Properties for the MPI framework and this processor.
+	 *  @param[in] arguments
+	 *      Flags and model used to score each image. Only
+	 *      arguments.flags and arguments.argv0 are used.
+	 *
+	 *  @throws BiometricEvaluation::Error::Exception
+	 *      Could not read properties.
+	 */
+	MPIRecordProcessor(const std::string &propertiesFileName,
+	    const NFIQ2UI::Arguments &arguments);
+
+	/** Queue a record read from the input RecordStore */
+	void processRecord(const std::string &key) override;
+
+	/** Queue a record delivered in the work package */
+	void processRecord(const std::string &key,
+	    const BiometricEvaluation::Memory::uint8Array &value) override;
+
+	/**
+	 *  @brief
+	 *  Score every record in a work package.
+	 *
+	 *  @details
+	 *  Output is synchronized to storage before returning.
+	 *
+	 *  @throws BiometricEvaluation::Error::StrategyError
+	 *      Could not write to the output RecordStore.
+	 */
+	void processWorkPackage(
+	    BiometricEvaluation::MPI::WorkPackage &workPackage) override;
+
+	/**
+	 *  @brief
+	 *  Create the processor used by a worker process.
+	 *
+	 *  @details
+	 *  The new processor shares the model loaded by
+	 *  performInitialization() and opens its own output RecordStore.
+	 *
+	 *  @throws BiometricEvaluation::Error::Exception
+	 *      Could not create the output RecordStore.
+	 */
+	std::shared_ptr<BiometricEvaluation::MPI::WorkPackageProcessor>
+	newProcessor(std::shared_ptr<BiometricEvaluation::IO::Logsheet>
+		&logsheet) override;
+
+	/**
+	 *  @brief
+	 *  Load the model and any comparison models.
+	 *
+	 *  @throws BiometricEvaluation::Error::StrategyError
+	 *      Could not load the model.
+	 */
+	void performInitialization(
+	    std::shared_ptr<BiometricEvaluation::IO::Logsheet> &logsheet)
+	    override;
+
+	virtual ~MPIRecordProcessor();
+
+    private:
+	/** Score pending records and write their output */
+	void scorePending();
+
+	/** Properties for the MPI framework and this processor */
+	std::string propertiesFileName {};
+	/** Flags and model used to score each image */
+	NFIQ2UI::Arguments arguments {};
+	/** Prefix of output RecordStore names */
+	std::string outputPrefix {};
+
+	/** Model, shared by every worker process on this task */
+	std::shared_ptr<NFIQ2::Algorithm> model {};
+	/** Output of this worker process */
+	std::shared_ptr<BiometricEvaluation::IO::RecordStore> output {};
+	/** Records of the current work package */
+	std::vector<BiometricEvaluation::IO::RecordStore::Record> pending {};
+};
+
+} // namespace NFIQ2UI
+
+#endif /* NFIQ2_UI_MPI_H_ */
@@ -12,18 +12,25 @@
 #define NFIQ2_UI_REFRESH_H_
 
 #include <be_image_image.h>
+#include <be_io_recordstoreprefetcher.h>
 #include <be_io_utility.h>
 #include <nfiq2_algorithm.hpp>
 #include <nfiq2_modelinfo.hpp>
 #include <opencv2/core.hpp>
 
+#include "nfiq2_ui_checkpoint.h"
 #include "nfiq2_ui_log.h"
 #include "nfiq2_ui_types.h"
 
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+/** Held while decoding WSQ images, since the decoder is single threaded */
+extern std::mutex mutGray;
+
 namespace NFIQ2UI {
 
 /**
@@ -106,6 +113,54 @@ cv::Mat resampleAndLogError(
     const NFIQ2UI::ImageProps &imageProps,
     std::shared_ptr<NFIQ2UI::Log> logger = nullptr);
 
+/**
+ * @brief
+ * Score quality features with every comparison model
+ *
+ * @param[in] flags
+ *  Flags holding the comparison models
+ * @param[in] features
+ *  Quality features already scored with the first model
+ *
+ * @return
+ *  Score from each of flags.comparisonAlgorithms, in order
+ *
+ * @throws NFIQ2::Exception
+ *  Could not compute a score
+ */
+std::vector<unsigned int> scoreComparisons(const Flags &flags,
+    const std::unordered_map<std::string, double> &features);
+
+/**
+ * @brief
+ * Score an image decoded at reduced resolution as if it had been decoded
+ * at full resolution and resampled to 500 PPI
+ *
+ * @details
+ * Used to measure the drift introduced by reduced-resolution decoding.
+ * The resolution reduction of img is restored before returning.
+ *
+ * @param[in] img
+ *  Image with a resolution reduction applied
+ * @param[in] fingerPosition
+ *  Finger position of img
+ * @param[in] model
+ *  Model used to compute the score
+ *
+ * @return
+ *  Score of the resampled full resolution image
+ *
+ * @throws BiometricEvaluation::Error::Exception
+ *  Could not decode img
+ * @throws NFIQ2UI::ResampleError
+ *  Could not resample img
+ * @throws NFIQ2::Exception
+ *  Could not compute the score
+ */
+unsigned int scoreWithoutReduction(
+    std::shared_ptr<BiometricEvaluation::Image::Image> img,
+    const uint8_t fingerPosition, const NFIQ2::Algorithm &model);
+
 /**
  *  @brief
  *  Executes a single Image and prints its computed NFIQ2 score.
@@ -169,6 +224,12 @@ void executeSingle(const NFIQ2UI::ImgCouple &couple, const Flags &flags,
     const NFIQ2::Algorithm &model, std::shared_ptr<NFIQ2UI::Log> logger,
     const bool singleImage, const bool interactive);
 
+/** Image paths queued for each scoring thread while walking directories */
+static const unsigned int DirectoryQueueDepth { 64 };
+
+/** Most threads scanning directories concurrently */
+static const unsigned int DirectoryScanThreads { 4 };
+
 /**
  *  @brief
  *  Uses executeSingle to iterate through a directory.
@@ -176,7 +237,9 @@ void executeSingle(const NFIQ2UI::ImgCouple &couple, const Flags &flags,
  *  @details
  *  Can recursively go through directories with -r flag,
  *  otherwise it will only scan the current directory given though
- *  the command line.
+ *  the command line. When multi-threaded, subdirectories are scanned
+ *  concurrently and image paths are streamed to scoring threads
+ *  through a bounded queue, so scoring starts before the walk finishes.
  *
  *  @param[in] dirname
  *      Directory path name that will be scanned.
@@ -190,6 +253,41 @@ void executeSingle(const NFIQ2UI::ImgCouple &couple, const Flags &flags,
 void parseDirectory(const std::string &dirname, const Flags &flags,
     const NFIQ2::Algorithm &model, std::shared_ptr<NFIQ2UI::Log> logger);
 
+/**
+ *  @brief
+ *  Directory Multi-threaded produce function.
+ *
+ *  @details
+ *  Scans directories from walk until every directory has been scanned,
+ *  pushing image paths to walk.files.
+ *
+ *  @param[in] walk
+ *      State shared with other scanning threads.
+ *  @param[in] flags
+ *      Contains information from command line arguments.
+ *  @param[in] logger
+ *      Prints debug messages to an output stream.
+ */
+void directoryScan(NFIQ2UI::DirectoryWalk &walk, const Flags &flags,
+    std::shared_ptr<NFIQ2UI::Log> logger);
+
+/**
+ *  @brief
+ *  Directory Multi-threaded consume function.
+ *
+ *  @param[in] files
+ *      Image paths produced by directoryScan.
+ *  @param[in] printQueue
+ *      Queue of scores that will be printed.
+ *  @param[in] flags
+ *      Contains information from command line arguments.
+ *  @param[in] model
+ *      Machine learning model that NFIQ2 relies on for score generation.
+ */
+void directoryConsume(NFIQ2UI::BoundedQueue<std::string> &files,
+    SafeQueue<std::string> &printQueue, const Flags &flags,
+    const NFIQ2::Algorithm &model);
+
 /**
  *  @brief
  *  Batch Multi-threaded consume function.
@@ -208,10 +306,13 @@ void parseDirectory(const std::string &dirname, const Flags &flags,
  *      Contains information from command line arguments.
  *  @param[in] model
  *      Machine learning model that NFIQ2 relies on for score generation.
+ *  @param[in] filename
+ *      Path to the batch file being processed, identifying its paths in
+ *      the checkpoint log.
  */
 void batchConsume(SafeSplitPathsQueue &splitQueue,
     SafeQueue<std::string> &printQueue, const Flags &flags,
-    const NFIQ2::Algorithm &model);
+    const NFIQ2::Algorithm &model, const std::string &filename);
 
 /**
  *  @brief
@@ -219,7 +320,8 @@ void batchConsume(SafeSplitPathsQueue &splitQueue,
  *  executeSingle.
  *
  *  @details
- *  Obtains its images by calling getImages
+ *  Obtains its images by calling getImages. When a checkpoint log is in
+ *  use, paths completed by a previous run are skipped.
  *
  *  @param[in] filename
  *      Path to the batch file being processed.
@@ -238,15 +340,13 @@ void executeBatch(const std::string &filename, const Flags &flags,
  *  RecordStore Multi-threaded consume function.
  *
  *  @details
- *  Consumes chunked up Records (stored as record keys). Threads will
- *  continuously take from splitQueue until empty and will push print
- *  results to printQueue.
+ *  Consumes Records read ahead by a shared prefetcher. Threads will
+ *  continuously take records from the prefetcher until the end of the
+ *  RecordStore is reached and will push print results to printQueue.
  *
- *  @param[in] name
- *      Name of the RecordStore.
- *  @param[in] splitQueue
- *      Thread-safe Queue containing chunks of data needing to be
- *      processed by worker threads.
+ *  @param[in] records
+ *      Prefetcher shared by all worker threads, returning records of the
+ *      RecordStore in sequence.
  *  @param[in] printQueue
  *      Thread-safe Queue containing all scores that need to be printed
  *      in a Multi-threaded operation.
@@ -254,11 +354,12 @@ void executeBatch(const std::string &filename, const Flags &flags,
  *      Contains information from command line arguments.
  *  @param[in] model
  *      Machine learning model that NFIQ2 relies on for score generation.
+ *  @param[in] filename
+ *      Name of the RecordStore, identifying its keys in the checkpoint log.
  */
-void recordStoreConsume(const std::string &name,
-    NFIQ2UI::SafeSplitPathsQueue &splitQueue,
+void recordStoreConsume(BiometricEvaluation::IO::RecordStorePrefetcher &records,
     SafeQueue<std::string> &printQueue, const Flags &flags,
-    const NFIQ2::Algorithm &model);
+    const NFIQ2::Algorithm &model, const std::string &filename);
 
 /**
  *  @brief
@@ -266,7 +367,10 @@ void recordStoreConsume(const std::string &name,
  *  record and executes those images.
  *
  *  @details
- *  Obtains its images by calling getImages
+ *  Obtains its images by calling getImages. Records are read ahead
+ *  asynchronously by a RecordStorePrefetcher so that scoring does not
+ *  block on storage. When a checkpoint log is in use, the sequence cursor
+ *  is first moved past the records completed by a previous run.
  *
  *  @param[in] filename
  *      Name of the RecordStore.
@@ -280,22 +384,46 @@ void recordStoreConsume(const std::string &name,
 void executeRecordStore(const std::string &filename, const Flags &flags,
     const NFIQ2::Algorithm &model, std::shared_ptr<NFIQ2UI::Log> logger);
 
+/**
+ *  @brief
+ *  Records a single-threaded unit of work in the checkpoint log.
+ *
+ *  @details
+ *  Does nothing if no checkpoint log is in use. When a flush of the
+ *  checkpoint log is due, the logger is flushed first.
+ *
+ *  @param[in] flags
+ *      Contains information from command line arguments.
+ *  @param[in] logger
+ *      Output stream that scores for item were printed to.
+ *  @param[in] source
+ *      Batch file or RecordStore containing item.
+ *  @param[in] item
+ *      Path or record key that was completed.
+ */
+void markComplete(const Flags &flags, std::shared_ptr<NFIQ2UI::Log> logger,
+    const std::string &source, const std::string &item);
+
 /**
  *  @brief
  *  Multi-Threaded print function.
  *
  *  @details
  *  Obtains scores from Multi-threaded operations and prints it to the
- *  output stream specified in the logger.
+ *  output stream specified in the logger. When a checkpoint log is in
+ *  use, items are written to it only after their scores are flushed.
  *
  *  @param[in] printQueue
  *      Thread-safe Queue containing all scores that need to be printed
  *      in a Multi-threaded operation.
  *  @param[in] logger
  *      Prints scores, errors and debug messages to an output stream.
+ *  @param[in] checkpoint
+ *      Checkpoint log, or nullptr if progress is not being recorded.
  */
-void threadedPrint(
-    SafeQueue<std::string> &printQueue, std::shared_ptr<NFIQ2UI::Log> logger);
+void threadedPrint(SafeQueue<std::string> &printQueue,
+    std::shared_ptr<NFIQ2UI::Log> logger,
+    std::shared_ptr<NFIQ2UI::Checkpoint> checkpoint);
 
 /**
  *  @brief
@@ -374,6 +502,23 @@ void printHeader(
  */
 NFIQ2::ModelInfo parseModelInfo(const NFIQ2UI::Arguments &arguments);
 
+/**
+ *  @brief
+ *  Extracts the model path and model hash from a model info file.
+ *
+ *  @param[in] modelInfoFilePath
+ *      Path to the model info file.
+ *
+ *  @return
+ *      Model information parsed from modelInfoFilePath.
+ *
+ *  @throws NFIQ2UI::ModelConstructionError
+ *      modelInfoFilePath could not be parsed.
+ *  @throws NFIQ2UI::PropertyParseError
+ *      The model named by modelInfoFilePath does not exist.
+ */
+NFIQ2::ModelInfo parseModelInfo(const std::string &modelInfoFilePath);
+
 } // namespace NFIQ2UI
 
 #endif /* NFIQ2_UI_REFRESH_H_ */
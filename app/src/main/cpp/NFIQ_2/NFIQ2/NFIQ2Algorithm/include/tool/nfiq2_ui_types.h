@@ -16,7 +16,9 @@
 #include <nfiq2_algorithm.hpp>
 
 #include <condition_variable>
+#include <deque>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <string>
@@ -25,6 +27,10 @@
 
 namespace NFIQ2UI {
 
+class Checkpoint;
+class DriftReport;
+class ScoreCache;
+
 /**
  *  @brief
  *  File containing enums, structs and data structures used throughout
@@ -61,10 +67,36 @@ struct Flags {
 	bool recursion { false };
 	/** Used if an alternative Machine Learning model is to be used */
 	std::string model { "" };
+	/** Model info files of models scored alongside model */
+	std::vector<std::string> comparisonModels {};
+	/** Models loaded from comparisonModels, shared by all threads */
+	std::vector<std::shared_ptr<NFIQ2::Algorithm>> comparisonAlgorithms {};
 	/** Actionable Flag value */
 	bool actionable { false };
 	/** Number of threads used for multi-threading */
 	unsigned int numthreads { 1 };
+	/** Path to a persistent score cache, if one is to be used */
+	std::string cache { "" };
+	/** Score cache opened from cache, shared by all threads */
+	std::shared_ptr<NFIQ2UI::ScoreCache> scoreCache {};
+	/** Path to a checkpoint log, if progress is to be recorded */
+	std::string checkpoint { "" };
+	/** Resume Flag value */
+	bool resume { false };
+	/** Checkpoint log opened from checkpoint, shared by all threads */
+	std::shared_ptr<NFIQ2UI::Checkpoint> checkpointLog {};
+	/** Path to write Chrome trace JSON to, if spans are to be exported */
+	std::string trace { "" };
+	/** Milliseconds allowed to score each image, or 0 for no limit */
+	unsigned int timeout { 0 };
+	/** Path of a UNIX domain socket to serve requests on, if any */
+	std::string daemon { "" };
+	/** Decode 1000 PPI wavelet-compressed images directly at 500 PPI */
+	bool reducedDecode { false };
+	/** Path to a drift report, if reduced decoding is to be compared */
+	std::string drift { "" };
+	/** Drift report opened from drift, shared by all threads */
+	std::shared_ptr<NFIQ2UI::DriftReport> driftReport {};
 };
 
 /**
@@ -308,19 +340,141 @@ class SafeSplitPathsQueue : public SafeQueue<std::vector<std::string>> {
 	 */
 	SafeSplitPathsQueue(std::vector<std::string> &content,
 	    const std::vector<std::string>::size_type splittingFactor);
+};
 
+/**
+ *  @brief
+ *  Queue that blocks producers while full.
+ *
+ *  @details
+ *  Used to stream work to consumer threads while bounding the amount
+ *  of work held in memory.
+ */
+template <typename T> class BoundedQueue {
+    public:
 	/**
 	 *  @brief
-	 *  Splits up the workload for a Multi-threaded RecordStore operation.
+	 *  Constructor.
 	 *
-	 *  @param[in] rs
-	 *      Shared Pointer to a RecordStore that is to be split up.
-	 *  @param[in] splittingFactor
-	 *      The size of each chunk of work.
+	 *  @param[in] capacity
+	 *      Most items held before push() blocks.
 	 */
-	SafeSplitPathsQueue(
-	    std::shared_ptr<BiometricEvaluation::IO::RecordStore> rs,
-	    const std::vector<std::string>::size_type splittingFactor);
+	explicit BoundedQueue(const size_t capacity)
+	    : capacity_ { capacity }
+	{
+	}
+
+	/**
+	 *  @brief
+	 *  Pushes an item, waiting for space if the queue is full.
+	 *
+	 *  @param[in] item
+	 *      The item to be pushed into the queue.
+	 *
+	 *  @return
+	 *      false if the queue was closed, in which case item was dropped.
+	 */
+	bool push(const T &item)
+	{
+		std::unique_lock<std::mutex> ulock(mutex_);
+		notFull_.wait(ulock,
+		    [this] { return (closed_ || queue_.size() < capacity_); });
+		if (closed_) {
+			return false;
+		}
+		queue_.push(item);
+		ulock.unlock();
+		notEmpty_.notify_one();
+		return true;
+	}
+
+	/**
+	 *  @brief
+	 *  Pops an item, waiting for one if the queue is empty.
+	 *
+	 *  @param[out] item
+	 *      The item at the front of the queue.
+	 *
+	 *  @return
+	 *      false once the queue is closed and empty.
+	 */
+	bool pop(T &item)
+	{
+		std::unique_lock<std::mutex> ulock(mutex_);
+		notEmpty_.wait(
+		    ulock, [this] { return (closed_ || !queue_.empty()); });
+		if (queue_.empty()) {
+			return false;
+		}
+		item = queue_.front();
+		queue_.pop();
+		ulock.unlock();
+		notFull_.notify_one();
+		return true;
+	}
+
+	/** Wakes all waiting threads; no more items may be pushed */
+	void close()
+	{
+		std::unique_lock<std::mutex> ulock(mutex_);
+		closed_ = true;
+		ulock.unlock();
+		notEmpty_.notify_all();
+		notFull_.notify_all();
+	}
+
+	/** Prevents copying */
+	BoundedQueue(const BoundedQueue &) = delete;
+
+    private:
+	/** Standard queue wrapped around with locks */
+	std::queue<T> queue_;
+	/** Most items held before push() blocks */
+	const size_t capacity_;
+	/** Set when no more items will be pushed */
+	bool closed_ { false };
+	/** Standard mutex */
+	std::mutex mutex_;
+	/** Signaled when an item is pushed or the queue is closed */
+	std::condition_variable notEmpty_;
+	/** Signaled when an item is popped or the queue is closed */
+	std::condition_variable notFull_;
+};
+
+/**
+ *  @brief
+ *  State shared by threads walking a directory tree.
+ *
+ *  @details
+ *  Scanning threads take directories from directories, push image paths
+ *  to files, and push subdirectories back to directories. The walk is
+ *  finished when outstanding reaches 0.
+ */
+struct DirectoryWalk {
+	/**
+	 *  @brief
+	 *  Constructor.
+	 *
+	 *  @param[in] capacity
+	 *      Most image paths held before scanning threads block.
+	 */
+	explicit DirectoryWalk(const size_t capacity)
+	    : files { capacity }
+	{
+	}
+
+	/** Image paths waiting to be scored */
+	BoundedQueue<std::string> files;
+	/** Directories waiting to be scanned */
+	std::deque<std::string> directories {};
+	/** Directories waiting to be scanned or being scanned */
+	unsigned int outstanding { 0 };
+	/** RecordStores found while scanning, scored after the walk */
+	std::vector<std::string> recordStores {};
+	/** Protects directories, outstanding, and recordStores */
+	std::mutex mutex {};
+	/** Signals changes to directories and outstanding */
+	std::condition_variable changed {};
 };
 
 } // namespace NFIQ2UI
@@ -143,6 +143,26 @@ std::string removeSlash(std::string path);
 bool yesOrNo(const std::string &prompt, bool default_answer = true,
     bool show_options = true, bool allow_default_answer = true);
 
+/**
+ *  @brief
+ *  Parses a non-negative decimal number that must fit in an unsigned int.
+ *
+ *  @details
+ *  Unlike std::stoul(), a leading '-' is rejected rather than wrapped.
+ *
+ *  @param[in] arg
+ *    Text of the number.
+ *
+ *  @return
+ *    The number.
+ *
+ *  @throws std::invalid_argument
+ *    arg is not a non-negative number.
+ *  @throws std::out_of_range
+ *    arg is larger than UINT_MAX.
+ */
+unsigned int parseUnsigned(const std::string &arg);
+
 /**
  *  @brief
  *  Checks the given thread amount against the physical cores
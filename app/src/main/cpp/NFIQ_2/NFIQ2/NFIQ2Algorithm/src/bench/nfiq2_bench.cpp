@@ -0,0 +1,821 @@
+/******************************************************************************
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ ******************************************************************************/
+
+/*
+ * nfiq2_bench: per-stage microbenchmark of the NFIQ 2 pipeline.
+ *
+ * Every image is taken through the same stages, in the same order, as
+ * NFIQ2::QualityFeatures::computeQualityModules() followed by
+ * NFIQ2::Algorithm::computeQualityScore(): near-white frame removal, the ten
+ * quality feature modules and the random forest. The NFIR resample is timed
+ * as well; images that are not 500 PPI are resampled for real, the others are
+ * resampled to 500 PPI from a copy scaled to the -r resolution.
+ *
+ * For each stage, throughput, latency percentiles and heap allocations per
+ * image are reported. Before any timing is trusted, the computed score,
+ * actionable feedback and feature values of the first iteration are checked
+ * against the expected output in examples/output and, when given the
+ * conformance dataset, conformance/conformance_expected_output.csv. Any
+ * mismatch fails the run.
+ */
+
+#ifdef _WIN32
+#include <getopt.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <be_error_exception.h>
+#include <be_image_image.h>
+#include <be_io_utility.h>
+#include <be_sysdeps.h>
+#include <features/FDAFeature.h>
+#include <features/FJFXMinutiaeQualityFeatures.h>
+#include <features/FingerJetFXFeature.h>
+#include <features/ImgProcROIFeature.h>
+#include <features/LCSFeature.h>
+#include <features/MuFeature.h>
+#include <features/OCLHistogramFeature.h>
+#include <features/OFFeature.h>
+#include <features/QualityMapFeatures.h>
+#include <features/RVUPHistogramFeature.h>
+#include <nfiq2_algorithm.hpp>
+#include <nfiq2_exception.hpp>
+#include <nfiq2_fingerprintimagedata.hpp>
+#include <nfiq2_modelinfo.hpp>
+#include <nfiq2_qualityfeatures.hpp>
+#include <nfiq2_timer.hpp>
+#include <nfir_lib.h>
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace BE = BiometricEvaluation;
+
+/*
+ * Heap allocation counters. Replacing the global allocation functions counts
+ * every operator new in the process, including the NFIQ 2 and FingerJet
+ * libraries. OpenCV matrix buffers come from cv::fastMalloc() and are not
+ * counted.
+ */
+static std::atomic<uint64_t> allocationCount { 0 };
+static std::atomic<uint64_t> allocationBytes { 0 };
+
+void *
+operator new(std::size_t size)
+{
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+	allocationBytes.fetch_add(size, std::memory_order_relaxed);
+	void *p = std::malloc(size != 0 ? size : 1);
+	if (p == nullptr) {
+		throw std::bad_alloc();
+	}
+	return (p);
+}
+
+void *
+operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+	allocationBytes.fetch_add(size, std::memory_order_relaxed);
+	return (std::malloc(size != 0 ? size : 1));
+}
+
+void
+operator delete(void *p) noexcept
+{
+	std::free(p);
+}
+
+void
+operator delete(void *p, const std::nothrow_t &) noexcept
+{
+	std::free(p);
+}
+
+namespace NFIQ2Bench {
+
+/** Timing and allocation samples of one pipeline stage. */
+struct Stage {
+	std::string name {};
+	std::vector<double> milliseconds {};
+	uint64_t allocations { 0 };
+	uint64_t bytes { 0 };
+};
+
+/** Records one sample of a Stage between construction and stop(). */
+class Measurement {
+    public:
+	explicit Measurement(Stage &stage)
+	    : stage(stage)
+	    , allocations(allocationCount.load())
+	    , bytes(allocationBytes.load())
+	{
+		timer.start();
+	}
+
+	void stop()
+	{
+		const double elapsed = timer.stop();
+		stage.milliseconds.push_back(elapsed);
+		stage.allocations += allocationCount.load() - allocations;
+		stage.bytes += allocationBytes.load() - bytes;
+	}
+
+    private:
+	Stage &stage;
+	const uint64_t allocations;
+	const uint64_t bytes;
+	NFIQ2::Timer timer {};
+};
+
+enum StageIndex {
+	Resample = 0,
+	NearWhiteFrame,
+	FDA,
+	FingerJetFX,
+	FJFXMinutiaeQuality,
+	ImgProcROI,
+	LCS,
+	Mu,
+	OCLHistogram,
+	OF,
+	QualityMap,
+	RVUPHistogram,
+	RandomForest,
+	Total,
+	StageCount
+};
+
+static const char *const StageNames[StageCount] { "NFIR::resample",
+	"copyRemovingNearWhiteFrame", "FDAFeature", "FingerJetFXFeature",
+	"FJFXMinutiaeQualityFeature", "ImgProcROIFeature", "LCSFeature",
+	"MuFeature", "OCLHistogramFeature", "OFFeature", "QualityMapFeatures",
+	"RVUPHistogramFeature", "RandomForest", "Total" };
+
+/** A decoded benchmark image. */
+struct Image {
+	std::string path {};
+	std::string name {};
+	uint8_t fingerCode { 0 };
+	/** 8-bit grayscale pixels at their native resolution. */
+	cv::Mat pixels {};
+	uint16_t ppi { NFIQ2::FingerprintImageData::Resolution500PPI };
+	/** Map of expected output values, if any are known. */
+	std::unordered_map<std::string, double> expected {};
+	/** Where `expected` was read from. */
+	std::string expectedSource {};
+	bool failed { false };
+};
+
+/** Values computed for one image, keyed as in the expected output. */
+using Values = std::unordered_map<std::string, double>;
+
+struct Options {
+	std::string modelInfoPath { NFIQ2_BENCH_SOURCE_ROOT
+		"/NFIQ2/nist_plain_tir-ink.txt" };
+	std::string expectedOutputDir { NFIQ2_BENCH_SOURCE_ROOT
+		"/examples/output" };
+	std::string conformanceDir {};
+	unsigned int iterations { 5 };
+	uint16_t resamplePPI { 1000 };
+	std::vector<std::string> inputs {};
+};
+
+static void
+printUsage(const char *argv0)
+{
+	std::cerr
+	    << "Usage: " << argv0
+	    << " [-m model_info] [-i iterations] [-r ppi] [-e expected_dir]\n"
+	       "       [-c conformance_dir] [image|directory ...]\n\n"
+	       "  -m  Random forest model information file\n"
+	       "      (default: NFIQ2/nist_plain_tir-ink.txt)\n"
+	       "  -i  Timed iterations over the corpus (default: 5)\n"
+	       "  -r  Resolution from which 500 PPI images are resampled "
+	       "when timing NFIR\n      (default: 1000)\n"
+	       "  -e  Directory of <name>_output.txt expected values\n"
+	       "      (default: examples/output)\n"
+	       "  -c  Directory holding the NFIQ 2 conformance dataset; "
+	       "its images are\n      added to the corpus and checked against "
+	       "conformance_expected_output.csv\n\n"
+	       "Without images, the in-repository sample images are used.\n";
+}
+
+/** @return `path` without directories and extension. */
+static std::string
+stem(const std::string &path)
+{
+	const std::string::size_type slash = path.find_last_of("/\\");
+	std::string name = (slash == std::string::npos) ?
+	    path :
+	    path.substr(slash + 1);
+	const std::string::size_type dot = name.find_last_of('.');
+	if (dot != std::string::npos && dot != 0) {
+		name.erase(dot);
+	}
+	return (name);
+}
+
+/** Append the regular files under `path` (or `path` itself) to `files`. */
+static void
+listFiles(const std::string &path, std::vector<std::string> &files)
+{
+	if (!BE::IO::Utility::pathIsDirectory(path)) {
+		files.push_back(path);
+		return;
+	}
+
+	std::vector<std::string> entries {};
+	DIR *dr = opendir(path.c_str());
+	if (dr == nullptr) {
+		return;
+	}
+	struct dirent *en;
+	while ((en = readdir(dr)) != nullptr) {
+		const std::string name { en->d_name };
+		if (name == "." || name == ".." || name[0] == '.') {
+			continue;
+		}
+		entries.push_back(path + "/" + name);
+	}
+	closedir(dr);
+
+	std::sort(entries.begin(), entries.end());
+	for (const auto &entry : entries) {
+		listFiles(entry, files);
+	}
+}
+
+/**
+ * Decode an image to 8-bit grayscale. Images without a resolution (NetPBM
+ * reports 72 PPI) are taken as 500 PPI, as the command-line tool does with -F.
+ */
+static bool
+loadImage(const std::string &path, Image &image)
+{
+	static const uint16_t defaultPPI { 72 };
+
+	try {
+		const std::shared_ptr<BE::Image::Image> img =
+		    BE::Image::Image::openImage(path);
+		const BE::Memory::uint8Array raw = img->getRawGrayscaleData(8);
+		const BE::Image::Size dimensions = img->getDimensions();
+		const BE::Image::Resolution resolution =
+		    img->getResolution().toUnits(
+			BE::Image::Resolution::Units::PPI);
+
+		image.path = path;
+		image.name = stem(path);
+		image.pixels = cv::Mat(static_cast<int>(dimensions.ySize),
+		    static_cast<int>(dimensions.xSize), CV_8U,
+		    const_cast<uint8_t *>(static_cast<const uint8_t *>(raw)))
+				   .clone();
+		image.ppi = static_cast<uint16_t>(std::round(resolution.xRes));
+		if (image.ppi == defaultPPI) {
+			image.ppi =
+			    NFIQ2::FingerprintImageData::Resolution500PPI;
+		}
+	} catch (const BE::Error::Exception &e) {
+		std::cerr << "Could not open " << path << ": " << e.what()
+			  << "\n";
+		return (false);
+	}
+	return (true);
+}
+
+/** Read "Key: value" lines, as written by examples/example_api.cpp. */
+static bool
+readExpectedOutput(const std::string &path, Values &expected)
+{
+	std::ifstream in { path };
+	if (!in) {
+		return (false);
+	}
+	std::string line {};
+	while (std::getline(in, line)) {
+		const std::string::size_type colon = line.find(':');
+		if (colon == std::string::npos) {
+			continue;
+		}
+		try {
+			expected[line.substr(0, colon)] =
+			    std::stod(line.substr(colon + 1));
+		} catch (const std::exception &) {
+			// Not a number
+		}
+	}
+	return (!expected.empty());
+}
+
+/** Split one CSV line, honoring double-quoted fields. */
+static std::vector<std::string>
+splitCSV(const std::string &line)
+{
+	std::vector<std::string> fields { std::string() };
+	bool quoted { false };
+	for (const char c : line) {
+		if (c == '"') {
+			quoted = !quoted;
+		} else if (c == ',' && !quoted) {
+			fields.emplace_back();
+		} else if (c != '\r') {
+			fields.back().push_back(c);
+		}
+	}
+	return (fields);
+}
+
+/**
+ * Add the images of the conformance dataset found under `dir`, with their
+ * expected values from the conformance CSV.
+ *
+ * @return
+ * Number of images added.
+ */
+static unsigned int
+addConformanceImages(const std::string &dir, std::vector<Image> &images)
+{
+	static const std::string csvPath { NFIQ2_BENCH_SOURCE_ROOT
+		"/conformance/conformance_expected_output.csv" };
+	/* Columns describing the run rather than the image */
+	static const std::vector<std::string> metadata { "Filename",
+		"FingerCode", "OptionalError", "Quantized", "Resampled" };
+
+	std::ifstream in { csvPath };
+	std::string line {};
+	if (!in || !std::getline(in, line)) {
+		std::cerr << "Could not read " << csvPath << "\n";
+		return (0);
+	}
+	const std::vector<std::string> header = splitCSV(line);
+
+	unsigned int added { 0 };
+	while (std::getline(in, line)) {
+		const std::vector<std::string> row = splitCSV(line);
+		if (row.size() != header.size()) {
+			continue;
+		}
+		std::unordered_map<std::string, std::string> fields {};
+		for (size_t i = 0; i < header.size(); ++i) {
+			fields[header[i]] = row[i];
+		}
+		/* Rows that record an error carry no values */
+		if (fields["OptionalError"] != "NA") {
+			continue;
+		}
+
+		const std::string path = dir + "/" + fields["Filename"];
+		if (!BE::IO::Utility::fileExists(path)) {
+			continue;
+		}
+		Image image {};
+		if (!loadImage(path, image)) {
+			continue;
+		}
+		image.fingerCode = static_cast<uint8_t>(
+		    std::stoi(fields["FingerCode"]));
+		for (const auto &field : fields) {
+			if (std::find(metadata.cbegin(), metadata.cend(),
+				field.first) != metadata.cend()) {
+				continue;
+			}
+			image.expected[field.first] = std::stod(field.second);
+		}
+		image.expectedSource = csvPath;
+		images.push_back(std::move(image));
+		++added;
+	}
+	return (added);
+}
+
+/**
+ * Run every stage once on `image`, recording a sample into each Stage.
+ *
+ * @param values
+ * If not null, receives the score, actionable feedback and feature values.
+ */
+static void
+runPipeline(const Image &image, const NFIQ2::Algorithm &model,
+    const Options &options, std::vector<Stage> &stages, Values *values)
+{
+	Measurement total { stages[Total] };
+
+	/* Resample to 500 PPI, from a scaled copy if already 500 PPI */
+	cv::Mat pixels {};
+	if (image.ppi != NFIQ2::FingerprintImageData::Resolution500PPI) {
+		cv::Mat src = image.pixels;
+		Measurement m { stages[Resample] };
+		NFIR::resample(src, pixels, image.ppi,
+		    NFIQ2::FingerprintImageData::Resolution500PPI, "", "");
+		m.stop();
+	} else {
+		const double scale = static_cast<double>(options.resamplePPI) /
+		    NFIQ2::FingerprintImageData::Resolution500PPI;
+		cv::Mat src {};
+		cv::resize(image.pixels, src, cv::Size(), scale, scale,
+		    cv::INTER_LINEAR);
+		cv::Mat tgt {};
+		Measurement m { stages[Resample] };
+		NFIR::resample(src, tgt, options.resamplePPI,
+		    NFIQ2::FingerprintImageData::Resolution500PPI, "", "");
+		m.stop();
+		pixels = image.pixels;
+	}
+	if (!pixels.isContinuous()) {
+		pixels = pixels.clone();
+	}
+
+	const NFIQ2::FingerprintImageData rawImage { pixels.ptr<uint8_t>(),
+		static_cast<uint32_t>(pixels.total()),
+		static_cast<uint32_t>(pixels.cols),
+		static_cast<uint32_t>(pixels.rows), image.fingerCode,
+		NFIQ2::FingerprintImageData::Resolution500PPI };
+
+	Measurement crop { stages[NearWhiteFrame] };
+	const NFIQ2::FingerprintImageData croppedImage =
+	    rawImage.copyRemovingNearWhiteFrame();
+	crop.stop();
+
+	std::vector<std::shared_ptr<NFIQ2::QualityFeatures::Module>>
+	    modules {};
+
+	Measurement fda { stages[FDA] };
+	modules.push_back(
+	    std::make_shared<NFIQ2::QualityFeatures::FDAFeature>(croppedImage));
+	fda.stop();
+
+	Measurement fjfx { stages[FingerJetFX] };
+	const std::shared_ptr<NFIQ2::QualityFeatures::FingerJetFXFeature>
+	    fjfxModule = std::make_shared<
+		NFIQ2::QualityFeatures::FingerJetFXFeature>(croppedImage);
+	modules.push_back(fjfxModule);
+	fjfx.stop();
+
+	Measurement minQuality { stages[FJFXMinutiaeQuality] };
+	modules.push_back(std::make_shared<
+	    NFIQ2::QualityFeatures::FJFXMinutiaeQualityFeature>(
+	    croppedImage, fjfxModule->getMinutiaData()));
+	minQuality.stop();
+
+	Measurement roi { stages[ImgProcROI] };
+	const std::shared_ptr<NFIQ2::QualityFeatures::ImgProcROIFeature>
+	    roiModule = std::make_shared<
+		NFIQ2::QualityFeatures::ImgProcROIFeature>(croppedImage);
+	modules.push_back(roiModule);
+	roi.stop();
+
+	Measurement lcs { stages[LCS] };
+	modules.push_back(
+	    std::make_shared<NFIQ2::QualityFeatures::LCSFeature>(croppedImage));
+	lcs.stop();
+
+	Measurement mu { stages[Mu] };
+	modules.push_back(
+	    std::make_shared<NFIQ2::QualityFeatures::MuFeature>(croppedImage));
+	mu.stop();
+
+	Measurement ocl { stages[OCLHistogram] };
+	modules.push_back(
+	    std::make_shared<NFIQ2::QualityFeatures::OCLHistogramFeature>(
+		croppedImage));
+	ocl.stop();
+
+	Measurement of { stages[OF] };
+	modules.push_back(
+	    std::make_shared<NFIQ2::QualityFeatures::OFFeature>(croppedImage));
+	of.stop();
+
+	Measurement qualityMap { stages[QualityMap] };
+	modules.push_back(
+	    std::make_shared<NFIQ2::QualityFeatures::QualityMapFeatures>(
+		croppedImage, roiModule->getImgProcResults()));
+	qualityMap.stop();
+
+	Measurement rvup { stages[RVUPHistogram] };
+	modules.push_back(
+	    std::make_shared<NFIQ2::QualityFeatures::RVUPHistogramFeature>(
+		croppedImage));
+	rvup.stop();
+
+	Measurement forest { stages[RandomForest] };
+	const unsigned int score = model.computeQualityScore(modules);
+	forest.stop();
+
+	total.stop();
+
+	if (values != nullptr) {
+		*values = NFIQ2::QualityFeatures::getQualityFeatureValues(
+		    modules);
+		for (const auto &feedback :
+		    NFIQ2::QualityFeatures::getActionableQualityFeedback(
+			modules)) {
+			values->insert(feedback);
+		}
+		(*values)["QualityScore"] = score;
+	}
+}
+
+/**
+ * Compare computed values with the expected output of an image.
+ *
+ * @return
+ * Number of mismatching values.
+ */
+static unsigned int
+checkConformance(const Image &image, const Values &values)
+{
+	/* Expected output is printed with 6 significant digits or 5 decimals */
+	static const double tolerance { 1e-5 };
+
+	unsigned int mismatches { 0 };
+	std::map<std::string, double> sorted { image.expected.cbegin(),
+		image.expected.cend() };
+	for (const auto &expected : sorted) {
+		const auto computed = values.find(expected.first);
+		if (computed == values.cend()) {
+			std::cerr << image.name << ": " << expected.first
+				  << " was not computed\n";
+			++mismatches;
+			continue;
+		}
+		const double error = std::fabs(
+		    computed->second - expected.second);
+		if (error >
+		    tolerance * std::max(1.0, std::fabs(expected.second))) {
+			std::cerr << std::setprecision(10) << image.name << ": "
+				  << expected.first << " = " << computed->second
+				  << ", expected " << expected.second << " ("
+				  << image.expectedSource << ")\n";
+			++mismatches;
+		}
+	}
+	return (mismatches);
+}
+
+/** @return nearest-rank percentile `p` of sorted samples */
+static double
+percentile(const std::vector<double> &sorted, const double p)
+{
+	if (sorted.empty()) {
+		return (0);
+	}
+	const size_t rank = static_cast<size_t>(
+	    std::ceil(p / 100.0 * static_cast<double>(sorted.size())));
+	return (sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1]);
+}
+
+static void
+printReport(const std::vector<Stage> &stages)
+{
+	std::cout << std::left << std::setw(28) << "Stage" << std::right
+		  << std::setw(7) << "Images" << std::setw(10) << "Images/s"
+		  << std::setw(9) << "p50 ms" << std::setw(9) << "p90 ms"
+		  << std::setw(9) << "p99 ms" << std::setw(9) << "max ms"
+		  << std::setw(12) << "Allocs/img" << std::setw(10)
+		  << "KiB/img"
+		  << "\n";
+
+	for (const auto &stage : stages) {
+		if (stage.milliseconds.empty()) {
+			continue;
+		}
+		std::vector<double> sorted { stage.milliseconds };
+		std::sort(sorted.begin(), sorted.end());
+		double sum { 0 };
+		for (const double ms : sorted) {
+			sum += ms;
+		}
+		const double n = static_cast<double>(sorted.size());
+
+		std::cout << std::left << std::setw(28) << stage.name
+			  << std::right << std::setw(7) << sorted.size()
+			  << std::fixed << std::setprecision(1) << std::setw(10)
+			  << (sum > 0 ? 1000.0 * n / sum : 0)
+			  << std::setprecision(3) << std::setw(9)
+			  << percentile(sorted, 50) << std::setw(9)
+			  << percentile(sorted, 90) << std::setw(9)
+			  << percentile(sorted, 99) << std::setw(9)
+			  << sorted.back() << std::setprecision(0)
+			  << std::setw(12)
+			  << static_cast<double>(stage.allocations) / n
+			  << std::setprecision(1) << std::setw(10)
+			  << static_cast<double>(stage.bytes) / n / 1024.0
+			  << "\n";
+	}
+	std::cout << "\nAllocations count operator new only; OpenCV matrix "
+		     "buffers are not included.\n";
+}
+
+static bool
+parseArguments(int argc, char *argv[], Options &options)
+{
+	int c {};
+	while ((c = getopt(argc, argv, "m:i:r:e:c:h")) != -1) {
+		try {
+			switch (c) {
+			case 'm':
+				options.modelInfoPath = optarg;
+				break;
+			case 'i':
+				options.iterations = static_cast<unsigned int>(
+				    std::max(1, std::stoi(optarg)));
+				break;
+			case 'r':
+				options.resamplePPI = static_cast<uint16_t>(
+				    std::stoi(optarg));
+				break;
+			case 'e':
+				options.expectedOutputDir = optarg;
+				break;
+			case 'c':
+				options.conformanceDir = optarg;
+				break;
+			default:
+				return (false);
+			}
+		} catch (const std::exception &) {
+			std::cerr << "Invalid argument to -"
+				  << static_cast<char>(c) << ": " << optarg
+				  << "\n";
+			return (false);
+		}
+	}
+	for (int i = optind; i < argc; ++i) {
+		options.inputs.emplace_back(argv[i]);
+	}
+	if (options.resamplePPI <=
+	    NFIQ2::FingerprintImageData::Resolution500PPI) {
+		std::cerr << "-r must be greater than 500\n";
+		return (false);
+	}
+	return (true);
+}
+
+} // namespace NFIQ2Bench
+
+int
+main(int argc, char *argv[])
+{
+	using namespace NFIQ2Bench;
+
+	Options options {};
+	if (!parseArguments(argc, argv, options)) {
+		printUsage(argv[0]);
+		return (EXIT_FAILURE);
+	}
+
+	std::unique_ptr<NFIQ2::Algorithm> model {};
+	try {
+		model.reset(new NFIQ2::Algorithm(
+		    NFIQ2::ModelInfo(options.modelInfoPath)));
+	} catch (const NFIQ2::Exception &e) {
+		std::cerr << "Could not load model: " << e.what() << "\n";
+		return (EXIT_FAILURE);
+	}
+
+	std::vector<std::string> files {};
+	if (options.inputs.empty() && options.conformanceDir.empty()) {
+		options.inputs = { NFIQ2_BENCH_SOURCE_ROOT "/examples/images",
+			NFIQ2_BENCH_SOURCE_ROOT
+			"/fingerjetfxose/FingerJetFXOSE/libFJFX/samples/"
+			"images-pgm",
+			NFIQ2_BENCH_SOURCE_ROOT
+			"/libbiomeval/src/test/test_data/img.wsq" };
+	}
+	for (const auto &input : options.inputs) {
+		listFiles(input, files);
+	}
+
+	std::vector<Image> images {};
+	for (const auto &path : files) {
+		Image image {};
+		if (!loadImage(path, image)) {
+			continue;
+		}
+		const std::string expectedPath = options.expectedOutputDir +
+		    "/" + image.name + "_output.txt";
+		if (readExpectedOutput(expectedPath, image.expected)) {
+			image.expectedSource = expectedPath;
+		}
+		images.push_back(std::move(image));
+	}
+	if (!options.conformanceDir.empty() &&
+	    addConformanceImages(options.conformanceDir, images) == 0) {
+		std::cerr << "No conformance images found in "
+			  << options.conformanceDir << "\n";
+		return (EXIT_FAILURE);
+	}
+	if (images.empty()) {
+		std::cerr << "No images to benchmark\n";
+		return (EXIT_FAILURE);
+	}
+
+	/*
+	 * computeQualityModules() sets the FPU mode NFIQ 2 requires before
+	 * looking at the image, so an empty image is enough for the modules
+	 * timed one by one below to run in that mode.
+	 */
+	try {
+		NFIQ2::QualityFeatures::computeQualityModules(
+		    NFIQ2::FingerprintImageData());
+	} catch (const NFIQ2::Exception &) {
+		// Expected
+	}
+
+	/* Untimed warm-up, which also drops images NFIQ 2 rejects */
+	for (auto &image : images) {
+		try {
+			std::vector<Stage> scratch(StageCount);
+			runPipeline(image, *model, options, scratch, nullptr);
+		} catch (const std::exception &e) {
+			std::cerr << image.name << ": " << e.what() << "\n";
+			image.failed = true;
+		}
+	}
+
+	std::vector<Stage> stages(StageCount);
+	for (unsigned int i = 0; i < StageCount; ++i) {
+		stages[i].name = StageNames[i];
+	}
+
+	unsigned int checkedImages { 0 }, checkedValues { 0 },
+	    mismatches { 0 }, failures { 0 };
+	for (unsigned int iteration = 0; iteration < options.iterations;
+	     ++iteration) {
+		for (auto &image : images) {
+			if (image.failed) {
+				continue;
+			}
+			const bool check = (iteration == 0) &&
+			    !image.expected.empty();
+			Values values {};
+			try {
+				runPipeline(image, *model, options, stages,
+				    check ? &values : nullptr);
+			} catch (const std::exception &e) {
+				std::cerr << image.name << ": " << e.what()
+					  << "\n";
+				image.failed = true;
+				continue;
+			}
+			if (check) {
+				++checkedImages;
+				checkedValues += static_cast<unsigned int>(
+				    image.expected.size());
+				mismatches += checkConformance(image, values);
+			}
+		}
+	}
+	/*
+	 * Images NFIQ 2 rejects are only skipped, unless an expected output
+	 * says they should have been scored.
+	 */
+	unsigned int skipped { 0 };
+	for (const auto &image : images) {
+		if (!image.failed) {
+			continue;
+		}
+		++skipped;
+		if (!image.expected.empty()) {
+			std::cerr << image.name << ": not scored, expected "
+				  << "output in " << image.expectedSource
+				  << "\n";
+			++failures;
+		}
+	}
+
+	std::cout << images.size() - skipped << " images, "
+		  << options.iterations << " iterations\n\n";
+	printReport(stages);
+	std::cout << "\nConformance: " << checkedValues << " values in "
+		  << checkedImages << " images checked, " << mismatches
+		  << " mismatches\n";
+	if (skipped != 0) {
+		std::cout << skipped << " images could not be scored\n";
+	}
+
+	return ((mismatches == 0 && failures == 0) ? EXIT_SUCCESS :
+						     EXIT_FAILURE);
+}
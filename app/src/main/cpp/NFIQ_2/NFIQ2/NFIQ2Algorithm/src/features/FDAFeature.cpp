@@ -2,6 +2,7 @@
 #include <features/FeatureFunctions.h>
 #include <nfiq2_exception.hpp>
 #include <nfiq2_timer.hpp>
+#include <nfiq2_trace.hpp>
 #include <opencv2/core.hpp>
 
 #include <cmath>
@@ -44,9 +45,10 @@ double fda(const cv::Mat &block, const double orientation, const int v1sz_x,
     const int v1sz_y, const bool padFlag);
 
 NFIQ2::QualityFeatures::FDAFeature::FDAFeature(
-    const NFIQ2::FingerprintImageData &fingerprintImage)
+    const NFIQ2::FingerprintImageData &fingerprintImage,
+    const NFIQ2::CancellationToken &cancellation)
 {
-	this->setFeatures(computeFeatureData(fingerprintImage));
+	this->setFeatures(computeFeatureData(fingerprintImage, cancellation));
 }
 
 NFIQ2::QualityFeatures::FDAFeature::~FDAFeature() = default;
@@ -86,7 +88,8 @@ NFIQ2::QualityFeatures::FDAFeature::getModuleName() const
 
 std::unordered_map<std::string, double>
 NFIQ2::QualityFeatures::FDAFeature::computeFeatureData(
-    const NFIQ2::FingerprintImageData &fingerprintImage)
+    const NFIQ2::FingerprintImageData &fingerprintImage,
+    const NFIQ2::CancellationToken &cancellation)
 {
 	std::unordered_map<std::string, double> featureDataList;
 
@@ -109,6 +112,8 @@ NFIQ2::QualityFeatures::FDAFeature::computeFeatureData(
 	NFIQ2::Timer timer;
 	try {
 		timer.start();
+		NFIQ2_TRACE_SPAN(
+		    span, NFIQ2::Identifiers::QualityModules::FrequencyDomainAnalysis);
 
 		cv::Mat maskim;
 		const int blksize = this->blocksize;
@@ -117,8 +122,10 @@ NFIQ2::QualityFeatures::FDAFeature::computeFeatureData(
 
 		assert((blksize > 0) && (this->threshold > 0));
 
+		NFIQ2_TRACE_SPAN(segmentSpan, "ridgesegment");
 		ridgesegment(img, blksize, this->threshold, cv::noArray(),
 		    maskim, cv::noArray());
+		NFIQ2_TRACE_END(segmentSpan);
 
 		int rows = img.rows;
 		int cols = img.cols;
@@ -148,10 +155,12 @@ NFIQ2::QualityFeatures::FDAFeature::computeFeatureData(
 
 		// Image processed NOT from beg to end but with a border around
 		// - can't be vectorized:(
+		NFIQ2_TRACE_SPAN(blockSpan, "blocks");
 		int br = 0;
 		int bc = 0;
 		for (int r = blkoffset; r < rows - (blksize + blkoffset - 1);
 		     r += blksize) {
+			cancellation.throwIfCancelled();
 			for (int c = blkoffset;
 			     c < cols - (blksize + blkoffset - 1);
 			     c += blksize) {
@@ -193,7 +202,9 @@ NFIQ2::QualityFeatures::FDAFeature::computeFeatureData(
 			br = br + 1;
 			bc = 0;
 		}
+		NFIQ2_TRACE_END(blockSpan);
 
+		NFIQ2_TRACE_SPAN(histogramSpan, "histogram");
 		std::vector<double> histogramBins10;
 		histogramBins10.push_back(FDAHISTLIMITS[0]);
 		histogramBins10.push_back(FDAHISTLIMITS[1]);
@@ -206,7 +217,9 @@ NFIQ2::QualityFeatures::FDAFeature::computeFeatureData(
 		histogramBins10.push_back(FDAHISTLIMITS[8]);
 		addHistogramFeatures(featureDataList, NFIQ2FDAFeaturePrefix,
 		    histogramBins10, dataVector, 10);
+		NFIQ2_TRACE_END(histogramSpan);
 
+		NFIQ2_TRACE_END(span);
 		this->setSpeed(timer.stop());
 	} catch (const cv::Exception &e) {
 		std::stringstream ssErr;
@@ -2,6 +2,7 @@
 #include <features/OCLHistogramFeature.h>
 #include <nfiq2_exception.hpp>
 #include <nfiq2_timer.hpp>
+#include <nfiq2_trace.hpp>
 
 #include <sstream>
 
@@ -17,10 +18,11 @@ const char NFIQ2::Identifiers::QualityFeatures::Minutiae::QualityOCL80[] {
 
 NFIQ2::QualityFeatures::FJFXMinutiaeQualityFeature::FJFXMinutiaeQualityFeature(
     const NFIQ2::FingerprintImageData &fingerprintImage,
-    const std::vector<FingerJetFXFeature::Minutia> &minutiaData)
+    const std::vector<FingerJetFXFeature::Minutia> &minutiaData,
+    const NFIQ2::CancellationToken &cancellation)
     : minutiaData_ { minutiaData }
 {
-	this->setFeatures(computeFeatureData(fingerprintImage));
+	this->setFeatures(computeFeatureData(fingerprintImage, cancellation));
 };
 
 NFIQ2::QualityFeatures::FJFXMinutiaeQualityFeature::
@@ -34,7 +36,8 @@ NFIQ2::QualityFeatures::FJFXMinutiaeQualityFeature::getMinutiaData() const
 
 std::unordered_map<std::string, double>
 NFIQ2::QualityFeatures::FJFXMinutiaeQualityFeature::computeFeatureData(
-    const NFIQ2::FingerprintImageData &fingerprintImage)
+    const NFIQ2::FingerprintImageData &fingerprintImage,
+    const NFIQ2::CancellationToken &cancellation)
 {
 	std::unordered_map<std::string, double> featureDataList;
 
@@ -49,6 +52,10 @@ NFIQ2::QualityFeatures::FJFXMinutiaeQualityFeature::computeFeatureData(
 	try {
 		NFIQ2::Timer timer;
 		timer.start();
+		NFIQ2_TRACE_SPAN(
+		    span, NFIQ2::Identifiers::QualityModules::MinutiaeQuality);
+
+		cancellation.throwIfCancelled();
 
 		// compute minutiae quality based on Mu feature computated at
 		// minutiae positions
@@ -81,6 +88,8 @@ NFIQ2::QualityFeatures::FJFXMinutiaeQualityFeature::computeFeatureData(
 		    (double)this->minutiaData_.size();
 		featureDataList[fd_mu.first] = fd_mu.second;
 
+		cancellation.throwIfCancelled();
+
 		// compute minutiae quality based on OCL feature computed at
 		// minutiae positions
 		std::vector<MinutiaData> vecOCLMinQualityData =
@@ -114,6 +123,7 @@ NFIQ2::QualityFeatures::FJFXMinutiaeQualityFeature::computeFeatureData(
 		    (double)this->minutiaData_.size();
 		featureDataList[fd_ocl.first] = fd_ocl.second;
 
+		NFIQ2_TRACE_END(span);
 		this->setSpeed(timer.stop());
 	} catch (const cv::Exception &e) {
 		std::stringstream ssErr;
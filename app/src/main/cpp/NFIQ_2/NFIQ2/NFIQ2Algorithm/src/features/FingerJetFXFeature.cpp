@@ -1,8 +1,8 @@
 #include <features/FingerJetFXFeature.h>
 #include <nfiq2_exception.hpp>
 #include <nfiq2_timer.hpp>
+#include <nfiq2_trace.hpp>
 
-#include <cstring>
 #include <memory>
 #include <sstream>
 #include <tuple>
@@ -18,9 +18,10 @@ const char NFIQ2::Identifiers::QualityFeatures::Minutiae::CountCOM[] {
 };
 
 NFIQ2::QualityFeatures::FingerJetFXFeature::FingerJetFXFeature(
-    const NFIQ2::FingerprintImageData &fingerprintImage)
+    const NFIQ2::FingerprintImageData &fingerprintImage,
+    const NFIQ2::CancellationToken &cancellation)
 {
-	this->setFeatures(computeFeatureData(fingerprintImage));
+	this->setFeatures(computeFeatureData(fingerprintImage, cancellation));
 }
 
 NFIQ2::QualityFeatures::FingerJetFXFeature::~FingerJetFXFeature() = default;
@@ -85,20 +86,11 @@ NFIQ2::QualityFeatures::FingerJetFXFeature::getMinutiaData() const
 
 std::unordered_map<std::string, double>
 NFIQ2::QualityFeatures::FingerJetFXFeature::computeFeatureData(
-    const NFIQ2::FingerprintImageData &fingerprintImage)
+    const NFIQ2::FingerprintImageData &fingerprintImage,
+    const NFIQ2::CancellationToken &cancellation)
 {
 	std::unordered_map<std::string, double> featureDataList;
 
-	// make local copy of fingerprint image
-	// since FJFX somehow transforms the input image
-	NFIQ2::FingerprintImageData localFingerprintImage(
-	    fingerprintImage.width, fingerprintImage.height,
-	    fingerprintImage.fingerCode, fingerprintImage.ppi);
-	// copy data now
-	localFingerprintImage.resize(fingerprintImage.size());
-	memcpy((void *)localFingerprintImage.data(), fingerprintImage.data(),
-	    fingerprintImage.size());
-
 	std::pair<std::string, double> fd_min_cnt;
 	fd_min_cnt = std::make_pair(
 	    Identifiers::QualityFeatures::Minutiae::Count, 0);
@@ -109,10 +101,24 @@ NFIQ2::QualityFeatures::FingerJetFXFeature::computeFeatureData(
 
 	NFIQ2::Timer timer;
 	timer.start();
+	NFIQ2_TRACE_SPAN(
+	    span, NFIQ2::Identifiers::QualityModules::MinutiaeCount);
+
+	cancellation.throwIfCancelled();
+
+	// minutiae are extracted straight into this buffer, without a feature
+	// set handle, and the input image is left unmodified
+	std::unique_ptr<FRFXLL_Basic_19794_2_Minutia[]> mdata {};
+	try {
+		mdata.reset(new FRFXLL_Basic_19794_2_Minutia[FRFXLL_MAX_MINUTIAE]);
+	} catch (const std::bad_alloc &) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::NotEnoughMemory,
+		    "Could not allocate space for extracted minutiae records.");
+	}
 
 	// create context for feature extraction
 	// the created context function is modified to override default settings
-	FRFXLL_HANDLE hCtx = NULL, hFeatureSet = NULL;
+	FRFXLL_HANDLE hCtx = NULL;
 	if (!FRFXLL_SUCCESS(createContext(&hCtx))) {
 		throw NFIQ2::Exception(
 		    NFIQ2::ErrorCode::FJFX_CannotCreateContext,
@@ -126,56 +132,21 @@ NFIQ2::QualityFeatures::FingerJetFXFeature::computeFeatureData(
 		    "NULL).");
 	}
 
-	// extract feature set
-	const FRFXLL_RESULT fxRes = FRFXLLCreateFeatureSetFromRaw(hCtx,
-	    (unsigned char *)localFingerprintImage.data(),
-	    localFingerprintImage.size(), localFingerprintImage.width,
-	    localFingerprintImage.height, localFingerprintImage.ppi,
-	    FRFXLL_FEX_ENABLE_ENHANCEMENT, &hFeatureSet);
-	if (!FRFXLL_SUCCESS(fxRes)) {
-		FRFXLLCloseHandle(&hCtx);
-		throw NFIQ2::Exception(
-		    NFIQ2::ErrorCode::FJFX_CannotCreateFeatureSet,
-		    "Could not create feature set from raw data: " +
-			FingerJetFXFeature::parseFRFXLLError(fxRes));
-	}
+	// extract minutiae
+	unsigned int minCnt { FRFXLL_MAX_MINUTIAE };
+	const FRFXLL_RESULT fxRes = FRFXLLExtractMinutiaeFromRaw(hCtx,
+	    fingerprintImage.data(), fingerprintImage.size(),
+	    fingerprintImage.width, fingerprintImage.height,
+	    fingerprintImage.ppi, FRFXLL_FEX_ENABLE_ENHANCEMENT,
+	    BASIC_19794_2_MINUTIA_STRUCT, &minCnt, mdata.get());
 
 	// close handle
 	FRFXLLCloseHandle(&hCtx);
-	if (hFeatureSet == NULL) {
+	if (!FRFXLL_SUCCESS(fxRes)) {
 		throw NFIQ2::Exception(
 		    NFIQ2::ErrorCode::FJFX_CannotCreateFeatureSet,
-		    "Feature set creation failed. Feature set is null.");
-	}
-
-	unsigned int minCnt { 0 };
-	const FRFXLL_RESULT fxResMin = FRFXLLGetMinutiaInfo(
-	    hFeatureSet, &minCnt, nullptr);
-	if (!FRFXLL_SUCCESS(fxResMin)) {
-		FRFXLLCloseHandle(&hFeatureSet);
-		throw NFIQ2::Exception(
-		    NFIQ2::ErrorCode::FJFX_NoFeatureSetCreated,
-		    "Failed to obtain Minutia Info from feature set: " +
-			FingerJetFXFeature::parseFRFXLLError(fxResMin));
-	}
-
-	std::unique_ptr<FRFXLL_Basic_19794_2_Minutia[]> mdata {};
-	try {
-		mdata.reset(new FRFXLL_Basic_19794_2_Minutia[minCnt]);
-	} catch (const std::bad_alloc &) {
-		FRFXLLCloseHandle(&hFeatureSet);
-		throw NFIQ2::Exception(NFIQ2::ErrorCode::NotEnoughMemory,
-		    "Could not allocate space for extracted minutiae records.");
-	}
-
-	const FRFXLL_RESULT fxResData = FRFXLLGetMinutiae(
-	    hFeatureSet, BASIC_19794_2_MINUTIA_STRUCT, &minCnt, mdata.get());
-	if (!FRFXLL_SUCCESS(fxResData)) {
-		FRFXLLCloseHandle(&hFeatureSet);
-		throw NFIQ2::Exception(
-		    NFIQ2::ErrorCode::FJFX_NoFeatureSetCreated,
-		    "Failed to parse Minutia Data into 19794 Minutia Struct: " +
-			FingerJetFXFeature::parseFRFXLLError(fxResData));
+		    "Could not extract minutiae from raw data: " +
+			FingerJetFXFeature::parseFRFXLLError(fxRes));
 	}
 
 	this->minutiaData_.clear();
@@ -191,9 +162,6 @@ NFIQ2::QualityFeatures::FingerJetFXFeature::computeFeatureData(
 			mdata[i].t)));
 	}
 
-	// close handle
-	FRFXLLCloseHandle(&hFeatureSet);
-
 	if (minCnt == 0) {
 		// return features
 		fd_min_cnt_comrect200x200.second = 0; // no minutiae found
@@ -203,11 +171,15 @@ NFIQ2::QualityFeatures::FingerJetFXFeature::computeFeatureData(
 		fd_min_cnt.second = 0; // no minutiae found
 		featureDataList[fd_min_cnt.first] = fd_min_cnt.second;
 
+		NFIQ2_TRACE_END(span);
 		this->setSpeed(timer.stop());
 
 		return featureDataList;
 	}
 
+	// extraction itself cannot be interrupted, so check once it returns
+	cancellation.throwIfCancelled();
+
 	// compute ROI and return features
 	std::vector<FingerJetFXFeature::Object> vecRectDimensions;
 	FingerJetFXFeature::Object rect200x200;
@@ -243,6 +215,7 @@ NFIQ2::QualityFeatures::FingerJetFXFeature::computeFeatureData(
 	fd_min_cnt.second = minCnt;
 	featureDataList[fd_min_cnt.first] = fd_min_cnt.second;
 
+	NFIQ2_TRACE_END(span);
 	this->setSpeed(timer.stop());
 
 	return featureDataList;
@@ -1,6 +1,7 @@
 #include <features/ImgProcROIFeature.h>
 #include <nfiq2_exception.hpp>
 #include <nfiq2_timer.hpp>
+#include <nfiq2_trace.hpp>
 #include <opencv2/imgproc.hpp>
 
 #include <sstream>
@@ -13,9 +14,10 @@ const char NFIQ2::Identifiers::QualityFeatures::RegionOfInterest::Mean[] {
 };
 
 NFIQ2::QualityFeatures::ImgProcROIFeature::ImgProcROIFeature(
-    const NFIQ2::FingerprintImageData &fingerprintImage)
+    const NFIQ2::FingerprintImageData &fingerprintImage,
+    const NFIQ2::CancellationToken &cancellation)
 {
-	this->setFeatures(computeFeatureData(fingerprintImage));
+	this->setFeatures(computeFeatureData(fingerprintImage, cancellation));
 }
 
 NFIQ2::QualityFeatures::ImgProcROIFeature::~ImgProcROIFeature() = default;
@@ -33,7 +35,8 @@ NFIQ2::QualityFeatures::ImgProcROIFeature::getImgProcResults()
 
 std::unordered_map<std::string, double>
 NFIQ2::QualityFeatures::ImgProcROIFeature::computeFeatureData(
-    const NFIQ2::FingerprintImageData &fingerprintImage)
+    const NFIQ2::FingerprintImageData &fingerprintImage,
+    const NFIQ2::CancellationToken &cancellation)
 {
 	std::unordered_map<std::string, double> featureDataList;
 
@@ -60,13 +63,15 @@ NFIQ2::QualityFeatures::ImgProcROIFeature::computeFeatureData(
 
 	NFIQ2::Timer timer;
 	timer.start();
+	NFIQ2_TRACE_SPAN(
+	    span, NFIQ2::Identifiers::QualityModules::RegionOfInterestMean);
 
 	// ---------------------------------------------
 	// compute ROI (and other features based on ROI)
 	// ---------------------------------------------
 	try {
-		this->imgProcResults_ = computeROI(
-		    img, 16); // block size = 16x16 pixels
+		this->imgProcResults_ = computeROI(img, 16,
+		    cancellation); // block size = 16x16 pixels
 
 		std::pair<std::string, double> fd_roi_pixel_area_mean;
 		fd_roi_pixel_area_mean = std::make_pair(
@@ -75,6 +80,7 @@ NFIQ2::QualityFeatures::ImgProcROIFeature::computeFeatureData(
 		featureDataList[fd_roi_pixel_area_mean.first] =
 		    fd_roi_pixel_area_mean.second;
 
+		NFIQ2_TRACE_END(span);
 		this->setSpeed(timer.stop());
 	} catch (const cv::Exception &e) {
 		std::stringstream ssErr;
@@ -108,33 +114,50 @@ NFIQ2::QualityFeatures::ImgProcROIFeature::getQualityFeatureIDs()
 }
 
 NFIQ2::QualityFeatures::ImgProcROIFeature::ImgProcROIResults
-NFIQ2::QualityFeatures::ImgProcROIFeature::computeROI(
-    cv::Mat &img, unsigned int bs)
+NFIQ2::QualityFeatures::ImgProcROIFeature::computeROI(cv::Mat &img,
+    unsigned int bs, const NFIQ2::CancellationToken &cancellation)
 {
 	ImgProcROIResults roiResults;
 
 	// 1. erode image to get fingerprint details more clearly
 	cv::Mat erodedImg;
 	cv::Mat element(5, 5, CV_8U, cv::Scalar(1));
+	NFIQ2_TRACE_SPAN(erodeSpan, "erode");
 	cv::erode(img, erodedImg, element);
+	NFIQ2_TRACE_END(erodeSpan);
+
+	cancellation.throwIfCancelled();
 
 	// 2. Gaussian blur to get important area
 	cv::Mat blurImg;
+	NFIQ2_TRACE_SPAN(blurSpan, "blur");
 	cv::GaussianBlur(erodedImg, blurImg, cv::Size(41, 41), 0.0);
+	NFIQ2_TRACE_END(blurSpan);
 
 	// 3. Binarize image with Otsu method
 	cv::Mat threshImg;
+	NFIQ2_TRACE_SPAN(otsuSpan, "otsu");
 	cv::threshold(blurImg, threshImg, 0, 255, cv::THRESH_OTSU);
+	NFIQ2_TRACE_END(otsuSpan);
+
+	cancellation.throwIfCancelled();
 
 	// 4. Blur image again
 	cv::Mat blurImg2;
+	NFIQ2_TRACE_SPAN(blurSpan2, "blur");
 	cv::GaussianBlur(threshImg, blurImg2, cv::Size(91, 91), 0.0);
+	NFIQ2_TRACE_END(blurSpan2);
 
 	// 5. Binarize image again with Otsu method
 	cv::Mat threshImg2;
+	NFIQ2_TRACE_SPAN(otsuSpan2, "otsu");
 	cv::threshold(blurImg2, threshImg2, 0, 255, cv::THRESH_OTSU);
+	NFIQ2_TRACE_END(otsuSpan2);
+
+	cancellation.throwIfCancelled();
 
 	// 6. try find white holes in black image
+	NFIQ2_TRACE_SPAN(contourSpan, "contours");
 	cv::Mat contImg = threshImg2.clone();
 	std::vector<std::vector<cv::Point>> contours;
 	std::vector<cv::Vec4i> hierarchy;
@@ -150,20 +173,25 @@ NFIQ2::QualityFeatures::ImgProcROIFeature::computeROI(
 
 		for (unsigned int idx = 0; idx < (hierarchy.size() - 2);
 		     idx++) {
+			cancellation.throwIfCancelled();
 			cv::drawContours(filledImg, contours, idx,
 			    cv::Scalar(0, 0, 0, 0), cv::FILLED, 8, hierarchy);
 		}
 
 		cv::cvtColor(filledImg, threshImg2, cv::COLOR_BGR2GRAY);
 	}
+	NFIQ2_TRACE_END(contourSpan);
 
 	// 7. remove smaller blobs at the edges that are not part of the
 	// fingerprint
+	NFIQ2_TRACE_SPAN(floodFillSpan, "floodfill");
 	cv::Mat ffImg = threshImg2.clone();
 	cv::Point point;
 	std::vector<cv::Rect> vecRects;
 	std::vector<cv::Point> vecPoints;
 	while (isBlackPixelAvailable(ffImg, point)) {
+		cancellation.throwIfCancelled();
+
 		// execute flood fill algorithm starting with discovered seed
 		// and save flooded area on copied image
 		cv::Rect rect;
@@ -188,6 +216,8 @@ NFIQ2::QualityFeatures::ImgProcROIFeature::computeROI(
 	// one
 	for (unsigned int i = 0; i < vecRects.size(); i++) {
 		if (i != maxIdx) {
+			cancellation.throwIfCancelled();
+
 			// apply floodfill on original image
 			// start seed first detected point
 			cv::floodFill(threshImg2,
@@ -195,6 +225,7 @@ NFIQ2::QualityFeatures::ImgProcROIFeature::computeROI(
 			    cv::Scalar(255, 255, 255, 0));
 		}
 	}
+	NFIQ2_TRACE_END(floodFillSpan);
 
 	// count ROI pixels ( = black pixels)
 	// and get mean value of ROI pixels
@@ -238,6 +269,7 @@ NFIQ2::QualityFeatures::ImgProcROIFeature::computeROI(
 	}
 
 	// 8. compute and draw blocks
+	NFIQ2_TRACE_SPAN(blockSpan, "blocks");
 	unsigned int width = img.cols;
 	unsigned int height = img.rows;
 	cv::Mat bsImg(height, width, CV_8UC1, cv::Scalar(255, 0, 0, 0));
@@ -274,6 +306,8 @@ NFIQ2::QualityFeatures::ImgProcROIFeature::computeROI(
 		}
 	}
 
+	NFIQ2_TRACE_END(blockSpan);
+
 	roiResults.chosenBlockSize = bs;
 	roiResults.noOfAllBlocks = noOfAllBlocks;
 	roiResults.noOfCompleteBlocks = noOfCompleteBlocks;
@@ -2,6 +2,7 @@
 #include <features/LCSFeature.h>
 #include <nfiq2_exception.hpp>
 #include <nfiq2_timer.hpp>
+#include <nfiq2_trace.hpp>
 #include <opencv2/core.hpp>
 
 #include <sstream>
@@ -61,9 +62,10 @@ double loclar(cv::Mat &block, const double orientation, const int v1sz_x,
     const int v1sz_y, const int scres, const bool padFlag);
 
 NFIQ2::QualityFeatures::LCSFeature::LCSFeature(
-    const NFIQ2::FingerprintImageData &fingerprintImage)
+    const NFIQ2::FingerprintImageData &fingerprintImage,
+    const NFIQ2::CancellationToken &cancellation)
 {
-	this->setFeatures(computeFeatureData(fingerprintImage));
+	this->setFeatures(computeFeatureData(fingerprintImage, cancellation));
 }
 
 NFIQ2::QualityFeatures::LCSFeature::~LCSFeature() = default;
@@ -93,7 +95,8 @@ NFIQ2::QualityFeatures::LCSFeature::getQualityFeatureIDs()
 
 std::unordered_map<std::string, double>
 NFIQ2::QualityFeatures::LCSFeature::computeFeatureData(
-    const NFIQ2::FingerprintImageData &fingerprintImage)
+    const NFIQ2::FingerprintImageData &fingerprintImage,
+    const NFIQ2::CancellationToken &cancellation)
 {
 	std::unordered_map<std::string, double> featureDataList;
 
@@ -121,6 +124,8 @@ NFIQ2::QualityFeatures::LCSFeature::computeFeatureData(
 	NFIQ2::Timer timerLCS;
 	try {
 		timerLCS.start();
+		NFIQ2_TRACE_SPAN(
+		    span, NFIQ2::Identifiers::QualityModules::LocalClarity);
 
 		int rows = img.rows;
 		int cols = img.cols;
@@ -168,6 +173,7 @@ NFIQ2::QualityFeatures::LCSFeature::computeFeatureData(
 
 		for (int r = blkoffset; r < rows - (blocksize + blkoffset - 1);
 		     r += blocksize) {
+			cancellation.throwIfCancelled();
 			for (int c = blkoffset;
 			     c < cols - (blocksize + blkoffset - 1);
 			     c += blocksize) {
@@ -225,6 +231,7 @@ NFIQ2::QualityFeatures::LCSFeature::computeFeatureData(
 		addHistogramFeatures(featureDataList, NFIQ2LCSFeaturePrefix,
 		    histogramBins10, dataVector, 10);
 
+		NFIQ2_TRACE_END(span);
 		this->setSpeed(timerLCS.stop());
 	} catch (const cv::Exception &e) {
 		std::stringstream ssErr;
@@ -1,6 +1,7 @@
 #include <features/MuFeature.h>
 #include <nfiq2_exception.hpp>
 #include <nfiq2_timer.hpp>
+#include <nfiq2_trace.hpp>
 #include <opencv2/core.hpp>
 
 #include <sstream>
@@ -10,16 +11,18 @@ const char NFIQ2::Identifiers::QualityFeatures::Contrast::Mean[] { "Mu" };
 const char NFIQ2::Identifiers::QualityFeatures::Contrast::MeanBlock[] { "MMB" };
 
 NFIQ2::QualityFeatures::MuFeature::MuFeature(
-    const NFIQ2::FingerprintImageData &fingerprintImage)
+    const NFIQ2::FingerprintImageData &fingerprintImage,
+    const NFIQ2::CancellationToken &cancellation)
 {
-	this->setFeatures(computeFeatureData(fingerprintImage));
+	this->setFeatures(computeFeatureData(fingerprintImage, cancellation));
 }
 
 NFIQ2::QualityFeatures::MuFeature::~MuFeature() = default;
 
 std::unordered_map<std::string, double>
 NFIQ2::QualityFeatures::MuFeature::computeFeatureData(
-    const NFIQ2::FingerprintImageData &fingerprintImage)
+    const NFIQ2::FingerprintImageData &fingerprintImage,
+    const NFIQ2::CancellationToken &cancellation)
 {
 	std::unordered_map<std::string, double> featureDataList;
 
@@ -46,6 +49,8 @@ NFIQ2::QualityFeatures::MuFeature::computeFeatureData(
 
 	NFIQ2::Timer timer;
 	timer.start();
+	NFIQ2_TRACE_SPAN(
+	    span, NFIQ2::Identifiers::QualityModules::Contrast);
 
 	// -------------------------
 	// compute Mu Mu Block (MMB)
@@ -59,6 +64,7 @@ NFIQ2::QualityFeatures::MuFeature::computeFeatureData(
 
 		// calculate blockwise mean values
 		for (unsigned int i = 0; i < height; i += blockSize) {
+			cancellation.throwIfCancelled();
 			for (unsigned int j = 0; j < width; j += blockSize) {
 				unsigned int takenBS_X = blockSize;
 				unsigned int takenBS_Y = blockSize;
@@ -138,6 +144,7 @@ NFIQ2::QualityFeatures::MuFeature::computeFeatureData(
 		    "Unknown exception occurred!");
 	}
 
+	NFIQ2_TRACE_END(span);
 	this->setSpeed(timer.stop());
 
 	return featureDataList;
@@ -2,6 +2,7 @@
 #include <features/OCLHistogramFeature.h>
 #include <nfiq2_exception.hpp>
 #include <nfiq2_timer.hpp>
+#include <nfiq2_trace.hpp>
 
 #include <sstream>
 
@@ -37,16 +38,18 @@ const char NFIQ2::Identifiers::QualityFeatures::OrientationCertainty::StdDev[] {
 };
 
 NFIQ2::QualityFeatures::OCLHistogramFeature::OCLHistogramFeature(
-    const NFIQ2::FingerprintImageData &fingerprintImage)
+    const NFIQ2::FingerprintImageData &fingerprintImage,
+    const NFIQ2::CancellationToken &cancellation)
 {
-	this->setFeatures(computeFeatureData(fingerprintImage));
+	this->setFeatures(computeFeatureData(fingerprintImage, cancellation));
 }
 
 NFIQ2::QualityFeatures::OCLHistogramFeature::~OCLHistogramFeature() = default;
 
 std::unordered_map<std::string, double>
 NFIQ2::QualityFeatures::OCLHistogramFeature::computeFeatureData(
-    const NFIQ2::FingerprintImageData &fingerprintImage)
+    const NFIQ2::FingerprintImageData &fingerprintImage,
+    const NFIQ2::CancellationToken &cancellation)
 {
 	std::unordered_map<std::string, double> featureDataList;
 
@@ -77,9 +80,12 @@ NFIQ2::QualityFeatures::OCLHistogramFeature::computeFeatureData(
 	std::vector<double> oclres;
 	try {
 		timerOCL.start();
+		NFIQ2_TRACE_SPAN(
+		    span, NFIQ2::Identifiers::QualityModules::OrientationCertainty);
 
 		// divide into blocks
 		for (int i = 0; i < img.rows; i += BS_OCL) {
+			cancellation.throwIfCancelled();
 			for (int j = 0; j < img.cols; j += BS_OCL) {
 				unsigned int actualBS_X = ((img.cols - j) <
 							      BS_OCL) ?
@@ -124,6 +130,7 @@ NFIQ2::QualityFeatures::OCLHistogramFeature::computeFeatureData(
 		addHistogramFeatures(featureDataList, NFIQ2OCLFeaturePrefix,
 		    histogramBins10, oclres, 10);
 
+		NFIQ2_TRACE_END(span);
 		this->setSpeed(timerOCL.stop());
 	} catch (const cv::Exception &e) {
 		std::stringstream ssErr;
@@ -3,6 +3,7 @@
 #include <math.h>
 #include <nfiq2_exception.hpp>
 #include <nfiq2_timer.hpp>
+#include <nfiq2_trace.hpp>
 #include <opencv2/core.hpp>
 
 #include <cmath>
@@ -60,9 +61,10 @@ const char NFIQ2::Identifiers::QualityFeatures::OrientationFlow::StdDev[] {
 };
 
 NFIQ2::QualityFeatures::OFFeature::OFFeature(
-    const NFIQ2::FingerprintImageData &fingerprintImage)
+    const NFIQ2::FingerprintImageData &fingerprintImage,
+    const NFIQ2::CancellationToken &cancellation)
 {
-	this->setFeatures(computeFeatureData(fingerprintImage));
+	this->setFeatures(computeFeatureData(fingerprintImage, cancellation));
 }
 
 NFIQ2::QualityFeatures::OFFeature::~OFFeature() = default;
@@ -92,7 +94,8 @@ NFIQ2::QualityFeatures::OFFeature::getQualityFeatureIDs()
 
 std::unordered_map<std::string, double>
 NFIQ2::QualityFeatures::OFFeature::computeFeatureData(
-    const NFIQ2::FingerprintImageData &fingerprintImage)
+    const NFIQ2::FingerprintImageData &fingerprintImage,
+    const NFIQ2::CancellationToken &cancellation)
 {
 	std::unordered_map<std::string, double> featureDataList;
 
@@ -120,6 +123,8 @@ NFIQ2::QualityFeatures::OFFeature::computeFeatureData(
 	NFIQ2::Timer timerOF;
 	try {
 		timerOF.start();
+		NFIQ2_TRACE_SPAN(
+		    span, NFIQ2::Identifiers::QualityModules::OrientationFlow);
 
 		int rows = img.rows;
 		int cols = img.cols;
@@ -163,6 +168,7 @@ NFIQ2::QualityFeatures::OFFeature::computeFeatureData(
 
 		for (int r = blkoffset; r < rows - (blocksize + blkoffset - 1);
 		     r += blocksize) {
+			cancellation.throwIfCancelled();
 			for (int c = blkoffset;
 			     c < cols - (blocksize + blkoffset - 1);
 			     c += blocksize) {
@@ -299,6 +305,7 @@ NFIQ2::QualityFeatures::OFFeature::computeFeatureData(
 		addHistogramFeatures(featureDataList, NFIQ2OFFeaturePrefix,
 		    histogramBins10, dataVector, 10);
 
+		NFIQ2_TRACE_END(span);
 		this->setSpeed(timerOF.stop());
 	} catch (const cv::Exception &e) {
 		std::stringstream ssErr;
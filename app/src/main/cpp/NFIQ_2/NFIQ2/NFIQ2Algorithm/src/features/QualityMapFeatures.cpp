@@ -2,6 +2,7 @@
 #include <features/QualityMapFeatures.h>
 #include <nfiq2_exception.hpp>
 #include <nfiq2_timer.hpp>
+#include <nfiq2_trace.hpp>
 
 #include <cmath>
 #include <sstream>
@@ -20,17 +21,19 @@ const char
 
 NFIQ2::QualityFeatures::QualityMapFeatures::QualityMapFeatures(
     const NFIQ2::FingerprintImageData &fingerprintImage,
-    const ImgProcROIFeature::ImgProcROIResults &imgProcResults)
+    const ImgProcROIFeature::ImgProcROIResults &imgProcResults,
+    const NFIQ2::CancellationToken &cancellation)
     : imgProcResults_ { imgProcResults }
 {
-	this->setFeatures(computeFeatureData(fingerprintImage));
+	this->setFeatures(computeFeatureData(fingerprintImage, cancellation));
 }
 
 NFIQ2::QualityFeatures::QualityMapFeatures::~QualityMapFeatures() = default;
 
 std::unordered_map<std::string, double>
 NFIQ2::QualityFeatures::QualityMapFeatures::computeFeatureData(
-    const NFIQ2::FingerprintImageData &fingerprintImage)
+    const NFIQ2::FingerprintImageData &fingerprintImage,
+    const NFIQ2::CancellationToken &cancellation)
 {
 	std::unordered_map<std::string, double> featureDataList;
 
@@ -44,6 +47,8 @@ NFIQ2::QualityFeatures::QualityMapFeatures::computeFeatureData(
 
 	NFIQ2::Timer timer;
 	timer.start();
+	NFIQ2_TRACE_SPAN(
+	    span, NFIQ2::Identifiers::QualityModules::RegionOfInterestCoherence);
 
 	cv::Mat img;
 	try {
@@ -69,7 +74,7 @@ NFIQ2::QualityFeatures::QualityMapFeatures::computeFeatureData(
 		double coherenceRelFilter = 0.0;
 		cv::Mat orientationMapImgFilter = computeOrientationMap(img,
 		    true, coherenceSumFilter, coherenceRelFilter, 16,
-		    this->imgProcResults_);
+		    this->imgProcResults_, cancellation);
 
 		// return features based on coherence values of orientation map
 		std::pair<std::string, double> fd_om_2;
@@ -86,6 +91,7 @@ NFIQ2::QualityFeatures::QualityMapFeatures::computeFeatureData(
 
 		featureDataList[fd_om_1.first] = fd_om_1.second;
 
+		NFIQ2_TRACE_END(span);
 		this->setSpeed(timer.stop());
 	} catch (const cv::Exception &e) {
 		std::stringstream ssErr;
@@ -102,7 +108,8 @@ NFIQ2::QualityFeatures::QualityMapFeatures::computeFeatureData(
 cv::Mat
 NFIQ2::QualityFeatures::QualityMapFeatures::computeOrientationMap(cv::Mat &img,
     bool bFilterByROI, double &coherenceSum, double &coherenceRel,
-    unsigned int bs, ImgProcROIFeature::ImgProcROIResults roiResults)
+    unsigned int bs, ImgProcROIFeature::ImgProcROIResults roiResults,
+    const NFIQ2::CancellationToken &cancellation)
 {
 	coherenceSum = 0.0;
 	coherenceRel = 0.0;
@@ -116,6 +123,8 @@ NFIQ2::QualityFeatures::QualityMapFeatures::computeOrientationMap(cv::Mat &img,
 	// divide into blocks
 	for (int i = 0; i < img.rows; i += bs) {
 		for (int j = 0; j < img.cols; j += bs) {
+			cancellation.throwIfCancelled();
+
 			int actualBS_X = ((img.cols - j) < (int)bs) ?
 				  (img.cols - j) :
 				  bs;
@@ -2,6 +2,7 @@
 #include <features/RVUPHistogramFeature.h>
 #include <nfiq2_exception.hpp>
 #include <nfiq2_timer.hpp>
+#include <nfiq2_trace.hpp>
 #include <opencv2/core.hpp>
 
 #include <cmath>
@@ -44,16 +45,18 @@ void rvuhist(cv::Mat block, const double orientation, const int v1sz_x,
     std::vector<uint8_t> &Nans);
 
 NFIQ2::QualityFeatures::RVUPHistogramFeature::RVUPHistogramFeature(
-    const NFIQ2::FingerprintImageData &fingerprintImage)
+    const NFIQ2::FingerprintImageData &fingerprintImage,
+    const NFIQ2::CancellationToken &cancellation)
 {
-	this->setFeatures(computeFeatureData(fingerprintImage));
+	this->setFeatures(computeFeatureData(fingerprintImage, cancellation));
 }
 
 NFIQ2::QualityFeatures::RVUPHistogramFeature::~RVUPHistogramFeature() = default;
 
 std::unordered_map<std::string, double>
 NFIQ2::QualityFeatures::RVUPHistogramFeature::computeFeatureData(
-    const NFIQ2::FingerprintImageData &fingerprintImage)
+    const NFIQ2::FingerprintImageData &fingerprintImage,
+    const NFIQ2::CancellationToken &cancellation)
 {
 	std::unordered_map<std::string, double> featureDataList;
 
@@ -85,6 +88,8 @@ NFIQ2::QualityFeatures::RVUPHistogramFeature::computeFeatureData(
 	NFIQ2::Timer timerRVU;
 	try {
 		timerRVU.start();
+		NFIQ2_TRACE_SPAN(
+		    span, NFIQ2::Identifiers::QualityModules::RidgeValleyUniformity);
 
 		cv::Mat maskim;
 		const int blksize = this->blocksize;
@@ -128,6 +133,7 @@ NFIQ2::QualityFeatures::RVUPHistogramFeature::computeFeatureData(
 		std::vector<uint8_t> NanVec;
 		for (int r = blkoffset; r < rows - (blksize + blkoffset - 1);
 		     r += blksize) {
+			cancellation.throwIfCancelled();
 			for (int c = blkoffset;
 			     c < cols - (blksize + blkoffset - 1);
 			     c += blksize) {
@@ -182,6 +188,7 @@ NFIQ2::QualityFeatures::RVUPHistogramFeature::computeFeatureData(
 		addHistogramFeatures(featureDataList, NFIQ2RVUPFeaturePrefix,
 		    histogramBins10, rvures, 10);
 
+		NFIQ2_TRACE_END(span);
 		this->setSpeed(timerRVU.stop());
 	} catch (const cv::Exception &e) {
 		std::stringstream ssErr;
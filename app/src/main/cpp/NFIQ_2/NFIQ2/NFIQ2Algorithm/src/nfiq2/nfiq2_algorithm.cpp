@@ -37,7 +37,15 @@ unsigned int
 NFIQ2::Algorithm::computeQualityScore(
     const NFIQ2::FingerprintImageData &rawImage) const
 {
-	return (this->pimpl->computeQualityScore(rawImage));
+	return (this->pimpl->computeQualityScore(rawImage, {}));
+}
+
+unsigned int
+NFIQ2::Algorithm::computeQualityScore(
+    const NFIQ2::FingerprintImageData &rawImage,
+    const NFIQ2::CancellationToken &cancellation) const
+{
+	return (this->pimpl->computeQualityScore(rawImage, cancellation));
 }
 
 unsigned int
@@ -55,6 +63,47 @@ NFIQ2::Algorithm::computeQualityScore(
 	return (this->pimpl->computeQualityScore(features));
 }
 
+std::vector<unsigned int>
+NFIQ2::Algorithm::computeQualityScores(
+    const std::vector<std::reference_wrapper<const Algorithm>> &algorithms,
+    const std::vector<std::shared_ptr<NFIQ2::QualityFeatures::Module>>
+	&modules)
+{
+	std::vector<const Impl *> impls {};
+	for (const auto &algorithm : algorithms) {
+		impls.push_back(algorithm.get().pimpl.get());
+	}
+	return (NFIQ2::Algorithm::Impl::computeQualityScores(impls, modules));
+}
+
+std::vector<unsigned int>
+NFIQ2::Algorithm::computeQualityScores(
+    const std::vector<std::reference_wrapper<const Algorithm>> &algorithms,
+    const std::unordered_map<std::string, double> &features)
+{
+	std::vector<const Impl *> impls {};
+	for (const auto &algorithm : algorithms) {
+		impls.push_back(algorithm.get().pimpl.get());
+	}
+	return (NFIQ2::Algorithm::Impl::computeQualityScores(impls, features));
+}
+
+bool
+NFIQ2::Algorithm::meetsQualityThreshold(
+    const std::unordered_map<std::string, double> &features,
+    const unsigned int threshold) const
+{
+	return (this->pimpl->meetsQualityThreshold(features, threshold));
+}
+
+std::vector<bool>
+NFIQ2::Algorithm::meetsQualityThreshold(
+    const std::vector<std::unordered_map<std::string, double>> &features,
+    const unsigned int threshold) const
+{
+	return (this->pimpl->meetsQualityThreshold(features, threshold));
+}
+
 std::string
 NFIQ2::Algorithm::getParameterHash() const
 {
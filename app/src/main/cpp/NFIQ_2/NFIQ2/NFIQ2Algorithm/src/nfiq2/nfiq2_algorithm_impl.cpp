@@ -12,6 +12,7 @@
 #include <nfiq2_fingerprintimagedata.hpp>
 #include <nfiq2_qualityfeatures.hpp>
 #include <nfiq2_timer.hpp>
+#include <nfiq2_trace.hpp>
 
 #include "nfiq2_algorithm_impl.hpp"
 #include <iomanip>
@@ -62,8 +63,10 @@ NFIQ2::Algorithm::Impl::getQualityPrediction(
 {
 	this->throwIfUninitialized();
 
+	NFIQ2_TRACE_SPAN(span, "prediction");
 	double quality {};
 	m_RandomForestML.evaluate(features, quality);
+	NFIQ2_TRACE_END(span);
 
 	return quality;
 }
@@ -101,7 +104,8 @@ NFIQ2::Algorithm::Impl::computeQualityScore(
 
 unsigned int
 NFIQ2::Algorithm::Impl::computeQualityScore(
-    const NFIQ2::FingerprintImageData &rawImage) const
+    const NFIQ2::FingerprintImageData &rawImage,
+    const NFIQ2::CancellationToken &cancellation) const
 {
 	this->throwIfUninitialized();
 
@@ -112,7 +116,7 @@ NFIQ2::Algorithm::Impl::computeQualityScore(
 	std::vector<std::shared_ptr<NFIQ2::QualityFeatures::Module>> modules {};
 	try {
 		modules = NFIQ2::QualityFeatures::computeQualityModules(
-		    rawImage);
+		    rawImage, cancellation);
 	} catch (const NFIQ2::Exception &) {
 		throw;
 	} catch (const std::exception &e) {
@@ -157,6 +161,87 @@ NFIQ2::Algorithm::Impl::computeQualityScore(
 	return (unsigned int)getQualityPrediction(features);
 }
 
+std::vector<unsigned int>
+NFIQ2::Algorithm::Impl::computeQualityScores(
+    const std::vector<const Impl *> &impls,
+    const std::vector<std::shared_ptr<NFIQ2::QualityFeatures::Module>>
+	&features)
+{
+	const std::unordered_map<std::string, double> quality =
+	    NFIQ2::QualityFeatures::getQualityFeatureValues(features);
+
+	if (quality.size() == 0) {
+		// no features have been computed
+		throw NFIQ2::Exception(
+		    NFIQ2::ErrorCode::FeatureCalculationError,
+		    "No features have been computed");
+	}
+
+	return (computeQualityScores(impls, quality));
+}
+
+std::vector<unsigned int>
+NFIQ2::Algorithm::Impl::computeQualityScores(
+    const std::vector<const Impl *> &impls,
+    const std::unordered_map<std::string, double> &features)
+{
+	for (const auto &impl : impls) {
+		impl->throwIfUninitialized();
+	}
+
+	NFIQ2_TRACE_SPAN(span, "prediction");
+	// Features are ordered once for every model
+	const cv::Mat sample =
+	    NFIQ2::Prediction::RandomForestML::getFeatureVector(features);
+
+	std::vector<unsigned int> scores {};
+	scores.reserve(impls.size());
+	for (const auto &impl : impls) {
+		double quality {};
+		impl->m_RandomForestML.evaluate(sample, quality);
+		scores.push_back((unsigned int)quality);
+	}
+	NFIQ2_TRACE_END(span);
+
+	return (scores);
+}
+
+bool
+NFIQ2::Algorithm::Impl::meetsQualityThreshold(
+    const std::unordered_map<std::string, double> &features,
+    const unsigned int threshold) const
+{
+	this->throwIfUninitialized();
+
+	NFIQ2_TRACE_SPAN(span, "prediction");
+	const bool meets = this->m_RandomForestML.meetsThreshold(
+	    NFIQ2::Prediction::RandomForestML::getFeatureVector(features),
+	    threshold);
+	NFIQ2_TRACE_END(span);
+
+	return (meets);
+}
+
+std::vector<bool>
+NFIQ2::Algorithm::Impl::meetsQualityThreshold(
+    const std::vector<std::unordered_map<std::string, double>> &features,
+    const unsigned int threshold) const
+{
+	this->throwIfUninitialized();
+
+	NFIQ2_TRACE_SPAN(span, "prediction");
+	std::vector<bool> meets {};
+	meets.reserve(features.size());
+	for (const auto &f : features) {
+		meets.push_back(this->m_RandomForestML.meetsThreshold(
+		    NFIQ2::Prediction::RandomForestML::getFeatureVector(f),
+		    threshold));
+	}
+	NFIQ2_TRACE_END(span);
+
+	return (meets);
+}
+
 std::string
 NFIQ2::Algorithm::Impl::getParameterHash() const
 {
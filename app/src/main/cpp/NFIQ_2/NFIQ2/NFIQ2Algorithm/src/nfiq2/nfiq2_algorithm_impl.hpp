@@ -50,15 +50,19 @@ class Algorithm::Impl {
 	 *
 	 * @param rawImage
 	 * Fingerprint image in raw format.
+	 * @param cancellation
+	 * Checked between blocks of work within each quality module.
 	 *
 	 * @return
 	 * Computed quality score.
 	 *
 	 * @throw Exception
-	 * Called before random forest parameters were loaded.
+	 * Called before random forest parameters were loaded, or
+	 * `cancellation` expired.
 	 */
 	unsigned int computeQualityScore(
-	    const NFIQ2::FingerprintImageData &rawImage) const;
+	    const NFIQ2::FingerprintImageData &rawImage,
+	    const NFIQ2::CancellationToken &cancellation) const;
 
 	/**
 	 * @brief
@@ -96,6 +100,93 @@ class Algorithm::Impl {
 	unsigned int computeQualityScore(
 	    const std::unordered_map<std::string, double> &features) const;
 
+	/**
+	 * @brief
+	 * Computes quality scores with several sets of random forest
+	 * parameters from a vector of extracted `features`.
+	 *
+	 * @param impls
+	 * Implementations of the models with which to compute scores.
+	 * @param features
+	 * Vector of computed feature metrics that contain quality
+	 * information for a fingerprint image.
+	 *
+	 * @return
+	 * Computed quality score from each of `impls`, in order.
+	 *
+	 * @throw Exception
+	 * Called before random forest parameters were loaded into any of
+	 * `impls`.
+	 */
+	static std::vector<unsigned int> computeQualityScores(
+	    const std::vector<const Impl *> &impls,
+	    const std::vector<std::shared_ptr<NFIQ2::QualityFeatures::Module>>
+		&features);
+
+	/**
+	 * @brief
+	 * Computes quality scores with several sets of random forest
+	 * parameters from a map of extracted image quality feature data.
+	 *
+	 * @param impls
+	 * Implementations of the models with which to compute scores.
+	 * @param features
+	 * Map of string, quality feature data pairs.
+	 *
+	 * @return
+	 * Computed quality score from each of `impls`, in order.
+	 *
+	 * @throw Exception
+	 * Called before random forest parameters were loaded into any of
+	 * `impls`.
+	 */
+	static std::vector<unsigned int> computeQualityScores(
+	    const std::vector<const Impl *> &impls,
+	    const std::unordered_map<std::string, double> &features);
+
+	/**
+	 * @brief
+	 * Determines whether the quality score from a map of extracted image
+	 * quality feature data is at least `threshold`, evaluating only as
+	 * many trees as needed.
+	 *
+	 * @param features
+	 * Map of string, quality feature data pairs.
+	 * @param threshold
+	 * Least acceptable quality score.
+	 *
+	 * @return
+	 * true if the quality score is at least `threshold`.
+	 *
+	 * @throw Exception
+	 * Called before random forest parameters were loaded.
+	 */
+	bool meetsQualityThreshold(
+	    const std::unordered_map<std::string, double> &features,
+	    const unsigned int threshold) const;
+
+	/**
+	 * @brief
+	 * Determines whether the quality score from each of several maps of
+	 * extracted image quality feature data is at least `threshold`.
+	 *
+	 * @param features
+	 * Maps of string, quality feature data pairs.
+	 * @param threshold
+	 * Least acceptable quality score.
+	 *
+	 * @return
+	 * Whether the quality score from each of `features` is at least
+	 * `threshold`, in order.
+	 *
+	 * @throw Exception
+	 * Called before random forest parameters were loaded.
+	 */
+	std::vector<bool> meetsQualityThreshold(
+	    const std::vector<std::unordered_map<std::string, double>>
+		&features,
+	    const unsigned int threshold) const;
+
 	/**
 	 * @brief
 	 * Obtain MD5 checksum of Random Forest parameter file loaded.
@@ -0,0 +1,53 @@
+#include <nfiq2_cancellation.hpp>
+#include <nfiq2_exception.hpp>
+
+#include <atomic>
+
+struct NFIQ2::CancellationToken::State {
+	std::atomic<bool> cancelled { false };
+	bool hasDeadline { false };
+	std::chrono::steady_clock::time_point deadline {};
+};
+
+NFIQ2::CancellationToken::CancellationToken()
+    : state { std::make_shared<State>() }
+{
+}
+
+NFIQ2::CancellationToken::CancellationToken(
+    const std::chrono::steady_clock::duration timeout)
+    : state { std::make_shared<State>() }
+{
+	this->state->hasDeadline = true;
+	this->state->deadline = std::chrono::steady_clock::now() + timeout;
+}
+
+void
+NFIQ2::CancellationToken::cancel()
+{
+	this->state->cancelled.store(true, std::memory_order_relaxed);
+}
+
+bool
+NFIQ2::CancellationToken::isCancelled() const
+{
+	return this->state->cancelled.load(std::memory_order_relaxed);
+}
+
+bool
+NFIQ2::CancellationToken::isExpired() const
+{
+	return this->state->hasDeadline &&
+	    std::chrono::steady_clock::now() >= this->state->deadline;
+}
+
+void
+NFIQ2::CancellationToken::throwIfCancelled() const
+{
+	if (this->isCancelled()) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::Cancelled);
+	}
+	if (this->isExpired()) {
+		throw NFIQ2::Exception(NFIQ2::ErrorCode::Timeout);
+	}
+}
@@ -63,7 +63,10 @@ NFIQ2::Exception::defaultErrorMessage(const NFIQ2::ErrorCode errorCode)
 		{ NFIQ2::ErrorCode::FJFX_NoFeatureSetCreated,
 		    "No feature set could be created" },
 		{ NFIQ2::ErrorCode::InvalidNFIQ2Score, "Invalid NFIQ2 Score" },
-		{ NFIQ2::ErrorCode::InvalidImageSize, "Invalid Image Size" }
+		{ NFIQ2::ErrorCode::InvalidImageSize, "Invalid Image Size" },
+		{ NFIQ2::ErrorCode::Timeout,
+		    "Quality computation exceeded its deadline" },
+		{ NFIQ2::ErrorCode::Cancelled, "Quality computation was cancelled" }
 	};
 
 	const auto message = errorCodeMessage.find(errorCode);
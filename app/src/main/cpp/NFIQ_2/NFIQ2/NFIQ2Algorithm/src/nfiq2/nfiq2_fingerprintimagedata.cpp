@@ -53,6 +53,15 @@ NFIQ2::FingerprintImageData::~FingerprintImageData() = default;
 
 NFIQ2::FingerprintImageData
 NFIQ2::FingerprintImageData::copyRemovingNearWhiteFrame() const
+{
+	return (NFIQ2::FingerprintImageData::copyRemovingNearWhiteFrame(
+	    this->data(), this->width, this->height, this->fingerCode,
+	    this->ppi));
+}
+
+NFIQ2::FingerprintImageData
+NFIQ2::FingerprintImageData::copyRemovingNearWhiteFrame(const uint8_t *pData,
+    uint32_t width_, uint32_t height_, uint8_t fingerCode_, uint16_t ppi_)
 {
 	/**
 	 * Pixel intensity threshold used for determining whitespace
@@ -64,8 +73,7 @@ NFIQ2::FingerprintImageData::copyRemovingNearWhiteFrame() const
 	cv::Mat img;
 	try {
 		// get matrix from fingerprint image
-		img = cv::Mat(
-		    this->height, this->width, CV_8UC1, (void *)this->data());
+		img = cv::Mat(height_, width_, CV_8UC1, (void *)pData);
 	} catch (const cv::Exception &e) {
 		std::stringstream ssErr;
 		ssErr << "Cannot get matrix from fingerprint image: "
@@ -192,17 +200,14 @@ NFIQ2::FingerprintImageData::copyRemovingNearWhiteFrame() const
 	NFIQ2::FingerprintImageData croppedImage;
 	croppedImage.height = roiImg.rows;
 	croppedImage.width = roiImg.cols;
-	croppedImage.fingerCode = this->fingerCode;
-	croppedImage.ppi = this->ppi;
-	// copy data now
+	croppedImage.fingerCode = fingerCode_;
+	croppedImage.ppi = ppi_;
+	// copy data now, one row at a time
 	const unsigned int size = roiImg.rows * roiImg.cols;
 	croppedImage.resize(size);
-	unsigned int counter = 0;
 	for (int i = 0; i < roiImg.rows; i++) {
-		for (int j = 0; j < roiImg.cols; j++) {
-			croppedImage.at(counter) = roiImg.at<uchar>(i, j);
-			counter++;
-		}
+		std::memcpy(&croppedImage[i * roiImg.cols],
+		    roiImg.ptr<uchar>(i), roiImg.cols);
 	}
 
 	return croppedImage;
@@ -26,7 +26,26 @@ std::vector<std::shared_ptr<NFIQ2::QualityFeatures::Module>>
 NFIQ2::QualityFeatures::computeQualityModules(
     const NFIQ2::FingerprintImageData &rawImage)
 {
-	return NFIQ2::QualityFeatures::Impl::computeQualityModules(rawImage);
+	return NFIQ2::QualityFeatures::Impl::computeQualityModules(
+	    rawImage, {});
+}
+
+std::vector<std::shared_ptr<NFIQ2::QualityFeatures::Module>>
+NFIQ2::QualityFeatures::computeQualityModules(
+    const NFIQ2::FingerprintImageData &rawImage,
+    const NFIQ2::CancellationToken &cancellation)
+{
+	return NFIQ2::QualityFeatures::Impl::computeQualityModules(
+	    rawImage, cancellation);
+}
+
+std::vector<std::shared_ptr<NFIQ2::QualityFeatures::Module>>
+NFIQ2::QualityFeatures::computeQualityModules(const uint8_t *pixels,
+    uint32_t width, uint32_t height, uint8_t fingerCode, uint16_t ppi,
+    const NFIQ2::CancellationToken &cancellation)
+{
+	return NFIQ2::QualityFeatures::Impl::computeQualityModules(
+	    pixels, width, height, fingerCode, ppi, cancellation);
 }
 
 std::unordered_map<std::string, double>
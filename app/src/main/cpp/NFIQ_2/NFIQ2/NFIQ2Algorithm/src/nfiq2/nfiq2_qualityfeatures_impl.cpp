@@ -12,6 +12,7 @@
 #include <nfiq2_exception.hpp>
 #include <nfiq2_fingerprintimagedata.hpp>
 #include <nfiq2_qualityfeatures.hpp>
+#include <nfiq2_trace.hpp>
 
 #include "nfiq2_qualityfeatures_impl.hpp"
 #include <iomanip>
@@ -215,43 +216,64 @@ NFIQ2::QualityFeatures::Impl::setFPU(unsigned int)
 
 std::vector<std::shared_ptr<NFIQ2::QualityFeatures::Module>>
 NFIQ2::QualityFeatures::Impl::computeQualityModules(
-    const NFIQ2::FingerprintImageData &rawImage)
+    const NFIQ2::FingerprintImageData &rawImage,
+    const NFIQ2::CancellationToken &cancellation)
+{
+	return (computeQualityModules(rawImage.data(), rawImage.width,
+	    rawImage.height, rawImage.fingerCode, rawImage.ppi, cancellation));
+}
+
+std::vector<std::shared_ptr<NFIQ2::QualityFeatures::Module>>
+NFIQ2::QualityFeatures::Impl::computeQualityModules(const uint8_t *pixels,
+    uint32_t width, uint32_t height, uint8_t fingerCode, uint16_t ppi,
+    const NFIQ2::CancellationToken &cancellation)
 {
 	/* use double-precision rounding for 32-bit linux */
 	setFPU(0x27F);
 
+	NFIQ2_TRACE_SPAN(span, "modules");
+
+	cancellation.throwIfCancelled();
+
 	const NFIQ2::FingerprintImageData croppedImage =
-	    rawImage.copyRemovingNearWhiteFrame();
+	    NFIQ2::FingerprintImageData::copyRemovingNearWhiteFrame(
+		pixels, width, height, fingerCode, ppi);
 
 	std::vector<std::shared_ptr<NFIQ2::QualityFeatures::Module>>
 	    features {};
 
-	features.push_back(std::make_shared<FDAFeature>(croppedImage));
+	features.push_back(
+	    std::make_shared<FDAFeature>(croppedImage, cancellation));
 
 	std::shared_ptr<FingerJetFXFeature> fjfxFeatureModule =
-	    std::make_shared<FingerJetFXFeature>(croppedImage);
+	    std::make_shared<FingerJetFXFeature>(croppedImage, cancellation);
 	features.push_back(fjfxFeatureModule);
 
 	features.push_back(std::make_shared<FJFXMinutiaeQualityFeature>(
-	    croppedImage, fjfxFeatureModule->getMinutiaData()));
+	    croppedImage, fjfxFeatureModule->getMinutiaData(), cancellation));
 
 	std::shared_ptr<ImgProcROIFeature> roiFeatureModule =
-	    std::make_shared<ImgProcROIFeature>(croppedImage);
+	    std::make_shared<ImgProcROIFeature>(croppedImage, cancellation);
 	features.push_back(roiFeatureModule);
 
-	features.push_back(std::make_shared<LCSFeature>(croppedImage));
+	features.push_back(
+	    std::make_shared<LCSFeature>(croppedImage, cancellation));
 
-	features.push_back(std::make_shared<MuFeature>(croppedImage));
+	features.push_back(
+	    std::make_shared<MuFeature>(croppedImage, cancellation));
 
-	features.push_back(std::make_shared<OCLHistogramFeature>(croppedImage));
+	features.push_back(std::make_shared<OCLHistogramFeature>(
+	    croppedImage, cancellation));
 
-	features.push_back(std::make_shared<OFFeature>(croppedImage));
+	features.push_back(
+	    std::make_shared<OFFeature>(croppedImage, cancellation));
 
 	features.push_back(std::make_shared<QualityMapFeatures>(
-	    croppedImage, roiFeatureModule->getImgProcResults()));
+	    croppedImage, roiFeatureModule->getImgProcResults(),
+	    cancellation));
 
-	features.push_back(
-	    std::make_shared<RVUPHistogramFeature>(croppedImage));
+	features.push_back(std::make_shared<RVUPHistogramFeature>(
+	    croppedImage, cancellation));
 
 	return features;
 }
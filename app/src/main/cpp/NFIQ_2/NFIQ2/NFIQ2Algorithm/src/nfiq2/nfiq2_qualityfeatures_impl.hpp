@@ -64,12 +64,40 @@ void setFPU(unsigned int mode);
  *
  * @param rawImage
  * Fingerprint image in raw format.
+ * @param cancellation
+ * Checked between blocks of work within each module.
  *
  * @return
  * A vector of quality modules containing computed feature data.
  */
 std::vector<std::shared_ptr<NFIQ2::QualityFeatures::Module>>
-computeQualityModules(const NFIQ2::FingerprintImageData &rawImage);
+computeQualityModules(const NFIQ2::FingerprintImageData &rawImage,
+    const NFIQ2::CancellationToken &cancellation);
+
+/**
+ * @brief
+ * Obtain computed quality feature data from pixels owned by the caller.
+ *
+ * @param pixels
+ * Decompressed 8 bit-per-pixel grayscale image data.
+ * @param width
+ * Width of the image in pixels.
+ * @param height
+ * Height of the image in pixels.
+ * @param fingerCode
+ * Finger position of the fingerprint in the image.
+ * @param ppi
+ * Resolution of the image in pixels per inch.
+ * @param cancellation
+ * Checked between blocks of work within each module.
+ *
+ * @return
+ * A vector of quality modules containing computed feature data.
+ */
+std::vector<std::shared_ptr<NFIQ2::QualityFeatures::Module>>
+computeQualityModules(const uint8_t *pixels, uint32_t width, uint32_t height,
+    uint8_t fingerCode, uint16_t ppi,
+    const NFIQ2::CancellationToken &cancellation);
 
 /**
  * @brief
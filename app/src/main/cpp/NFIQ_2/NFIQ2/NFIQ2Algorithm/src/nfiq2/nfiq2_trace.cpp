@@ -0,0 +1,338 @@
+#include <nfiq2_trace.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+/**
+ * An Event in a ring buffer. Fields are relaxed atomics so that readers may
+ * copy a slot while its owner overwrites it; such copies are discarded.
+ */
+struct Slot {
+	std::atomic<const char *> name { nullptr };
+	std::atomic<const char *> parent { nullptr };
+	std::atomic<uint64_t> start { 0 };
+	std::atomic<uint64_t> duration { 0 };
+	std::atomic<uint32_t> thread { 0 };
+	std::atomic<uint32_t> depth { 0 };
+
+	void
+	store(const NFIQ2::Trace::Event &event)
+	{
+		this->name.store(event.name, std::memory_order_relaxed);
+		this->parent.store(event.parent, std::memory_order_relaxed);
+		this->start.store(event.start, std::memory_order_relaxed);
+		this->duration.store(event.duration, std::memory_order_relaxed);
+		this->thread.store(event.thread, std::memory_order_relaxed);
+		this->depth.store(event.depth, std::memory_order_relaxed);
+	}
+
+	NFIQ2::Trace::Event
+	load() const
+	{
+		return { this->name.load(std::memory_order_relaxed),
+			this->parent.load(std::memory_order_relaxed),
+			this->start.load(std::memory_order_relaxed),
+			this->duration.load(std::memory_order_relaxed),
+			this->thread.load(std::memory_order_relaxed),
+			this->depth.load(std::memory_order_relaxed) };
+	}
+};
+
+/**
+ * Ring buffer of one thread's events. Only the owning thread writes;
+ * readers copy events and then discard any the writer may have overwritten
+ * in the meantime.
+ */
+struct Buffer {
+	Slot events[NFIQ2::Trace::BufferCapacity];
+	/** Number of events ever written. */
+	std::atomic<uint64_t> written { 0 };
+	/** Value of written when clear() was last called. */
+	std::atomic<uint64_t> cleared { 0 };
+	/** Whether a live thread owns the buffer. */
+	std::atomic<bool> inUse { true };
+};
+
+std::mutex &
+registryMutex()
+{
+	static std::mutex mutex {};
+	return mutex;
+}
+
+/** Buffers of all threads, kept after their thread exits for reuse. */
+std::vector<std::shared_ptr<Buffer>> &
+registry()
+{
+	static std::vector<std::shared_ptr<Buffer>> buffers {};
+	return buffers;
+}
+
+std::chrono::steady_clock::time_point
+epoch()
+{
+	static const std::chrono::steady_clock::time_point start {
+		std::chrono::steady_clock::now()
+	};
+	return start;
+}
+
+uint64_t
+now()
+{
+	return static_cast<uint64_t>(
+	    std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now() - epoch())
+		.count());
+}
+
+struct ThreadState {
+	std::shared_ptr<Buffer> buffer {};
+	uint32_t thread { 0 };
+	/** Innermost open span */
+	const char *current { nullptr };
+	uint32_t depth { 0 };
+
+	ThreadState()
+	{
+		static std::atomic<uint32_t> nextThread { 1 };
+		this->thread = nextThread.fetch_add(1);
+
+		std::lock_guard<std::mutex> lock(registryMutex());
+		for (const auto &candidate : registry()) {
+			bool expected { false };
+			if (candidate->inUse.compare_exchange_strong(
+				expected, true)) {
+				this->buffer = candidate;
+				return;
+			}
+		}
+		this->buffer = std::make_shared<Buffer>();
+		registry().push_back(this->buffer);
+	}
+
+	~ThreadState()
+	{
+		this->buffer->inUse.store(false, std::memory_order_release);
+	}
+};
+
+ThreadState &
+threadState()
+{
+	static thread_local ThreadState state {};
+	return state;
+}
+
+/** @return nearest-rank percentile `p` of sorted samples */
+double
+percentile(const std::vector<double> &sorted, const double p)
+{
+	const size_t rank = static_cast<size_t>(
+	    std::ceil(p / 100.0 * static_cast<double>(sorted.size())));
+	return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+}
+
+void
+writeJSONString(std::ostream &out, const char *s)
+{
+	out << '"';
+	for (; *s != '\0'; ++s) {
+		if (*s == '"' || *s == '\\') {
+			out << '\\';
+		}
+		out << *s;
+	}
+	out << '"';
+}
+
+}
+
+NFIQ2::Trace::Span::Span(const char *name)
+    : name(name)
+{
+	/* Start the epoch before the first span */
+	epoch();
+
+	ThreadState &state = threadState();
+	this->parent = state.current;
+	this->depth = state.depth;
+	state.current = name;
+	++state.depth;
+
+	this->open = true;
+	this->start = now();
+}
+
+NFIQ2::Trace::Span::~Span()
+{
+	this->end();
+}
+
+void
+NFIQ2::Trace::Span::end()
+{
+	if (!this->open) {
+		return;
+	}
+	this->open = false;
+	const uint64_t finish = now();
+
+	ThreadState &state = threadState();
+	state.current = this->parent;
+	state.depth = this->depth;
+
+	Buffer &buffer = *state.buffer;
+	const uint64_t n = buffer.written.load(std::memory_order_relaxed);
+	/* A reader that sees any store below also sees written == n */
+	std::atomic_thread_fence(std::memory_order_release);
+	buffer.events[n % BufferCapacity].store({ this->name, this->parent,
+	    this->start, finish - this->start, state.thread, this->depth });
+	buffer.written.store(n + 1, std::memory_order_release);
+}
+
+bool
+NFIQ2::Trace::isEnabled()
+{
+#ifdef NFIQ2_TRACING
+	return true;
+#else
+	return false;
+#endif
+}
+
+std::vector<NFIQ2::Trace::Event>
+NFIQ2::Trace::collect()
+{
+	std::vector<std::shared_ptr<Buffer>> buffers {};
+	{
+		std::lock_guard<std::mutex> lock(registryMutex());
+		buffers = registry();
+	}
+
+	std::vector<Event> events {};
+	std::vector<Event> copy {};
+	for (const auto &buffer : buffers) {
+		const uint64_t end = buffer->written.load(
+		    std::memory_order_acquire);
+		const uint64_t first = std::max(buffer->cleared.load(),
+		    end > BufferCapacity ? end - BufferCapacity : 0);
+
+		copy.clear();
+		for (uint64_t i = first; i < end; ++i) {
+			copy.push_back(
+			    buffer->events[i % BufferCapacity].load());
+		}
+
+		/* Drop events the owning thread may have overwritten */
+		std::atomic_thread_fence(std::memory_order_acquire);
+		const uint64_t after = buffer->written.load(
+		    std::memory_order_relaxed);
+		const uint64_t valid = after >= BufferCapacity ?
+		    after - BufferCapacity + 1 :
+		    0;
+		for (uint64_t i = first; i < end; ++i) {
+			if (i >= valid) {
+				events.push_back(copy[i - first]);
+			}
+		}
+	}
+	return events;
+}
+
+void
+NFIQ2::Trace::clear()
+{
+	std::lock_guard<std::mutex> lock(registryMutex());
+	for (const auto &buffer : registry()) {
+		buffer->cleared.store(buffer->written.load());
+	}
+}
+
+std::vector<NFIQ2::Trace::Summary>
+NFIQ2::Trace::summarize(const std::vector<Event> &events)
+{
+	std::map<std::string, std::vector<double>> durations {};
+	for (const auto &event : events) {
+		std::string name { event.name };
+		if (event.parent != nullptr) {
+			name = std::string(event.parent) + "/" + name;
+		}
+		durations[name].push_back(
+		    static_cast<double>(event.duration) / 1e6);
+	}
+
+	std::vector<Summary> summaries {};
+	for (auto &span : durations) {
+		std::vector<double> &sorted = span.second;
+		std::sort(sorted.begin(), sorted.end());
+
+		double total { 0 };
+		for (const double duration : sorted) {
+			total += duration;
+		}
+		summaries.push_back({ span.first, sorted.size(), total,
+		    percentile(sorted, 50), percentile(sorted, 90),
+		    percentile(sorted, 99), sorted.back() });
+	}
+	return summaries;
+}
+
+void
+NFIQ2::Trace::writeChromeTrace(
+    std::ostream &out, const std::vector<Event> &events)
+{
+	out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	const std::ios_base::fmtflags flags = out.flags();
+	out << std::fixed << std::setprecision(3);
+	bool first { true };
+	for (const auto &event : events) {
+		out << (first ? "\n" : ",\n") << "{\"name\":";
+		writeJSONString(out, event.name);
+		out << ",\"cat\":\"nfiq2\",\"ph\":\"X\",\"ts\":"
+		    << static_cast<double>(event.start) / 1e3
+		    << ",\"dur\":" << static_cast<double>(event.duration) / 1e3
+		    << ",\"pid\":1,\"tid\":" << event.thread << "}";
+		first = false;
+	}
+	out << "\n]}\n";
+	out.flags(flags);
+}
+
+void
+NFIQ2::Trace::writeSummary(std::ostream &out, const std::vector<Event> &events)
+{
+	const std::vector<Summary> summaries = summarize(events);
+
+	size_t width { 4 };
+	for (const auto &summary : summaries) {
+		width = std::max(width, summary.name.size());
+	}
+
+	const std::ios_base::fmtflags flags = out.flags();
+	out << std::left << std::setw(static_cast<int>(width)) << "Span"
+	    << std::right << std::setw(9) << "Count" << std::setw(12)
+	    << "Total ms" << std::setw(10) << "p50 ms" << std::setw(10)
+	    << "p90 ms" << std::setw(10) << "p99 ms" << std::setw(10)
+	    << "max ms"
+	    << "\n";
+	out << std::fixed << std::setprecision(3);
+	for (const auto &summary : summaries) {
+		out << std::left << std::setw(static_cast<int>(width))
+		    << summary.name << std::right << std::setw(9)
+		    << summary.count << std::setw(12) << summary.total
+		    << std::setw(10) << summary.p50 << std::setw(10)
+		    << summary.p90 << std::setw(10) << summary.p99
+		    << std::setw(10) << summary.max << "\n";
+	}
+	out.flags(flags);
+}
@@ -26,8 +26,12 @@
 #endif /* NFIQ2_EMBED_RANDOM_FOREST_PARAMETERS */
 
 #include "digestpp.hpp"
+#include <algorithm>
+#include <cfloat>
 #include <cmath>
 #include <ctime>
+#include <memory>
+#include <mutex>
 #include <numeric> // std::accumulate
 
 const char NFIQ2::Identifiers::PredictionModules::RandomForest[] {
@@ -44,16 +48,166 @@ NFIQ2::Prediction::RandomForestML::calculateHashString(const std::string &s)
 	return ss.str();
 }
 
-void
+namespace {
+/** A forest shared by RandomForestML loaded from the same parameters. */
+struct LoadedForest {
+	std::weak_ptr<cv::ml::RTrees> forest {};
+	/** Whether RandomForestML::meetsThreshold() may traverse it. */
+	bool traversable { false };
+};
+
+/**
+ * Whether predict() with RAW_OUTPUT sums one leaf value from each tree of
+ * forest, reached with only ordered splits on sample columns. Anything
+ * else is left to OpenCV.
+ */
+bool
+isTraversable(const cv::ml::RTrees &rf, const cv::FileNode &forest)
+{
+	std::vector<int> labels {};
+	forest["class_labels"] >> labels;
+	const int nclasses = labels.empty() ? (int)forest["nclasses"] :
+					      (int)labels.size();
+
+	return (rf.isClassifier() && nclasses == 2 &&
+	    forest["var_idx"].empty() && forest["missing_subst"].empty() &&
+	    rf.getSubsets().empty());
+}
+
+/** Quality value computed by evaluate() from a sum of leaf values. */
+int
+qualityFromSum(const double sum)
+{
+	const float prob = (float)sum;
+	return ((int)(prob + 0.5));
+}
+}
+
+std::string
 NFIQ2::Prediction::RandomForestML::initModule(const std::string &params)
 {
+	/*
+	 * Models loaded from identical parameters share one forest, which
+	 * is only read by predict().
+	 */
+	static std::mutex loadedMutex {};
+	static std::unordered_map<std::string, LoadedForest> loaded {};
+
+	const std::string hash = calculateHashString(params);
+	std::lock_guard<std::mutex> lock(loadedMutex);
+	const auto it = loaded.find(hash);
+	if (it != loaded.end()) {
+		const std::shared_ptr<cv::ml::RTrees> forest =
+		    it->second.forest.lock();
+		if (forest != nullptr) {
+			m_pTrainedRF = forest;
+			initTreeOrder(it->second.traversable);
+			return hash;
+		}
+	}
+
 	// create file storage with parameters in memory
 	cv::FileStorage fs(params.c_str(),
 	    cv::FileStorage::READ | cv::FileStorage::MEMORY |
 		cv::FileStorage::FORMAT_YAML);
 	// now import data structures
+	const cv::FileNode node = fs["my_random_trees"];
 	m_pTrainedRF = cv::ml::RTrees::create();
-	m_pTrainedRF->read(cv::FileNode(fs["my_random_trees"]));
+	m_pTrainedRF->read(node);
+
+	const bool traversable = isTraversable(*m_pTrainedRF, node);
+	loaded[hash] = LoadedForest { m_pTrainedRF, traversable };
+	initTreeOrder(traversable);
+
+	return hash;
+}
+
+void
+NFIQ2::Prediction::RandomForestML::initTreeOrder(const bool traversable)
+{
+	m_earlyExit = false;
+	m_treeOrder.clear();
+	m_remainingMin.clear();
+	m_remainingMax.clear();
+	m_constantSum = 0;
+	m_sumTolerance = 0;
+	if (!traversable) {
+		return;
+	}
+
+	const std::vector<int> &roots = m_pTrainedRF->getRoots();
+	const std::vector<cv::ml::DTrees::Node> &nodes =
+	    m_pTrainedRF->getNodes();
+
+	struct Tree {
+		int root;
+		double min, max;
+		/** Mean depth of leaves, or nodes visited per evaluation */
+		double depth;
+	};
+	std::vector<Tree> trees {};
+	bool integral { true };
+	double magnitude { 0 };
+	for (const int root : roots) {
+		Tree tree { root, DBL_MAX, -DBL_MAX, 0 };
+		unsigned int leaves { 0 };
+		std::vector<std::pair<int, unsigned int>> stack { { root, 1 } };
+		while (!stack.empty()) {
+			const auto top = stack.back();
+			stack.pop_back();
+			const cv::ml::DTrees::Node &n = nodes[top.first];
+			if (n.split < 0) {
+				tree.min = std::min(tree.min, n.value);
+				tree.max = std::max(tree.max, n.value);
+				tree.depth += top.second;
+				integral = integral &&
+				    n.value == std::floor(n.value);
+				leaves++;
+			} else {
+				stack.push_back({ n.left, top.second + 1 });
+				stack.push_back({ n.right, top.second + 1 });
+			}
+		}
+		tree.depth /= leaves;
+		magnitude += std::max(std::fabs(tree.min), std::fabs(tree.max));
+
+		if (tree.min == tree.max) {
+			m_constantSum += tree.min;
+		} else {
+			trees.push_back(tree);
+		}
+	}
+
+	/*
+	 * Trees that can move the sum furthest for each node visited
+	 * narrow the range of possible scores fastest.
+	 */
+	std::stable_sort(trees.begin(), trees.end(),
+	    [](const Tree &a, const Tree &b) {
+		    return ((a.max - a.min) / a.depth >
+			(b.max - b.min) / b.depth);
+	    });
+
+	m_treeOrder.reserve(trees.size());
+	m_remainingMin.assign(trees.size() + 1, 0);
+	m_remainingMax.assign(trees.size() + 1, 0);
+	for (size_t i = trees.size(); i-- > 0;) {
+		m_remainingMin[i] = m_remainingMin[i + 1] + trees[i].min;
+		m_remainingMax[i] = m_remainingMax[i + 1] + trees[i].max;
+	}
+	for (const Tree &tree : trees) {
+		m_treeOrder.push_back(tree.root);
+	}
+
+	/*
+	 * Sums of integers are exact. Otherwise, OpenCV and meetsThreshold()
+	 * add in different orders, and either may be off by this much.
+	 */
+	if (!integral) {
+		m_sumTolerance = 4 * (roots.size() + 1) * DBL_EPSILON *
+		    magnitude;
+	}
+	m_earlyExit = true;
 }
 
 #ifdef NFIQ2_EMBED_RANDOM_FOREST_PARAMETERS
@@ -72,12 +226,8 @@ NFIQ2::Prediction::RandomForestML::joinRFTrainedParamsString()
 
 NFIQ2::Prediction::RandomForestML::RandomForestML() = default;
 
-NFIQ2::Prediction::RandomForestML::~RandomForestML()
-{
-	if (!m_pTrainedRF.empty()) {
-		m_pTrainedRF->clear();
-	}
-}
+// The forest may be shared, so it is released rather than cleared
+NFIQ2::Prediction::RandomForestML::~RandomForestML() = default;
 
 #ifdef NFIQ2_EMBED_RANDOM_FOREST_PARAMETERS
 std::string
@@ -93,8 +243,7 @@ NFIQ2::Prediction::RandomForestML::initModule()
 		data.fromBase64String(params);
 		params = "";
 		params.assign((const char *)data.data(), data.size());
-		initModule(params);
-		return calculateHashString(params);
+		return initModule(params);
 	} catch (const cv::Exception &e) {
 		throw Exception(NFIQ2::ErrorCode::UnknownError, e.msg);
 	} catch (...) {
@@ -110,11 +259,10 @@ NFIQ2::Prediction::RandomForestML::initModule(
 	std::ifstream input(fileName);
 	std::string params((std::istreambuf_iterator<char>(input)),
 	    std::istreambuf_iterator<char>());
-	initModule(params);
 	// calculate and compare the hash
-	std::string hash = calculateHashString(params);
+	std::string hash = initModule(params);
 	if (fileHash.compare(hash) != 0) {
-		m_pTrainedRF->clear();
+		m_pTrainedRF.release();
 		throw NFIQ2::Exception(NFIQ2::ErrorCode::InvalidConfiguration,
 		    "The trained network could not be initialized! "
 		    "Error: " +
@@ -127,6 +275,13 @@ void
 NFIQ2::Prediction::RandomForestML::evaluate(
     const std::unordered_map<std::string, double> &features,
     double &qualityValue) const
+{
+	this->evaluate(getFeatureVector(features), qualityValue);
+}
+
+cv::Mat
+NFIQ2::Prediction::RandomForestML::getFeatureVector(
+    const std::unordered_map<std::string, double> &features)
 {
 	/**
 	   The following ordering of feature keys is critical to the
@@ -245,6 +400,25 @@ NFIQ2::Prediction::RandomForestML::evaluate(
 		Identifiers::QualityFeatures::RidgeValleyUniformity::StdDev
 	};
 
+	// copy data to structure
+	cv::Mat sample_data = cv::Mat(1, rfFeatureOrder.size(), CV_32FC1);
+	try {
+		for (unsigned int i { 0 }; i < rfFeatureOrder.size(); ++i) {
+			sample_data.at<float>(0, i) = features.at(
+			    rfFeatureOrder[i]);
+		}
+	} catch (const std::out_of_range &e) {
+		throw Exception(
+		    NFIQ2::ErrorCode::FeatureCalculationError, e.what());
+	}
+
+	return sample_data;
+}
+
+void
+NFIQ2::Prediction::RandomForestML::evaluate(
+    const cv::Mat &sample, double &qualityValue) const
+{
 	try {
 		if (m_pTrainedRF.empty() || !m_pTrainedRF->isTrained() ||
 		    !m_pTrainedRF->isClassifier()) {
@@ -254,30 +428,75 @@ NFIQ2::Prediction::RandomForestML::evaluate(
 			    "prediction!");
 		}
 
-		// copy data to structure
-		cv::Mat sample_data = cv::Mat(
-		    1, rfFeatureOrder.size(), CV_32FC1);
-
-		for (unsigned int i { 0 }; i < rfFeatureOrder.size(); ++i) {
-			sample_data.at<float>(0, i) = features.at(
-			    rfFeatureOrder[i]);
-		}
-
 		// returns probability that between 0 and 1 that result belongs
 		// to second class
 		float prob = m_pTrainedRF->predict(
-		    sample_data, cv::noArray(), cv::ml::StatModel::RAW_OUTPUT);
+		    sample, cv::noArray(), cv::ml::StatModel::RAW_OUTPUT);
 		// return quality value
 		qualityValue = (int)(prob + 0.5);
 
 	} catch (const cv::Exception &e) {
 		throw Exception(NFIQ2::ErrorCode::MachineLearningError, e.msg);
-	} catch (const std::out_of_range &e) {
-		throw Exception(
-		    NFIQ2::ErrorCode::FeatureCalculationError, e.what());
 	}
 }
 
+bool
+NFIQ2::Prediction::RandomForestML::meetsThreshold(
+    const cv::Mat &sample, const unsigned int threshold) const
+{
+	if (!m_earlyExit || m_pTrainedRF.empty() ||
+	    sample.type() != CV_32FC1 || sample.rows != 1 ||
+	    sample.cols != m_pTrainedRF->getVarCount()) {
+		double qualityValue {};
+		this->evaluate(sample, qualityValue);
+		return (qualityValue >= threshold);
+	}
+
+	const std::vector<cv::ml::DTrees::Node> &nodes =
+	    m_pTrainedRF->getNodes();
+	const std::vector<cv::ml::DTrees::Split> &splits =
+	    m_pTrainedRF->getSplits();
+	const float *values = sample.ptr<float>();
+	const float missing = cv::ml::TrainData::missingValue();
+
+	double sum = m_constantSum;
+	for (size_t i = 0; i <= m_treeOrder.size(); ++i) {
+		// Stop once every possible total is on one side of threshold
+		if (qualityFromSum(sum + m_remainingMin[i] - m_sumTolerance) >=
+		    (long long)threshold) {
+			return (true);
+		}
+		if (qualityFromSum(sum + m_remainingMax[i] + m_sumTolerance) <
+		    (long long)threshold) {
+			return (false);
+		}
+		if (i == m_treeOrder.size()) {
+			break;
+		}
+
+		// Same path as DTreesImpl::predictTrees()
+		int nidx = m_treeOrder[i];
+		while (nodes[nidx].split >= 0) {
+			const cv::ml::DTrees::Node &node = nodes[nidx];
+			const cv::ml::DTrees::Split &split = splits[node.split];
+			const float value = values[split.varIdx];
+			if (value == missing) {
+				nidx = node.defaultDir < 0 ? node.left :
+							     node.right;
+			} else {
+				nidx = value <= split.c ? node.left :
+							  node.right;
+			}
+		}
+		sum += nodes[nidx].value;
+	}
+
+	// Total is within rounding error of the threshold
+	double qualityValue {};
+	this->evaluate(sample, qualityValue);
+	return (qualityValue >= threshold);
+}
+
 std::string
 NFIQ2::Prediction::RandomForestML::getModuleName() const
 {
@@ -0,0 +1,394 @@
+/******************************************************************************
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ ******************************************************************************/
+
+/*
+ * nfiq2_daemon_test: round trip of images through `nfiq2 -S`.
+ *
+ * Each image is first scored by the nfiq2 command line (-F -v -a). A daemon
+ * is then started on a socket in a temporary directory and sent every
+ * image, twice: pipelined on one connection, then on one connection per
+ * image, which the daemon must reap as clients disconnect. Every response
+ * must carry the score, actionable feedback, and feature values that the
+ * command line printed for the same image.
+ */
+
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/** Requests pipelined at once, within the QueueDepth of one worker */
+const size_t Window { 4 };
+
+/** Command line output is rounded to 5 decimal places */
+const double Tolerance { 1e-5 };
+
+/** Values of one image, by column or "Name=Value" name */
+using Values = std::map<std::string, std::string>;
+
+std::vector<std::string>
+splitCSV(const std::string &line)
+{
+	std::vector<std::string> fields {};
+	std::string field {};
+	bool quoted { false };
+	for (const char c : line) {
+		if (c == '"') {
+			quoted = !quoted;
+		} else if (c == ',' && !quoted) {
+			fields.push_back(field);
+			field.clear();
+		} else {
+			field += c;
+		}
+	}
+	fields.push_back(field);
+	return fields;
+}
+
+/** Score an image with the nfiq2 command line */
+bool
+scoreWithCLI(const std::string &nfiq2, const std::string &model,
+    const std::string &image, Values &values)
+{
+	const std::string command { "\"" + nfiq2 + "\" -F -v -a -m \"" +
+		model + "\" \"" + image + "\" < /dev/null" };
+	FILE *pipe = ::popen(command.c_str(), "r");
+	if (pipe == nullptr) {
+		return false;
+	}
+	std::string output {};
+	char buffer[4096];
+	size_t n {};
+	while ((n = std::fread(buffer, 1, sizeof(buffer), pipe)) > 0) {
+		output.append(buffer, n);
+	}
+	if (::pclose(pipe) != 0) {
+		return false;
+	}
+
+	std::istringstream lines { output };
+	std::string header {}, row {};
+	if (!std::getline(lines, header) || !std::getline(lines, row)) {
+		return false;
+	}
+	const auto names = splitCSV(header);
+	const auto fields = splitCSV(row);
+	if (names.size() != fields.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < names.size(); i++) {
+		values[names[i]] = fields[i];
+	}
+	return true;
+}
+
+void
+writeUInt32(std::vector<uint8_t> &buffer, const uint32_t value)
+{
+	buffer.push_back(static_cast<uint8_t>(value >> 24));
+	buffer.push_back(static_cast<uint8_t>(value >> 16));
+	buffer.push_back(static_cast<uint8_t>(value >> 8));
+	buffer.push_back(static_cast<uint8_t>(value));
+}
+
+uint32_t
+readUInt32(const uint8_t *p)
+{
+	return (static_cast<uint32_t>(p[0]) << 24) |
+	    (static_cast<uint32_t>(p[1]) << 16) |
+	    (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+bool
+readFully(const int fd, uint8_t *buffer, size_t size)
+{
+	while (size > 0) {
+		const ssize_t n = ::recv(fd, buffer, size, 0);
+		if (n <= 0) {
+			return false;
+		}
+		buffer += n;
+		size -= static_cast<size_t>(n);
+	}
+	return true;
+}
+
+bool
+writeFully(const int fd, const std::vector<uint8_t> &buffer)
+{
+	size_t sent { 0 };
+	while (sent < buffer.size()) {
+		const ssize_t n = ::send(
+		    fd, buffer.data() + sent, buffer.size() - sent, 0);
+		if (n <= 0) {
+			return false;
+		}
+		sent += static_cast<size_t>(n);
+	}
+	return true;
+}
+
+/** Encoded image request, with the PPI left to the daemon */
+std::vector<uint8_t>
+makeRequest(const uint32_t id, const std::string &image)
+{
+	std::ifstream file(image, std::ios::binary);
+	const std::vector<uint8_t> bytes {
+		std::istreambuf_iterator<char>(file),
+		std::istreambuf_iterator<char>()
+	};
+
+	std::vector<uint8_t> request {};
+	writeUInt32(request, static_cast<uint32_t>(8 + bytes.size()));
+	writeUInt32(request, id);
+	request.push_back(1); // Encoded
+	request.push_back(0); // Finger position
+	request.push_back(0); // PPI
+	request.push_back(0);
+	request.insert(request.end(), bytes.begin(), bytes.end());
+	return request;
+}
+
+/**
+ * Read one response.
+ * @return false on a closed connection or a status other than OK
+ */
+bool
+readResponse(const int fd, uint32_t &id, Values &values)
+{
+	uint8_t prefix[4] {};
+	if (!readFully(fd, prefix, sizeof(prefix))) {
+		return false;
+	}
+	std::vector<uint8_t> frame(readUInt32(prefix));
+	if (frame.size() < 5 || !readFully(fd, frame.data(), frame.size())) {
+		return false;
+	}
+	id = readUInt32(frame.data());
+	const std::string body(frame.begin() + 5, frame.end());
+	if (frame[4] != 0) {
+		std::cerr << "Request " << id << " failed with status "
+			  << static_cast<unsigned int>(frame[4]) << ": "
+			  << body << "\n";
+		return false;
+	}
+
+	std::istringstream lines { body };
+	std::string line {};
+	while (std::getline(lines, line)) {
+		const auto equals = line.find('=');
+		if (equals != std::string::npos) {
+			values[line.substr(0, equals)] = line.substr(equals + 1);
+		}
+	}
+	return true;
+}
+
+int
+connectTo(const std::string &socketPath)
+{
+	struct sockaddr_un address {};
+	address.sun_family = AF_UNIX;
+	std::strncpy(address.sun_path, socketPath.c_str(),
+	    sizeof(address.sun_path) - 1);
+
+	const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd >= 0 &&
+	    ::connect(fd, reinterpret_cast<struct sockaddr *>(&address),
+		sizeof(address)) == 0) {
+		return fd;
+	}
+	if (fd >= 0) {
+		::close(fd);
+	}
+	return -1;
+}
+
+/** @return Number of values in the response that differ from the CLI */
+unsigned int
+compare(const std::string &image, const Values &cli, const Values &daemon)
+{
+	unsigned int failures { 0 };
+	for (const auto &name : { "QualityScore", "Quantized", "Resampled" }) {
+		if (cli.count(name) == 0 || daemon.count(name) == 0 ||
+		    cli.at(name) != daemon.at(name)) {
+			std::cerr << image << ": " << name << " differs\n";
+			failures++;
+		}
+	}
+
+	unsigned int compared { 0 };
+	for (const auto &value : daemon) {
+		const auto column = cli.find(value.first);
+		if (column == cli.end() || value.first == "QualityScore" ||
+		    value.first == "Quantized" || value.first == "Resampled") {
+			continue;
+		}
+		compared++;
+		const double expected = std::strtod(column->second.c_str(),
+		    nullptr);
+		const double actual = std::strtod(value.second.c_str(),
+		    nullptr);
+		if (std::fabs(expected - actual) > Tolerance) {
+			std::cerr << image << ": " << value.first << " is "
+				  << value.second << ", expected "
+				  << column->second << "\n";
+			failures++;
+		}
+	}
+
+	// Every feature and actionable feedback column is in the response
+	if (compared + 6 != cli.size()) {
+		std::cerr << image << ": compared " << compared << " of "
+			  << cli.size() - 6 << " values\n";
+		failures++;
+	}
+	return failures;
+}
+
+} // namespace
+
+int
+main(int argc, char **argv)
+{
+	if (argc < 4) {
+		std::cerr << "Usage: " << argv[0]
+			  << " <nfiq2> <model info> <image> [<image> ...]\n";
+		return EXIT_FAILURE;
+	}
+	const std::string nfiq2 { argv[1] };
+	const std::string model { argv[2] };
+	const std::vector<std::string> images(argv + 3, argv + argc);
+
+	std::vector<Values> expected(images.size());
+	for (size_t i = 0; i < images.size(); i++) {
+		if (!scoreWithCLI(nfiq2, model, images[i], expected[i])) {
+			std::cerr << "Could not score " << images[i]
+				  << " with " << nfiq2 << "\n";
+			return EXIT_FAILURE;
+		}
+	}
+
+	char directory[] { "/tmp/nfiq2_daemon_test.XXXXXX" };
+	if (::mkdtemp(directory) == nullptr) {
+		std::cerr << "Could not create a temporary directory\n";
+		return EXIT_FAILURE;
+	}
+	const std::string socketPath { std::string(directory) + "/socket" };
+
+	const pid_t daemon = ::fork();
+	if (daemon == 0) {
+		::execl(nfiq2.c_str(), nfiq2.c_str(), "-S", socketPath.c_str(),
+		    "-F", "-m", model.c_str(),
+		    static_cast<char *>(nullptr));
+		std::_Exit(EXIT_FAILURE);
+	}
+
+	// Wait for the daemon to load its model and listen
+	int fd { -1 };
+	const auto deadline = std::chrono::steady_clock::now() +
+	    std::chrono::seconds(60);
+	while ((fd = connectTo(socketPath)) < 0 &&
+	    std::chrono::steady_clock::now() < deadline &&
+	    ::waitpid(daemon, nullptr, WNOHANG) == 0) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	}
+
+	unsigned int failures { 0 };
+	if (fd < 0) {
+		std::cerr << "Could not connect to " << socketPath << "\n";
+		failures++;
+	} else {
+		// Pipelined on one connection; responses may be reordered
+		for (size_t first = 0; first < images.size(); first += Window) {
+			const size_t last = std::min(
+			    first + Window, images.size());
+			for (size_t i = first; i < last; i++) {
+				if (!writeFully(fd, makeRequest(
+					static_cast<uint32_t>(i), images[i]))) {
+					failures++;
+				}
+			}
+			for (size_t n = first; n < last; n++) {
+				uint32_t id {};
+				Values values {};
+				if (!readResponse(fd, id, values) ||
+				    id < first || id >= last) {
+					failures++;
+					continue;
+				}
+				failures += compare(
+				    images[id], expected[id], values);
+			}
+		}
+		::close(fd);
+
+		// One connection per request
+		for (size_t i = 0; i < images.size(); i++) {
+			fd = connectTo(socketPath);
+			uint32_t id {};
+			Values values {};
+			if (fd < 0 ||
+			    !writeFully(fd, makeRequest(
+				static_cast<uint32_t>(i), images[i])) ||
+			    !readResponse(fd, id, values) || id != i) {
+				std::cerr << images[i]
+					  << ": no response on a new "
+					     "connection\n";
+				failures++;
+			} else {
+				failures += compare(
+				    images[i], expected[i], values);
+			}
+			if (fd >= 0) {
+				::close(fd);
+			}
+		}
+	}
+
+	// The daemon must exit cleanly on SIGTERM
+	int status {};
+	::kill(daemon, SIGTERM);
+	if (::waitpid(daemon, &status, 0) != daemon || !WIFEXITED(status) ||
+	    WEXITSTATUS(status) != EXIT_SUCCESS) {
+		std::cerr << "Daemon did not exit cleanly\n";
+		failures++;
+	}
+	::rmdir(directory);
+
+	if (failures != 0) {
+		std::cerr << failures << " failures\n";
+		return EXIT_FAILURE;
+	}
+	std::cout << "Daemon matched nfiq2 on " << images.size()
+		  << " images\n";
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,179 @@
+/******************************************************************************
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ ******************************************************************************/
+
+/*
+ * nfiq2_threshold_test: meetsQualityThreshold() against computeQualityScore().
+ *
+ * Quality features are computed for each image, and each feature vector is
+ * also scaled at random to spread the scores out. For every vector and every
+ * threshold from 0 to 101, meetsQualityThreshold() must agree with comparing
+ * computeQualityScore() to the threshold, both one vector at a time and for
+ * all vectors in one batch.
+ */
+
+#include <nfiq2.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using Features = std::unordered_map<std::string, double>;
+
+/** Thresholds checked: every score, and one above the highest */
+const unsigned int MaxThreshold { 101 };
+
+/** Randomly scaled copies of each image's features */
+const unsigned int Variations { 200 };
+
+/** Resolution of the example images */
+const uint16_t PPI { 500 };
+
+/** Read the next PGM header field, skipping comments */
+bool
+readField(std::istream &in, std::string &field)
+{
+	while (in >> field) {
+		if (field[0] != '#') {
+			return true;
+		}
+		std::getline(in, field);
+	}
+	return false;
+}
+
+/** Read an 8-bit binary PGM image */
+bool
+readPGM(const std::string &path, std::vector<uint8_t> &pixels,
+    uint32_t &width, uint32_t &height)
+{
+	std::ifstream in(path, std::ios::binary);
+	std::string magic {}, w {}, h {}, maxval {};
+	if (!readField(in, magic) || magic != "P5" || !readField(in, w) ||
+	    !readField(in, h) || !readField(in, maxval) ||
+	    std::stoul(maxval) > 255) {
+		return false;
+	}
+	in.get();
+
+	width = static_cast<uint32_t>(std::stoul(w));
+	height = static_cast<uint32_t>(std::stoul(h));
+	pixels.resize(static_cast<size_t>(width) * height);
+	return static_cast<bool>(in.read(reinterpret_cast<char *>(
+	    pixels.data()), static_cast<std::streamsize>(pixels.size())));
+}
+
+/** Features of an image, followed by randomly scaled copies */
+std::vector<Features>
+featureVectors(const NFIQ2::FingerprintImageData &image, std::mt19937 &rng)
+{
+	const Features original =
+	    NFIQ2::QualityFeatures::getQualityFeatureValues(
+		NFIQ2::QualityFeatures::computeQualityModules(image));
+
+	std::uniform_real_distribution<double> scale { 0.0, 2.0 };
+	std::vector<Features> vectors { original };
+	for (unsigned int v = 0; v < Variations; v++) {
+		Features scaled { original };
+		for (auto &feature : scaled) {
+			feature.second *= scale(rng);
+		}
+		vectors.push_back(scaled);
+	}
+	return vectors;
+}
+}
+
+int
+main(int argc, char **argv)
+{
+	if (argc < 3) {
+		std::cerr << "Usage: " << argv[0]
+			  << " <model info> <image> [<image> ...]\n";
+		return EXIT_FAILURE;
+	}
+
+	std::vector<Features> features {};
+	try {
+		const NFIQ2::Algorithm model { NFIQ2::ModelInfo(argv[1]) };
+
+		std::mt19937 rng { 1 };
+		for (int i = 2; i < argc; i++) {
+			std::vector<uint8_t> pixels {};
+			uint32_t width {}, height {};
+			if (!readPGM(argv[i], pixels, width, height)) {
+				std::cerr << "Could not read " << argv[i]
+					  << "\n";
+				return EXIT_FAILURE;
+			}
+			const NFIQ2::FingerprintImageData image { pixels.data(),
+				static_cast<uint32_t>(pixels.size()), width,
+				height, 0, PPI };
+			for (const auto &f : featureVectors(image, rng)) {
+				features.push_back(f);
+			}
+		}
+
+		std::vector<unsigned int> scores {};
+		std::set<unsigned int> distinct {};
+		for (const auto &f : features) {
+			scores.push_back(model.computeQualityScore(f));
+			distinct.insert(scores.back());
+		}
+
+		unsigned int failures { 0 };
+		for (unsigned int t = 0; t <= MaxThreshold; t++) {
+			const std::vector<bool> batch =
+			    model.meetsQualityThreshold(features, t);
+			if (batch.size() != features.size()) {
+				std::cerr << "Threshold " << t << ": batch of "
+					  << features.size() << " returned "
+					  << batch.size() << " results\n";
+				failures++;
+				continue;
+			}
+			for (size_t i = 0; i < features.size(); i++) {
+				const bool expected { scores[i] >= t };
+				const bool single { model.meetsQualityThreshold(
+					features[i], t) };
+				if (single == expected &&
+				    batch[i] == expected) {
+					continue;
+				}
+				std::cerr << "Vector " << i << " (score "
+					  << scores[i] << "), threshold " << t
+					  << ": single " << single << ", batch "
+					  << batch[i] << "\n";
+				failures++;
+			}
+		}
+
+		std::cout << features.size() << " feature vectors, "
+			  << distinct.size() << " distinct scores from "
+			  << *distinct.begin() << " to " << *distinct.rbegin()
+			  << "\n";
+		if (failures != 0) {
+			std::cerr << failures << " failures\n";
+			return EXIT_FAILURE;
+		}
+	} catch (const NFIQ2::Exception &e) {
+		std::cerr << e.what() << "\n";
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
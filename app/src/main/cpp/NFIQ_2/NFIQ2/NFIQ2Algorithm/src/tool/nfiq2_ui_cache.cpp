@@ -0,0 +1,140 @@
+/******************************************************************************
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ ******************************************************************************/
+
+#include <be_error_exception.h>
+#include <be_io_recordstore.h>
+#include <be_io_utility.h>
+#include <tool/nfiq2_ui_cache.h>
+#include <tool/nfiq2_ui_exception.h>
+
+#include "digestpp.hpp"
+
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+
+namespace BE = BiometricEvaluation;
+
+NFIQ2UI::ScoreCache::ScoreCache(
+    const std::string &pathname, const std::string &parameterHash)
+    : parameterHash(parameterHash)
+{
+	try {
+		if (BE::IO::Utility::pathIsDirectory(pathname)) {
+			this->rs = BE::IO::RecordStore::openRecordStore(
+			    pathname, BE::IO::Mode::ReadWrite);
+		} else {
+			this->rs = BE::IO::RecordStore::createRecordStore(
+			    pathname, "NFIQ 2 score cache",
+			    BE::IO::RecordStore::Kind::SQLite);
+		}
+	} catch (const BE::Error::Exception &e) {
+		throw NFIQ2UI::CacheError(
+		    "Could not open cache at " + pathname + ": " + e.what());
+	}
+}
+
+std::string
+NFIQ2UI::ScoreCache::computeKey(const NFIQ2::FingerprintImageData &image) const
+{
+	// Everything that can change the features or score is hashed
+	std::stringstream header {};
+	header << image.width << 'x' << image.height << '@' << image.ppi
+	       << ':' << this->parameterHash;
+	const std::string headerStr = header.str();
+
+	digestpp::blake2b hasher(256);
+	hasher.absorb(headerStr.c_str(), headerStr.length());
+	hasher.absorb(image.data(), image.size());
+	return hasher.hexdigest();
+}
+
+bool
+NFIQ2UI::ScoreCache::find(const std::string &key, Entry &entry) const
+{
+	BE::Memory::uint8Array data {};
+	try {
+		std::lock_guard<std::mutex> lock(this->mutex);
+		data = this->rs->read(key);
+	} catch (const BE::Error::Exception &) {
+		return false;
+	}
+	if (data.size() == 0) {
+		return false;
+	}
+
+	// Format: "S score", followed by "F id value" and "A id value" lines
+	std::istringstream in { std::string(
+	    reinterpret_cast<const char *>(&data[0]), data.size()) };
+	Entry parsed {};
+	bool haveScore { false };
+	std::string line {};
+	while (std::getline(in, line)) {
+		std::istringstream fields { line };
+		std::string type {}, id {}, value {};
+		fields >> type;
+		try {
+			if (type == "S") {
+				fields >> value;
+				parsed.score = static_cast<unsigned int>(
+				    std::stoul(value));
+				haveScore = true;
+			} else if (type == "F") {
+				fields >> id >> value;
+				parsed.features[id] = std::stod(value);
+			} else if (type == "A") {
+				fields >> id >> value;
+				parsed.actionable[id] = std::stod(value);
+			}
+		} catch (const std::exception &) {
+			// Treat a corrupt entry as a miss
+			return false;
+		}
+	}
+	if (!haveScore) {
+		return false;
+	}
+
+	entry = parsed;
+	return true;
+}
+
+void
+NFIQ2UI::ScoreCache::insert(const std::string &key, const Entry &entry)
+{
+	std::ostringstream out {};
+	out << std::setprecision(std::numeric_limits<double>::max_digits10);
+	out << "S " << entry.score << "\n";
+	for (const auto &feature : entry.features) {
+		out << "F " << feature.first << " " << feature.second << "\n";
+	}
+	for (const auto &feedback : entry.actionable) {
+		out << "A " << feedback.first << " " << feedback.second << "\n";
+	}
+	const std::string outStr = out.str();
+
+	try {
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->rs->insert(key, outStr.c_str(), outStr.length());
+	} catch (const BE::Error::Exception &) {
+		// Another thread inserted the same image, or the store is
+		// unwritable. Either way, the score is still valid.
+	}
+}
+
+NFIQ2UI::ScoreCache::~ScoreCache()
+{
+	try {
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->rs->sync();
+	} catch (const BE::Error::Exception &) {
+	}
+}
@@ -0,0 +1,124 @@
+/******************************************************************************
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ ******************************************************************************/
+
+#include <tool/nfiq2_ui_checkpoint.h>
+#include <tool/nfiq2_ui_exception.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Entries are "source<TAB>item", one per line
+std::string
+NFIQ2UI::Checkpoint::makeEntry(
+    const std::string &source, const std::string &item)
+{
+	return source + '\t' + item;
+}
+
+NFIQ2UI::Checkpoint::Checkpoint(const std::string &pathname, const bool resume)
+{
+	bool interrupted { false };
+
+	if (resume) {
+		std::ifstream in(pathname);
+		std::string line {};
+		while (std::getline(in, line)) {
+			// A line without a newline was interrupted mid-write
+			if (in.eof()) {
+				interrupted = !line.empty();
+				break;
+			}
+
+			const auto tab = line.find('\t');
+			if (tab == std::string::npos) {
+				continue;
+			}
+			this->completed.insert(line);
+			this->sources.insert(line.substr(0, tab));
+		}
+	}
+
+	// An interrupted entry is discarded by rewriting the complete entries
+	const bool append = resume && !interrupted;
+	this->log.open(pathname,
+	    append ? (std::ios::out | std::ios::app) :
+			   (std::ios::out | std::ios::trunc));
+	if (!this->log) {
+		throw NFIQ2UI::CheckpointError(
+		    "Could not open checkpoint log: " + pathname);
+	}
+	if (interrupted) {
+		for (const auto &entry : this->completed) {
+			this->log << entry << '\n';
+		}
+		this->log.flush();
+	}
+}
+
+bool
+NFIQ2UI::Checkpoint::isComplete(
+    const std::string &source, const std::string &item) const
+{
+	// completed is not modified after construction
+	return (this->completed.find(makeEntry(source, item)) !=
+	    this->completed.end());
+}
+
+bool
+NFIQ2UI::Checkpoint::hasCompleted(const std::string &source) const
+{
+	return (this->sources.find(source) != this->sources.end());
+}
+
+void
+NFIQ2UI::Checkpoint::markComplete(
+    const std::string &source, const std::string &item)
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	this->pending.push_back(makeEntry(source, item));
+}
+
+bool
+NFIQ2UI::Checkpoint::flushDue() const
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	return (this->pending.size() >= FlushInterval);
+}
+
+std::vector<std::string>
+NFIQ2UI::Checkpoint::takePending()
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	std::vector<std::string> entries {};
+	entries.swap(this->pending);
+	return entries;
+}
+
+void
+NFIQ2UI::Checkpoint::commit(const std::vector<std::string> &entries)
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	for (const auto &entry : entries) {
+		this->log << entry << '\n';
+	}
+	this->log.flush();
+}
+
+void
+NFIQ2UI::Checkpoint::flush()
+{
+	this->commit(this->takePending());
+}
+
+NFIQ2UI::Checkpoint::~Checkpoint()
+{
+	this->flush();
+}
@@ -0,0 +1,568 @@
+/******************************************************************************
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ ******************************************************************************/
+
+#include <be_image_image.h>
+#include <be_memory_autoarray.h>
+#include <nfiq2_exception.hpp>
+#include <nfiq2_fingerprintimagedata.hpp>
+#include <nfiq2_qualityfeatures.hpp>
+#include <opencv2/core.hpp>
+#include <tool/nfiq2_ui_cache.h>
+#include <tool/nfiq2_ui_daemon.h>
+#include <tool/nfiq2_ui_exception.h>
+#include <tool/nfiq2_ui_refresh.h>
+
+#ifndef _WIN32
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace BE = BiometricEvaluation;
+
+#ifndef _WIN32
+
+namespace {
+
+/** Set by SIGINT and SIGTERM */
+volatile std::sig_atomic_t stopRequested { 0 };
+
+extern "C" void
+requestStop(int)
+{
+	stopRequested = 1;
+}
+
+uint32_t
+readUInt32(const uint8_t *p)
+{
+	return (static_cast<uint32_t>(p[0]) << 24) |
+	    (static_cast<uint32_t>(p[1]) << 16) |
+	    (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+void
+writeUInt32(uint8_t *p, const uint32_t value)
+{
+	p[0] = static_cast<uint8_t>(value >> 24);
+	p[1] = static_cast<uint8_t>(value >> 16);
+	p[2] = static_cast<uint8_t>(value >> 8);
+	p[3] = static_cast<uint8_t>(value);
+}
+
+/** @return true if size bytes were read, false on EOF or error */
+bool
+readFully(const int fd, uint8_t *buffer, size_t size)
+{
+	while (size > 0) {
+		const ssize_t n = ::recv(fd, buffer, size, 0);
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n <= 0) {
+			return false;
+		}
+		buffer += n;
+		size -= static_cast<size_t>(n);
+	}
+	return true;
+}
+
+/** @return true if size bytes were written, false on error */
+bool
+writeFully(const int fd, const uint8_t *buffer, size_t size)
+{
+	while (size > 0) {
+		const ssize_t n = ::send(fd, buffer, size, 0);
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n <= 0) {
+			return false;
+		}
+		buffer += n;
+		size -= static_cast<size_t>(n);
+	}
+	return true;
+}
+
+/** @return "Name=Value" lines, sorted by name */
+std::string
+formatValues(const std::unordered_map<std::string, double> &values)
+{
+	const std::map<std::string, double> sorted(
+	    values.begin(), values.end());
+
+	std::ostringstream out {};
+	out << std::setprecision(std::numeric_limits<double>::max_digits10);
+	for (const auto &value : sorted) {
+		out << value.first << '=' << value.second << '\n';
+	}
+	return out.str();
+}
+
+} // namespace
+
+struct NFIQ2UI::Daemon::Connection {
+	explicit Connection(const int fd_)
+	    : fd { fd_ }
+	{
+	}
+
+	~Connection()
+	{
+		::close(this->fd);
+	}
+
+	/** Connected socket */
+	const int fd;
+	/** Keeps responses from interleaving */
+	std::mutex writeMutex {};
+};
+
+NFIQ2UI::Daemon::Daemon(const std::string &socketPath, const Flags &flags,
+    const NFIQ2::Algorithm &model, std::shared_ptr<NFIQ2UI::Log> logger)
+    : socketPath { socketPath }
+    , flags { flags }
+    , model { model }
+    , logger { logger }
+{
+	struct sockaddr_un address {};
+	if (socketPath.size() >= sizeof(address.sun_path)) {
+		throw NFIQ2UI::DaemonError("Socket path is too long: " +
+		    socketPath);
+	}
+	address.sun_family = AF_UNIX;
+	std::strncpy(address.sun_path, socketPath.c_str(),
+	    sizeof(address.sun_path) - 1);
+
+	this->listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	if (this->listener < 0) {
+		throw NFIQ2UI::DaemonError(
+		    "Could not create socket: " + std::string(strerror(errno)));
+	}
+
+	::unlink(socketPath.c_str());
+	if (::bind(this->listener, reinterpret_cast<struct sockaddr *>(&address),
+		sizeof(address)) != 0 ||
+	    ::listen(this->listener, SOMAXCONN) != 0) {
+		const std::string reason { strerror(errno) };
+		::close(this->listener);
+		throw NFIQ2UI::DaemonError(
+		    "Could not listen on " + socketPath + ": " + reason);
+	}
+
+	this->queueCapacity = static_cast<size_t>(this->flags.numthreads) *
+	    QueueDepth;
+}
+
+NFIQ2UI::Daemon::~Daemon()
+{
+	::close(this->listener);
+	::unlink(this->socketPath.c_str());
+}
+
+void
+NFIQ2UI::Daemon::run()
+{
+	// Clients that disconnect early must not kill the daemon
+	std::signal(SIGPIPE, SIG_IGN);
+	stopRequested = 0;
+	std::signal(SIGINT, requestStop);
+	std::signal(SIGTERM, requestStop);
+
+	std::vector<std::thread> workers {};
+	for (unsigned int i = 0; i < this->flags.numthreads; ++i) {
+		workers.emplace_back(&NFIQ2UI::Daemon::work, this);
+	}
+
+	this->logger->debugMsg("Listening on " + this->socketPath);
+
+	std::vector<std::thread> readers {};
+	while (stopRequested == 0) {
+		this->reapReaders(readers);
+
+		// Wake periodically to notice signals
+		struct pollfd pending {
+			this->listener, POLLIN, 0
+		};
+		if (::poll(&pending, 1, 250) <= 0) {
+			continue;
+		}
+
+		const int fd = ::accept(this->listener, nullptr, nullptr);
+		if (fd < 0) {
+			continue;
+		}
+
+		auto connection = std::make_shared<Connection>(fd);
+		{
+			std::lock_guard<std::mutex> lock(
+			    this->connectionsMutex);
+			this->connections.push_back(connection);
+		}
+		readers.emplace_back(
+		    &NFIQ2UI::Daemon::readRequests, this, connection);
+	}
+
+	this->logger->debugMsg("Stopping daemon");
+
+	// Stop reading new requests, but let queued requests be answered
+	{
+		std::lock_guard<std::mutex> lock(this->connectionsMutex);
+		for (const auto &weak : this->connections) {
+			if (const auto connection = weak.lock()) {
+				::shutdown(connection->fd, SHUT_RD);
+			}
+		}
+	}
+	for (auto &reader : readers) {
+		reader.join();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(this->queueMutex);
+		this->stopping = true;
+	}
+	this->queueChanged.notify_all();
+	for (auto &worker : workers) {
+		worker.join();
+	}
+}
+
+void
+NFIQ2UI::Daemon::reapReaders(std::vector<std::thread> &readers)
+{
+	std::vector<std::thread::id> finished {};
+	{
+		std::lock_guard<std::mutex> lock(this->connectionsMutex);
+		finished.swap(this->finishedReaders);
+		this->connections.erase(
+		    std::remove_if(this->connections.begin(),
+			this->connections.end(),
+			[](const std::weak_ptr<Connection> &weak) {
+				return weak.expired();
+			}),
+		    this->connections.end());
+	}
+
+	for (const auto &id : finished) {
+		const auto reader = std::find_if(readers.begin(),
+		    readers.end(),
+		    [&id](const std::thread &t) { return t.get_id() == id; });
+		if (reader != readers.end()) {
+			reader->join();
+			readers.erase(reader);
+		}
+	}
+}
+
+void
+NFIQ2UI::Daemon::readRequests(std::shared_ptr<Connection> connection)
+{
+	static const size_t HeaderSize { 8 };
+	static const size_t RawHeaderSize { 8 };
+
+	while (true) {
+		uint8_t prefix[4] {};
+		if (!readFully(connection->fd, prefix, sizeof(prefix))) {
+			break;
+		}
+
+		const uint32_t length = readUInt32(prefix);
+		if (length < HeaderSize || length > MaxRequestSize) {
+			// The stream cannot be resynchronized
+			respond(*connection, 0, Status::BadRequest,
+			    "Request length " + std::to_string(length) +
+				" is out of range");
+			break;
+		}
+
+		std::vector<uint8_t> frame(length);
+		if (!readFully(connection->fd, frame.data(), frame.size())) {
+			break;
+		}
+
+		Job job {};
+		job.connection = connection;
+		job.id = readUInt32(frame.data());
+		job.type = static_cast<RequestType>(frame[4]);
+		job.fingerPosition = frame[5];
+		job.ppi = static_cast<uint16_t>((frame[6] << 8) | frame[7]);
+
+		if (job.type != RequestType::Raw &&
+		    job.type != RequestType::Encoded) {
+			respond(*connection, job.id, Status::BadRequest,
+			    "Unknown request type " +
+				std::to_string(frame[4]));
+			continue;
+		}
+		if (job.type == RequestType::Raw &&
+		    length < HeaderSize + RawHeaderSize) {
+			respond(*connection, job.id, Status::BadRequest,
+			    "Raw request is missing image dimensions");
+			continue;
+		}
+		job.payload.assign(frame.begin() + HeaderSize, frame.end());
+
+		bool admitted { false };
+		{
+			std::lock_guard<std::mutex> lock(this->queueMutex);
+			if (this->queue.size() < this->queueCapacity) {
+				this->queue.push_back(std::move(job));
+				admitted = true;
+			}
+		}
+		if (admitted) {
+			this->queueChanged.notify_one();
+		} else {
+			respond(*connection, job.id, Status::Busy,
+			    "Too many requests are waiting");
+		}
+	}
+
+	// Queued jobs keep the connection open until they are answered
+	connection.reset();
+	std::lock_guard<std::mutex> lock(this->connectionsMutex);
+	this->finishedReaders.push_back(std::this_thread::get_id());
+}
+
+void
+NFIQ2UI::Daemon::work()
+{
+	while (true) {
+		Job job {};
+		{
+			std::unique_lock<std::mutex> lock(this->queueMutex);
+			this->queueChanged.wait(lock, [this] {
+				return this->stopping || !this->queue.empty();
+			});
+			if (this->queue.empty()) {
+				return;
+			}
+			job = std::move(this->queue.front());
+			this->queue.pop_front();
+		}
+
+		std::string body {};
+		const Status status = this->score(job, body);
+		respond(*job.connection, job.id, status, body);
+	}
+}
+
+NFIQ2UI::Daemon::Status
+NFIQ2UI::Daemon::score(const Job &job, std::string &body) const
+{
+	static const uint16_t defaultPPI { 72 };
+	static const uint16_t requiredPPI { 500 };
+
+	const std::string name { "request " + std::to_string(job.id) };
+
+	BE::Memory::uint8Array pixels {};
+	uint32_t width {};
+	uint32_t height {};
+	uint16_t ppi { job.ppi };
+	bool quantized { false };
+
+	if (job.type == RequestType::Raw) {
+		width = readUInt32(job.payload.data());
+		height = readUInt32(job.payload.data() + 4);
+		const uint64_t size = static_cast<uint64_t>(width) * height;
+		if (job.payload.size() - 8 != size) {
+			body = "Expected " + std::to_string(size) +
+			    " pixels, received " +
+			    std::to_string(job.payload.size() - 8);
+			return Status::BadRequest;
+		}
+		pixels.copy(job.payload.data() + 8, size);
+		if (ppi == 0) {
+			ppi = requiredPPI;
+		}
+	} else {
+		try {
+			const auto img = BE::Image::Image::openImage(
+			    job.payload.data(), job.payload.size(), name);
+
+			const uint16_t bitDepth = img->getBitDepth();
+			const uint32_t colorDepth = img->getColorDepth();
+			if ((bitDepth != colorDepth) ||
+			    (bitDepth != 8 && bitDepth != 1)) {
+				if (!this->flags.force) {
+					body = "Image is not 8 bit or 1 bit "
+					       "depth and/or color";
+					return Status::Error;
+				}
+				quantized = true;
+			}
+
+			if (img->getCompressionAlgorithm() ==
+			    BE::Image::CompressionAlgorithm::WSQ20) {
+				std::lock_guard<std::mutex> lock(mutGray);
+				pixels = img->getRawGrayscaleData(8);
+			} else {
+				pixels = img->getRawGrayscaleData(8);
+			}
+
+			const BE::Image::Size dimensions =
+			    img->getDimensions();
+			width = dimensions.xSize;
+			height = dimensions.ySize;
+			if (ppi == 0) {
+				ppi = static_cast<uint16_t>(std::round(
+				    img->getResolution()
+					.toUnits(BE::Image::Resolution::Units::
+						PPI)
+					.xRes));
+				if (this->flags.force && ppi == defaultPPI) {
+					// Assume unrecorded resolution
+					ppi = requiredPPI;
+				}
+			}
+		} catch (const BE::Error::Exception &e) {
+			body = std::string { "Could not decode image: " } +
+			    e.what();
+			return Status::Error;
+		}
+	}
+
+	cv::Mat postResample {};
+	const bool resampled { ppi != requiredPPI };
+	if (resampled) {
+		if (!this->flags.force) {
+			body = "Image is " + std::to_string(ppi) +
+			    " PPI, not " + std::to_string(requiredPPI) + " PPI";
+			return Status::Error;
+		}
+		try {
+			postResample = NFIQ2UI::resampleAndLogError(pixels,
+			    { height, width, ppi, requiredPPI },
+			    { name, job.fingerPosition, quantized, true,
+				false });
+		} catch (const NFIQ2UI::ResampleError &e) {
+			body = e.what();
+			return Status::Error;
+		}
+	}
+
+	const NFIQ2::FingerprintImageData image = resampled ?
+		  NFIQ2::FingerprintImageData(postResample.data,
+		static_cast<uint32_t>(postResample.total()),
+		static_cast<uint32_t>(postResample.cols),
+		static_cast<uint32_t>(postResample.rows), job.fingerPosition,
+		requiredPPI) :
+		  NFIQ2::FingerprintImageData(pixels,
+		static_cast<uint32_t>(pixels.size()), width, height,
+		job.fingerPosition, requiredPPI);
+
+	const std::string header { "QualityScore=" };
+	const std::string flagLines { "Quantized=" +
+		std::to_string(quantized) + "\nResampled=" +
+		std::to_string(resampled) + "\n" };
+
+	std::string cacheKey {};
+	if (this->flags.scoreCache != nullptr) {
+		cacheKey = this->flags.scoreCache->computeKey(image);
+
+		NFIQ2UI::ScoreCache::Entry cached {};
+		if (this->flags.scoreCache->find(cacheKey, cached)) {
+			body = header + std::to_string(cached.score) + "\n" +
+			    flagLines + formatValues(cached.features) +
+			    formatValues(cached.actionable);
+			return Status::OK;
+		}
+	}
+
+	const NFIQ2::CancellationToken cancellation =
+	    this->flags.timeout == 0 ?
+	    NFIQ2::CancellationToken {} :
+	    NFIQ2::CancellationToken { std::chrono::milliseconds(
+		this->flags.timeout) };
+
+	std::vector<std::shared_ptr<NFIQ2::QualityFeatures::Module>> modules {};
+	unsigned int score {};
+	try {
+		modules = NFIQ2::QualityFeatures::computeQualityModules(
+		    image, cancellation);
+		score = this->model.computeQualityScore(modules);
+	} catch (const NFIQ2::Exception &e) {
+		body = e.what();
+		return (e.getErrorCode() == NFIQ2::ErrorCode::Timeout ?
+			Status::Timeout :
+			Status::Error);
+	}
+
+	NFIQ2UI::ScoreCache::Entry entry {};
+	entry.score = score;
+	entry.features = NFIQ2::QualityFeatures::getQualityFeatureValues(
+	    modules);
+	entry.actionable =
+	    NFIQ2::QualityFeatures::getActionableQualityFeedback(modules);
+	if (this->flags.scoreCache != nullptr) {
+		this->flags.scoreCache->insert(cacheKey, entry);
+	}
+
+	body = header + std::to_string(score) + "\n" + flagLines +
+	    formatValues(entry.features) + formatValues(entry.actionable);
+	return Status::OK;
+}
+
+void
+NFIQ2UI::Daemon::respond(Connection &connection, const uint32_t id,
+    const Status status, const std::string &body)
+{
+	static const size_t HeaderSize { 4 + 4 + 1 };
+
+	std::vector<uint8_t> frame(HeaderSize + body.size());
+	writeUInt32(frame.data(),
+	    static_cast<uint32_t>(frame.size() - sizeof(uint32_t)));
+	writeUInt32(frame.data() + 4, id);
+	frame[8] = static_cast<uint8_t>(status);
+	std::memcpy(frame.data() + HeaderSize, body.data(), body.size());
+
+	// A client that went away is noticed by its reader
+	std::lock_guard<std::mutex> lock(connection.writeMutex);
+	writeFully(connection.fd, frame.data(), frame.size());
+}
+
+#else /* _WIN32 */
+
+struct NFIQ2UI::Daemon::Connection {};
+
+NFIQ2UI::Daemon::Daemon(const std::string &socketPath, const Flags &flags,
+    const NFIQ2::Algorithm &model, std::shared_ptr<NFIQ2UI::Log> logger)
+    : model { model }
+{
+	throw NFIQ2UI::DaemonError(
+	    "UNIX domain sockets are not supported on this platform");
+}
+
+NFIQ2UI::Daemon::~Daemon() = default;
+
+void
+NFIQ2UI::Daemon::run()
+{
+}
+
+#endif /* _WIN32 */
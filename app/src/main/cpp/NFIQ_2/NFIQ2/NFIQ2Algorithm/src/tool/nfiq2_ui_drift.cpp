@@ -0,0 +1,87 @@
+/******************************************************************************
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ ******************************************************************************/
+
+#include <tool/nfiq2_ui_drift.h>
+#include <tool/nfiq2_ui_exception.h>
+
+#include <cstdlib>
+#include <iomanip>
+#include <ostream>
+#include <string>
+
+NFIQ2UI::DriftReport::DriftReport(const std::string &pathname)
+{
+	this->csv.open(pathname, std::ios::out | std::ios::trunc);
+	if (!this->csv) {
+		throw NFIQ2UI::DriftError(
+		    "Could not open drift report: " + pathname);
+	}
+	this->csv << "\"Filename\",\"FingerCode\",\"ResampledScore\","
+		     "\"ReducedScore\",\"Drift\"\n";
+}
+
+void
+NFIQ2UI::DriftReport::record(const std::string &name,
+    const uint8_t fingerPosition, const unsigned int resampledScore,
+    const unsigned int reducedScore)
+{
+	const int drift = static_cast<int>(reducedScore) -
+	    static_cast<int>(resampledScore);
+	const unsigned int absDrift = static_cast<unsigned int>(
+	    std::abs(drift));
+
+	std::lock_guard<std::mutex> lock(this->mutex);
+	this->csv << "\"" << name << "\","
+		  << static_cast<unsigned int>(fingerPosition) << ","
+		  << resampledScore << "," << reducedScore << "," << drift
+		  << "\n";
+
+	this->count++;
+	this->sumDrift += drift;
+	this->sumAbsDrift += absDrift;
+	if (absDrift > this->maxAbsDrift) {
+		this->maxAbsDrift = absDrift;
+	}
+	this->histogram[absDrift > HistogramLimit ? HistogramLimit + 1 :
+							absDrift]++;
+}
+
+void
+NFIQ2UI::DriftReport::writeSummary(std::ostream &out) const
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+
+	out << "Reduced-resolution drift over " << this->count
+	    << " images\n";
+	if (this->count == 0) {
+		return;
+	}
+
+	const double n = static_cast<double>(this->count);
+	out << std::fixed << std::setprecision(3)
+	    << "  Mean drift: " << this->sumDrift / n << "\n"
+	    << "  Mean absolute drift: " << this->sumAbsDrift / n << "\n"
+	    << "  Maximum absolute drift: " << this->maxAbsDrift << "\n";
+
+	for (unsigned int i = 0; i <= HistogramLimit + 1; i++) {
+		if (this->histogram[i] == 0) {
+			continue;
+		}
+		out << "  |drift| " << (i > HistogramLimit ? "> " : "= ")
+		    << (i > HistogramLimit ? HistogramLimit : i) << ": "
+		    << this->histogram[i] << " (" << std::setprecision(1)
+		    << 100.0 * this->histogram[i] / n << "%)\n";
+	}
+}
+
+NFIQ2UI::DriftReport::~DriftReport()
+{
+	this->csv.flush();
+}
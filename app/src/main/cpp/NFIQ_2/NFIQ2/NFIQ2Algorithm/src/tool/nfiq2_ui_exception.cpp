@@ -70,3 +70,23 @@ NFIQ2UI::ResampleError::errorWasHandled() const noexcept
 {
 	return this->_errorHandled;
 }
+
+NFIQ2UI::CacheError::CacheError(const std::string &info)
+    : Exception("CacheError: " + info)
+{
+}
+
+NFIQ2UI::CheckpointError::CheckpointError(const std::string &info)
+    : Exception("CheckpointError: " + info)
+{
+}
+
+NFIQ2UI::DaemonError::DaemonError(const std::string &info)
+    : Exception("DaemonError: " + info)
+{
+}
+
+NFIQ2UI::DriftError::DriftError(const std::string &info)
+    : Exception("DriftError: " + info)
+{
+}
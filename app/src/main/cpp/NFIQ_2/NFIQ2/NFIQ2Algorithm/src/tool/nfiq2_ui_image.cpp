@@ -8,7 +8,7 @@
  * about its quality, reliability, or any other characteristic.
  ******************************************************************************/
 
-#include <be_data_interchange_an2k.h>
+#include <be_data_interchange_an2kindex.h>
 #include <be_data_interchange_ansi2004.h>
 #include <be_image_image.h>
 #include <be_image_raw.h>
@@ -117,11 +117,13 @@ NFIQ2UI::getImagesFromAN2K(const BE::Memory::uint8Array &dataArray,
 	logger->debugMsg(
 	    "Trying to obtain images from ANSI/NIST Record: " + name);
 	std::vector<NFIQ2UI::ImgCouple> vecCouple {};
-	std::shared_ptr<BE::DataInterchange::AN2KRecord> an2k;
+	std::shared_ptr<BE::DataInterchange::AN2KIndex> an2k;
 
 	try {
-		an2k = std::make_shared<BE::DataInterchange::AN2KRecord>(
-		    const_cast<BE::Memory::uint8Array &>(dataArray));
+		// Locates records without parsing them; the index reads
+		// image data in place, so dataArray must outlive it
+		an2k = std::make_shared<BE::DataInterchange::AN2KIndex>(
+		    dataArray);
 
 	} catch (const BE::Error::Exception &e) {
 		std::string error {
@@ -131,17 +133,23 @@ NFIQ2UI::getImagesFromAN2K(const BE::Memory::uint8Array &dataArray,
 		return vecCouple;
 	}
 
-	logger->debugMsg("Successfully constructed AN2KRecord");
+	logger->debugMsg("Successfully indexed AN2KRecord");
 
-	const std::vector<BE::Finger::AN2KViewCapture> captures =
-	    an2k->getFingerCaptures();
+	for (const auto &cap : an2k->getFingerCaptures()) {
+		const auto fingerPosition = cap.fingerPosition;
 
-	for (const auto &cap : captures) {
-		// Image is valid and in memory provided that the AN2K record
-		// was constructed correctly
-		std::shared_ptr<BE::Image::Image> img = cap.getImage();
-		const auto fingerPosition =
-		    BE::Framework::Enumeration::to_int_type(cap.getPosition());
+		std::shared_ptr<BE::Image::Image> img {};
+		try {
+			img = BE::DataInterchange::AN2KIndex::getImage(
+			    cap, name + "_" + std::to_string(fingerPosition));
+		} catch (const BE::Error::Exception &e) {
+			std::string error { "Error: Could not open image : " };
+			logger->printError(
+			    name + "_" + std::to_string(fingerPosition),
+			    static_cast<uint8_t>(fingerPosition),
+			    error.append(e.what()), 0, 0);
+			continue;
+		}
 
 		logger->debugMsg("Successfully parsed image from AN2KRecord: " +
 		    name + "_" + std::to_string(fingerPosition));
@@ -160,7 +168,7 @@ NFIQ2UI::getImagesFromAN2K(const BE::Memory::uint8Array &dataArray,
 				    .xRes));
 			const uint16_t an2kPPI = static_cast<uint16_t>(
 			    std::round(
-				cap.getImageResolution()
+				cap.resolution
 				    .toUnits(BE::Image::Resolution::Units::PPI)
 				    .xRes));
 
@@ -186,7 +194,7 @@ NFIQ2UI::getImagesFromAN2K(const BE::Memory::uint8Array &dataArray,
 					    img->getDimensions(),
 					    img->getColorDepth(),
 					    img->getBitDepth(),
-					    cap.getImageResolution(),
+					    cap.resolution,
 					    img->hasAlphaChannel(),
 					    name + "_" +
 						std::to_string(fingerPosition));
@@ -26,11 +26,15 @@ NFIQ2UI::Log::Log(const Flags &flags, const std::string &path)
 	this->debug = flags.debug;
 	this->speed = flags.speed;
 	this->actionable = flags.actionable;
+	this->comparisons = flags.comparisonModels.size();
 
 	if (path.empty()) {
 		out = &std::cout;
 	} else {
-		this->logFile.open(path);
+		// Resumed runs continue the output of the interrupted run
+		this->logFile.open(path,
+		    flags.resume ? (std::ios::out | std::ios::app) :
+				   (std::ios::out | std::ios::trunc));
 		if (!this->logFile) {
 			throw NFIQ2UI::FileOpenError(
 			    "Logger could not open file: " + path);
@@ -43,8 +47,8 @@ NFIQ2UI::Log::Log(const Flags &flags, const std::string &path)
 // Prints the qualityScore of the Image
 void
 NFIQ2UI::Log::printScore(const std::string &name, uint8_t fingerCode,
-    unsigned int score, const std::string &errmsg, const bool quantized,
-    const bool resampled,
+    unsigned int score, const std::vector<unsigned int> &comparisonScores,
+    const std::string &errmsg, const bool quantized, const bool resampled,
     const std::unordered_map<std::string, double> &features,
     const std::unordered_map<std::string, double> &speed,
     const std::unordered_map<std::string, double> &actionable) const
@@ -53,6 +57,9 @@ NFIQ2UI::Log::printScore(const std::string &name, uint8_t fingerCode,
 		     << "," << std::to_string(fingerCode) << "," << score << ","
 		     << NFIQ2UI::sanitizeErrorMsg(errmsg) << "," << quantized
 		     << "," << resampled;
+	for (const auto &comparisonScore : comparisonScores) {
+		*(this->out) << "," << comparisonScore;
+	}
 	if (this->actionable || this->verbose || this->speed) {
 		*(this->out) << ",";
 	}
@@ -116,6 +123,8 @@ NFIQ2UI::Log::padNA() const
 	static const unsigned int MIN_NUM_COLS { 6 };
 	unsigned int numCols { MIN_NUM_COLS };
 
+	numCols += this->comparisons;
+
 	if (this->actionable) {
 		numCols += 4;
 	}
@@ -160,9 +169,14 @@ NFIQ2UI::Log::printError(
 
 // Prints the quality score of a single image
 void
-NFIQ2UI::Log::printSingle(unsigned int qualityScore) const
+NFIQ2UI::Log::printSingle(unsigned int qualityScore,
+    const std::vector<unsigned int> &comparisonScores) const
 {
-	*(this->out) << qualityScore << "\n";
+	*(this->out) << qualityScore;
+	for (const auto &comparisonScore : comparisonScores) {
+		*(this->out) << "," << comparisonScore;
+	}
+	*(this->out) << "\n";
 }
 
 // Prints the error of a single image
@@ -179,6 +193,13 @@ NFIQ2UI::Log::printThreaded(const std::string &message) const
 	*(this->out) << message;
 }
 
+// Flushes scores printed so far
+void
+NFIQ2UI::Log::flush() const
+{
+	this->out->flush();
+}
+
 // Prints debug messages to stdout
 void
 NFIQ2UI::Log::debugMsg(const std::string &message) const
@@ -203,6 +224,11 @@ NFIQ2UI::Log::printCSVHeader() const
 		     << "Quantized"
 		     << ","
 		     << "Resampled";
+	// Comparison models are numbered from the second -m
+	for (unsigned int i = 0; i < this->comparisons; i++) {
+		*(this->out) << ","
+			     << "QualityScore" << i + 2;
+	}
 	if (this->actionable || this->verbose || this->speed) {
 		*(this->out) << ",";
 	}
@@ -0,0 +1,263 @@
+/******************************************************************************
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ ******************************************************************************/
+
+#include <be_image_jpeg2000.h>
+#include <nfiq2_algorithm.hpp>
+#include <nfiq2_modelinfo.hpp>
+#include <nfiq2_timer.hpp>
+#include <nfiq2_trace.hpp>
+#include <tool/nfiq2_ui_cache.h>
+#include <tool/nfiq2_ui_checkpoint.h>
+#include <tool/nfiq2_ui_daemon.h>
+#include <tool/nfiq2_ui_drift.h>
+#include <tool/nfiq2_ui_exception.h>
+#include <tool/nfiq2_ui_log.h>
+#include <tool/nfiq2_ui_refresh.h>
+#include <tool/nfiq2_ui_types.h>
+#include <tool/nfiq2_ui_utils.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace BE = BiometricEvaluation;
+
+int
+main(int argc, char **argv)
+{
+	if (argc < 2) {
+		NFIQ2UI::printUsage();
+		return EXIT_SUCCESS;
+	}
+
+	NFIQ2UI::Arguments arguments {};
+	try {
+		arguments = NFIQ2UI::processArguments(argc, argv);
+	} catch (const NFIQ2UI::UndefinedFlagError &e) {
+		std::cerr << e.what() << "\n";
+		NFIQ2UI::printUndefinedFlag();
+		return EXIT_FAILURE;
+	} catch (const NFIQ2UI::InvalidArgumentError &e) {
+		std::cerr << e.what() << "\n";
+		return EXIT_FAILURE;
+	}
+
+	// Cores left idle by the scoring threads decode JPEG 2000 images
+	const unsigned int cores = std::thread::hardware_concurrency();
+	BE::Image::JPEG2000::setDecodeThreadBudget(
+	    cores > arguments.flags.numthreads ?
+		cores - arguments.flags.numthreads :
+		0);
+
+	std::shared_ptr<NFIQ2UI::Log> logger {};
+	try {
+		logger = std::make_shared<NFIQ2UI::Log>(
+		    arguments.flags, arguments.output);
+	} catch (const NFIQ2UI::FileOpenError &e) {
+		std::cerr << "Error: Could not create logger object. "
+			  << e.what() << "\n";
+		return EXIT_FAILURE;
+	}
+
+	// Initialize Model
+	NFIQ2::Timer timerInit;
+	double timeInit = 0.0;
+	timerInit.start();
+
+	NFIQ2::ModelInfo modelInfoObj {};
+
+	try {
+		modelInfoObj = NFIQ2::ModelInfo(
+		    NFIQ2UI::parseModelInfo(arguments));
+
+	} catch (const NFIQ2UI::Exception &e) {
+		std::cerr << "Unable to extract model information. " << e.what()
+			  << "\n";
+		return EXIT_FAILURE;
+	}
+
+	logger->debugMsg("Model Name: " +
+	    (modelInfoObj.getModelName().empty() ?
+			  "<NA>" :
+			  modelInfoObj.getModelName()));
+	logger->debugMsg("Model Trainer: " +
+	    (modelInfoObj.getModelTrainer().empty() ?
+			  "<NA>" :
+			  modelInfoObj.getModelTrainer()));
+	logger->debugMsg("Model Description: " +
+	    (modelInfoObj.getModelDescription().empty() ?
+			  "<NA>" :
+			  modelInfoObj.getModelDescription()));
+	logger->debugMsg("Model Version: " +
+	    (modelInfoObj.getModelVersion().empty() ?
+			  "<NA>" :
+			  modelInfoObj.getModelVersion()));
+	logger->debugMsg("Model Path: " + modelInfoObj.getModelPath());
+	logger->debugMsg("Model Hash: " + modelInfoObj.getModelHash());
+
+	std::shared_ptr<NFIQ2::Algorithm> model {};
+	try {
+		model = std::make_shared<NFIQ2::Algorithm>(modelInfoObj);
+	} catch (const NFIQ2::Exception &e) {
+		std::cerr << "Model could not be constructed. " << e.what()
+			  << "\n";
+		return EXIT_FAILURE;
+	}
+
+	// Additional models are scored from the same quality features
+	for (const auto &path : arguments.flags.comparisonModels) {
+		try {
+			arguments.flags.comparisonAlgorithms.push_back(
+			    std::make_shared<NFIQ2::Algorithm>(
+				NFIQ2UI::parseModelInfo(path)));
+		} catch (const NFIQ2UI::Exception &e) {
+			std::cerr << "Unable to extract model information. "
+				  << e.what() << "\n";
+			return EXIT_FAILURE;
+		} catch (const NFIQ2::Exception &e) {
+			std::cerr << "Model could not be constructed. "
+				  << e.what() << "\n";
+			return EXIT_FAILURE;
+		}
+		logger->debugMsg("Comparison Model Hash: " +
+		    arguments.flags.comparisonAlgorithms.back()
+			->getParameterHash());
+	}
+
+	// Open the score cache against this model's parameters
+	if (!arguments.flags.cache.empty()) {
+		try {
+			arguments.flags.scoreCache =
+			    std::make_shared<NFIQ2UI::ScoreCache>(
+				arguments.flags.cache,
+				model->getParameterHash());
+		} catch (const NFIQ2UI::CacheError &e) {
+			std::cerr << e.what() << "\n";
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (!arguments.flags.checkpoint.empty()) {
+		try {
+			arguments.flags.checkpointLog =
+			    std::make_shared<NFIQ2UI::Checkpoint>(
+				arguments.flags.checkpoint,
+				arguments.flags.resume);
+		} catch (const NFIQ2UI::CheckpointError &e) {
+			std::cerr << e.what() << "\n";
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (!arguments.flags.drift.empty()) {
+		try {
+			arguments.flags.driftReport =
+			    std::make_shared<NFIQ2UI::DriftReport>(
+				arguments.flags.drift);
+		} catch (const NFIQ2UI::DriftError &e) {
+			std::cerr << e.what() << "\n";
+			return EXIT_FAILURE;
+		}
+	}
+
+	timeInit = timerInit.stop();
+
+	std::stringstream loggerStream;
+	loggerStream << "Model Initialization: " << std::setprecision(3)
+		     << std::fixed << timeInit << " ms";
+
+	logger->debugMsg(loggerStream.str());
+	loggerStream.str("");
+	loggerStream.clear();
+
+	// Printing values of flags
+	logger->debugMsg("Value of verbose flag: " +
+	    std::to_string(arguments.flags.verbose));
+	logger->debugMsg(
+	    "Value of debug flag: " + std::to_string(arguments.flags.debug));
+	logger->debugMsg(
+	    "Value of speed flag: " + std::to_string(arguments.flags.speed));
+	logger->debugMsg(
+	    "Value of force flag: " + std::to_string(arguments.flags.force));
+	logger->debugMsg("Value of model flag: " + arguments.flags.model);
+	logger->debugMsg("Value of recursive flag: " +
+	    std::to_string(arguments.flags.recursion));
+	logger->debugMsg("Value of cache flag: " + arguments.flags.cache);
+	logger->debugMsg(
+	    "Value of checkpoint flag: " + arguments.flags.checkpoint);
+	logger->debugMsg(
+	    "Value of resume flag: " + std::to_string(arguments.flags.resume));
+	logger->debugMsg("Value of trace flag: " + arguments.flags.trace);
+	logger->debugMsg("Value of timeout flag: " +
+	    std::to_string(arguments.flags.timeout));
+	logger->debugMsg("Value of daemon flag: " + arguments.flags.daemon);
+	logger->debugMsg("Value of reduced decode flag: " +
+	    std::to_string(arguments.flags.reducedDecode));
+	logger->debugMsg("Value of drift flag: " + arguments.flags.drift);
+
+	// Serve requests with the loaded model instead of scoring arguments
+	if (!arguments.flags.daemon.empty()) {
+		try {
+			NFIQ2UI::Daemon daemon(arguments.flags.daemon,
+			    arguments.flags, *model, logger);
+			daemon.run();
+		} catch (const NFIQ2UI::DaemonError &e) {
+			std::cerr << e.what() << "\n";
+			return EXIT_FAILURE;
+		}
+		return EXIT_SUCCESS;
+	}
+
+	// Prints Header
+	NFIQ2UI::printHeader(arguments, logger);
+
+	// Process single images - includes AN2K files
+	logger->debugMsg("Processing Singles and AN2K files:");
+	NFIQ2UI::procSingle(arguments, *model, logger);
+
+	logger->debugMsg("Processing Directories:");
+	for (const auto &i : arguments.vecDirs) {
+		NFIQ2UI::parseDirectory(i, arguments.flags, *model, logger);
+	}
+
+	logger->debugMsg("Processing Batch-files:");
+	for (const auto &i : arguments.vecBatch) {
+		NFIQ2UI::executeBatch(i, arguments.flags, *model, logger);
+	}
+
+	logger->debugMsg("Processing RecordStores:");
+	for (const auto &i : arguments.vecRecordStore) {
+		NFIQ2UI::executeRecordStore(i, arguments.flags, *model, logger);
+	}
+
+	// Export spans recorded by every scoring thread
+	if (!arguments.flags.trace.empty()) {
+		const auto events = NFIQ2::Trace::collect();
+		std::ofstream traceFile(arguments.flags.trace);
+		NFIQ2::Trace::writeChromeTrace(traceFile, events);
+		if (!traceFile) {
+			std::cerr << "Could not write trace to "
+				  << arguments.flags.trace << "\n";
+			return EXIT_FAILURE;
+		}
+		NFIQ2::Trace::writeSummary(std::cerr, events);
+	}
+
+	if (arguments.flags.driftReport != nullptr) {
+		arguments.flags.driftReport->writeSummary(std::cerr);
+	}
+
+	return EXIT_SUCCESS;
+}
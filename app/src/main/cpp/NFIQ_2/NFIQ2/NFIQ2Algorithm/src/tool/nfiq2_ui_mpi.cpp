@@ -0,0 +1,197 @@
+/******************************************************************************
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ ******************************************************************************/
+
+#include <be_error_exception.h>
+#include <be_io_propertiesfile.h>
+#include <be_mpi.h>
+#include <tool/nfiq2_ui_exception.h>
+#include <tool/nfiq2_ui_image.h>
+#include <tool/nfiq2_ui_mpi.h>
+#include <tool/nfiq2_ui_refresh.h>
+#include <tool/nfiq2_ui_threadedlog.h>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace BE = BiometricEvaluation;
+
+const std::string NFIQ2UI::MPIRecordProcessor::OUTPUTRSPROPERTY {
+	"Output Record Store"
+};
+
+NFIQ2UI::MPIRecordProcessor::MPIRecordProcessor(
+    const std::string &propertiesFileName, const NFIQ2UI::Arguments &arguments)
+    : BE::MPI::RecordProcessor(propertiesFileName)
+    , propertiesFileName { propertiesFileName }
+    , arguments { arguments }
+{
+	const BE::IO::PropertiesFile props(
+	    propertiesFileName, BE::IO::Mode::ReadOnly);
+	this->outputPrefix = props.getProperty(OUTPUTRSPROPERTY);
+}
+
+void
+NFIQ2UI::MPIRecordProcessor::processRecord(const std::string &key)
+{
+	const auto resources = this->getResources();
+	if (!resources->haveRecordStore()) {
+		throw BE::Error::ObjectDoesNotExist(
+		    "Input RecordStore is not open");
+	}
+
+	// Records that cannot be read are reported in the output
+	BE::Memory::uint8Array value {};
+	try {
+		value = resources->getRecordStore()->read(key);
+	} catch (const BE::Error::Exception &e) {
+		BE::MPI::logMessage(*this->getLogsheet(),
+		    "Could not read " + key + ": " + e.whatString());
+	}
+	this->pending.emplace_back(key, value);
+}
+
+void
+NFIQ2UI::MPIRecordProcessor::processRecord(
+    const std::string &key, const BE::Memory::uint8Array &value)
+{
+	this->pending.emplace_back(key, value);
+}
+
+void
+NFIQ2UI::MPIRecordProcessor::processWorkPackage(
+    BE::MPI::WorkPackage &workPackage)
+{
+	// Records are queued by processRecord(), then scored together
+	this->pending.clear();
+	BE::MPI::RecordProcessor::processWorkPackage(workPackage);
+	this->scorePending();
+}
+
+void
+NFIQ2UI::MPIRecordProcessor::scorePending()
+{
+	std::vector<std::string> results(this->pending.size());
+	std::atomic<size_t> next { 0 };
+
+	// Each thread scores whole records, taking the next unscored one
+	auto consume = [&]() {
+		const auto logger = std::make_shared<NFIQ2UI::ThreadedLog>(
+		    this->arguments.flags);
+		for (size_t i = next++; i < this->pending.size(); i = next++) {
+			const auto &rec = this->pending[i];
+			if (rec.data.size() == 0) {
+				logger->printError(rec.key, 0,
+				    "Error: Could not read record", false,
+				    false);
+				results[i] = logger->getAndClearLastScore();
+				continue;
+			}
+
+			const auto images = NFIQ2UI::getImages(
+			    rec.data, rec.key, logger);
+			results[i] = logger->getAndClearLastScore();
+			for (const auto &image : images) {
+				NFIQ2UI::executeSingle(image,
+				    this->arguments.flags, *this->model, logger,
+				    false, false);
+				results[i] += logger->getAndClearLastScore();
+			}
+		}
+	};
+
+	const size_t numThreads = std::min<size_t>(
+	    std::max(this->arguments.flags.numthreads, 1u),
+	    this->pending.size());
+	std::vector<std::thread> threads {};
+	for (size_t t = 1; t < numThreads; t++) {
+		threads.emplace_back(consume);
+	}
+	consume();
+	for (auto &thread : threads) {
+		thread.join();
+	}
+
+	// RecordStores are written from this thread only. Records
+	// redistributed after a checkpoint restore replace earlier output.
+	try {
+		for (size_t i = 0; i < this->pending.size(); i++) {
+			const auto &key = this->pending[i].key;
+			if (this->output->containsKey(key)) {
+				this->output->replace(key, results[i].data(),
+				    results[i].size());
+			} else {
+				this->output->insert(key, results[i].data(),
+				    results[i].size());
+			}
+		}
+		this->output->sync();
+	} catch (const BE::Error::Exception &e) {
+		throw BE::Error::StrategyError(
+		    "Could not write output: " + e.whatString());
+	}
+	this->pending.clear();
+}
+
+std::shared_ptr<BE::MPI::WorkPackageProcessor>
+NFIQ2UI::MPIRecordProcessor::newProcessor(
+    std::shared_ptr<BE::IO::Logsheet> &logsheet)
+{
+	// Input RecordStores are reopened in each worker process
+	std::shared_ptr<NFIQ2UI::MPIRecordProcessor> processor(
+	    new NFIQ2UI::MPIRecordProcessor(
+		this->propertiesFileName, this->arguments));
+	processor->setLogsheet(logsheet);
+	processor->model = this->model;
+
+	const std::string name = this->outputPrefix + "-" +
+	    std::to_string(processor->getResources()->getRank()) + "-" +
+	    std::to_string(::getpid());
+	processor->output = BE::IO::RecordStore::createRecordStore(
+	    name, "NFIQ 2 scores", BE::IO::RecordStore::Kind::SQLite);
+	BE::MPI::logMessage(*logsheet, "Writing scores to " + name);
+
+	return processor;
+}
+
+void
+NFIQ2UI::MPIRecordProcessor::performInitialization(
+    std::shared_ptr<BE::IO::Logsheet> &logsheet)
+{
+	this->setLogsheet(logsheet);
+
+	// Loaded before workers are forked, so pages are shared
+	try {
+		const NFIQ2::ModelInfo modelInfo = NFIQ2UI::parseModelInfo(
+		    this->arguments);
+		this->model = std::make_shared<NFIQ2::Algorithm>(modelInfo);
+		for (const auto &path : this->arguments.flags.comparisonModels) {
+			this->arguments.flags.comparisonAlgorithms.push_back(
+			    std::make_shared<NFIQ2::Algorithm>(
+				NFIQ2UI::parseModelInfo(path)));
+		}
+	} catch (const NFIQ2UI::Exception &e) {
+		throw BE::Error::StrategyError(
+		    std::string { "Could not load model: " } + e.what());
+	} catch (const NFIQ2::Exception &e) {
+		throw BE::Error::StrategyError(
+		    std::string { "Could not load model: " } + e.what());
+	}
+	BE::MPI::logMessage(*logsheet,
+	    "Loaded model " + this->model->getParameterHash());
+}
+
+NFIQ2UI::MPIRecordProcessor::~MPIRecordProcessor()
+{
+}
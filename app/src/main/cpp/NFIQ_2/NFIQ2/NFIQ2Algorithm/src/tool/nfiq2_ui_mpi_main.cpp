@@ -0,0 +1,205 @@
+/******************************************************************************
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ ******************************************************************************/
+
+#include <be_error_exception.h>
+#include <be_io_recordstore.h>
+#include <be_mpi.h>
+#include <be_mpi_receiver.h>
+#include <be_mpi_recordstoredistributor.h>
+#include <be_mpi_runtime.h>
+#include <tool/nfiq2_ui_exception.h>
+#include <tool/nfiq2_ui_log.h>
+#include <tool/nfiq2_ui_mpi.h>
+#include <tool/nfiq2_ui_types.h>
+#include <tool/nfiq2_ui_utils.h>
+
+#include <getopt.h>
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace BE = BiometricEvaluation;
+
+static void
+printMPIUsage()
+{
+	std::cout << "Distributed scoring (run with mpirun, at least 2 tasks):"
+		  << "\n";
+	std::cout << "\tnfiq2-mpi [-j threads] [-m model] [-F] [-W] [-v] [-q] "
+		     "[-a] [-k] [-V] <properties>"
+		  << "\n";
+	std::cout << "Merging output RecordStores:"
+		  << "\n";
+	std::cout << "\tnfiq2-mpi -M <output> [-m model ...] [-v] [-q] [-a] "
+		     "<RecordStore> [<RecordStore> ...]"
+		  << "\n\n";
+	std::cout << "-j [# of threads]: Threads scoring each work package"
+		  << "\n";
+	std::cout << "-m [model info file]: Path to alternate model info file. "
+		     "Repeat to compare models"
+		  << "\n";
+	std::cout << "-F: Forces images to be quantized or resampled"
+		  << "\n";
+	std::cout << "-W: Decodes 1000 PPI WSQ and JPEG 2000 images directly "
+		     "at 500 PPI"
+		  << "\n";
+	std::cout << "-v, -q, -a: Records feature values, speed timings, and "
+		     "actionable feedback, as with nfiq2"
+		  << "\n";
+	std::cout << "-k: Saves and restores a checkpoint in the properties' "
+		     "Checkpoint Path"
+		  << "\n";
+	std::cout << "-V: Sends record values with each work package, instead "
+		     "of only keys"
+		  << "\n";
+	std::cout << "-M [output]: Writes the records of output RecordStores "
+		     "as CSV to output,\n\twith the -m, -v, -q, and -a flags "
+		     "used to score them"
+		  << "\n";
+	std::cout << "\nThe properties file names the Input Record Store, Chunk "
+		     "Size, Workers Per Node,\nand Output Record Store. Each "
+		     "worker process writes to its own RecordStore,\nnamed "
+		     "<Output Record Store>-<rank>-<process ID>."
+		  << "\n";
+}
+
+// Concatenate the output RecordStores of a distributed run into one CSV file
+static int
+merge(const NFIQ2UI::Flags &flags, const std::string &output,
+    const std::vector<std::string> &pathnames)
+{
+	std::shared_ptr<NFIQ2UI::Log> logger {};
+	try {
+		logger = std::make_shared<NFIQ2UI::Log>(flags, output);
+	} catch (const NFIQ2UI::FileOpenError &e) {
+		std::cerr << e.what() << "\n";
+		return EXIT_FAILURE;
+	}
+	logger->printCSVHeader();
+
+	for (const auto &pathname : pathnames) {
+		try {
+			const auto rs = BE::IO::RecordStore::openRecordStore(
+			    pathname);
+			for (const auto &rec : *rs) {
+				logger->printThreaded(std::string(
+				    reinterpret_cast<const char *>(&rec.data[0]),
+				    rec.data.size()));
+			}
+		} catch (const BE::Error::Exception &e) {
+			std::cerr << "Could not merge " << pathname << ": "
+				  << e.what() << "\n";
+			return EXIT_FAILURE;
+		}
+	}
+	logger->flush();
+
+	return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char **argv)
+{
+	NFIQ2UI::Arguments arguments {};
+	arguments.argv0 = argv[0];
+
+	std::string mergeOutput {};
+	bool checkpoint { false };
+	bool includeValues { false };
+
+	static const char options[] { "j:m:FWvqakVM:" };
+	int c {};
+	while ((c = getopt(argc, argv, options)) != -1) {
+		switch (c) {
+		case 'j':
+			// Tasks have no terminal, so checkThreads() cannot prompt
+			try {
+				arguments.flags.numthreads =
+				    NFIQ2UI::parseUnsigned(optarg);
+			} catch (const std::exception &) {
+				printMPIUsage();
+				return EXIT_FAILURE;
+			}
+			break;
+		case 'm':
+			// Models after the first are compared against it
+			if (arguments.flags.model.empty()) {
+				arguments.flags.model = optarg;
+			} else {
+				arguments.flags.comparisonModels.push_back(
+				    optarg);
+			}
+			break;
+		case 'F':
+			arguments.flags.force = true;
+			break;
+		case 'W':
+			arguments.flags.reducedDecode = true;
+			break;
+		case 'v':
+			arguments.flags.verbose = true;
+			break;
+		case 'q':
+			arguments.flags.speed = true;
+			break;
+		case 'a':
+			arguments.flags.actionable = true;
+			break;
+		case 'k':
+			checkpoint = true;
+			break;
+		case 'V':
+			includeValues = true;
+			break;
+		case 'M':
+			mergeOutput = optarg;
+			break;
+		default:
+			printMPIUsage();
+			return EXIT_FAILURE;
+		}
+	}
+
+	std::vector<std::string> operands(argv + optind, argv + argc);
+	if (!mergeOutput.empty()) {
+		if (operands.empty()) {
+			printMPIUsage();
+			return EXIT_FAILURE;
+		}
+		return merge(arguments.flags, mergeOutput, operands);
+	}
+	if (operands.size() != 1) {
+		printMPIUsage();
+		return EXIT_FAILURE;
+	}
+	const std::string &propertiesFileName = operands[0];
+
+	BE::MPI::Runtime runtime(argc, argv, checkpoint);
+	try {
+		std::shared_ptr<BE::MPI::WorkPackageProcessor> processor(
+		    new NFIQ2UI::MPIRecordProcessor(
+			propertiesFileName, arguments));
+		BE::MPI::RecordStoreDistributor distributor(
+		    propertiesFileName, includeValues);
+		BE::MPI::Receiver receiver(propertiesFileName, processor);
+
+		runtime.start(distributor, receiver);
+	} catch (const BE::Error::Exception &e) {
+		BE::MPI::printStatus("Could not start: " + e.whatString());
+		runtime.abort(EXIT_FAILURE);
+	}
+	runtime.shutdown();
+
+	return EXIT_SUCCESS;
+}
@@ -15,14 +15,18 @@
 #include <be_image_image.h>
 #include <be_io_propertiesfile.h>
 #include <be_io_recordstore.h>
+#include <be_io_recordstoreprefetcher.h>
 #include <be_io_utility.h>
 #include <be_sysdeps.h>
 #include <be_text.h>
 #include <nfiq2_algorithm.hpp>
 #include <nfiq2_modelinfo.hpp>
-#include <nfiq2_timer.hpp>
+#include <nfiq2_trace.hpp>
 #include <nfir_lib.h>
 #include <opencv2/opencv.hpp>
+#include <tool/nfiq2_ui_cache.h>
+#include <tool/nfiq2_ui_checkpoint.h>
+#include <tool/nfiq2_ui_drift.h>
 #include <tool/nfiq2_ui_exception.h>
 #include <tool/nfiq2_ui_image.h>
 #include <tool/nfiq2_ui_log.h>
@@ -31,11 +35,14 @@
 #include <tool/nfiq2_ui_types.h>
 #include <tool/nfiq2_ui_utils.h>
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <mutex>
@@ -43,6 +50,7 @@
 #include <sstream>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 namespace BE = BiometricEvaluation;
@@ -142,6 +150,66 @@ NFIQ2UI::resampleAndLogError(BE::Memory::uint8Array &grayscaleRawData,
 	return postResample;
 }
 
+unsigned int
+NFIQ2UI::scoreWithoutReduction(std::shared_ptr<BE::Image::Image> img,
+    const uint8_t fingerPosition, const NFIQ2::Algorithm &model)
+{
+	static const uint16_t requiredPPI { 500 };
+
+	const uint8_t reduction = img->getResolutionReduction();
+	BE::Memory::uint8Array grayscaleRawData {};
+	BE::Image::Size dimensions {};
+	BE::Image::Resolution resolution {};
+
+	img->setResolutionReduction(0);
+	try {
+		if (img->getCompressionAlgorithm() ==
+		    BE::Image::CompressionAlgorithm::WSQ20) {
+			std::lock_guard<std::mutex> lock(mutGray);
+			grayscaleRawData = img->getRawGrayscaleData(8);
+		} else {
+			grayscaleRawData = img->getRawGrayscaleData(8);
+		}
+		dimensions = img->getDimensions();
+		resolution = img->getResolution().toUnits(
+		    BE::Image::Resolution::Units::PPI);
+	} catch (const BE::Error::Exception &) {
+		img->setResolutionReduction(reduction);
+		throw;
+	}
+	img->setResolutionReduction(reduction);
+
+	const NFIQ2UI::DimensionInfo dimensionInfo { dimensions.ySize,
+		dimensions.xSize,
+		static_cast<uint16_t>(std::round(resolution.xRes)),
+		requiredPPI };
+	const NFIQ2UI::ImageProps imageProps { "", fingerPosition, false,
+		true, false };
+	const cv::Mat postResample = NFIQ2UI::resampleAndLogError(
+	    grayscaleRawData, dimensionInfo, imageProps);
+
+	const NFIQ2::FingerprintImageData wrappedImage(postResample.data,
+	    postResample.total(), postResample.cols, postResample.rows,
+	    fingerPosition, requiredPPI);
+	return (model.computeQualityScore(
+	    NFIQ2::QualityFeatures::computeQualityModules(wrappedImage)));
+}
+
+std::vector<unsigned int>
+NFIQ2UI::scoreComparisons(const Flags &flags,
+    const std::unordered_map<std::string, double> &features)
+{
+	if (flags.comparisonAlgorithms.empty()) {
+		return {};
+	}
+
+	std::vector<std::reference_wrapper<const NFIQ2::Algorithm>> models {};
+	for (const auto &model : flags.comparisonAlgorithms) {
+		models.push_back(*model);
+	}
+	return NFIQ2::Algorithm::computeQualityScores(models, features);
+}
+
 // Performs additional checks for an image before calculating an NFIQ2 score
 void
 NFIQ2UI::executeSingle(std::shared_ptr<BE::Image::Image> img,
@@ -207,6 +275,24 @@ NFIQ2UI::executeSingle(std::shared_ptr<BE::Image::Image> img,
 	    "Successfully passed bit and color depth check. Quantized?: " +
 	    std::to_string(imageProps.quantized));
 
+	static const uint8_t defaultPPI { 72 };
+	static const uint16_t requiredPPI { 500 };
+
+	// 1000 PPI wavelet images can be decoded directly at 500 PPI
+	bool reduced { false };
+	if (flags.reducedDecode && img->getMaximumResolutionReduction() >= 1) {
+		const BE::Image::Resolution fullResolution =
+		    img->getResolution().toUnits(
+			BE::Image::Resolution::Units::PPI);
+		if (fullResolution.xRes == fullResolution.yRes &&
+		    std::round(fullResolution.xRes) == 2 * requiredPPI) {
+			img->setResolutionReduction(1);
+			reduced = true;
+		}
+	}
+	logger->debugMsg(
+	    "Reduced-resolution decode?: " + std::to_string(reduced));
+
 	// Now check for PPI
 	BE::Memory::uint8Array grayscaleRawData {};
 	// Need to lock around WSQ because it is single threaded
@@ -246,9 +332,6 @@ NFIQ2UI::executeSingle(std::shared_ptr<BE::Image::Image> img,
 
 	cv::Mat postResample {};
 
-	static const uint8_t defaultPPI { 72 };
-	static const uint16_t requiredPPI { 500 };
-
 	const NFIQ2UI::DimensionInfo dimensionInfo { imageHeight, imageWidth,
 		imagePPI, requiredPPI };
 
@@ -348,13 +431,18 @@ NFIQ2UI::executeSingle(std::shared_ptr<BE::Image::Image> img,
 		}
 	}
 
+	// Reduced-resolution decoding is reported as a resample
+	if (reduced) {
+		imageProps.resampled = true;
+	}
+
 	logger->debugMsg("Successfully passed PPI check. Re-sampled?: " +
 	    std::to_string(imageProps.resampled));
 
 	// At this point - all images are 500PPI, have been converted to that
 	// resolution, or are assumed to be that resolution.
 
-	const NFIQ2::FingerprintImageData wrappedImage = imageProps.resampled ?
+	const NFIQ2::FingerprintImageData wrappedImage = !postResample.empty() ?
 		  NFIQ2::FingerprintImageData(postResample.data, postResample.total(),
 		postResample.cols, postResample.rows, fingerPosition,
 		requiredPPI) :
@@ -362,11 +450,65 @@ NFIQ2UI::executeSingle(std::shared_ptr<BE::Image::Image> img,
 		grayscaleRawData.size(), imageWidth, imageHeight,
 		fingerPosition, requiredPPI);
 
+	// Images scored in a previous run are not scored again
+	std::string cacheKey {};
+	if (flags.scoreCache != nullptr) {
+		cacheKey = flags.scoreCache->computeKey(wrappedImage);
+
+		NFIQ2UI::ScoreCache::Entry cached {};
+		if (flags.scoreCache->find(cacheKey, cached)) {
+			logger->debugMsg("Score cache hit: " + cacheKey);
+
+			// Comparison models score the cached features
+			std::vector<unsigned int> comparisonScores {};
+			try {
+				comparisonScores = NFIQ2UI::scoreComparisons(
+				    flags, cached.features);
+			} catch (const NFIQ2::Exception &e) {
+				std::string errStr {
+					"Error: NFIQ2 computeQualityScores "
+					"returned an error code: "
+				};
+				errStr = errStr.append(e.what());
+				if (singleImage) {
+					logger->printSingleError(errStr);
+				} else {
+					logger->printError(errStr, imageProps);
+				}
+				return;
+			}
+
+			if (singleImage) {
+				logger->printSingle(
+				    cached.score, comparisonScores);
+			} else {
+				// No modules were computed, so no time was spent
+				std::unordered_map<std::string, double> speeds {};
+				for (const auto &id :
+				    NFIQ2::QualityFeatures::getQualityModuleIDs()) {
+					speeds[id] = 0.0;
+				}
+				logger->printScore(name, fingerPosition,
+				    cached.score, comparisonScores, warning,
+				    imageProps.quantized,
+				    imageProps.resampled, cached.features, speeds,
+				    cached.actionable);
+			}
+			return;
+		}
+	}
+
+	// Modules stop between blocks once the per-image deadline passes
+	const NFIQ2::CancellationToken cancellation = flags.timeout == 0 ?
+	    NFIQ2::CancellationToken {} :
+	    NFIQ2::CancellationToken { std::chrono::milliseconds(
+		flags.timeout) };
+
 	std::vector<std::shared_ptr<NFIQ2::QualityFeatures::Module>> modules {};
 	unsigned int score {};
 	try {
 		modules = NFIQ2::QualityFeatures::computeQualityModules(
-		    wrappedImage);
+		    wrappedImage, cancellation);
 		score = model.computeQualityScore(modules);
 	} catch (const NFIQ2::Exception &e) {
 		std::string errStr {
@@ -381,20 +523,70 @@ NFIQ2UI::executeSingle(std::shared_ptr<BE::Image::Image> img,
 		return;
 	}
 
+	const std::unordered_map<std::string, double> features =
+	    NFIQ2::QualityFeatures::getQualityFeatureValues(modules);
+	const std::unordered_map<std::string, double> actionable =
+	    NFIQ2::QualityFeatures::getActionableQualityFeedback(modules);
+
+	// Comparison models score the same features
+	std::vector<unsigned int> comparisonScores {};
+	try {
+		comparisonScores = NFIQ2UI::scoreComparisons(flags, features);
+	} catch (const NFIQ2::Exception &e) {
+		std::string errStr {
+			"Error: NFIQ2 computeQualityScores returned an error code: "
+		};
+		errStr = errStr.append(e.what());
+		if (singleImage) {
+			logger->printSingleError(errStr);
+		} else {
+			logger->printError(errStr, imageProps);
+		}
+		return;
+	}
+
+	if (reduced && flags.driftReport != nullptr) {
+		std::string errStr {};
+		try {
+			flags.driftReport->record(name, fingerPosition,
+			    NFIQ2UI::scoreWithoutReduction(
+				img, fingerPosition, model),
+			    score);
+		} catch (const BE::Error::Exception &e) {
+			errStr = e.what();
+		} catch (const NFIQ2UI::ResampleError &e) {
+			errStr = e.what();
+		} catch (const NFIQ2::Exception &e) {
+			errStr = e.what();
+		}
+		if (!errStr.empty()) {
+			logger->debugMsg(
+			    "Could not score " + name +
+			    " without reduction: " + errStr);
+		}
+	}
+
+	if (flags.scoreCache != nullptr) {
+		NFIQ2UI::ScoreCache::Entry entry {};
+		entry.score = score;
+		entry.features = features;
+		entry.actionable = actionable;
+		flags.scoreCache->insert(cacheKey, entry);
+	}
+
 	// Print score:
 	if (singleImage) {
 		// print just the plain score to std::out
-		logger->printSingle(score);
+		logger->printSingle(score, comparisonScores);
 
 	} else {
 
 		// Print full score with optional headers
-		logger->printScore(name, fingerPosition, score, warning,
-		    imageProps.quantized, imageProps.resampled,
-		    NFIQ2::QualityFeatures::getQualityFeatureValues(modules),
+		logger->printScore(name, fingerPosition, score,
+		    comparisonScores, warning, imageProps.quantized,
+		    imageProps.resampled, features,
 		    NFIQ2::QualityFeatures::getQualityModuleSpeeds(modules),
-		    NFIQ2::QualityFeatures::getActionableQualityFeedback(
-			modules));
+		    actionable);
 	}
 }
 
@@ -412,6 +604,70 @@ void
 NFIQ2UI::parseDirectory(const std::string &dirname, const Flags &flags,
     const NFIQ2::Algorithm &model, std::shared_ptr<NFIQ2UI::Log> logger)
 {
+	if (flags.numthreads != 1) {
+		// Multi Threaded:
+
+		NFIQ2UI::DirectoryWalk walk(
+		    flags.numthreads * NFIQ2UI::DirectoryQueueDepth);
+		walk.directories.push_back(NFIQ2UI::removeSlash(dirname));
+		walk.outstanding = 1;
+
+		SafeQueue<std::string> printQueue;
+		printQueue.setNumThreads(flags.numthreads);
+
+		// Start scanning threads, which produce image paths as they go
+		const unsigned int scanThreads = flags.recursion ?
+		    std::min(flags.numthreads, NFIQ2UI::DirectoryScanThreads) :
+		    1;
+		std::vector<std::thread> scanners;
+		std::vector<std::thread> threads;
+		try {
+			for (unsigned int i { 0 }; i < scanThreads; ++i) {
+				scanners.emplace_back(std::bind(&directoryScan,
+				    std::ref(walk), flags, logger));
+			}
+
+			// Start consumer threads
+			for (unsigned int i { 0 }; i < flags.numthreads; ++i) {
+				threads.emplace_back(std::bind(
+				    &directoryConsume, std::ref(walk.files),
+				    std::ref(printQueue), flags,
+				    std::cref(model)));
+			}
+		} catch (const std::exception &e) {
+			std::cerr << "Error during thread creation: "
+				  << e.what() << "\n";
+			std::exit(EXIT_FAILURE);
+		}
+
+		// Start printing thread
+		std::thread printThread(threadedPrint, std::ref(printQueue),
+		    logger, flags.checkpointLog);
+
+		// Once every directory is scanned, consumers drain the queue
+		for (auto &i : scanners) {
+			i.join();
+		}
+		walk.files.close();
+
+		// Join consumer threads
+		for (auto &i : threads) {
+			i.join();
+		}
+		printQueue.setNumThreads(0);
+
+		// Join printing thread
+		printThread.join();
+
+		// RecordStores are already processed by multiple threads, so
+		// nested ones are scored one at a time after the walk
+		for (const auto &i : walk.recordStores) {
+			NFIQ2UI::executeRecordStore(i, flags, model, logger);
+		}
+
+		return;
+	}
+
 	// Uses dirent to iterate through a directory
 	DIR *dr;
 	struct dirent *en;
@@ -483,19 +739,111 @@ NFIQ2UI::parseDirectory(const std::string &dirname, const Flags &flags,
 }
 
 void
-NFIQ2UI::batchConsume(NFIQ2UI::SafeSplitPathsQueue &splitQueue,
+NFIQ2UI::directoryScan(NFIQ2UI::DirectoryWalk &walk, const Flags &flags,
+    std::shared_ptr<NFIQ2UI::Log> logger)
+{
+	for (;;) {
+		// Take the next directory, or stop once none are left to scan
+		std::string dirname {};
+		{
+			std::unique_lock<std::mutex> ulock(walk.mutex);
+			walk.changed.wait(ulock, [&walk] {
+				return (!walk.directories.empty() ||
+				    walk.outstanding == 0);
+			});
+			if (walk.directories.empty()) {
+				break;
+			}
+			dirname = walk.directories.front();
+			walk.directories.pop_front();
+		}
+
+		DIR *dr = opendir(dirname.c_str());
+		if (dr != nullptr) {
+			struct dirent *en;
+			while ((en = readdir(dr)) != nullptr) {
+				const std::string name { en->d_name };
+				if (name == "." || name == "..") {
+					continue;
+				}
+
+				const std::string path = dirname + "/" + name;
+				if (!BE::IO::Utility::pathIsDirectory(path)) {
+					// Blocks while enough paths are queued
+					walk.files.push(path);
+				} else if (flags.recursion) {
+					logger->debugMsg(
+					    "Queueing inner directory: " + path);
+
+					std::lock_guard<std::mutex> lock(
+					    walk.mutex);
+					if (NFIQ2UI::isRecordStore(path)) {
+						walk.recordStores.push_back(
+						    path);
+					} else {
+						walk.directories.push_back(
+						    path);
+						++walk.outstanding;
+						walk.changed.notify_one();
+					}
+				}
+			}
+			closedir(dr);
+		}
+
+		std::lock_guard<std::mutex> lock(walk.mutex);
+		if (--walk.outstanding == 0) {
+			walk.changed.notify_all();
+		}
+	}
+}
+
+void
+NFIQ2UI::directoryConsume(NFIQ2UI::BoundedQueue<std::string> &files,
     SafeQueue<std::string> &printQueue, const Flags &flags,
     const NFIQ2::Algorithm &model)
 {
 	std::shared_ptr<NFIQ2UI::ThreadedLog> threadedlogger =
 	    std::make_shared<NFIQ2UI::ThreadedLog>(flags);
 
+	std::string path {};
+	while (files.pop(path)) {
+		const auto images = NFIQ2UI::getImages(path, threadedlogger);
+
+		for (const auto &image : images) {
+			NFIQ2UI::executeSingle(
+			    image, flags, model, threadedlogger, false, false);
+		}
+
+		// Push these scores, or errors reading the file, to another
+		// queue that will get processed by the printing thread
+		const std::string scores =
+		    threadedlogger->getAndClearLastScore();
+		if (!scores.empty()) {
+			printQueue.push(scores);
+		}
+	}
+}
+
+void
+NFIQ2UI::batchConsume(NFIQ2UI::SafeSplitPathsQueue &splitQueue,
+    SafeQueue<std::string> &printQueue, const Flags &flags,
+    const NFIQ2::Algorithm &model, const std::string &filename)
+{
+	std::shared_ptr<NFIQ2UI::ThreadedLog> threadedlogger =
+	    std::make_shared<NFIQ2UI::ThreadedLog>(flags);
+
 	while (!splitQueue.isEmpty()) {
 		// Pop from the produced queue
 		const auto item = splitQueue.pop();
 
 		// Iterate through the vector and produce a score for each image
 		for (const auto &j : item) {
+			if (flags.checkpointLog != nullptr &&
+			    flags.checkpointLog->isComplete(filename, j)) {
+				continue;
+			}
+
 			const auto images = NFIQ2UI::getImages(
 			    j, threadedlogger);
 
@@ -507,6 +855,11 @@ NFIQ2UI::batchConsume(NFIQ2UI::SafeSplitPathsQueue &splitQueue,
 				printQueue.push(
 				    threadedlogger->getAndClearLastScore());
 			}
+
+			// The printing thread flushes the checkpoint log
+			if (flags.checkpointLog != nullptr) {
+				flags.checkpointLog->markComplete(filename, j);
+			}
 		}
 	}
 }
@@ -524,12 +877,20 @@ NFIQ2UI::executeBatch(const std::string &filename, const Flags &flags,
 		// Single Threaded:
 
 		for (const auto &i : content) {
+			if (flags.checkpointLog != nullptr &&
+			    flags.checkpointLog->isComplete(filename, i)) {
+				logger->debugMsg("Skipping completed path: " + i);
+				continue;
+			}
+
 			const auto images = NFIQ2UI::getImages(i, logger);
 
 			for (const auto &image : images) {
 				executeSingle(
 				    image, flags, model, logger, false, false);
 			}
+
+			NFIQ2UI::markComplete(flags, logger, filename, i);
 		}
 
 	} else {
@@ -558,7 +919,7 @@ NFIQ2UI::executeBatch(const std::string &filename, const Flags &flags,
 			try {
 				threads.emplace_back(std::bind(&batchConsume,
 				    std::ref(splitQueue), std::ref(printQueue),
-				    flags, std::cref(model)));
+				    flags, std::cref(model), filename));
 			} catch (const std::exception &e) {
 				std::cerr << "Error during thread creation: "
 					  << e.what() << "\n";
@@ -567,8 +928,8 @@ NFIQ2UI::executeBatch(const std::string &filename, const Flags &flags,
 		}
 
 		// Start printing thread
-		std::thread printThread(
-		    threadedPrint, std::ref(printQueue), logger);
+		std::thread printThread(threadedPrint, std::ref(printQueue),
+		    logger, flags.checkpointLog);
 
 		// Join consumer threads
 		for (auto &i : threads) {
@@ -587,47 +948,57 @@ NFIQ2UI::executeBatch(const std::string &filename, const Flags &flags,
 		// Join printing thread
 		printThread.join();
 	}
+
+	if (flags.checkpointLog != nullptr) {
+		logger->flush();
+		flags.checkpointLog->flush();
+	}
 }
 
 void
-NFIQ2UI::recordStoreConsume(const std::string &name,
-    NFIQ2UI::SafeSplitPathsQueue &splitQueue,
+NFIQ2UI::recordStoreConsume(BE::IO::RecordStorePrefetcher &records,
     SafeQueue<std::string> &printQueue, const Flags &flags,
-    const NFIQ2::Algorithm &model)
+    const NFIQ2::Algorithm &model, const std::string &filename)
 {
-	std::shared_ptr<BE::IO::RecordStore> rs {};
-
 	std::shared_ptr<NFIQ2UI::ThreadedLog> threadedlogger =
 	    std::make_shared<NFIQ2UI::ThreadedLog>(flags);
 
-	threadedlogger->debugMsg("Attempting to parse RecordStore.");
-	try {
-		rs = BE::IO::RecordStore::openRecordStore(name);
-	} catch (const BE::Error::Exception &e) {
-		std::string error { "Error: Could not open RecordStore" };
-		threadedlogger->printError(
-		    name, 0, error.append(e.what()), false, false);
-		return;
-	}
+	for (;;) {
+		// Pop the next prefetched record
+		BE::IO::RecordStore::Record rec {};
+		try {
+			rec = records.sequence();
+		} catch (const BE::Error::ObjectDoesNotExist &) {
+			break;
+		} catch (const BE::Error::Exception &e) {
+			std::string error { "Error: Could not read record: " };
+			threadedlogger->printError(
+			    "NA", 0, error.append(e.what()), false, false);
+			printQueue.push(threadedlogger->getAndClearLastScore());
+			continue;
+		}
 
-	while (!splitQueue.isEmpty()) {
-		// Pop from the produced queue
-		const auto item = splitQueue.pop();
+		// Completed out of sequence order by a previous run
+		if (flags.checkpointLog != nullptr &&
+		    flags.checkpointLog->isComplete(filename, rec.key)) {
+			continue;
+		}
 
-		// Iterate through the vector and produce a score for each image
-		for (const auto &j : item) {
-			const auto data = rs->read(j);
-			const auto images = NFIQ2UI::getImages(
-			    data, j, threadedlogger);
+		// Produce a score for each image in the record
+		const auto images = NFIQ2UI::getImages(
+		    rec.data, rec.key, threadedlogger);
 
-			for (const auto &image : images) {
-				NFIQ2UI::executeSingle(image, flags, model,
-				    threadedlogger, false, false);
-				// Push these scores to another queue that will
-				// get processed by the printing thread
-				printQueue.push(
-				    threadedlogger->getAndClearLastScore());
-			}
+		for (const auto &image : images) {
+			NFIQ2UI::executeSingle(
+			    image, flags, model, threadedlogger, false, false);
+			// Push these scores to another queue that will
+			// get processed by the printing thread
+			printQueue.push(threadedlogger->getAndClearLastScore());
+		}
+
+		// The printing thread flushes the checkpoint log
+		if (flags.checkpointLog != nullptr) {
+			flags.checkpointLog->markComplete(filename, rec.key);
 		}
 	}
 }
@@ -648,13 +1019,73 @@ NFIQ2UI::executeRecordStore(const std::string &filename, const Flags &flags,
 		return;
 	}
 
+	// When resuming, move the sequence cursor past the records completed
+	// by a previous run, without reading them
+	int cursor { BE::IO::RecordStore::BE_RECSTORE_SEQ_START };
+	if (flags.checkpointLog != nullptr &&
+	    flags.checkpointLog->hasCompleted(filename)) {
+		try {
+			std::string key {};
+			do {
+				key = rs->sequenceKey(cursor);
+				cursor = BE::IO::RecordStore::BE_RECSTORE_SEQ_NEXT;
+			} while (flags.checkpointLog->isComplete(filename, key));
+
+			rs->setCursorAtKey(key);
+			logger->debugMsg("Resuming RecordStore at: " + key);
+		} catch (const BE::Error::ObjectDoesNotExist &) {
+			logger->debugMsg("All records complete in: " + filename);
+			return;
+		} catch (const BE::Error::Exception &e) {
+			std::string error { "Error: Could not resume RecordStore" };
+			logger->printError(
+			    filename, 0, error.append(e.what()), false, false);
+			return;
+		}
+	}
+
+	// Records are read ahead asynchronously, in sequence order, so that
+	// scoring does not wait on storage
+	std::unique_ptr<BE::IO::RecordStorePrefetcher> records {};
+	try {
+		records.reset(new BE::IO::RecordStorePrefetcher(rs,
+		    BE::IO::RecordStorePrefetcher::DefaultWindow,
+		    BE::IO::RecordStorePrefetcher::DefaultIOThreads, cursor));
+	} catch (const BE::Error::Exception &e) {
+		std::string error { "Error: Could not prefetch RecordStore" };
+		logger->printError(
+		    filename, 0, error.append(e.what()), false, false);
+		return;
+	}
+
 	// Single Threaded
 
 	if (flags.numthreads == 1) {
 		logger->debugMsg(
 		    "Successfully parsed RecordStore: " + filename);
 
-		for (const auto &rec : (*rs)) {
+		for (;;) {
+			BE::IO::RecordStore::Record rec {};
+			try {
+				rec = records->sequence();
+			} catch (const BE::Error::ObjectDoesNotExist &) {
+				break;
+			} catch (const BE::Error::Exception &e) {
+				std::string error {
+					"Error: Could not read record: "
+				};
+				logger->printError(filename, 0,
+				    error.append(e.what()), false, false);
+				continue;
+			}
+
+			if (flags.checkpointLog != nullptr &&
+			    flags.checkpointLog->isComplete(filename, rec.key)) {
+				logger->debugMsg(
+				    "Skipping completed record: " + rec.key);
+				continue;
+			}
+
 			logger->debugMsg(
 			    "Getting Images from record: " + rec.key);
 
@@ -669,6 +1100,8 @@ NFIQ2UI::executeRecordStore(const std::string &filename, const Flags &flags,
 				NFIQ2UI::executeSingle(
 				    image, flags, model, logger, false, false);
 			}
+
+			NFIQ2UI::markComplete(flags, logger, filename, rec.key);
 		}
 	} else {
 		// Multi threaded
@@ -678,8 +1111,6 @@ NFIQ2UI::executeRecordStore(const std::string &filename, const Flags &flags,
 		// This value needs to be the total images for each record
 		const unsigned int count = rs->getCount();
 
-		NFIQ2UI::SafeSplitPathsQueue splitQueue(rs, splittingFactor);
-
 		// Can call threaded to print out scores
 
 		SafeQueue<std::string> printQueue;
@@ -696,10 +1127,10 @@ NFIQ2UI::executeRecordStore(const std::string &filename, const Flags &flags,
 		std::vector<std::thread> threads;
 		for (unsigned int i { 0 }; i < upperThreadBound; ++i) {
 			try {
-				threads.emplace_back(std::bind(
-				    &recordStoreConsume, filename,
-				    std::ref(splitQueue), std::ref(printQueue),
-				    flags, std::cref(model)));
+				threads.emplace_back(
+				    std::bind(&recordStoreConsume,
+					std::ref(*records), std::ref(printQueue),
+					flags, std::cref(model), filename));
 			} catch (const std::exception &e) {
 				std::cerr << "Error during thread creation: "
 					  << e.what() << "\n";
@@ -708,8 +1139,8 @@ NFIQ2UI::executeRecordStore(const std::string &filename, const Flags &flags,
 		}
 
 		// Start printing thread
-		std::thread printThread(
-		    threadedPrint, std::ref(printQueue), logger);
+		std::thread printThread(threadedPrint, std::ref(printQueue),
+		    logger, flags.checkpointLog);
 
 		// Join consumer threads
 		for (auto &i : threads) {
@@ -726,17 +1157,56 @@ NFIQ2UI::executeRecordStore(const std::string &filename, const Flags &flags,
 		// Join printing thread
 		printThread.join();
 	}
+
+	if (flags.checkpointLog != nullptr) {
+		logger->flush();
+		flags.checkpointLog->flush();
+	}
+}
+
+void
+NFIQ2UI::markComplete(const Flags &flags, std::shared_ptr<NFIQ2UI::Log> logger,
+    const std::string &source, const std::string &item)
+{
+	if (flags.checkpointLog == nullptr) {
+		return;
+	}
+
+	flags.checkpointLog->markComplete(source, item);
+	if (flags.checkpointLog->flushDue()) {
+		// Scores must reach the output before the log claims them
+		logger->flush();
+		flags.checkpointLog->flush();
+	}
 }
 
 void
-NFIQ2UI::threadedPrint(
-    SafeQueue<std::string> &printQueue, std::shared_ptr<NFIQ2UI::Log> logger)
+NFIQ2UI::threadedPrint(SafeQueue<std::string> &printQueue,
+    std::shared_ptr<NFIQ2UI::Log> logger,
+    std::shared_ptr<NFIQ2UI::Checkpoint> checkpoint)
 {
 	while (printQueue.getNumThreads() != 0) {
 		if (!printQueue.isEmpty()) {
 			const auto item = printQueue.pop();
 			logger->printThreaded(item);
 		}
+
+		if (checkpoint != nullptr && checkpoint->flushDue()) {
+			// Items are marked complete after their scores are
+			// queued, so once the queue has been drained, every
+			// taken item's score has been printed
+			const auto entries = checkpoint->takePending();
+			while (!printQueue.isEmpty()) {
+				logger->printThreaded(printQueue.pop());
+			}
+			logger->flush();
+			checkpoint->commit(entries);
+		}
+	}
+
+	// Print scores queued after the last check
+	while (!printQueue.isEmpty()) {
+		logger->printThreaded(printQueue.pop());
 	}
 }
 
@@ -753,7 +1223,7 @@ NFIQ2UI::processArguments(int argc, char **argv)
 
 	std::string output {};
 
-	static const char options[] { "i:f:o:j:vqdFrm:a" };
+	static const char options[] { "i:f:o:j:vqdFrm:ac:k:Rt:T:S:WD:" };
 	int c {};
 
 	auto vecPush = [&](const std::string &m) {
@@ -796,11 +1266,46 @@ NFIQ2UI::processArguments(int argc, char **argv)
 			flags.recursion = true;
 			break;
 		case 'm':
-			flags.model = optarg;
+			// Models after the first are compared against it
+			if (flags.model.empty()) {
+				flags.model = optarg;
+			} else {
+				flags.comparisonModels.push_back(optarg);
+			}
 			break;
 		case 'a':
 			flags.actionable = true;
 			break;
+		case 'c':
+			flags.cache = optarg;
+			break;
+		case 'k':
+			flags.checkpoint = optarg;
+			break;
+		case 'R':
+			flags.resume = true;
+			break;
+		case 't':
+			flags.trace = optarg;
+			break;
+		case 'T':
+			try {
+				flags.timeout = NFIQ2UI::parseUnsigned(optarg);
+			} catch (const std::exception &) {
+				throw NFIQ2UI::InvalidArgumentError(
+				    "Timeout must be a number of "
+				    "milliseconds.");
+			}
+			break;
+		case 'S':
+			flags.daemon = optarg;
+			break;
+		case 'W':
+			flags.reducedDecode = true;
+			break;
+		case 'D':
+			flags.drift = optarg;
+			break;
 		case '?':
 			NFIQ2UI::printUsage();
 			throw NFIQ2UI::UndefinedFlagError(
@@ -811,12 +1316,43 @@ NFIQ2UI::processArguments(int argc, char **argv)
 		vecPush(argv[i]);
 	}
 
-	if (flags.numthreads != 1 &&
-	    (vecBatch.empty() && vecRecordStore.empty())) {
+	if (flags.numthreads != 1 && flags.daemon.empty() &&
+	    (vecBatch.empty() && vecRecordStore.empty() && vecDirs.empty())) {
 		throw NFIQ2UI::InvalidArgumentError(
 		    "User cannot use threading flag for single-threaded operations. "
 		    "\nBatch "
-		    "files and recordstores are the only multi-threaded operations.");
+		    "files, directories, and recordstores are the only "
+		    "multi-threaded operations.");
+	}
+
+	if (!flags.daemon.empty() &&
+	    (!vecSingle.empty() || !vecDirs.empty() || !vecBatch.empty() ||
+		!vecRecordStore.empty() || !flags.checkpoint.empty())) {
+		throw NFIQ2UI::InvalidArgumentError(
+		    "User cannot provide images or a checkpoint log to the "
+		    "daemon. Images are sent over its socket.");
+	}
+
+	if (!flags.daemon.empty() && !flags.comparisonModels.empty()) {
+		throw NFIQ2UI::InvalidArgumentError(
+		    "User cannot compare models with the daemon.");
+	}
+
+	if (flags.resume && flags.checkpoint.empty()) {
+		throw NFIQ2UI::InvalidArgumentError(
+		    "User cannot resume without a checkpoint log.");
+	}
+
+	if (!flags.drift.empty() && !flags.reducedDecode) {
+		throw NFIQ2UI::InvalidArgumentError(
+		    "User cannot report drift without reduced-resolution "
+		    "decoding.");
+	}
+
+	if (!flags.trace.empty() && !NFIQ2::Trace::isEnabled()) {
+		throw NFIQ2UI::InvalidArgumentError(
+		    "User cannot trace when NFIQ 2 is built without "
+		    "NFIQ2_TRACING.");
 	}
 
 	NFIQ2UI::Arguments arguments = { flags, argv[0], output, vecSingle,
@@ -857,6 +1393,13 @@ void
 NFIQ2UI::printHeader(
     NFIQ2UI::Arguments arguments, std::shared_ptr<NFIQ2UI::Log> logger)
 {
+	// A resumed run appends to the header already in the output file
+	if (arguments.flags.resume && !arguments.output.empty() &&
+	    BE::IO::Utility::fileExists(arguments.output) &&
+	    BE::IO::Utility::getFileSize(arguments.output) > 0) {
+		return;
+	}
+
 	if ((arguments.vecSingle.size() == 1 &&
 		(arguments.flags.verbose || arguments.flags.speed ||
 		    arguments.flags.actionable)) ||
@@ -908,6 +1451,12 @@ NFIQ2UI::parseModelInfo(const NFIQ2UI::Arguments &arguments)
 		modelInfoFilePath = arguments.flags.model;
 	}
 
+	return NFIQ2UI::parseModelInfo(modelInfoFilePath);
+}
+
+NFIQ2::ModelInfo
+NFIQ2UI::parseModelInfo(const std::string &modelInfoFilePath)
+{
 	NFIQ2::ModelInfo modelInfoObj {};
 	try {
 		modelInfoObj = NFIQ2::ModelInfo(modelInfoFilePath);
@@ -926,126 +1475,3 @@ NFIQ2UI::parseModelInfo(const NFIQ2UI::Arguments &arguments)
 
 	return modelInfoObj;
 }
-
-int
-main(int argc, char **argv)
-{
-	if (argc < 2) {
-		NFIQ2UI::printUsage();
-		return EXIT_SUCCESS;
-	}
-
-	NFIQ2UI::Arguments arguments {};
-	try {
-		arguments = NFIQ2UI::processArguments(argc, argv);
-	} catch (const NFIQ2UI::UndefinedFlagError &e) {
-		std::cerr << e.what() << "\n";
-		NFIQ2UI::printUndefinedFlag();
-		return EXIT_FAILURE;
-	} catch (const NFIQ2UI::InvalidArgumentError &e) {
-		std::cerr << e.what() << "\n";
-		return EXIT_FAILURE;
-	}
-
-	std::shared_ptr<NFIQ2UI::Log> logger {};
-	try {
-		logger = std::make_shared<NFIQ2UI::Log>(
-		    arguments.flags, arguments.output);
-	} catch (const NFIQ2UI::FileOpenError &e) {
-		std::cerr << "Error: Could not create logger object. "
-			  << e.what() << "\n";
-		return EXIT_FAILURE;
-	}
-
-	// Initialize Model
-	NFIQ2::Timer timerInit;
-	double timeInit = 0.0;
-	timerInit.start();
-
-	NFIQ2::ModelInfo modelInfoObj {};
-
-	try {
-		modelInfoObj = NFIQ2::ModelInfo(
-		    NFIQ2UI::parseModelInfo(arguments));
-
-	} catch (const NFIQ2UI::Exception &e) {
-		std::cerr << "Unable to extract model information. " << e.what()
-			  << "\n";
-		return EXIT_FAILURE;
-	}
-
-	logger->debugMsg("Model Name: " +
-	    (modelInfoObj.getModelName().empty() ?
-			  "<NA>" :
-			  modelInfoObj.getModelName()));
-	logger->debugMsg("Model Trainer: " +
-	    (modelInfoObj.getModelTrainer().empty() ?
-			  "<NA>" :
-			  modelInfoObj.getModelTrainer()));
-	logger->debugMsg("Model Description: " +
-	    (modelInfoObj.getModelDescription().empty() ?
-			  "<NA>" :
-			  modelInfoObj.getModelDescription()));
-	logger->debugMsg("Model Version: " +
-	    (modelInfoObj.getModelVersion().empty() ?
-			  "<NA>" :
-			  modelInfoObj.getModelVersion()));
-	logger->debugMsg("Model Path: " + modelInfoObj.getModelPath());
-	logger->debugMsg("Model Hash: " + modelInfoObj.getModelHash());
-
-	std::shared_ptr<NFIQ2::Algorithm> model {};
-	try {
-		model = std::make_shared<NFIQ2::Algorithm>(modelInfoObj);
-	} catch (const NFIQ2::Exception &e) {
-		std::cerr << "Model could not be constructed. " << e.what()
-			  << "\n";
-		return EXIT_FAILURE;
-	}
-
-	timeInit = timerInit.stop();
-
-	std::stringstream loggerStream;
-	loggerStream << "Model Initialization: " << std::setprecision(3)
-		     << std::fixed << timeInit << " ms";
-
-	logger->debugMsg(loggerStream.str());
-	loggerStream.str("");
-	loggerStream.clear();
-
-	// Printing values of flags
-	logger->debugMsg("Value of verbose flag: " +
-	    std::to_string(arguments.flags.verbose));
-	logger->debugMsg(
-	    "Value of debug flag: " + std::to_string(arguments.flags.debug));
-	logger->debugMsg(
-	    "Value of speed flag: " + std::to_string(arguments.flags.speed));
-	logger->debugMsg(
-	    "Value of force flag: " + std::to_string(arguments.flags.force));
-	logger->debugMsg("Value of model flag: " + arguments.flags.model);
-	logger->debugMsg("Value of recursive flag: " +
-	    std::to_string(arguments.flags.recursion));
-
-	// Prints Header
-	NFIQ2UI::printHeader(arguments, logger);
-
-	// Process single images - includes AN2K files
-	logger->debugMsg("Processing Singles and AN2K files:");
-	NFIQ2UI::procSingle(arguments, *model, logger);
-
-	logger->debugMsg("Processing Directories:");
-	for (const auto &i : arguments.vecDirs) {
-		NFIQ2UI::parseDirectory(i, arguments.flags, *model, logger);
-	}
-
-	logger->debugMsg("Processing Batch-files:");
-	for (const auto &i : arguments.vecBatch) {
-		NFIQ2UI::executeBatch(i, arguments.flags, *model, logger);
-	}
-
-	logger->debugMsg("Processing RecordStores:");
-	for (const auto &i : arguments.vecRecordStore) {
-		NFIQ2UI::executeRecordStore(i, arguments.flags, *model, logger);
-	}
-
-	return EXIT_SUCCESS;
-}
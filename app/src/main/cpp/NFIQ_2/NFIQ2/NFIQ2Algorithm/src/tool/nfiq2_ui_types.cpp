@@ -8,7 +8,6 @@
  * about its quality, reliability, or any other characteristic.
  ******************************************************************************/
 
-#include <be_io_recordstore.h>
 #include <tool/nfiq2_ui_types.h>
 
 #include <string>
@@ -39,28 +38,3 @@ NFIQ2UI::SafeSplitPathsQueue::SafeSplitPathsQueue(
 		pushUnsafe(split);
 	}
 }
-
-// Constructor for executeRecordStore splitQueue
-NFIQ2UI::SafeSplitPathsQueue::SafeSplitPathsQueue(
-    std::shared_ptr<BE::IO::RecordStore> rs,
-    const std::vector<std::string>::size_type splittingFactor)
-    : NFIQ2UI::SafeQueue<std::vector<std::string>>()
-{
-	std::vector<std::string> content;
-
-	for (auto i = rs->begin(); i != rs->end(); i++) {
-		content.push_back(i->key);
-	}
-
-	while (!content.empty()) {
-		std::vector<std::string> split;
-
-		for (std::vector<std::string>::size_type i { 0 };
-		     i < std::min(splittingFactor, content.size()); ++i) {
-			split.emplace_back(content.back());
-			content.pop_back();
-		}
-
-		pushUnsafe(split);
-	}
-}
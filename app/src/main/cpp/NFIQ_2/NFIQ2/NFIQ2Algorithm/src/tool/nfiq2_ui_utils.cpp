@@ -17,7 +17,9 @@
 
 #include <array>
 #include <iostream>
+#include <limits>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -181,6 +183,22 @@ NFIQ2UI::yesOrNo(const std::string &prompt, bool default_answer,
 	}
 }
 
+unsigned int
+NFIQ2UI::parseUnsigned(const std::string &arg)
+{
+	// std::stoul() skips whitespace and negates values after a '-'
+	const size_t start = arg.find_first_not_of(" \t\n\v\f\r");
+	if (start != std::string::npos && arg[start] == '-') {
+		throw std::invalid_argument("Negative number: " + arg);
+	}
+
+	const unsigned long value = std::stoul(arg);
+	if (value > std::numeric_limits<unsigned int>::max()) {
+		throw std::out_of_range("Number too large: " + arg);
+	}
+	return static_cast<unsigned int>(value);
+}
+
 // Checks the threads given and prompts user if the requested amount is higher
 // than CPU cores/threads
 unsigned int
@@ -190,7 +208,7 @@ NFIQ2UI::checkThreads(const std::string &threadArg)
 	unsigned int input = 1;
 
 	try {
-		input = static_cast<unsigned int>(std::stoul(threadArg));
+		input = NFIQ2UI::parseUnsigned(threadArg);
 	} catch (const std::invalid_argument &e) {
 		std::cerr << e.what() << "\n";
 		std::cerr << "Number not given to threading flag. Single "
@@ -292,10 +310,34 @@ NFIQ2UI::printUsage()
 		  << "\n";
 	std::cout << "-o [file path]: Saving all output to a specified file"
 		  << "\n";
-	std::cout << "-j [# of threads]: Enables Multi-Threading for Batch and "
-		     "RecordStore processes"
+	std::cout << "-j [# of threads]: Enables Multi-Threading for Batch, "
+		     "Directory, and RecordStore processes"
+		  << "\n";
+	std::cout << "-m [model info file]: Path to alternate model info file. "
+		     "Repeat to compare models"
+		  << "\n";
+	std::cout << "-c [cache path]: Reuses scores stored in a RecordStore "
+		     "score cache"
+		  << "\n";
+	std::cout << "-k [checkpoint path]: Records completed Batch and "
+		     "RecordStore work in a checkpoint log"
+		  << "\n";
+	std::cout << "-R: Resumes from the checkpoint log, skipping completed work"
+		  << "\n";
+	std::cout << "-t [trace path]: Writes timing spans as Chrome trace JSON "
+		     "(requires NFIQ2_TRACING)"
+		  << "\n";
+	std::cout << "-T [milliseconds]: Reports an error for images that take "
+		     "longer than this to score"
+		  << "\n";
+	std::cout << "-S [socket path]: Scores images sent to a UNIX domain "
+		     "socket until interrupted"
+		  << "\n";
+	std::cout << "-W: Decodes 1000 PPI WSQ and JPEG 2000 images directly "
+		     "at 500 PPI"
 		  << "\n";
-	std::cout << "-m [model info file]: Path to alternate model info file "
+	std::cout << "-D [drift path]: Compares -W scores against scores from "
+		     "resampling"
 		  << "\n";
 	std::cout
 	    << "-a: Displays actionable quality scores about each processed image\n";
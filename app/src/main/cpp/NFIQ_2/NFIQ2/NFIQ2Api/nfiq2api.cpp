@@ -1,14 +1,22 @@
 #include <nfiq2_algorithm.hpp>
+#include <nfiq2_cancellation.hpp>
 #include <nfiq2_exception.hpp>
+#include <nfiq2_qualityfeatures.hpp>
 #include <opencv2/core/core_c.h>
 #include <opencv2/core/version.hpp>
 
 #include "nfiq2api.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <new>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #ifndef _WIN32
 #include <dlfcn.h>
@@ -23,6 +31,19 @@ extern int version_patch;
 
 // static object to load the algorithm only once (random forest init!)
 std::unique_ptr<NFIQ2::Algorithm> g_nfiq2;
+// protects g_nfiq2, which InitNfiq2 may set while others are scoring
+std::mutex g_nfiq2Mutex;
+
+struct Nfiq2Model {
+	NFIQ2::Algorithm algorithm;
+	std::string hash;
+};
+
+struct Nfiq2Context {
+	const Nfiq2Model *model;
+	unsigned int timeout;
+	std::string lastError;
+};
 
 std::string
 GetYamlFilePath()
@@ -84,6 +105,7 @@ DLLEXPORT const char *STDCALL
 InitNfiq2(char **hash)
 {
 	try {
+		std::lock_guard<std::mutex> lock(g_nfiq2Mutex);
 		if (g_nfiq2.get() == nullptr) {
 #ifdef NFIQ2_EMBED_RANDOM_FOREST_PARAMETERS
 			g_nfiq2 = std::unique_ptr<NFIQ2::Algorithm>(
@@ -109,11 +131,23 @@ ComputeNfiq2Score(int fpos, const unsigned char *pixels, int size, int width,
     int height, int ppi)
 {
 	try {
-		if (g_nfiq2.get() != nullptr) {
-			NFIQ2::FingerprintImageData rawImage(
-			    pixels, size, width, height, fpos, ppi);
-			int qualityScore = (int)g_nfiq2->computeQualityScore(
-			    rawImage);
+		NFIQ2::Algorithm *nfiq2 {};
+		{
+			std::lock_guard<std::mutex> lock(g_nfiq2Mutex);
+			nfiq2 = g_nfiq2.get();
+		}
+		if (nfiq2 != nullptr) {
+			if (pixels == nullptr || width <= 0 || height <= 0 ||
+			    size < width * height) {
+				throw NFIQ2::Exception(
+				    NFIQ2::ErrorCode::BadArguments,
+				    "Pixel buffer is smaller than width * "
+				    "height");
+			}
+			// Pixels are read in place rather than copied
+			int qualityScore = (int)nfiq2->computeQualityScore(
+			    NFIQ2::QualityFeatures::computeQualityModules(
+				pixels, width, height, fpos, ppi, {}));
 			return qualityScore;
 		}
 	} catch (const NFIQ2::Exception &exc) {
@@ -129,4 +163,225 @@ ComputeNfiq2Score(int fpos, const unsigned char *pixels, int size, int width,
 	}
 	return -2; // not initialized
 }
+
+/*
+ * Handle-based API
+ */
+
+static const std::vector<std::string> &
+getFeatureIDs()
+{
+	static const std::vector<std::string> featureIDs =
+	    NFIQ2::QualityFeatures::getQualityFeatureIDs();
+	return featureIDs;
+}
+
+static Nfiq2Status
+toStatus(const NFIQ2::Exception &e)
+{
+	switch (e.getErrorCode()) {
+	case NFIQ2::ErrorCode::Timeout:
+		return NFIQ2_STATUS_TIMEOUT;
+	case NFIQ2::ErrorCode::BadArguments:
+		return NFIQ2_STATUS_BAD_ARGUMENT;
+	case NFIQ2::ErrorCode::MachineLearningError:
+		return NFIQ2_STATUS_MODEL_ERROR;
+	case NFIQ2::ErrorCode::UnknownError:
+		return NFIQ2_STATUS_UNKNOWN_ERROR;
+	default:
+		return NFIQ2_STATUS_IMAGE_ERROR;
+	}
+}
+
+static Nfiq2Status
+computeScore(Nfiq2Context *context, const Nfiq2Image *image,
+    unsigned int *score, double *features)
+{
+	if (image == nullptr || image->pixels == nullptr ||
+	    image->width == 0 || image->height == 0) {
+		context->lastError = "Image has no pixels";
+		return NFIQ2_STATUS_BAD_ARGUMENT;
+	}
+
+	try {
+		const NFIQ2::CancellationToken cancellation =
+		    (context->timeout == 0) ?
+			NFIQ2::CancellationToken {} :
+			NFIQ2::CancellationToken { std::chrono::milliseconds(
+			    context->timeout) };
+
+		const auto modules =
+		    NFIQ2::QualityFeatures::computeQualityModules(image->pixels,
+			image->width, image->height, image->fingerPosition,
+			image->ppi, cancellation);
+		const std::unordered_map<std::string, double> values =
+		    NFIQ2::QualityFeatures::getQualityFeatureValues(modules);
+
+		*score = context->model->algorithm.computeQualityScore(values);
+
+		if (features != nullptr) {
+			const auto &featureIDs = getFeatureIDs();
+			for (size_t i = 0; i < featureIDs.size(); i++) {
+				const auto value = values.find(featureIDs[i]);
+				features[i] = (value == values.cend()) ?
+				    0 :
+				    value->second;
+			}
+		}
+	} catch (const NFIQ2::Exception &e) {
+		context->lastError = e.getErrorMessage();
+		return toStatus(e);
+	} catch (const std::bad_alloc &) {
+		context->lastError = "Out of memory";
+		return NFIQ2_STATUS_NO_MEMORY;
+	} catch (const std::exception &e) {
+		context->lastError = e.what();
+		return NFIQ2_STATUS_UNKNOWN_ERROR;
+	}
+
+	return NFIQ2_STATUS_OK;
+}
+
+DLLEXPORT Nfiq2Status STDCALL
+Nfiq2OpenModel(const char *path, const char *hash, Nfiq2Model **model)
+{
+	if (model == nullptr || (path != nullptr && hash == nullptr))
+		return NFIQ2_STATUS_BAD_ARGUMENT;
+	*model = nullptr;
+
+	try {
+		std::unique_ptr<Nfiq2Model> m {};
+		if (path != nullptr) {
+			m.reset(new Nfiq2Model { NFIQ2::Algorithm(path, hash),
+			    "" });
+		} else {
+#ifdef NFIQ2_EMBED_RANDOM_FOREST_PARAMETERS
+			m.reset(new Nfiq2Model { NFIQ2::Algorithm(), "" });
+#else
+			m.reset(new Nfiq2Model { NFIQ2::Algorithm(
+						     GetYamlFilePath(),
+						     "ccd75820b48c19f1645ef5e9c"
+						     "481c592"),
+			    "" });
+#endif
+		}
+		m->hash = m->algorithm.getParameterHash();
+		*model = m.release();
+	} catch (const std::bad_alloc &) {
+		return NFIQ2_STATUS_NO_MEMORY;
+	} catch (const std::exception &) {
+		return NFIQ2_STATUS_MODEL_ERROR;
+	}
+
+	return NFIQ2_STATUS_OK;
+}
+
+DLLEXPORT void STDCALL
+Nfiq2CloseModel(Nfiq2Model *model)
+{
+	delete model;
+}
+
+DLLEXPORT const char *STDCALL
+Nfiq2GetModelHash(const Nfiq2Model *model)
+{
+	if (model == nullptr)
+		return nullptr;
+	return model->hash.c_str();
+}
+
+DLLEXPORT size_t STDCALL
+Nfiq2GetFeatureCount(void)
+{
+	return getFeatureIDs().size();
+}
+
+DLLEXPORT const char *STDCALL
+Nfiq2GetFeatureName(size_t index)
+{
+	const auto &featureIDs = getFeatureIDs();
+	if (index >= featureIDs.size())
+		return nullptr;
+	return featureIDs[index].c_str();
+}
+
+DLLEXPORT Nfiq2Status STDCALL
+Nfiq2CreateContext(const Nfiq2Model *model, Nfiq2Context **context)
+{
+	if (model == nullptr || context == nullptr)
+		return NFIQ2_STATUS_BAD_ARGUMENT;
+
+	*context = new (std::nothrow) Nfiq2Context { model, 0, "" };
+	if (*context == nullptr)
+		return NFIQ2_STATUS_NO_MEMORY;
+
+	return NFIQ2_STATUS_OK;
+}
+
+DLLEXPORT void STDCALL
+Nfiq2DestroyContext(Nfiq2Context *context)
+{
+	delete context;
+}
+
+DLLEXPORT void STDCALL
+Nfiq2SetTimeout(Nfiq2Context *context, unsigned int milliseconds)
+{
+	if (context != nullptr)
+		context->timeout = milliseconds;
+}
+
+DLLEXPORT const char *STDCALL
+Nfiq2GetLastError(const Nfiq2Context *context)
+{
+	if (context == nullptr)
+		return nullptr;
+	return context->lastError.c_str();
+}
+
+DLLEXPORT Nfiq2Status STDCALL
+Nfiq2ComputeScore(Nfiq2Context *context, const Nfiq2Image *image,
+    unsigned int *score, double *features)
+{
+	if (context == nullptr || score == nullptr)
+		return NFIQ2_STATUS_BAD_ARGUMENT;
+
+	return computeScore(context, image, score, features);
+}
+
+DLLEXPORT Nfiq2Status STDCALL
+Nfiq2ComputeScores(Nfiq2Context *context, const Nfiq2Image *images,
+    size_t count, unsigned int *scores, double *features,
+    Nfiq2Status *statuses)
+{
+	if (context == nullptr || (count > 0 && (images == nullptr ||
+						    scores == nullptr)))
+		return NFIQ2_STATUS_BAD_ARGUMENT;
+
+	const size_t featureCount = getFeatureIDs().size();
+	Nfiq2Status firstFailure { NFIQ2_STATUS_OK };
+	std::string firstError {};
+	for (size_t i = 0; i < count; i++) {
+		double *row = (features == nullptr) ?
+		    nullptr :
+		    features + (i * featureCount);
+		const Nfiq2Status status = computeScore(
+		    context, &images[i], &scores[i], row);
+		if (status != NFIQ2_STATUS_OK) {
+			scores[i] = 255;
+			if (row != nullptr)
+				std::fill(row, row + featureCount, 0.0);
+			if (firstFailure == NFIQ2_STATUS_OK) {
+				firstFailure = status;
+				firstError = context->lastError;
+			}
+		}
+		if (statuses != nullptr)
+			statuses[i] = status;
+	}
+
+	if (firstFailure != NFIQ2_STATUS_OK)
+		context->lastError = firstError;
+	return firstFailure;
+}
 }
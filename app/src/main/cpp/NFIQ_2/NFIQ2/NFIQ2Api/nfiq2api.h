@@ -23,6 +23,8 @@
     include nfiq2api.h."
 #endif /* I_UNDERSTAND_THIS_NFIQ2_API_WILL_BE_REMOVED */
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -33,6 +35,99 @@ DLLEXPORT const char *STDCALL InitNfiq2(char **hash);
 DLLEXPORT int STDCALL ComputeNfiq2Score(int fpos, const unsigned char *pixels,
     int size, int width, int height, int ppi);
 
+/*
+ * Handle-based API.
+ *
+ * A model holds loaded random forest parameters and may be shared by any
+ * number of threads. A context holds per-thread scratch state (the last
+ * error message and timeout) and must only be used by one thread at a
+ * time; create one context per thread. Functions never print, and report
+ * failures through their return value and Nfiq2GetLastError().
+ */
+
+/** Loaded random forest parameters */
+typedef struct Nfiq2Model Nfiq2Model;
+/** Per-thread scoring state */
+typedef struct Nfiq2Context Nfiq2Context;
+
+/** Return values of the handle-based API */
+typedef enum Nfiq2Status {
+	NFIQ2_STATUS_OK = 0,
+	/** A required pointer was NULL or a dimension was invalid */
+	NFIQ2_STATUS_BAD_ARGUMENT = 1,
+	/** Random forest parameters could not be loaded */
+	NFIQ2_STATUS_MODEL_ERROR = 2,
+	/** The image could not be scored (e.g., too small once cropped) */
+	NFIQ2_STATUS_IMAGE_ERROR = 3,
+	/** Scoring the image took longer than the context's timeout */
+	NFIQ2_STATUS_TIMEOUT = 4,
+	/** Memory could not be allocated */
+	NFIQ2_STATUS_NO_MEMORY = 5,
+	NFIQ2_STATUS_UNKNOWN_ERROR = 6
+} Nfiq2Status;
+
+/**
+ * An 8 bit-per-pixel grayscale fingerprint image owned by the caller.
+ * Pixels are read in place and only the region remaining after near-white
+ * borders are removed is copied.
+ */
+typedef struct Nfiq2Image {
+	/** width * height pixels, row-major, 0 is black */
+	const unsigned char *pixels;
+	unsigned int width;
+	unsigned int height;
+	/** ISO/IEC 19794-4 finger position */
+	unsigned char fingerPosition;
+	/** Must be 500 to produce a meaningful score */
+	unsigned short ppi;
+} Nfiq2Image;
+
+/**
+ * Load random forest parameters. When path is NULL, the embedded
+ * parameters are used if available, otherwise nist_plain_tir-ink.yaml next
+ * to this library, and hash is ignored.
+ */
+DLLEXPORT Nfiq2Status STDCALL Nfiq2OpenModel(
+    const char *path, const char *hash, Nfiq2Model **model);
+/** Release a model. All contexts created from it must be destroyed first. */
+DLLEXPORT void STDCALL Nfiq2CloseModel(Nfiq2Model *model);
+/** MD5 checksum of the loaded parameters, owned by the model */
+DLLEXPORT const char *STDCALL Nfiq2GetModelHash(const Nfiq2Model *model);
+
+/** Number of quality features written per image by the scoring functions */
+DLLEXPORT size_t STDCALL Nfiq2GetFeatureCount(void);
+/** Identifier of the quality feature at index, or NULL if out of range */
+DLLEXPORT const char *STDCALL Nfiq2GetFeatureName(size_t index);
+
+/** Create scratch state for one thread scoring with model */
+DLLEXPORT Nfiq2Status STDCALL Nfiq2CreateContext(
+    const Nfiq2Model *model, Nfiq2Context **context);
+DLLEXPORT void STDCALL Nfiq2DestroyContext(Nfiq2Context *context);
+/** Give up on images taking longer than milliseconds to score, 0 = never */
+DLLEXPORT void STDCALL Nfiq2SetTimeout(
+    Nfiq2Context *context, unsigned int milliseconds);
+/** Message describing the most recent failure in context, owned by it */
+DLLEXPORT const char *STDCALL Nfiq2GetLastError(const Nfiq2Context *context);
+
+/**
+ * Score one image. features may be NULL, otherwise it receives
+ * Nfiq2GetFeatureCount() values in Nfiq2GetFeatureName() order.
+ */
+DLLEXPORT Nfiq2Status STDCALL Nfiq2ComputeScore(Nfiq2Context *context,
+    const Nfiq2Image *image, unsigned int *score, double *features);
+
+/**
+ * Score count images. scores receives count values, 255 for images that
+ * could not be scored. features may be NULL, otherwise it receives
+ * count * Nfiq2GetFeatureCount() values, one row per image. statuses may
+ * be NULL, otherwise it receives the outcome of each image. Returns
+ * NFIQ2_STATUS_OK if every image was scored, otherwise the status of the
+ * first image that was not, whose message is left in Nfiq2GetLastError().
+ */
+DLLEXPORT Nfiq2Status STDCALL Nfiq2ComputeScores(Nfiq2Context *context,
+    const Nfiq2Image *images, size_t count, unsigned int *scores,
+    double *features, Nfiq2Status *statuses);
+
 #ifdef __cplusplus
 }
 #endif
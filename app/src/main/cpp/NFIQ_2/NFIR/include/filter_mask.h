@@ -55,6 +55,7 @@ private:
 protected:
   double _maskRadiusFactor;
   cv::Mat _theMask;
+  cv::Mat _thePackedMask;
 
   int _srcSampleRate;
   int _tgtSampleRate;
@@ -82,6 +83,14 @@ public:
   virtual FilterShape get_filterShape(void) const;
   virtual void build( cv::Size );
 
+  /**
+  Rearrange the built filter/mask into the Hermitian-packed (CCS) layout of
+  the spectrum produced by a real-input `cv::dft`, so that it can be applied
+  by element-wise multiplication.  The `1/(W x H)` scale of the inverse
+  transform is folded into the packed values.
+  */
+  void pack(void);
+
   void set_srcSampleRate( const int& );
   void set_tgtSampleRate( const int& );
 
@@ -92,6 +101,7 @@ public:
   int get_tgtSampleRate(void) const;
   double get_maskRadiusFactor(void) const;
   cv::Mat get_theMask(void) const;
+  cv::Mat get_packedMask(void) const;
 
   // Implement a clone operator.
   FilterMask Clone(void);
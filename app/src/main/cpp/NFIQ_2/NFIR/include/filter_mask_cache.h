@@ -0,0 +1,108 @@
+/*******************************************************************************
+License:
+This software was developed at the National Institute of Standards and
+Technology (NIST) by employees of the Federal Government in the course
+of their official duties. Pursuant to title 17 Section 105 of the
+United States Code, this software is not subject to copyright protection
+and is in the public domain. NIST assumes no responsibility  whatsoever for
+its use by other parties, and makes no guarantees, expressed or implied,
+about its quality, reliability, or any other characteristic.
+
+This software has been determined to be outside the scope of the EAR
+(see Part 734.3 of the EAR for exact details) as it has been created solely
+by employees of the U.S. Government; it is freely distributed with no
+licensing requirements; and it is considered public domain. Therefore,
+it is permissible to distribute this software as a free download from the
+internet.
+
+Disclaimer:
+This software was developed to promote biometric standards and biometric
+technology testing for the Federal Government in accordance with the USA
+PATRIOT Act and the Enhanced Border Security and Visa Entry Reform Act.
+Specific hardware and software products identified in this software were used
+in order to perform the software development.  In no case does such
+identification imply recommendation or endorsement by the National Institute
+of Standards and Technology, nor does it imply that the products and equipment
+identified are necessarily the best available for the purpose.
+
+*******************************************************************************/
+#pragma once
+
+#include "filter_mask.h"
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace NFIR {
+
+/** Least-recently-used cache of built and packed filter/masks.
+
+Building a filter/mask costs several passes over an image-sized matrix, and
+batches of images from the same capture device repeat the same padded size
+and sample rates.  Masks are keyed by padded size, source and target sample
+rates, and filter shape.  Cached masks are shared and must not be modified.
+
+All methods may be called concurrently.
+*/
+class FilterMaskCache
+{
+public:
+  /** Default number of masks retained.  Each mask holds two image-sized
+  float matrices. */
+  static const std::size_t DefaultCapacity{ 4 };
+
+  /**
+  @return the process-wide cache used by `NFIR::resample`
+  */
+  static FilterMaskCache& instance(void);
+
+  // Construct an empty cache.
+  FilterMaskCache( std::size_t capacity = DefaultCapacity );
+
+  /** Obtain a built and packed filter/mask, building it on a miss.
+
+  @param filterShape `gaussian` or `ideal`
+  @param srcSampleRate source image ppi to be downsampled
+  @param tgtSampleRate target image ppi of resulting image
+  @param maskSize `width` x `height` of the padded source image
+
+  @return shared filter/mask
+
+  @throw NFIR::Miscue for invalid filter shape
+  */
+  std::shared_ptr<FilterMask> get( const std::string& filterShape,
+                                   int srcSampleRate, int tgtSampleRate,
+                                   cv::Size maskSize );
+
+  void set_capacity( std::size_t );
+  std::size_t get_capacity(void) const;
+  std::size_t get_size(void) const;
+
+  // Remove all cached masks.
+  void clear(void);
+
+private:
+  // width, height, source rate, target rate, shape
+  typedef std::tuple<int, int, int, int, std::string> Key;
+  typedef std::list< std::pair< Key, std::shared_ptr<FilterMask> > > EntryList;
+
+  // Remove least-recently-used entries beyond capacity.  Caller holds lock.
+  void evict(void);
+
+  std::size_t _capacity;
+  EntryList _entries;     // most-recently-used first
+  std::map< Key, EntryList::iterator > _index;
+  mutable std::mutex _mutex;
+
+  // Non-copyable.
+  FilterMaskCache( const FilterMaskCache& ) = delete;
+  FilterMaskCache& operator=( const FilterMaskCache& ) = delete;
+};
+
+}   // End namespace
@@ -51,4 +51,8 @@ std::string printVersion(void);
 void resample( cv::Mat &srcImage, cv::Mat &tgtImage,
                int srcSampleRate, int tgtSampleRate,
                std::string interpolationMethod, std::string filterShape );
+void resample( cv::Mat &srcImage, cv::Mat &tgtImage,
+               int srcSampleRate, int tgtSampleRate,
+               std::string interpolationMethod, std::string filterShape,
+               std::string downsampleDomain );
 }
@@ -0,0 +1,113 @@
+/*******************************************************************************
+License:
+This software was developed at the National Institute of Standards and
+Technology (NIST) by employees of the Federal Government in the course
+of their official duties. Pursuant to title 17 Section 105 of the
+United States Code, this software is not subject to copyright protection
+and is in the public domain. NIST assumes no responsibility  whatsoever for
+its use by other parties, and makes no guarantees, expressed or implied,
+about its quality, reliability, or any other characteristic.
+
+This software has been determined to be outside the scope of the EAR
+(see Part 734.3 of the EAR for exact details) as it has been created solely
+by employees of the U.S. Government; it is freely distributed with no
+licensing requirements; and it is considered public domain. Therefore,
+it is permissible to distribute this software as a free download from the
+internet.
+
+Disclaimer:
+This software was developed to promote biometric standards and biometric
+technology testing for the Federal Government in accordance with the USA
+PATRIOT Act and the Enhanced Border Security and Visa Entry Reform Act.
+Specific hardware and software products identified in this software were used
+in order to perform the software development.  In no case does such
+identification imply recommendation or endorsement by the National Institute
+of Standards and Technology, nor does it imply that the products and equipment
+identified are necessarily the best available for the purpose.
+
+*******************************************************************************/
+#pragma once
+
+#include "resample.h"
+
+#include <string>
+#include <vector>
+
+namespace NFIR {
+
+/** Downsample entirely in the space domain.
+
+The frequency domain low-pass filter of `Downsample` is replaced by an
+equivalent separable FIR filter, designed from the same filter shape and
+resize factor.  The filter is composed with the bilinear interpolation of the
+final `resize` step and evaluated only at the target sample positions, so no
+Fourier transforms and no intermediate, full resolution image are needed.
+
+For a resize factor of p/q (in lowest terms), target positions fall on p
+distinct sub-pixel offsets (phases) of the source grid, so p sets of filter
+taps are designed once per image axis and reused for every row and column.
+*/
+class SpatialDownsample : public Resample
+{
+private:
+  bool dirty;       // Keep track of the object state.
+  std::string _filterShape;
+
+  /** Filter taps for one sub-pixel offset of the target grid. */
+  struct Phase
+  {
+    std::vector<float> taps;      // Low-pass filter composed with bilinear interpolation.
+    std::vector<float> linear;    // Bilinear interpolation alone, at `halfWidth` into the support.
+  };
+
+  /** Design the polyphase filter bank for one image axis.
+
+  @param tgtLength number of target samples along the axis
+  @param phases OUT filter taps for each phase
+  @param starts OUT index of the source sample under the first tap, per target sample
+  */
+  void designPhases( int tgtLength, std::vector<Phase>& phases, std::vector<int>& starts ) const;
+
+  // Apply one tap set of the filter banks to both axes of a bordered image.
+  cv::Mat filter( const cv::Mat&, int, std::vector<float> Phase::*, int,
+                  const std::vector<Phase>&, const std::vector<int>&,
+                  const std::vector<Phase>&, const std::vector<int>& ) const;
+
+  // Half-width, in source samples, of the low-pass filter support.
+  int get_halfWidth(void) const;
+
+  // Low-pass filter impulse response at offset `d` source samples.
+  double impulseResponse( int d ) const;
+
+  // Gaussian frequency mask minimum, removed by its min-max normalization.
+  double get_maskFloor(void) const;
+
+public:
+  // Default constructor.
+  SpatialDownsample();
+
+  // Copy constructor.
+  SpatialDownsample( const SpatialDownsample& );
+
+  // Full constructor with all accessible members defined.
+  SpatialDownsample( int, int );
+
+  // Virtual destructor
+  virtual ~SpatialDownsample() {}
+
+
+  cv::Mat resize( cv::Mat ) override;
+  cv::Mat resize( cv::Mat, NFIR::FilterMask*, Padding& ) override;
+  void to_s(void) const override;
+  int set_interpolationMethodAndFilterShape( const std::string, const std::string ) override;
+
+  std::string get_filterShape(void) const override;
+
+  // Implement a clone operator.
+  SpatialDownsample Clone(void);
+
+  // Implement an assigment operator.
+  SpatialDownsample operator=( const SpatialDownsample& );
+};
+
+}   // End namespace
@@ -0,0 +1,231 @@
+/*******************************************************************************
+License:
+This software was developed at the National Institute of Standards and
+Technology (NIST) by employees of the Federal Government in the course
+of their official duties. Pursuant to title 17 Section 105 of the
+United States Code, this software is not subject to copyright protection
+and is in the public domain. NIST assumes no responsibility  whatsoever for
+its use by other parties, and makes no guarantees, expressed or implied,
+about its quality, reliability, or any other characteristic.
+
+This software has been determined to be outside the scope of the EAR
+(see Part 734.3 of the EAR for exact details) as it has been created solely
+by employees of the U.S. Government; it is freely distributed with no
+licensing requirements; and it is considered public domain. Therefore,
+it is permissible to distribute this software as a free download from the
+internet.
+
+Disclaimer:
+This software was developed to promote biometric standards and biometric
+technology testing for the Federal Government in accordance with the USA
+PATRIOT Act and the Enhanced Border Security and Visa Entry Reform Act.
+Specific hardware and software products identified in this software were used
+in order to perform the software development.  In no case does such
+identification imply recommendation or endorsement by the National Institute
+of Standards and Technology, nor does it imply that the products and equipment
+identified are necessarily the best available for the purpose.
+
+*******************************************************************************/
+#include "glob.h"
+#include "nfir_lib.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*******************************************************************************
+Benchmark the frequency and spatial domain downsamplers against each other.
+
+Each 500 PPI PGM (P5) image in the source directory is upsampled to 600, 1000
+and 1200 PPI, then downsampled back to 500 PPI in both domains with each
+filter shape.  Reported per configuration:
+
+* mean milliseconds per downsample in each domain
+* pixel drift of spatial versus frequency: max and mean absolute difference, PSNR
+
+With an output dir, every downsampled image is written as PGM so that quality
+scores can be compared with the NFIQ 2 tool.
+
+Usage:  nfir_bench <src-dir> [repetitions] [output-dir]
+*******************************************************************************/
+
+static cv::Mat readPGM( const std::string& );
+static void writePGM( const std::string&, const cv::Mat& );
+static std::vector<std::string> listPGM( const std::string& );
+
+struct Drift
+{
+  int maxAbs{0};
+  double meanAbs{0.0};
+  double psnr{0.0};
+};
+
+static Drift measureDrift( const cv::Mat&, const cv::Mat& );
+static double timeDownsample( cv::Mat, cv::Mat&, int, const std::string&,
+                              const std::string&, int );
+
+int main( int argc, char** argv )
+{
+  if( argc < 2 )
+  {
+    std::cerr << "Usage: " << argv[0] << " <src-dir> [repetitions] [output-dir]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string srcDir{ argv[1] };
+  const int reps = ( argc > 2 ) ? std::max( 1, std::atoi( argv[2] ) ) : 3;
+  const std::string outDir = ( argc > 3 ) ? argv[3] : "";
+
+  const std::vector<std::string> files = listPGM( srcDir );
+  if( files.empty() )
+  {
+    std::cerr << "No PGM images in '" << srcDir << "'" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << std::left << std::setw(6) << "PPI" << std::setw(10) << "shape"
+            << std::right << std::setw(10) << "freq ms" << std::setw(10) << "spat ms"
+            << std::setw(9) << "speedup" << std::setw(8) << "max" << std::setw(8) << "mean"
+            << std::setw(9) << "PSNR" << std::endl;
+
+  for( const int srcRate : { 600, 1000, 1200 } )
+  {
+    for( const std::string shape : { "ideal", "gaussian" } )
+    {
+      double freqMs{0.0}, spatMs{0.0};
+      Drift worst;
+      double meanSum{0.0}, psnrMin{ INFINITY };
+
+      for( const auto& path : files )
+      {
+        cv::Mat src = readPGM( path );
+        if( src.empty() )
+        {
+          std::cerr << "Cannot read '" << path << "'" << std::endl;
+          return EXIT_FAILURE;
+        }
+        cv::Mat up, freqImg, spatImg;
+        NFIR::resample( src, up, 500, srcRate, "bicubic", "" );
+
+        freqMs += timeDownsample( up, freqImg, srcRate, shape, "frequency", reps );
+        spatMs += timeDownsample( up, spatImg, srcRate, shape, "spatial", reps );
+
+        const Drift d = measureDrift( freqImg, spatImg );
+        worst.maxAbs = std::max( worst.maxAbs, d.maxAbs );
+        meanSum += d.meanAbs;
+        psnrMin = std::min( psnrMin, d.psnr );
+
+        if( !outDir.empty() )
+        {
+          const size_t slash = path.find_last_of( "/\\" );
+          const std::string stem = path.substr( slash + 1, path.size() - slash - 5 );
+          const std::string tag = "_" + std::to_string( srcRate ) + "_" + shape;
+          writePGM( outDir + "/" + stem + tag + "_frequency.pgm", freqImg );
+          writePGM( outDir + "/" + stem + tag + "_spatial.pgm", spatImg );
+        }
+      }
+
+      const double n = (double)files.size();
+      std::cout << std::left << std::setw(6) << srcRate << std::setw(10) << shape
+                << std::right << std::fixed << std::setprecision(2)
+                << std::setw(10) << freqMs / n << std::setw(10) << spatMs / n
+                << std::setw(8) << freqMs / spatMs << "x"
+                << std::setw(8) << worst.maxAbs << std::setw(8) << meanSum / n
+                << std::setw(9) << psnrMin << std::endl;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+/**
+@return mean milliseconds per downsample to 500 PPI over `reps` repetitions
+*/
+double timeDownsample( cv::Mat src, cv::Mat& tgt, int srcRate, const std::string& shape,
+                       const std::string& domain, int reps )
+{
+  // Warm up, e.g. the frequency domain filter/mask cache.
+  NFIR::resample( src, tgt, srcRate, 500, "bilinear", shape, domain );
+
+  const auto start = std::chrono::steady_clock::now();
+  for( int i=0; i<reps; i++ )
+    NFIR::resample( src, tgt, srcRate, 500, "bilinear", shape, domain );
+  const auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>( stop - start ).count() / reps;
+}
+
+/**
+@return drift of `b` relative to `a`; PSNR is infinite for identical images
+*/
+Drift measureDrift( const cv::Mat& a, const cv::Mat& b )
+{
+  Drift d;
+  if( a.size() != b.size() )
+  {
+    std::cerr << "Size mismatch: " << a.size() << " vs " << b.size() << std::endl;
+    std::exit( EXIT_FAILURE );
+  }
+  cv::Mat diff;
+  cv::absdiff( a, b, diff );
+  double maxVal;
+  cv::minMaxLoc( diff, nullptr, &maxVal );
+  d.maxAbs = (int)maxVal;
+  d.meanAbs = cv::mean( diff )[0];
+  d.psnr = cv::PSNR( a, b );
+  if( d.maxAbs == 0 )
+    d.psnr = INFINITY;
+  return d;
+}
+
+/**
+@return 8-bit grayscale image, or empty on error
+*/
+cv::Mat readPGM( const std::string& path )
+{
+  std::ifstream in( path, std::ios::binary );
+  std::string magic;
+  int width{0}, height{0}, maxVal{0};
+  in >> magic >> width >> height >> maxVal;
+  in.get();
+  if( !in || ( magic != "P5" ) || ( maxVal != 255 ) )
+    return cv::Mat();
+
+  cv::Mat img( height, width, CV_8U );
+  in.read( reinterpret_cast<char*>( img.data ), img.total() );
+  if( !in )
+    return cv::Mat();
+  return img;
+}
+
+void writePGM( const std::string& path, const cv::Mat& img )
+{
+  std::ofstream out( path, std::ios::binary );
+  out << "P5\n" << img.cols << " " << img.rows << "\n255\n";
+  out.write( reinterpret_cast<const char*>( img.data ), img.total() );
+  if( !out )
+  {
+    std::cerr << "Cannot write '" << path << "'" << std::endl;
+    std::exit( EXIT_FAILURE );
+  }
+}
+
+/**
+@return sorted paths of the `.pgm` files in `dir`
+*/
+std::vector<std::string> listPGM( const std::string& dir )
+{
+  std::vector<std::string> v;
+  glob::Glob glob( dir + "/*.pgm" );
+  while( glob ) {
+    const std::string fname = glob.GetFileName();
+    if( ( fname != "." ) && ( fname != ".." ) )   // Req'd for windows.
+      v.push_back( dir + "/" + fname );
+    glob.Next();
+  }
+  std::sort( v.begin(), v.end() );
+  return v;
+}
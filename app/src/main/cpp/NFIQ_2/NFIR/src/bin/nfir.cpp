@@ -109,6 +109,9 @@ int main(int argc, char** argv)
     ->needs(im_opt);
   im_opt->needs(fs_opt);
 
+  std::string downsampleDomain {"frequency"};
+  app.add_option( "-e, --downsamp-domain", downsampleDomain, "For downsample use [ frequency | spatial ], default is 'frequency'" );
+
   bool dryRunFlag {false};
   app.add_flag( "-x,--dry-run", dryRunFlag, "Do not write images to disk" )
     ->multi_option_policy()
@@ -187,6 +190,7 @@ int main(int argc, char** argv)
     std::cout << "Source image format: '" << srcImageFormat  << "'" << std::endl;
     std::cout << "Target image format: '" << tgtImageFormat  << "'" << std::endl;
     std::cout << "Resample interpolation method: '" << interpolationMethod  << "'" << std::endl;
+    std::cout << "Downsample domain: '" << downsampleDomain  << "'" << std::endl;
     std::cout << std::endl;
     std::cout << "Dry-run: " << std::boolalpha << dryRunFlag << std::endl;
     std::cout << "Verbose mode: " << std::boolalpha << verboseFlag << std::endl;
@@ -254,7 +258,7 @@ int main(int argc, char** argv)
       try {
         NFIR::resample( srcImage, tgtImage,
                   srcSampleRate, tgtSampleRate,
-                  interpolationMethod, filterShape );
+                  interpolationMethod, filterShape, downsampleDomain );
         cv::imwrite( tgtPath, tgtImage );
         tmp_count += 1;
       }
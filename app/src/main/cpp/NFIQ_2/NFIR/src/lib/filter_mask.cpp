@@ -98,6 +98,64 @@ cv::Mat FilterMask::get_theMask(void) const
   return _theMask;
 }
 
+/**
+@return packed filter/mask, empty if `pack()` has not been called
+*/
+cv::Mat FilterMask::get_packedMask(void) const
+{
+  return _thePackedMask;
+}
+
+/** The real-input forward DFT of a W x H image (both even) stores only the
+non-redundant half of the spectrum.  Columns 1 to W-2 hold (Re, Im) pairs of
+frequency columns 1 to W/2-1, for every row.  Columns 0 and W-1 hold the
+purely real frequency columns 0 and W/2, packed vertically: row 0 is frequency
+row 0, rows (2k-1, 2k) are the (Re, Im) pair of frequency row k, and row H-1
+is frequency row H/2.
+
+Because the mask is real and symmetric, each (Re, Im) pair is weighted by the
+mask value at the corresponding frequency.
+*/
+void FilterMask::pack(void)
+{
+  int M = _theMask.cols;    // count cols
+  int N = _theMask.rows;    // count rows
+  CV_Assert( _theMask.type() == CV_32F && M % 2 == 0 && N % 2 == 0 );
+
+  // Fold in the scale of the unnormalized inverse DFT.
+  const float scale = (float)( 1.0 / ( (double)M * (double)N ) );
+
+  cv::Mat packed = cv::Mat( N, M, CV_32F );
+  for(int i=0; i<N; i++)
+  {
+    const float* maskRow = _theMask.ptr<float>(i);
+    float* packedRow = packed.ptr<float>(i);
+    for(int j=1; j<M/2; j++)
+    {
+      packedRow[2*j-1] = maskRow[j] * scale;
+      packedRow[2*j] = maskRow[j] * scale;
+    }
+  }
+
+  // Frequency columns 0 and W/2 are stored in packed columns 0 and W-1.
+  const int freqCols[] = { 0, M/2 };
+  const int packedCols[] = { 0, M-1 };
+  for(int c=0; c<2; c++)
+  {
+    const int fc = freqCols[c];
+    const int pc = packedCols[c];
+    packed.at<float>(0, pc) = _theMask.at<float>(0, fc) * scale;
+    for(int k=1; k<N/2; k++)
+    {
+      packed.at<float>(2*k-1, pc) = _theMask.at<float>(k, fc) * scale;
+      packed.at<float>(2*k, pc) = _theMask.at<float>(k, fc) * scale;
+    }
+    packed.at<float>(N-1, pc) = _theMask.at<float>(N/2, fc) * scale;
+  }
+
+  _thePackedMask = packed;
+}
+
 // *********
 // Always create a virtual destructor- implemented in header file: virtual ~FilterMask() {}.
 // *********
@@ -0,0 +1,128 @@
+/*******************************************************************************
+License:
+This software was developed at the National Institute of Standards and
+Technology (NIST) by employees of the Federal Government in the course
+of their official duties. Pursuant to title 17 Section 105 of the
+United States Code, this software is not subject to copyright protection
+and is in the public domain. NIST assumes no responsibility  whatsoever for
+its use by other parties, and makes no guarantees, expressed or implied,
+about its quality, reliability, or any other characteristic.
+
+This software has been determined to be outside the scope of the EAR
+(see Part 734.3 of the EAR for exact details) as it has been created solely
+by employees of the U.S. Government; it is freely distributed with no
+licensing requirements; and it is considered public domain. Therefore,
+it is permissible to distribute this software as a free download from the
+internet.
+
+Disclaimer:
+This software was developed to promote biometric standards and biometric
+technology testing for the Federal Government in accordance with the USA
+PATRIOT Act and the Enhanced Border Security and Visa Entry Reform Act.
+Specific hardware and software products identified in this software were used
+in order to perform the software development.  In no case does such
+identification imply recommendation or endorsement by the National Institute
+of Standards and Technology, nor does it imply that the products and equipment
+identified are necessarily the best available for the purpose.
+
+*******************************************************************************/
+#include "exceptions.h"
+#include "filter_mask_cache.h"
+#include "filter_mask_gaussian.h"
+#include "filter_mask_ideal.h"
+
+namespace NFIR {
+
+FilterMaskCache& FilterMaskCache::instance(void)
+{
+  static FilterMaskCache cache;
+  return cache;
+}
+
+FilterMaskCache::FilterMaskCache( std::size_t capacity ) : _capacity{ capacity }
+{
+}
+
+/** Masks are built outside the lock so that threads resampling images of
+different sizes do not serialize on each other.  If two threads miss on the
+same key, the first mask inserted is kept.
+*/
+std::shared_ptr<FilterMask> FilterMaskCache::get( const std::string& filterShape,
+                                                  int srcSampleRate, int tgtSampleRate,
+                                                  cv::Size maskSize )
+{
+  const Key key{ maskSize.width, maskSize.height, srcSampleRate, tgtSampleRate, filterShape };
+
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+    auto found = _index.find( key );
+    if( found != _index.end() )
+    {
+      _entries.splice( _entries.begin(), _entries, found->second );
+      return found->second->second;
+    }
+  }
+
+  std::shared_ptr<FilterMask> mask;
+  if( filterShape == "gaussian" )
+    mask.reset( new Gaussian( srcSampleRate, tgtSampleRate ) );
+  else if( filterShape == "ideal" )
+    mask.reset( new Ideal( srcSampleRate, tgtSampleRate ) );
+  else
+    throw NFIR::Miscue( "NFIR lib: invalid parameter filter shape: '" + filterShape + "'" );
+  mask->build( maskSize );
+  mask->pack();
+
+  std::lock_guard<std::mutex> lock( _mutex );
+  auto found = _index.find( key );
+  if( found != _index.end() )
+  {
+    _entries.splice( _entries.begin(), _entries, found->second );
+    return found->second->second;
+  }
+  if( _capacity == 0 )
+    return mask;
+
+  _entries.emplace_front( key, mask );
+  _index[key] = _entries.begin();
+  evict();
+
+  return mask;
+}
+
+void FilterMaskCache::set_capacity( std::size_t capacity )
+{
+  std::lock_guard<std::mutex> lock( _mutex );
+  _capacity = capacity;
+  evict();
+}
+
+std::size_t FilterMaskCache::get_capacity(void) const
+{
+  std::lock_guard<std::mutex> lock( _mutex );
+  return _capacity;
+}
+
+std::size_t FilterMaskCache::get_size(void) const
+{
+  std::lock_guard<std::mutex> lock( _mutex );
+  return _entries.size();
+}
+
+void FilterMaskCache::clear(void)
+{
+  std::lock_guard<std::mutex> lock( _mutex );
+  _index.clear();
+  _entries.clear();
+}
+
+void FilterMaskCache::evict(void)
+{
+  while( _entries.size() > _capacity )
+  {
+    _index.erase( _entries.back().first );
+    _entries.pop_back();
+  }
+}
+
+}   // End namespace
@@ -27,10 +27,10 @@ identified are necessarily the best available for the purpose.
 
 *******************************************************************************/
 #include "exceptions.h"
-#include "filter_mask_gaussian.h"
-#include "filter_mask_ideal.h"
+#include "filter_mask_cache.h"
 #include "nfir_lib.h"
 #include "resample_down.h"
+#include "resample_down_spatial.h"
 #include "resample_up.h"
 
 
@@ -50,8 +50,9 @@ sample rates.  The up- or down-sample "resize factor" = (target rate)/(source ra
 
 For upsample, perform the resize and return.
 
-For downsample, pad the source image, build the lowpass filter, Fourier
-transform the padded image and matrix multiply with the filter (or mask).
+For downsample, pad the source image, obtain the lowpass filter (built once
+per padded size, sample rates and shape, then cached), Fourier transform the
+padded image and matrix multiply with the filter (or mask).
 Inverse-Fourier transform the product, strip the image padding, perform
 final resize.
 
@@ -69,17 +70,42 @@ void resample( cv::Mat &srcImage, cv::Mat &tgtImage,
                int srcSampleRate, int tgtSampleRate,
                std::string interpolationMethod,
                std::string filterShape )
+{
+  resample( srcImage, tgtImage, srcSampleRate, tgtSampleRate,
+            interpolationMethod, filterShape, "frequency" );
+}
+
+/**
+Same as above, with choice of the domain in which to downsample.
+
+For the "spatial" domain, the lowpass filter is applied as a separable FIR
+filter evaluated only at the target sample positions (see SpatialDownsample);
+no padding, Fourier transforms, or final resize are performed.  Results differ
+slightly from the "frequency" domain; see doc/spatial_downsample.md.
+
+@param downsampleDomain [ frequency | spatial ], ignored for upsample
+
+@throw NFIR::Miscue for invalid sample rate(s), interpolation method, downsample filter shape or domain, or cannot resize image
+*/
+void resample( cv::Mat &srcImage, cv::Mat &tgtImage,
+               int srcSampleRate, int tgtSampleRate,
+               std::string interpolationMethod,
+               std::string filterShape,
+               std::string downsampleDomain )
 {
   int errCode{0};
   validateSampleRate( srcSampleRate, tgtSampleRate );
+  if( ( downsampleDomain != "frequency" ) && ( downsampleDomain != "spatial" ) ) {
+    throw NFIR::Miscue( "NFIR lib: invalid parameter downsample domain: '" + downsampleDomain + "'" );
+  }
 
   // To be sure, clear the target.
   tgtImage.release();
 
   /** Polymorphic, single instance either Upsample or Downsample */
   Resample *resampler;
-  /** Polymorphic, single instance Gaussian or Ideal */
-  FilterMask *currentFilter;
+  /** Polymorphic, shared instance Gaussian or Ideal */
+  std::shared_ptr<FilterMask> currentFilter;
 
   cv::Mat padded;
   Padding actualPadSize;
@@ -91,6 +117,11 @@ void resample( cv::Mat &srcImage, cv::Mat &tgtImage,
     resampler = new Upsample( srcSampleRate, tgtSampleRate );
     errCode = resampler->set_interpolationMethod( interpolationMethod );
   }
+  else if( downsampleDomain == "spatial" )
+  {
+    resampler = new SpatialDownsample( srcSampleRate, tgtSampleRate );
+    errCode = resampler->set_interpolationMethodAndFilterShape( interpolationMethod, filterShape );
+  }
   else
   {
     resampler = new Downsample( srcSampleRate, tgtSampleRate );
@@ -112,32 +143,34 @@ void resample( cv::Mat &srcImage, cv::Mat &tgtImage,
     return;
   }
 
+  if( downsampleDomain == "spatial" )
+  {
+    try
+    {
+      tgtImage = resampler->resize( srcImage );
+    }
+    catch( const cv::Exception& ex ) {
+      std::string err{"NFIR lib: SpatialDownsample failed resize(): "};
+      err.append( ex.what() );
+      throw NFIR::Miscue( err );
+    }
+    delete resampler;
+    resampler = nullptr;
+    return;
+  }
+
   // Not an UPSAMPLE, so start the DOWNSAMPLE process.
   padded = padImage( srcImage, actualPadSize );
 
-  // Build the filter/mask for freq domain mulSpectums.
+  // Obtain the filter/mask for freq domain multiplication.
   // The filter/mask is same dimension (WxH) as the padded, source image.
   try
   {
-    if( resampler->get_filterShape() == "gaussian" )
-    {
-      currentFilter = new Gaussian( srcSampleRate, tgtSampleRate );
-      currentFilter->build( padded.size() );
-    }
-    else if( resampler->get_filterShape() == "ideal" )
-    {
-      currentFilter = new Ideal( srcSampleRate, tgtSampleRate );
-      currentFilter->build( padded.size() );
-    }
-    else
-    {
-      // Although filter shape has already been verfied, the compiler throws an error
-      // that currentFilter may not have been initialized.
-      throw NFIR::Miscue( "NFIR lib: invalid parameter filter shape: '" + resampler->get_filterShape() + "'");
-    }
+    currentFilter = FilterMaskCache::instance().get( resampler->get_filterShape(),
+                      srcSampleRate, tgtSampleRate, padded.size() );
 
     // Now that the padded, source image and "current" filter mask are available...
-    tgtImage = resampler->resize( padded, currentFilter, actualPadSize );
+    tgtImage = resampler->resize( padded, currentFilter.get(), actualPadSize );
   }
   catch( const cv::Exception& ex ) {
     std::string err{"NFIR lib: Downsample failed resize(): "};
@@ -149,8 +182,6 @@ void resample( cv::Mat &srcImage, cv::Mat &tgtImage,
   // Clean up
   delete resampler;
   resampler = nullptr;
-  delete currentFilter;
-  currentFilter = nullptr;
 
   return;
 }
@@ -173,9 +204,9 @@ std::string printVersion()
 
 
 /** Utilize the OpenCV optimal padding function.  If either (or both) of the optimal
-rows or columns are odd, one row or column is added to the padding.  This must be
-done to ensure that the ideal filter/mask rightmost column and bottommost row
-contain all zeros.
+rows or columns are odd, the next larger optimal size that is even is used.  Even
+sizes are required to ensure that the ideal filter/mask rightmost column and
+bottommost row contain all zeros, and by the packed, real-input DFT.
 
 @param image to pad
 @param actual OUT padding values
@@ -186,11 +217,11 @@ cv::Mat padImage( cv::Mat image, Padding &actual )
 {
   cv::Mat padded;
   int optimalRows = cv::getOptimalDFTSize( image.rows );
-  if (optimalRows % 2)  // odd
-    optimalRows++;
+  while (optimalRows % 2)  // odd
+    optimalRows = cv::getOptimalDFTSize( optimalRows + 1 );
   int optimalCols = cv::getOptimalDFTSize( image.cols );
-  if (optimalCols % 2)  // odd
-    optimalCols++;
+  while (optimalCols % 2)  // odd
+    optimalCols = cv::getOptimalDFTSize( optimalCols + 1 );
   int pad_rows = optimalRows - image.rows;
   int pad_cols = optimalCols - image.cols;
   cv::copyMakeBorder( image, padded, 0, pad_rows, 0, pad_cols,
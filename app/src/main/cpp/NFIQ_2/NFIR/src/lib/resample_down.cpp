@@ -30,8 +30,6 @@ identified are necessarily the best available for the purpose.
 
 #include <iostream>
 
-static cv::Mat applyFilterFreqDomain( cv::Mat complexI, cv::Mat mask );
-
 
 namespace NFIR {
 
@@ -68,18 +66,21 @@ Downsample::Downsample( int srcSampleRate, int tgtSampleRate )
 
 /** Includes image processing prior to the OpenCV `resize` function:
 
-1. performs the forward fourier transform of the `srcImg`
-2. factors-out the DC component (by dividing each freq by size of `srcImg`)
-3. applies the filter/mask
-4. takes the inverse transform
-5. extracts image that is (polar) magnitude of inverse Fourier transform
-6. crops space domain image
-7. calls the OpenCV `resize` function.
+1. performs the real-input forward fourier transform of the `srcImg`
+2. applies the filter/mask, packed to match the Hermitian-packed spectrum and
+   pre-scaled to factor-out the DC component (size of `srcImg`)
+3. takes the real-output inverse transform
+4. crops space domain image
+5. calls the OpenCV `resize` function.
+
+Since the image is real, its spectrum is Hermitian and only half of it is
+computed, stored, filtered and inverted.
 
 The `resize` function uses the __resize factor__ and interpolation method.
 
 @param srcImg to be resized by the amount of the __resizeFactor__
-@param filterMask that is multiplied with the freq domain image
+@param filterMask that is multiplied with the freq domain image; packed if it
+was not already
 @param pads amount to crop the space domain image
 
 @return final downsampled, resized image for write to disk
@@ -89,41 +90,33 @@ cv::Mat Downsample::resize( cv::Mat srcImg, NFIR::FilterMask* filterMask, Paddin
   cv::Mat resampledImg;
   try
   {
-    cv::Mat fourierTransform, scaledFwdDFT;
-
-    // ------ STEP #1) Forward Fourier transform.
-    cv::Mat planes[] = { cv::Mat_<float>(srcImg), cv::Mat::zeros( srcImg.size(), CV_32F ) };
-    cv::Mat complexI;
-    cv::merge(planes, 2, complexI);
-
-    cv::dft( complexI, fourierTransform, cv::DFT_COMPLEX_OUTPUT );
-    // ------ STEP #2) Scale by dividing by the DC component.
-    cv::multiply( fourierTransform, (float)1/srcImg.total(), scaledFwdDFT );
-
-    // ------ STEP #3) Apply filter/mask to image spectrum in freq domain.
-    // Multiplication in freq domain where the (multiplicands/factors) spectrums
-    // have DC term in center.  The filter/mask was constructed to have DC term
-    // in center, therefore, shift the fourier transform signal.
-    cv::Mat filteredSpectrum = applyFilterFreqDomain( scaledFwdDFT, filterMask->get_theMask() );
-
-    // ------ STEP #4) Inverse Fourier transform.
+    // ------ STEP #1) Forward Fourier transform of the real image, producing
+    // the Hermitian-packed (CCS) half spectrum.
+    cv::Mat realImg, spectrum;
+    srcImg.convertTo( realImg, CV_32F );
+    cv::dft( realImg, spectrum );
+
+    // ------ STEP #2) Apply scaled filter/mask to image spectrum in freq domain.
+    // The mask is real, so each packed (Re, Im) pair is multiplied by the mask
+    // value at its frequency.
+    if( filterMask->get_packedMask().empty() )
+      filterMask->pack();
+    cv::multiply( spectrum, filterMask->get_packedMask(), spectrum );
+
+    // ------ STEP #3) Inverse Fourier transform, producing the real image directly.
     cv::Mat inverseTransform;
-    cv::dft( filteredSpectrum, inverseTransform, cv::DFT_INVERSE );
-
-    // ------ STEP #5) extract image that is (polar) magnitude of inverse Fourier transform.
-    cv::Mat planes2[] = { cv::Mat::zeros( inverseTransform.size(), CV_32F ), cv::Mat::zeros( inverseTransform.size(), CV_32F ) };
-    cv::split(inverseTransform, planes2);                 // planes[0] = Re(DFT(I), planes[1] = Im(DFT(I))
+    cv::dft( spectrum, inverseTransform, cv::DFT_INVERSE | cv::DFT_REAL_OUTPUT );
     cv::Mat finalImage;
-    planes2[0].convertTo(finalImage, CV_8U);
+    inverseTransform.convertTo(finalImage, CV_8U);
 
-    // ------ STEP #6) Crop padding.
+    // ------ STEP #4) Crop padding.
     int startX=pads.left;  // since padding only right and bottom, this is 0.
     int startY=pads.top;   // since padding only right and bottom, this is 0.
     int cropWidth=srcImg.cols - pads.right;
     int cropHeight=srcImg.rows - pads.bottom;
     cv::Mat croppedImage( finalImage, cv::Rect(startX,startY,cropWidth,cropHeight) );
 
-    // ------ STEP #7) Downsize to target ppi.
+    // ------ STEP #5) Downsize to target ppi.
     cv::resize( croppedImage, resampledImg, cv::Size(0, 0), _resizeFactor, _resizeFactor, _interpolationMethod );
   }
   catch( const cv::Exception& ex ) {
@@ -257,26 +250,3 @@ std::string Downsample::get_filterShape(void) const
 }
 
 }   // End namespace
-
-/** Wrapper for OpenCV `mulSpectrums` function.  THIS IS THE FILTER by multiplication
-in the frequency domain.
-
-@param complexI has 2 channels
-@param mask has one channel
-
-@return filtered image in freq domain
-*/
-cv::Mat applyFilterFreqDomain( cv::Mat complexI, cv::Mat mask )
-{
-  cv::Mat planes[] = {cv::Mat::zeros( complexI.size(), CV_32F ),
-                      cv::Mat::zeros( complexI.size(), CV_32F )};
-  cv::Mat kernel_spec;
-  planes[0] = mask; // real
-  planes[1] = mask; // imaginary, no apparent change with this in or out.
-  cv::merge( planes, 2, kernel_spec );
-
-  cv::Mat filteredSpectrum;
-  cv::mulSpectrums( complexI, kernel_spec, filteredSpectrum, cv::DFT_ROWS );  // DFT_ROWS accepted);
-
-  return filteredSpectrum;
-}
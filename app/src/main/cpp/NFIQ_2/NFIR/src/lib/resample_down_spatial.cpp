@@ -0,0 +1,425 @@
+/*******************************************************************************
+License:
+This software was developed at the National Institute of Standards and
+Technology (NIST) by employees of the Federal Government in the course
+of their official duties. Pursuant to title 17 Section 105 of the
+United States Code, this software is not subject to copyright protection
+and is in the public domain. NIST assumes no responsibility  whatsoever for
+its use by other parties, and makes no guarantees, expressed or implied,
+about its quality, reliability, or any other characteristic.
+
+This software has been determined to be outside the scope of the EAR
+(see Part 734.3 of the EAR for exact details) as it has been created solely
+by employees of the U.S. Government; it is freely distributed with no
+licensing requirements; and it is considered public domain. Therefore,
+it is permissible to distribute this software as a free download from the
+internet.
+
+Disclaimer:
+This software was developed to promote biometric standards and biometric
+technology testing for the Federal Government in accordance with the USA
+PATRIOT Act and the Enhanced Border Security and Visa Entry Reform Act.
+Specific hardware and software products identified in this software were used
+in order to perform the software development.  In no case does such
+identification imply recommendation or endorsement by the National Institute
+of Standards and Technology, nor does it imply that the products and equipment
+identified are necessarily the best available for the purpose.
+
+*******************************************************************************/
+#include "resample_down_spatial.h"
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+static int greatestCommonDivisor( int, int );
+
+namespace NFIR {
+
+// Default constructor.
+SpatialDownsample::SpatialDownsample()
+{
+  Init();
+}
+// Copy constructor.
+SpatialDownsample::SpatialDownsample( const SpatialDownsample& aCopy ) : Resample::Resample( aCopy )
+{
+  Copy( aCopy );
+  _filterShape = aCopy._filterShape;
+}
+
+/** Full constructor.  Calculates the image resize factor.
+
+@param srcSampleRate source image ppi to be downsampled
+@param tgtSampleRate target image ppi of resulting downsample
+*/
+SpatialDownsample::SpatialDownsample( int srcSampleRate, int tgtSampleRate )
+{
+  _srcSampleRate = srcSampleRate;
+  _tgtSampleRate = tgtSampleRate;
+  _resizeFactor = (float)_tgtSampleRate / (float)_srcSampleRate;
+
+  dirty = true;
+}
+
+
+// *********
+// Always create a virtual destructor- implemented in header file: virtual ~SpatialDownsample() {}.
+// *********
+
+
+/** The frequency domain filter/masks cut off at the target Nyquist frequency,
+`resizeFactor/2` cycles per source sample.
+
+* **ideal**: the elliptical mask is approximated by a separable (square)
+  pass band, whose impulse response is `r.sinc(r.t)`, Hamming-windowed to
+  three lobes.
+* **gaussian**: a frequency domain Gaussian with standard deviation `r/2`
+  cycles per sample is, roughly, a space domain Gaussian with standard
+  deviation `1/(pi.r)` samples.
+
+@return half-width, in source samples, of the filter support
+*/
+int SpatialDownsample::get_halfWidth(void) const
+{
+  const double r = (double)_tgtSampleRate / (double)_srcSampleRate;
+  if( _filterShape == "gaussian" )
+    return std::max( 3, (int)std::ceil( 3.0 / ( CV_PI * r ) ) );
+  return (int)std::ceil( 3.0 / r );
+}
+
+/** The mask covers only the frequencies of the source grid, (-1/2, 1/2]
+cycles per sample, which truncates the Gaussian when the resize factor is near
+1.  The Gaussian weight is therefore the inverse transform of the truncated
+mask, integrated numerically, rather than a sampled space domain Gaussian.
+
+@param d offset from the filtered sample, in whole source samples
+
+@return unnormalized filter weight at `d`
+*/
+double SpatialDownsample::impulseResponse( int d ) const
+{
+  const double r = (double)_tgtSampleRate / (double)_srcSampleRate;
+  if( _filterShape == "gaussian" )
+  {
+    // Simpson's rule over [0, 1/2]; the mask is even.
+    const int intervals{128};
+    const double sigma = r / 2.0;
+    const double step = 0.5 / intervals;
+    double sum{0.0};
+    for( int i=0; i<=intervals; i++ )
+    {
+      const double f = i * step;
+      const double weight = ( i == 0 || i == intervals ) ? 1.0 : ( ( i % 2 ) ? 4.0 : 2.0 );
+      sum += weight * std::exp( -( f * f ) / ( 2.0 * sigma * sigma ) ) * std::cos( 2.0 * CV_PI * f * d );
+    }
+    return 2.0 * sum * step / 3.0;
+  }
+
+  const double halfWidth = get_halfWidth();
+  if( std::abs( d ) >= halfWidth )
+    return 0.0;
+  const double x = CV_PI * r * d;
+  const double sinc = ( d == 0 ) ? 1.0 : std::sin( x ) / x;
+  const double window = 0.54 + 0.46 * std::cos( CV_PI * d / halfWidth );
+  return r * sinc * window;
+}
+
+/** The Gaussian mask is min-max normalized, which lowers the mask by its
+minimum value `m`, found at the corner frequency (1/2, 1/2):
+`mask = (G - m) / (1 - m)`.  In the space domain, the `-m` term is a scaled
+impulse, which is not negligible for resize factors near 1.
+
+@return `m` for the gaussian filter shape, 0 otherwise
+*/
+double SpatialDownsample::get_maskFloor(void) const
+{
+  if( _filterShape != "gaussian" )
+    return 0.0;
+  const double r = (double)_tgtSampleRate / (double)_srcSampleRate;
+  return std::exp( -1.0 / ( r * r ) );
+}
+
+/** Target sample `u` is centered at source position
+`x = (u + 0.5) * src/tgt - 0.5`, matching the OpenCV `resize` convention.  The
+position is computed exactly in integers, so the sub-pixel offset repeats every
+`tgt/gcd(src, tgt)` target samples.
+
+The low-pass filter, sampled at whole source pixels and normalized to unity
+gain, is applied at the two source pixels on either side of `x` and the results
+are linearly interpolated; each phase folds both steps into `2 * halfWidth + 2`
+taps.
+*/
+void SpatialDownsample::designPhases( int tgtLength, std::vector<Phase>& phases, std::vector<int>& starts ) const
+{
+  const int halfWidth = get_halfWidth();
+  const int numTaps = 2 * halfWidth + 2;
+  const int numPhases = _tgtSampleRate / greatestCommonDivisor( _srcSampleRate, _tgtSampleRate );
+  const int64_t den = 2 * (int64_t)_tgtSampleRate;
+
+  std::vector<double> lowpass( 2 * halfWidth + 1 );
+  double sum = 0.0;
+  for( int d=-halfWidth; d<=halfWidth; d++ )
+  {
+    lowpass[d + halfWidth] = impulseResponse( d );
+    sum += lowpass[d + halfWidth];
+  }
+  for( auto &weight : lowpass )
+    weight /= sum;
+
+  phases.assign( numPhases, Phase() );
+  starts.resize( tgtLength );
+  for( int u=0; u<tgtLength; u++ )
+  {
+    // x = num / den; num is positive when downsampling.
+    const int64_t num = ( 2 * (int64_t)u + 1 ) * _srcSampleRate - _tgtSampleRate;
+    const int64_t floorX = num / den;
+    starts[u] = (int)floorX - halfWidth;
+
+    if( u >= numPhases )
+      continue;
+
+    const double fracX = (double)( num - floorX * den ) / (double)den;
+    Phase &phase = phases[u];
+    phase.taps.assign( numTaps, 0.0f );
+    phase.linear.resize( 2 );
+    for( int k=0; k<numTaps; k++ )
+    {
+      double weight{0.0};
+      if( k <= 2 * halfWidth )
+        weight += ( 1.0 - fracX ) * lowpass[k];
+      if( k >= 1 )
+        weight += fracX * lowpass[k - 1];
+      phase.taps[k] = (float)weight;
+    }
+    phase.linear[0] = (float)( 1.0 - fracX );
+    phase.linear[1] = (float)fracX;
+  }
+}
+
+/** Filter and decimate one axis at a time:
+
+1. filter each source row, evaluating only the target columns
+2. filter the columns of those narrow rows, evaluating only the target rows.
+
+Both passes read and write rows contiguously.
+
+@param bordered source image, padded by `border` pixels on every side
+@param border pad width
+@param taps which taps of each phase to apply
+@param offset position of the first of those taps within the phase support
+@param colPhases filter bank for the horizontal pass
+@param colStarts first source column of each target column
+@param rowPhases filter bank for the vertical pass
+@param rowStarts first source row of each target row
+
+@return filtered, decimated image as 32-bit float
+*/
+cv::Mat SpatialDownsample::filter( const cv::Mat& bordered, int border,
+                                   std::vector<float> Phase::*taps, int offset,
+                                   const std::vector<Phase>& colPhases, const std::vector<int>& colStarts,
+                                   const std::vector<Phase>& rowPhases, const std::vector<int>& rowStarts ) const
+{
+  const int tgtCols = (int)colStarts.size();
+  const int tgtRows = (int)rowStarts.size();
+
+  // ------ Horizontal pass: full height, target width.
+  const int numColPhases = (int)colPhases.size();
+  cv::Mat narrow( bordered.rows, tgtCols, CV_32F );
+  for(int y=0; y<bordered.rows; y++)
+  {
+    const uchar* src = bordered.ptr<uchar>(y);
+    float* dst = narrow.ptr<float>(y);
+    for(int u=0; u<tgtCols; u++)
+    {
+      const std::vector<float> &t = colPhases[u % numColPhases].*taps;
+      const uchar* s = src + colStarts[u] + border + offset;
+      float sum = 0.0f;
+      for(size_t k=0; k<t.size(); k++)
+        sum += t[k] * s[k];
+      dst[u] = sum;
+    }
+  }
+
+  // ------ Vertical pass: target height, accumulating whole rows.
+  const int numRowPhases = (int)rowPhases.size();
+  cv::Mat tgt( tgtRows, tgtCols, CV_32F, cv::Scalar::all(0) );
+  for(int v=0; v<tgtRows; v++)
+  {
+    const std::vector<float> &t = rowPhases[v % numRowPhases].*taps;
+    float* dst = tgt.ptr<float>(v);
+    for(size_t k=0; k<t.size(); k++)
+    {
+      const float w = t[k];
+      if( w == 0.0f )
+        continue;
+      const float* s = narrow.ptr<float>( rowStarts[v] + border + offset + (int)k );
+      for(int u=0; u<tgtCols; u++)
+        dst[u] += w * s[u];
+    }
+  }
+
+  return tgt;
+}
+
+/** Pad the source image with white pixels (as `Downsample` does) so that
+every tap is in bounds, then filter and decimate.  When the Gaussian mask has a
+floor `m`, the result is `(lowpass - m * bilinear) / (1 - m)`.
+
+@param srcImg 8-bit grayscale image to be resized by the amount of the __resizeFactor__
+
+@return final downsampled, resized image
+*/
+cv::Mat SpatialDownsample::resize( cv::Mat srcImg )
+{
+  CV_Assert( srcImg.type() == CV_8UC1 );
+  CV_Assert( _tgtSampleRate < _srcSampleRate );
+
+  const int tgtCols = cvRound( srcImg.cols * _resizeFactor );
+  const int tgtRows = cvRound( srcImg.rows * _resizeFactor );
+
+  std::vector<Phase> colPhases, rowPhases;
+  std::vector<int> colStarts, rowStarts;
+  designPhases( tgtCols, colPhases, colStarts );
+  designPhases( tgtRows, rowPhases, rowStarts );
+
+  // Rounding of the target size can place the last sample up to one target
+  // sample beyond the source image.
+  const int border = get_halfWidth() + 1 + (int)std::ceil( 1.0 / _resizeFactor );
+  cv::Mat bordered;
+  cv::copyMakeBorder( srcImg, bordered, border, border, border, border,
+                      cv::BORDER_CONSTANT, cv::Scalar::all(255) );
+
+  cv::Mat result = filter( bordered, border, &Phase::taps, 0,
+                           colPhases, colStarts, rowPhases, rowStarts );
+
+  const double maskFloor = get_maskFloor();
+  if( maskFloor > 1e-3 )
+  {
+    cv::Mat linear = filter( bordered, border, &Phase::linear, get_halfWidth(),
+                             colPhases, colStarts, rowPhases, rowStarts );
+    cv::addWeighted( result, 1.0 / ( 1.0 - maskFloor ),
+                     linear, -maskFloor / ( 1.0 - maskFloor ), 0.0, result );
+  }
+
+  cv::Mat tgtImg;
+  result.convertTo( tgtImg, CV_8U );
+  return tgtImg;
+}
+
+
+/** Space domain downsampling requires neither padding nor a filter/mask;
+delegates to `resize( srcImg )`.
+
+@param srcImg to be resized by the amount of the __resizeFactor__
+@param filterMask unused
+@param pads unused
+
+@return final downsampled, resized image
+*/
+cv::Mat SpatialDownsample::resize( cv::Mat srcImg, NFIR::FilterMask*, Padding& )
+{
+  return resize( srcImg );
+}
+
+
+SpatialDownsample SpatialDownsample::Clone(void)
+{
+  SpatialDownsample c;
+  c.Copy( *this );
+  c._filterShape = _filterShape;
+  return c;
+}
+
+SpatialDownsample SpatialDownsample::operator=( const SpatialDownsample& aCopy )
+{
+  Copy( aCopy );
+  _filterShape = aCopy._filterShape;
+  return *this;
+}
+
+
+/** Print to console this instance configuration.
+*/
+void SpatialDownsample::to_s(void) const
+{
+  std::cout << "SPATIAL DOWNSAMPLE configuration:" << std::endl;
+  std::cout << "  source sample rate:  " << get_srcSampleRate() << std::endl;
+  std::cout << "  target sample rate:  " << get_tgtSampleRate() << std::endl;
+  std::cout << "  resize factor:       " << get_resizeFactor() << std::endl;
+  std::cout << std::endl;
+  std::cout << "Filter config: " << _configRecap << std::endl;
+  std::cout << "  filter shape:          " << _filterShape << std::endl;
+  std::cout << "  filter half-width:     " << get_halfWidth() << " source samples" << std::endl;
+  std::cout << std::endl;
+}
+
+
+/** Same validation and recommended filter shapes as `Downsample`.  The
+interpolation method is validated but has no effect; the FIR filter
+interpolates at the target sample positions.
+
+@param im interpolation method `bicubic` or `bilinear`
+@param fs filter shape `gaussian` or `ideal`
+
+@return 0 upon success, -1 for invalid interpolation method, -2 for invalid filter shape
+*/
+int SpatialDownsample::set_interpolationMethodAndFilterShape( const std::string im, const std::string fs )
+{
+  if( ( im != "" ) && ( fs != "" ) )
+  {
+    _configRecap = "Filter shape specified by user (per config).";
+    if( im == "bicubic" )
+      _interpolationMethod = cv::INTER_CUBIC;
+    else if( im == "bilinear" )
+      _interpolationMethod = cv::INTER_LINEAR;
+    else
+      return -1;
+
+    if( fs == "ideal" )
+      _filterShape = "ideal";
+    else if( fs == "gaussian" )
+      _filterShape = "gaussian";
+    else
+      return -2;
+  }
+
+  if( ( im == "" ) && ( fs == "" ) )
+  {
+    _configRecap = "Using recommended filter shape.";
+    switch ( get_srcSampleRate() ) {
+      case 1200:
+        _filterShape = "gaussian";
+        break;
+
+      default:
+        _filterShape = "ideal";
+        break;
+    }
+  }
+  return 0;
+}
+
+/*
+@return "gaussian" or "ideal"
+*/
+std::string SpatialDownsample::get_filterShape(void) const
+{
+  return _filterShape;
+}
+
+}   // End namespace
+
+/**
+@return greatest common divisor of two positive integers
+*/
+int greatestCommonDivisor( int a, int b )
+{
+  while( b != 0 )
+  {
+    const int t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
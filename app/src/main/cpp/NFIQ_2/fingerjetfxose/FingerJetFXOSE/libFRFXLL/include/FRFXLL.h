@@ -413,6 +413,34 @@ FRFXLL_RESULT FRFXLL_EXPORT FRFXLLGetMinutiae(
   void *mdata					///< [in/out] caller allocated... calloc of number minutira * sizeof minutia struct type
 );
 
+#define FRFXLL_MAX_MINUTIAE 255  ///< Most minutiae kept by feature extraction
+
+/**
+Minutiae-only feature extraction using raw pixel array as an input
+Writes the same minutiae as FRFXLLCreateFeatureSetFromRaw followed by FRFXLLGetMinutiae straight into
+caller allocated memory, without creating a feature set handle or a footprint
+Minutiae are sorted by decreasing confidence; when more are found than *num_minutia, the most confident are kept
+The caller specifies the layout with the enum value, as for FRFXLLGetMinutiae
+\retval FRFXLL_OK                        The operation completed successfully.
+\retval FRFXLL_ERR_INVALID_PARAM         Invalid parameter, for example incorrect data type.
+\retval FRFXLL_ERR_INVALID_HANDLE        Invalid context handle.
+\retval FRFXLL_ERR_NO_MEMORY             No enough memory to complete the operation
+\retval FRFXLL_ERR_FB_TOO_SMALL_AREA     Fingerprint area is too small
+\retval FRFXLL_ERR_INVALID_IMAGE         Invalid image data
+*/
+FRFXLL_RESULT FRFXLL_EXPORT FRFXLLExtractMinutiaeFromRaw(
+  FRFXLL_HANDLE hContext,            ///< [in] Handle to a fingerprint recognition context
+  const unsigned char pixels[],      ///< [in] sample as 8bpp pixel array (no line padding for alignment)
+  size_t size,                       ///< [in] size of the sample buffer
+  unsigned int width,                ///< [in] width of the image
+  unsigned int height,               ///< [in] heidht of the image
+  unsigned int imageResolution,      ///< [in] image resolution [DPI]
+  unsigned int flags,                ///< [in] Set to 0 for default or bitwise or of any of the FRFXLL_FEX_xxx flags
+  enum FRXLL_MINUTIAE_LAYOUT layout, ///< [in] layout of mdata, currently only BASIC_19794_2_MINUTIA_STRUCT
+  unsigned int *num_minutia,         ///< [in/out] capacity of mdata in minutiae / number of minutiae written
+  void *mdata                        ///< [out] caller allocated, FRFXLL_MAX_MINUTIAE entries hold every minutia
+);
+
 
 #ifdef __cplusplus
 }
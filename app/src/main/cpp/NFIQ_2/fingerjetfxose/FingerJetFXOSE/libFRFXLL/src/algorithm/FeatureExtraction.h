@@ -99,31 +99,37 @@ namespace Embedded {
       ori_size = ori_height * ori_width;
     }
 
-    void WriteFootprint(Footprint & fp) {
+    // Samples the footprint on the Footprint grid; returns its area and, if fp is given, writes the bitmap
+    uint32 SampleFootprint(Footprint * fp) const {
       uint32 area = 0;
-      for (int32 y = 0; y < fp.height; y++) {
-        for (int32 x = 0; x < fp.width; x++) {
+      for (int32 y = 0; y < Footprint::height; y++) {
+        for (int32 x = 0; x < Footprint::width; x++) {
           size_t xi = reduce(((x * 8) * imageResolution + imageResolution / 2) / imageScale, 2);
           size_t yi = reduce(((y * 8) * imageResolution + imageResolution / 2) / imageScale, 2) * ori_width;
           bool b = (xi < ori_width) && (yi < ori_size) && (footprint[xi + yi]);
           if (b) area++;
-          fp.Pixel(x,y) = b;
+          if (fp) fp->Pixel(x,y) = b;
         }
       }
-      fp.area = area * 8 * 8;
+      return area * 8 * 8;
     }
 
-    void RescaleMinutia(MatchData & md) {
-      for (size_t i = 0; i < md.size(); i++) {
-        md.minutia[i].position.x = int16(md.minutia[i].position.x * imageScale / imageResolution);
-        md.minutia[i].position.y = int16(md.minutia[i].position.y * imageScale / imageResolution);
+    void WriteFootprint(Footprint & fp) {
+      fp.area = SampleFootprint(&fp);
+    }
+
+    void RescaleMinutia(Minutia * begin, Minutia * end) {
+      for (Minutia * m = begin; m != end; ++m) {
+        m->position.x = int16(m->position.x * imageScale / imageResolution);
+        m->position.y = int16(m->position.y * imageScale / imageResolution);
       }
     }
 
-    FRFXLL_RESULT From333DpiImg(
+    // Finds the minutiae of the 333 dpi image, in internal coordinates
+    FRFXLL_RESULT DetectMinutiae(
       uint32 flags,
       size_t buffer_size,
-      MatchData &md
+      top_n<Minutia> & top_minutia
     ) {
       ori = reinterpret_cast<ori_t *>(img + size);
       if ((flags & flag_enable_fft_enhancement) != 0) {
@@ -140,54 +146,89 @@ namespace Embedded {
         orientation_map_and_footprint<maxwidth, ori_scale>(width, size, img, true, ori, footprint);
       }
       freeman_phasemap<ori_scale>(width, size, img, ori, img);
-      /* Patched limits of FRFXLL for NFIQ2 */
-      /* original line: top_n<Minutia> top_minutia(md.minutia, md.minutia + std::min(md.capacity(), size_t(68))); */
-      top_n<Minutia> top_minutia(md.minutia, md.minutia + md.capacity());
       extract_minutia<maxwidth, ori_scale>(img, width, size, footprint, top_minutia, param);
-      md.numMinutia = top_minutia.size();
-      top_minutia.sort();
-      
+      return FRFXLL_OK;
+    }
+
+    // Converts detected minutiae to ISO angles and 500 ppi image coordinates
+    void ToOutputCoordinates(Minutia * begin, Minutia * end) {
       // this code fixes the angles to be ISO compliant (was in the serializer) 
-      std::for_each(&md.minutia[0],&md.minutia[md.numMinutia], [](Minutia &m) {int theta = (int) m.theta; theta = -theta + 64; m.theta = (unsigned int) theta;});
+      std::for_each(begin, end, [](Minutia &m) {int theta = (int) m.theta; theta = -theta + 64; m.theta = (unsigned int) theta;});
 
-      RescaleMinutia(md);
+      RescaleMinutia(begin, end);
 
       // this code corrects for padding impact due to from the freeman phasemap (but its broken)
-      std::for_each(&md.minutia[0],&md.minutia[md.numMinutia], [this](Minutia &m) {
+      std::for_each(begin, end, [this](Minutia &m) {
 		  m.position.x += int16(xOffs * imageScale / imageResolution);
 		  m.position.y += int16(yOffs * imageScale / imageResolution);
       });
       
-      WriteFootprint(md.footprint);  // this uses offset
-      
       // this code has been moved from the serializer (it is broken, but works the same as in previous version)
       // we cannot rescale after shifting.. -- all rescaling has to be done before the uncrop... 
       // fixing this will break every expected feature in unit test... but we need to do it...
       // this code always scales back to 500 ppi - just as it did for every tested use case...
       // and it should really scale to image resolution...
       #define StdFmdDeserializer_Resolution 167	// this was a constant in deserializeFpData... (it needs to be fixed)
-      std::for_each(&md.minutia[0],&md.minutia[md.numMinutia], [md](Minutia &m) {
+      std::for_each(begin, end, [](Minutia &m) {
 //		  m.position.x = muldiv(m.position.x, 197, StdFmdDeserializer::Resolution);
 //		  m.position.y = muldiv(m.position.y, 197, StdFmdDeserializer::Resolution);
 		  m.position.x = muldiv(m.position.x, 197, StdFmdDeserializer_Resolution);
 		  m.position.y = muldiv(m.position.y, 197, StdFmdDeserializer_Resolution);
       });
+    }
 
-//      md.minutia_resolution_ppi = imageResolution;		// this is what it should be..
-      md.minutia_resolution_ppi = 500;	// its currently broken!
-      
+    FRFXLL_RESULT CheckExtracted(size_t numMinutia, uint32 footprint_area) const {
       // ideally, this would return an error code of INSUFFICIENT_MINUTIA... (no new error codes for now)
       // the threshold should also be adjustable???
-      if (md.numMinutia<min_minutia) return FRFXLL_ERR_FB_TOO_SMALL_AREA;
+      if (numMinutia<min_minutia) return FRFXLL_ERR_FB_TOO_SMALL_AREA;
 
 		// this is a measure of what the masking information found...
-      if (   md.size() < param.user_feedback.minimum_number_of_minutia
-          || md.footprint.area < param.user_feedback.minimum_footprint_area) {
+      if (   numMinutia < param.user_feedback.minimum_number_of_minutia
+          || footprint_area < param.user_feedback.minimum_footprint_area) {
         return FRFXLL_ERR_FB_TOO_SMALL_AREA;
       }
       return FRFXLL_OK;
     }
 
+    FRFXLL_RESULT From333DpiImg(
+      uint32 flags,
+      size_t buffer_size,
+      MatchData &md
+    ) {
+      /* Patched limits of FRFXLL for NFIQ2 */
+      /* original line: top_n<Minutia> top_minutia(md.minutia, md.minutia + std::min(md.capacity(), size_t(68))); */
+      top_n<Minutia> top_minutia(md.minutia, md.minutia + md.capacity());
+      CheckR(DetectMinutiae(flags, buffer_size, top_minutia));
+      md.numMinutia = top_minutia.size();
+      top_minutia.sort();
+
+      ToOutputCoordinates(&md.minutia[0], &md.minutia[md.numMinutia]);
+      WriteFootprint(md.footprint);  // this uses offset
+
+//      md.minutia_resolution_ppi = imageResolution;		// this is what it should be..
+      md.minutia_resolution_ppi = 500;	// its currently broken!
+
+      return CheckExtracted(md.numMinutia, md.footprint.area);
+    }
+
+    // Same minutiae as From333DpiImg, written to a caller buffer without building the footprint bitmap.
+    // Minutiae are sorted by confidence, as in MatchData.
+    FRFXLL_RESULT MinutiaeFrom333DpiImg(
+      uint32 flags,
+      size_t buffer_size,
+      Minutia minutia[],
+      size_t capacity,
+      size_t &numMinutia
+    ) {
+      top_n<Minutia> top_minutia(minutia, minutia + capacity);
+      CheckR(DetectMinutiae(flags, buffer_size, top_minutia));
+      numMinutia = top_minutia.size();
+      top_minutia.sort();
+
+      ToOutputCoordinates(minutia, minutia + numMinutia);
+      return CheckExtracted(numMinutia, SampleFootprint(NULL));
+    }
+
     template <class T_FIR>
     FRFXLL_RESULT ReadFIRHeader(
       const uint8 data[],             ///< [in] sample buffer
@@ -306,6 +347,20 @@ namespace Embedded {
       img = buffer;
       return From333DpiImg(flags, buffer_size, md);
     }
+
+    FRFXLL_RESULT ExtractMinutiae (
+      const uint8 in_img[],           ///< [in] input sample buffer, not preserved
+      uint8 buffer[],                 ///< [] working buffer that is modified, can be the same as image buffer, or start before it
+      size_t buffer_size,             ///< [in] size of the working buffer
+      uint32 flags,
+      Minutia minutia[],              ///< [out] minutiae, sorted by confidence
+      size_t capacity,                ///< [in] size of the minutia array
+      size_t &numMinutia              ///< [out] number of minutiae written
+    ) {
+      CheckR(Resize_AnyTo333InPlaceOrBuffer(in_img, buffer, buffer_size));
+      img = buffer;
+      return MinutiaeFrom333DpiImg(flags, buffer_size, minutia, capacity, numMinutia);
+    }
   };
 
   struct FeatureExtractionInPlace : public FeatureExtractionBase {
@@ -375,6 +430,21 @@ namespace Embedded {
       CheckR(Init(data, size_, width_, height_, imageResolution_));
       return ExtractMinutiae(imgIn, buffer, maxsize, flags, md);
     }
+
+    FRFXLL_RESULT FromRawSample(
+      const uint8 data[],             ///< [in] sample buffer
+      size_t size_,                   ///< [in] size of the sample buffer
+      uint32 width_,                  ///< [in] width of the image
+      uint32 height_,                 ///< [in] heidht of the image
+      uint32 imageResolution_,        ///< [in] pixel resolution [DPI]
+      uint32 flags,                   ///< [in] select which features of the algorithm to use
+      Minutia minutia[],              ///< [out] minutiae, sorted by confidence
+      size_t capacity,                ///< [in] size of the minutia array
+      size_t &numMinutia              ///< [out] number of minutiae written
+    ) {
+      CheckR(Init(data, size_, width_, height_, imageResolution_));
+      return ExtractMinutiae(imgIn, buffer, maxsize, flags, minutia, capacity, numMinutia);
+    }
   };
 
 }
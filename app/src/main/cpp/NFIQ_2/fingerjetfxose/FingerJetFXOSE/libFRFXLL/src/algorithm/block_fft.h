@@ -34,6 +34,7 @@
 #include <dpTypes.h>
 #include <intmath.h>
 #include <complex.h>
+#include <algorithm>
 #include <bitset>
 
 namespace FingerJetFxOSE {
@@ -145,6 +146,44 @@ namespace FFT {
     }
   }
 
+  // Same as fft<inverse, dim_bits * 2, dim_bits> on every column of a square
+  // block, with all columns transformed together: rows are shuffled whole and
+  // each butterfly is applied across a row, so the inner loop runs over
+  // contiguous, independent columns with a common twiddle factor.
+  template <bool inverse, uint8 dim_bits>
+  inline void fft_columns(int32 * data) {
+    static const int32 row = 1 << dim_bits;
+    static const int32 n = row << dim_bits;
+    for (int32 i = row; i < n - row; i += row) {
+      const int32 j = bitreverser<dim_bits, dim_bits>::reverse(i);
+      if (i > j) {
+        std::swap_ranges(data + i, data + i + row, data + j);
+      }
+    }
+    int32 dt = (inverse ? 1 : -1) * (1 << sin_bits);
+    for (uint8 ll = dim_bits; ll < dim_bits * 2; ll++) {
+      const int32 mmax = 1 << ll;
+      const int32 istep = mmax << 1;
+      dt >>= 1;
+      for (int32 m = 0, t = 0; m < mmax; m += row, t += dt) {
+        const int32 wr = cos(t);
+        const int32 wi = sin(t);
+        for (int32 i = m; i < n; i += istep) {
+          int32 * pi = data + i;
+          int32 * pj = pi + mmax;
+          for (int32 x = 0; x < row; x += 2) {
+            int32 tr = reduce(wr * pj[x] - wi * pj[x + 1], 12);
+            int32 ti = reduce(wr * pj[x + 1] + wi * pj[x], 12);
+            pj[x] = pi[x] - tr;
+            pj[x + 1] = pi[x + 1] - ti;
+            pi[x] += tr;
+            pi[x + 1] += ti;
+          }
+        }
+      }
+    }
+  }
+
   template <bool real, bool inverse, uint8 size_bits, uint8 stride_bits>
   inline void fft1(int32 * data) {
     if (!inverse) {
@@ -183,9 +222,7 @@ namespace FFT {
         fft1<real, inverse, dim_bits, 1>(data + y);
       }
     }
-    for (int32 x = 0; x < size1; x += 2) {
-      fft<inverse, dim_bits*2, dim_bits>(data + x);
-    }
+    fft_columns<inverse, dim_bits>(data);
     if (inverse) {
       for (int32 y = 0; y < size2; y += size1) {
         fft1<real, inverse, dim_bits, 1>(data + y);
@@ -76,6 +76,26 @@ namespace FingerJetFxOSE {
         }
       };
 
+      // Delay line for a block of samples at a time: block()[i - dt] is the
+      // sample dt positions before block()[i], or init before the first block.
+      // size must be at least dt plus the longest block.
+      template <class T, size_t size> struct block_delay {
+        T buffer[size];
+        size_t dt;
+        block_delay(size_t dt_, const T & init = T(0)) : dt(dt_) {
+          for (size_t i = 0; i < dt; i++) {
+            buffer[i] = init;
+          }
+        }
+        T * block() {
+          return buffer + dt;
+        }
+        // Keep the last dt samples as history for the next block of n samples
+        void shift(size_t n) {
+          memmove(buffer, buffer + n, dt * sizeof(T));
+        }
+      };
+
       template <size_t size> struct delay<bool, size> {
         typedef unsigned char byte;
         static const size_t bytesize = (size + 7) / 8;
@@ -33,6 +33,16 @@
 
 #include "block_fft.h"
 
+#include <vector>
+
+// Threads used to enhance one image; 1 enhances in place with no threads
+#ifndef FRFXLL_ENHANCE_THREADS
+  #define FRFXLL_ENHANCE_THREADS 1
+#endif
+#if FRFXLL_ENHANCE_THREADS > 1
+  #include <thread>
+#endif
+
 namespace FingerJetFxOSE {
 namespace FpRecEngineImpl {
 namespace Embedded {
@@ -88,13 +98,109 @@ namespace FeatureExtractionImpl {
         *p = ~*p;
       }
     }
+
+    // Enhances block rows [first, last) of in_img and adds them to tile, which
+    // holds the output rows they cover, starting with the top of block row first
+    template <uint8 block_bits, int32 spacing>
+    inline void enhance_rows(const image & in_img, int32 first, int32 last, image & tile) {
+      const static int32 block_dim = 1 << block_bits;
+      const static size_t block_size = 1 << block_bits * 2;
+      int32 block[block_size];
+      const int32 yspacing = in_img.width * spacing;
+      const int32 yw0 = yspacing - block_dim * in_img.width;
+      FFT::envelope<block_dim, spacing> env(false, false);
+      for (int32 r = first; r < last; ++r) {
+        const int32 yw = yw0 + r * yspacing;
+        for (int32 x = spacing - block_dim; x < in_img.width; x += spacing) {
+          copy<block_dim>(in_img, x, yw, block);
+          FFT::enhance_block<block_bits, spacing>(block, env, env);
+          add<block_dim>(tile, x, (r - first) * yspacing, block);
+        }
+      }
+    }
   }
+
+  // Same result as fft_enhance, with the block rows split into tiles that are
+  // enhanced concurrently (when FRFXLL_ENHANCE_THREADS > 1) into separate
+  // buffers. Overlap-add is modulo 256, so merging the buffers in tile order
+  // reproduces the in-place result exactly.
+  template <uint8 block_bits, int32 spacing>
+  inline bool fft_enhance_tiled(uint8 * img, size_t width_, size_t size_, size_t tiles) {
+    int32 width = (int32) width_;
+    int32 size  = (int32) size_;
+
+    using namespace FFT;
+    using FFT::image;
+    const static int32 block_dim = 1 << block_bits;
+    STATIC_ASSERT(0 < spacing && spacing <= block_dim);
+
+    const int32 bw = block_dim * width;
+    const int32 yspacing = width * spacing;
+    const int32 yw0 = yspacing - bw;
+    const int32 rows = (size - yw0 + yspacing - 1) / yspacing;
+    if (rows <= 0) return false;
+    if (tiles < 1) tiles = 1;
+    if (tiles > size_t(rows)) tiles = rows;
+
+    const image in_img(img, width, size);
+    std::vector<std::vector<uint8> > buffers(tiles);
+    std::vector<int32> first(tiles + 1);
+    for (size_t t = 0; t <= tiles; ++t) {
+      first[t] = int32(rows * t / tiles);
+    }
+    auto run = [&](size_t t) {
+      const int32 tile_size = (first[t + 1] - first[t] - 1) * yspacing + bw;
+      buffers[t].assign(tile_size, 0);
+      image tile(&buffers[t][0], width, tile_size);
+      enhance_rows<block_bits, spacing>(in_img, first[t], first[t + 1], tile);
+    };
+#if FRFXLL_ENHANCE_THREADS > 1
+    std::vector<std::thread> workers;
+    size_t t = 1;
+    try {
+      for (; t < tiles; ++t) {
+        workers.push_back(std::thread(run, t));
+      }
+    } catch (...) {
+      // Could not start a thread: enhance the remaining tiles here
+    }
+    for (size_t rest = t; rest < tiles; ++rest) {
+      run(rest);
+    }
+    run(0);
+    for (size_t i = 0; i < workers.size(); ++i) {
+      workers[i].join();
+    }
+#else
+    for (size_t t = 0; t < tiles; ++t) {
+      run(t);
+    }
+#endif
+
+    image out_img(img, width, size);
+    init(out_img, 0, width, 0, size);
+    for (size_t t = 0; t < tiles; ++t) {
+      const uint8 * p = &buffers[t][0];
+      const int32 yw1 = yw0 + first[t] * yspacing;
+      for (int32 yw = yw1; yw < yw1 + int32(buffers[t].size()); yw += width) {
+        for (int32 x = 0; x < width; ++x) {
+          out_img(x, yw) += *p++;
+        }
+      }
+    }
+    inverse(out_img);
+    return true;
+  }
+
   // does not work completely in-place, in has to be larger than out at least by block_size * width
   template <uint8 block_bits, int32 spacing>
   inline bool fft_enhance(uint8 * img, size_t width_, size_t size_, size_t buffer_size) {
     int32 width = (int32) width_;
     int32 size  = (int32) size_;
-
+#if FRFXLL_ENHANCE_THREADS > 1
+    if (size_t(size + (width << block_bits)) > buffer_size) return false;
+    return fft_enhance_tiled<block_bits, spacing>(img, width_, size_, FRFXLL_ENHANCE_THREADS);
+#else
     using namespace FFT;
     using FFT::image;
     const static int32 block_dim = 1 << block_bits;
@@ -126,6 +232,7 @@ namespace FeatureExtractionImpl {
     }
     inverse(out_img);
     return true;
+#endif
   }
 }
 }
@@ -54,77 +54,113 @@ namespace FeatureExtractionImpl {
 
   typedef complex<int8> ori_t;
 
+  // The steerable filter responses are computed one image row at a time, each
+  // stage over the whole row, so that the per-column integer arithmetic maps
+  // onto SIMD lanes. Samples are in stream order: the row and column offsets
+  // (1, width - 1, width, width + 1) are the same as in a per-pixel delay line
+  // implementation, including the fill values before the first row.
   template <size_t stride, size_t ori_scale>
   inline void raw_orimap(size_t width, size_t size, const uint8 * inImage, bool compute_footprint, ori_t * ori, uint8 * footprint) {
     static const size_t ori_scale2 = ori_scale * ori_scale;
     static const size_t ori_stride = stride / ori_scale;
+    static const size_t hist = 2 * stride + 1;
     const size_t ori_width = width / ori_scale;
     const size_t ori_size = size / ori_scale2;
+    const size_t row = ori_width * ori_scale;
     const int16 filler = 255; // typical background value: TODO: compute from the image
 
-    delay<int16, stride + 1> x100(width + 1, filler * 2), x102(width + 1, filler * 5), x10d(width + 1), x11d(width + 1);
-    delay<int16, stride - 1> x103(width - 1, filler * 10);
     inImage += (width + 1) * 2 + 4;  // offset to put in sync with orientation map
     const uint8 * p0 = inImage;
     const uint8 * p1 = inImage + width - 1;
 
-    delay<int16, stride> x10c(width, filler * 5), x101(width, filler * 25), x201(width), x221(width), x301(width), x321(width);
-    delay<int16, 1> x0, x10(filler * 50), x11, x20, x21, x22, x30, x31, x32, x33;
+    block_delay<int16, hist> in(1), cur(width + 1, filler * 2);
+    block_delay<int16, hist> v1a(width + 1, filler * 5), v2(width - 1, filler * 10), v1b(width, filler * 25);
+    block_delay<int16, hist> v10a(1, filler * 50), v11a(1), v10(width), v11(width);
+    block_delay<int16, hist> v20a(1), v21a(1), v22a(1);
+    int32 re[stride], im[stride];
     delay<complex<int32>, 1> dom;
 
     for (size_t y = 0; y < ori_size - ori_width; y += ori_width) {
       complex<int32> ori_mag[ori_stride] = {0};
-      for (size_t i = ori_scale; i; --i) {
+      for (size_t i = ori_scale; i; --i, p0 += row, p1 += row) {
+        int16 * const s0 = in.block();
+        int16 * const s1 = cur.block();
+        for (size_t x = 0; x < row; ++x) {
+          s0[x] = p0[x];
+          s1[x] = int16(p0[x]) + p1[x];
+        }
+        // Box filters; pointers offset back by 1, width - 1, width or width + 1
+        // samples read the delayed signals.
+        const int16 * const s0_1 = s0 - 1;
+        const int16 * const s1_w1 = s1 - (width + 1);
+        int16 * const a = v1a.block();
+        for (size_t x = 0; x < row; ++x) {
+          a[x] = s1_w1[x] + s1[x] + s0_1[x];
+        }
+        const int16 * const a_w1 = a - (width + 1);
+        const int16 * const a_w = a - width;
+        int16 * const b = v2.block();
+        for (size_t x = 0; x < row; ++x) {
+          b[x] = a_w1[x] + a[x];
+        }
+        const int16 * const b_w_1 = b - (width - 1);
+        int16 * const c = v1b.block();
+        for (size_t x = 0; x < row; ++x) {
+          c[x] = b_w_1[x] + b[x] + a_w[x];
+        }
+        // First order derivatives
+        const int16 * const c_w = c - width;
+        int16 * const d10 = v10a.block();
+        int16 * const d11 = v11a.block();
+        for (size_t x = 0; x < row; ++x) {
+          d10[x] = c_w[x] + c[x];
+          d11[x] = c_w[x] - c[x];
+        }
+        const int16 * const d10_1 = d10 - 1;
+        const int16 * const d11_1 = d11 - 1;
+        int16 * const e10 = v10.block();
+        int16 * const e11 = v11.block();
+        for (size_t x = 0; x < row; ++x) {
+          e10[x] = d10_1[x] - d10[x];
+          e11[x] = d11_1[x] + d11[x];
+        }
+        // Second order derivatives
+        const int16 * const e10_w = e10 - width;
+        const int16 * const e11_w = e11 - width;
+        int16 * const d20 = v20a.block();
+        int16 * const d21 = v21a.block();
+        int16 * const d22 = v22a.block();
+        for (size_t x = 0; x < row; ++x) {
+          d20[x] = e10_w[x] + e10[x];
+          d21[x] = e10_w[x] - e10[x];
+          d22[x] = e11_w[x] - e11[x];
+        }
+        // Only the second order response is weighted in the orientation
+        // estimate (first and third order weights are 0).
+        const int16 * const d20_1 = d20 - 1;
+        const int16 * const d21_1 = d21 - 1;
+        const int16 * const d22_1 = d22 - 1;
+        for (size_t x = 0; x < row; ++x) {
+          int16 v20 = d20_1[x] - d20[x];
+          int16 v21 = d21_1[x] + d21[x];
+          int16 v22 = d22_1[x] + d22[x];
+          int32 G20 = v20 + v22;
+          int32 G21 = v20 - v22;
+          int32 G22 = 2 * v21;
+          re[x] = G20 * G21;
+          im[x] = G20 * G22;
+        }
         for (size_t x = 0; x < ori_width; ++x) {
           complex<int32> z(0);
-          for (size_t j = ori_scale; j; ++p0, ++p1, --j) {
-            int16 cur = int16(*p0) + *p1;
-            int16 v1 = x100(cur) + cur + x0(*p0);
-            int16 v2 = x102(v1) + v1;
-            v1 = x103(v2) + v2 + x10c(v1);
-            int16 v1x = x101(v1);
-            int16 v10 = v1x + v1;
-            v10 = x10(v10) - v10;
-            int16 v11 = v1x - v1;
-            v11 = x11(v11) + v11;
-            complex<int32> Z1(v10, v11);
-            Z1 = Z1 * Z1;
-
-            int16 v10x = x201(v10);
-            int16 v20 = v10x + v10;
-            v20 = x20(v20) - v20;
-            int16 v21 = v10x - v10;
-            v21 = x21(v21) + v21;
-            int16 v22 = x221(v11) - v11;
-            v22 = x22(v22) + v22;
-
-            int32 G20 = v20 + v22;
-            int32 G21 = v20 - v22;
-            int32 G22 = 2 * v21;
-            complex<int32> Z2(G20 * G21, G20 * G22);
-
-            int16 v20x = x301(v20);
-            int16 v30 = v20x + v20;
-            int32 X30 = x30(v30) - v30;
-            int16 v31 = v20x - v20;
-            int32 X31 = x31(v31) + v31;
-            int16 v22x = x321(v22);
-            int16 v32 = v22x + v22;
-            int32 X32 = x32(v32) - v32;
-            int16 v33 = v22x - v22;
-            int32 X33 = x33(v33) + v33;
-
-            complex<int32> Z3(5*(X30*X30 - X33*X33) + 3*(X31*X31 - X32*X32) + 2*(X30*X32 - X31*X33),
-                              10*(X32*X33 + X30*X31) + 18*X31*X32 + 2*X30*X33);
-
-            const int32 k1 = 0; //1; // 20;
-            const int32 k2 = 1; // 24;
-            const int32 k3 = 0; // 1;
-            complex<int32> Z = k1 * Z1 + k2 * Z2 + k3 * Z3;
-            z += Z;
+          for (size_t j = 0; j < ori_scale; ++j) {
+            z += complex<int32>(re[x * ori_scale + j], im[x * ori_scale + j]);
           }
           ori_mag[x] += z;
         }
+        in.shift(row); cur.shift(row);
+        v1a.shift(row); v2.shift(row); v1b.shift(row);
+        v10a.shift(row); v11a.shift(row); v10.shift(row); v11.shift(row);
+        v20a.shift(row); v21a.shift(row); v22a.shift(row);
       }
       for (size_t x = 0; x < ori_width; ++x) {
         ori_t o = oct_sign(dom(ori_mag[x]), 50000); // 100000
@@ -66,6 +66,14 @@ namespace FingerJetFxOSE {
         return ftrSet->GetHandle(phFtrSet, GetResult());
       }
 
+      static FRFXLL_RESULT CheckRawImageSize(uint32 width, uint32 height, uint32 dpi) {
+        if (width > 2000 || height > 2000)                         return FRFXLL_ERR_INVALID_IMAGE;
+        if (dpi < 300 || dpi > 1024)                               return FRFXLL_ERR_INVALID_IMAGE;
+        if (width * 500 < 150 * dpi  || width * 500 > 812 * dpi)   return FRFXLL_ERR_INVALID_IMAGE; // in range 0.3..1.62 in
+        if (height * 500 < 150 * dpi || height * 500 > 1000 * dpi) return FRFXLL_ERR_INVALID_IMAGE; // in range 0.3..2.0 in
+        return FRFXLL_OK;
+      }
+
       template <class T>
       FRFXLL_RESULT CreateFeatureSet(
         T data[],                      ///< [in] sample
@@ -76,11 +84,8 @@ namespace FingerJetFxOSE {
         uint32 flags,                  ///< [in] select which features of the algorithm to use
         FRFXLL_HANDLE * phFtrSet       ///< [out] handle to feature set
       ) {
-        if (width > 2000 || height > 2000)                         return FRFXLL_ERR_INVALID_IMAGE;
-        if (dpi < 300 || dpi > 1024)                               return FRFXLL_ERR_INVALID_IMAGE;
-        if (width * 500 < 150 * dpi  || width * 500 > 812 * dpi)   return FRFXLL_ERR_INVALID_IMAGE; // in range 0.3..1.62 in
-        if (height * 500 < 150 * dpi || height * 500 > 1000 * dpi) return FRFXLL_ERR_INVALID_IMAGE; // in range 0.3..2.0 in
-        
+        CheckR(CheckRawImageSize(width, height, dpi));
+
         Ptr<FpFtrSetObj> ftrSet(new(ctx) FpFtrSetObj(ctx));
         if (!ftrSet) {
           rc = CheckResult(FRFXLL_ERR_NO_MEMORY);
@@ -0,0 +1,75 @@
+/*
+    FingerJetFX OSE -- Fingerprint Feature Extractor, Open Source Edition
+
+    Copyright (c) 2019 by HID Global, Inc. All rights reserved.
+
+    DigitalPersona, FingerJet, and FingerJetFX are registered trademarks 
+    or trademarks of DigitalPersona, Inc. in the United States and other
+    countries.
+
+    FingerJetFX OSE is open source software that you may modify and/or
+    redistribute under the terms of the GNU Lesser General Public License
+    as published by the Free Software Foundation, either version 3 of the 
+    License, or (at your option) any later version, provided that the 
+    conditions specified in the COPYRIGHT.txt file provided with this 
+    software are met.
+ 
+    For more information, please visit digitalpersona.com/fingerjetfx.
+*/ 
+
+#include "CreateFtrSet.h"
+
+typedef FeatureExtractionObj<Engine::FeatureExtraction> FexObj;
+
+static_assert(FRFXLL_MAX_MINUTIAE == MatchData::Capacity, "FRFXLL_MAX_MINUTIAE should match MatchData");
+
+// Working memory of one extraction: no reference count, no handle, freed on return
+struct MinutiaeExtraction : public ObjectBase {
+  Engine::FeatureExtraction fex;
+  Minutia minutia[FRFXLL_MAX_MINUTIAE];
+
+  explicit MinutiaeExtraction(const Context * ctx)
+    : fex(ctx->settings.fex)
+  {
+  }
+};
+
+FRFXLL_RESULT FRFXLLExtractMinutiaeFromRaw(
+  FRFXLL_HANDLE hContext,            ///< [in] Handle to a fingerprint recognition context
+  const unsigned char pixels[],      ///< [in] sample as 8bpp pixel array (no line padding for alignment)
+  size_t size,                       ///< [in] size of the sample buffer
+  unsigned int width,                ///< [in] width of the image
+  unsigned int height,               ///< [in] heidht of the image
+  unsigned int imageResolution,      ///< [in] image resolution [DPI]
+  unsigned int flags,                ///< [in] Set to 0 for default or bitwise or of any of the FRFXLL_FEX_xxx flags
+  enum FRXLL_MINUTIAE_LAYOUT layout, ///< [in] layout of mdata, currently only BASIC_19794_2_MINUTIA_STRUCT
+  unsigned int *num_minutia,         ///< [in/out] capacity of mdata in minutiae / number of minutiae written
+  void *mdata                        ///< [out] caller allocated, FRFXLL_MAX_MINUTIAE entries hold every minutia
+) {
+  if (pixels == NULL)  return CheckResult(FRFXLL_ERR_INVALID_PARAM);
+  if (layout != BASIC_19794_2_MINUTIA_STRUCT) return CheckResult(FRFXLL_ERR_INVALID_PARAM);
+  if (num_minutia == NULL)  return CheckResult(FRFXLL_ERR_INVALID_PARAM);
+  if (mdata == NULL)  return CheckResult(FRFXLL_ERR_INVALID_PARAM);
+  CheckInvalidFlagsCombinationR(flags, FRFXLL_FEX_DISABLE_ENHANCEMENT | FRFXLL_FEX_ENABLE_ENHANCEMENT);
+  Ptr<const Context> ctx(hContext);
+  if (!ctx) return CheckResult(FRFXLL_ERR_INVALID_HANDLE);
+  CheckR(FexObj::CheckRawImageSize(width, height, imageResolution));
+
+  MinutiaeExtraction * ext = new(ctx) MinutiaeExtraction(ctx);
+  if (ext == nullptr) return CheckResult(FRFXLL_ERR_NO_MEMORY);
+
+  size_t count = 0;
+  FRFXLL_RESULT rc = ext->fex.FromRawSample(pixels, size, width, height, imageResolution, flags, ext->minutia, FRFXLL_MAX_MINUTIAE, count);
+  if (rc != FRFXLL_OK) {
+    *num_minutia = 0;
+  } else {
+    // minutiae are sorted by confidence, so truncation keeps the most confident
+    if (*num_minutia > count) *num_minutia = (unsigned int) count;
+    struct FRFXLL_Basic_19794_2_Minutia* minutia = (struct FRFXLL_Basic_19794_2_Minutia*) mdata;
+    for (unsigned int i = 0; i < *num_minutia; i++) {
+      ToBasic19794_2Minutia(ext->minutia[i], minutia[i]);
+    }
+  }
+  delete ext;
+  return rc;
+}
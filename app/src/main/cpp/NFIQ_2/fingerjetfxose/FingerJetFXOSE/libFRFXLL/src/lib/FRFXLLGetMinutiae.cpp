@@ -66,30 +66,7 @@ FRFXLL_RESULT FRFXLLGetMinutiae(
 	// its broken as well, as the export simply assumes that the output resolution is 197 ppcm (500 dpi)...
 	// I am doing this stepwise however... - resampling (dithering) will be handled in FeatureExtraction soon...
 	  
-	// first the x and y, as the code currently works in Export
-	unsigned int x = md.minutia[i].position.x;
-	unsigned int y = md.minutia[i].position.y;
-
-	  
-//	DIAG_MSG(printf("@C@ %s:%d GM XYATQ %u %u %u %u %u\n",__FILE__,__LINE__,x,y,md.minutia[i].theta,md.minutia[i].type,FingerJetFxOSE::FpRecEngineImpl::Embedded::StdFmdSerializer::QualityFromConfidence(md.minutia[i].conf)));
-    minutia[i].x = x;
-    minutia[i].y = y;
-    minutia[i].a = md.minutia[i].theta;
-    switch (md.minutia[i].type) {
-		case Minutia::type_ridge_ending:
-			minutia[i].t = RIDGE_END;
-			break;
-		case Minutia::type_bifurcation:
-			minutia[i].t = RIDGE_BIFURCATION;
-			break;
-		case Minutia::type_other:
-			minutia[i].t = OTHER;
-			break;
-		default:
-			minutia[i].t = OTHER;
-			break;
-	}
-    minutia[i].q = FingerJetFxOSE::FpRecEngineImpl::Embedded::StdFmdSerializer::QualityFromConfidence(md.minutia[i].conf);
+    ToBasic19794_2Minutia(md.minutia[i], minutia[i]);
   }
   
   return FRFXLL_OK;	
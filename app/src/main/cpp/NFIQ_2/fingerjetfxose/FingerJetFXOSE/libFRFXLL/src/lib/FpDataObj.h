@@ -70,6 +70,25 @@ namespace FingerJetFxOSE {
       }
     };
 
+    // Copies a minutia into the public BASIC_19794_2_MINUTIA_STRUCT layout
+    inline void ToBasic19794_2Minutia(const Minutia & m, FRFXLL_Basic_19794_2_Minutia & out) {
+      out.x = m.position.x;
+      out.y = m.position.y;
+      out.a = m.theta;
+      switch (m.type) {
+        case Minutia::type_ridge_ending:
+          out.t = RIDGE_END;
+          break;
+        case Minutia::type_bifurcation:
+          out.t = RIDGE_BIFURCATION;
+          break;
+        default:
+          out.t = OTHER;
+          break;
+      }
+      out.q = Embedded::StdFmdSerializer::QualityFromConfidence(m.conf);
+    }
+
     template <class T> inline FRFXLL_RESULT Invoke(
       FRFXLL_RESULT (T::*import_f) (
         const unsigned char data[],  ///< [in] (fingerprint) data to import
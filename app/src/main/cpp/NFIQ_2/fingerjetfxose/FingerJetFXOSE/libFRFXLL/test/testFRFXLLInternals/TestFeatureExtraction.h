@@ -32,6 +32,7 @@
 #include "serializeFpData.h"
 #include "FeatureExtraction.h"
 #include "TestAnsiImage.h"
+#include "testRawImage.h"
 
 using namespace FingerJetFxOSE::FpRecEngineImpl::FIR;
 using namespace FingerJetFxOSE::FpRecEngineImpl::Embedded;
@@ -658,6 +659,23 @@ namespace {
       MatchData md;
       TS_ASSERT_OK(fex.FromFIRSample<ISOImageRecord>(TestIsoImage, sizeof(TestIsoImage), 0, md));
     }
+    void testFexRawMinutiaeOnly() {
+      const raw_image & img = test_raw_image_500;
+      const size_t size = img.width * img.height;
+      std::unique_ptr<MatchData> md(new MatchData);
+      TS_ASSERT_OK(fex.FromRawSample(img.pixels, size, img.width, img.height, img.resolution, FeatureExtraction::flag_enable_fft_enhancement, *md));
+      Minutia minutia[MatchData::Capacity];
+      size_t count = 0;
+      TS_ASSERT_OK(fex.FromRawSample(img.pixels, size, img.width, img.height, img.resolution, FeatureExtraction::flag_enable_fft_enhancement, minutia, MatchData::Capacity, count));
+      TS_ASSERT_EQUALS(count, md->numMinutia);
+      for (size_t i = 0; i < count && i < md->numMinutia; i++) {
+        TS_ASSERT_EQUALS(minutia[i].position.x, md->minutia[i].position.x);
+        TS_ASSERT_EQUALS(minutia[i].position.y, md->minutia[i].position.y);
+        TS_ASSERT_EQUALS(minutia[i].theta, md->minutia[i].theta);
+        TS_ASSERT_EQUALS(minutia[i].conf, md->minutia[i].conf);
+        TS_ASSERT_EQUALS(minutia[i].type, md->minutia[i].type);
+      }
+    }
 
   };
 
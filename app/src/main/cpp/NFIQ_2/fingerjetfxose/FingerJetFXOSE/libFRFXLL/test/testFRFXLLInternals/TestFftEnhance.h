@@ -0,0 +1,102 @@
+/*
+    FingerJetFX OSE -- Fingerprint Feature Extractor, Open Source Edition
+
+    Copyright (c) 2011 by DigitalPersona, Inc. All rights reserved.
+
+    DigitalPersona, FingerJet, and FingerJetFX are registered trademarks 
+    or trademarks of DigitalPersona, Inc. in the United States and other
+    countries.
+
+    FingerJetFX OSE is open source software that you may modify and/or
+    redistribute under the terms of the GNU Lesser General Public License
+    as published by the Free Software Foundation, either version 3 of the 
+    License, or (at your option) any later version, provided that the 
+    conditions specified in the COPYRIGHT.txt file provided with this 
+    software are met.
+ 
+    For more information, please visit digitalpersona.com/fingerjetfx.
+*/ 
+/*
+      BINARY: testFRFXLLInternals - Unit Tests for Fingerprint Feature Extractor Internals
+      
+      ALGORITHM:      Alexander Ivanisov
+                      Yi Chen
+                      Salil Prabhakar
+      IMPLEMENTATION: Alexander Ivanisov
+                      Jacob Kaminsky
+                      Lixin Wei
+      DATE:           11/08/2011
+*/
+
+#ifndef __TESTFFTENHANCE_H
+#define __TESTFFTENHANCE_H
+
+#include <vector>
+
+#include "fft_enhance.h"
+#include "lfsr.h"
+#include "TestOrimap.h"
+using namespace FingerJetFxOSE::FpRecEngineImpl::Embedded;
+using namespace FingerJetFxOSE::FpRecEngineImpl::Embedded::FeatureExtractionImpl;
+
+class TestFftEnhance : public CxxTest::TestSuite {
+  static const uint8 block_bits = 5;
+  static const int32 spacing = 17;
+
+  void CompareTiled(size_t width, size_t height, size_t tiles) {
+    std::vector<uint8> img;
+    MakeRidges(img, width, height, 9.0, 0.7, 40);
+    const size_t size = img.size();
+    const size_t buffer_size = size + (width << block_bits);
+    std::vector<uint8> expected(buffer_size), actual(buffer_size);
+    std::copy(img.begin(), img.end(), expected.begin());
+    std::copy(img.begin(), img.end(), actual.begin());
+
+    bool ok = fft_enhance<block_bits, spacing>(&expected[0], width, size, buffer_size);
+    TS_ASSERT(ok);
+    ok = fft_enhance_tiled<block_bits, spacing>(&actual[0], width, size, tiles);
+    TS_ASSERT(ok);
+    for (size_t i = 0; i < size; i++) {
+      TS_ASSERT_EQUALS(expected[i], actual[i]);
+    }
+  }
+
+public:
+  void testFftColumns() {
+    const int32 dim = 1 << block_bits;
+    LFSR l;
+    std::vector<int32> data(dim * dim);
+    for (size_t i = 0; i < data.size(); i++) {
+      data[i] = int32(l.Next<uint16>() >> 4) - 2048;
+    }
+    std::vector<int32> expected(data), actual(data);
+    for (int32 x = 0; x < dim; x += 2) {
+      FFT::fft<false, block_bits * 2, block_bits>(&expected[x]);
+    }
+    FFT::fft_columns<false, block_bits>(&actual[0]);
+    for (size_t i = 0; i < data.size(); i++) {
+      TS_ASSERT_EQUALS(expected[i], actual[i]);
+    }
+    for (int32 x = 0; x < dim; x += 2) {
+      FFT::fft<true, block_bits * 2, block_bits>(&expected[x]);
+    }
+    FFT::fft_columns<true, block_bits>(&actual[0]);
+    for (size_t i = 0; i < data.size(); i++) {
+      TS_ASSERT_EQUALS(expected[i], actual[i]);
+    }
+  }
+  void testTiled_256x360_1() {
+    CompareTiled(256, 360, 1);
+  }
+  void testTiled_256x360_4() {
+    CompareTiled(256, 360, 4);
+  }
+  void testTiled_200x120_3() {
+    CompareTiled(200, 120, 3);
+  }
+  void testTiled_64x40_8() {
+    CompareTiled(64, 40, 8);
+  }
+};
+
+#endif // __TESTFFTENHANCE_H
@@ -0,0 +1,169 @@
+/*
+    FingerJetFX OSE -- Fingerprint Feature Extractor, Open Source Edition
+
+    Copyright (c) 2011 by DigitalPersona, Inc. All rights reserved.
+
+    DigitalPersona, FingerJet, and FingerJetFX are registered trademarks 
+    or trademarks of DigitalPersona, Inc. in the United States and other
+    countries.
+
+    FingerJetFX OSE is open source software that you may modify and/or
+    redistribute under the terms of the GNU Lesser General Public License
+    as published by the Free Software Foundation, either version 3 of the 
+    License, or (at your option) any later version, provided that the 
+    conditions specified in the COPYRIGHT.txt file provided with this 
+    software are met.
+ 
+    For more information, please visit digitalpersona.com/fingerjetfx.
+*/ 
+/*
+      BINARY: testFRFXLLInternals - Unit Tests for Fingerprint Feature Extractor Internals
+      
+      ALGORITHM:      Alexander Ivanisov
+                      Yi Chen
+                      Salil Prabhakar
+      IMPLEMENTATION: Alexander Ivanisov
+                      Jacob Kaminsky
+                      Lixin Wei
+      DATE:           11/08/2011
+*/
+
+#ifndef __TESTORIMAP_H
+#define __TESTORIMAP_H
+
+#include <math.h>
+#include <vector>
+
+#include "orimap.h"
+#include "lfsr.h"
+using namespace FingerJetFxOSE::FpRecEngineImpl::Embedded;
+using namespace FingerJetFxOSE::FpRecEngineImpl::Embedded::FeatureExtractionImpl;
+
+namespace {
+  // Per-pixel delay line implementation that raw_orimap must match exactly
+  template <size_t stride, size_t ori_scale>
+  void reference_raw_orimap(size_t width, size_t size, const uint8 * inImage, bool compute_footprint, ori_t * ori, uint8 * footprint) {
+    static const size_t ori_scale2 = ori_scale * ori_scale;
+    static const size_t ori_stride = stride / ori_scale;
+    const size_t ori_width = width / ori_scale;
+    const size_t ori_size = size / ori_scale2;
+    const int16 filler = 255;
+
+    delay<int16, stride + 1> x100(width + 1, filler * 2), x102(width + 1, filler * 5), x10d(width + 1), x11d(width + 1);
+    delay<int16, stride - 1> x103(width - 1, filler * 10);
+    inImage += (width + 1) * 2 + 4;
+    const uint8 * p0 = inImage;
+    const uint8 * p1 = inImage + width - 1;
+
+    delay<int16, stride> x10c(width, filler * 5), x101(width, filler * 25), x201(width), x221(width);
+    delay<int16, 1> x0, x10(filler * 50), x11, x20, x21, x22;
+    delay<complex<int32>, 1> dom;
+
+    for (size_t y = 0; y < ori_size - ori_width; y += ori_width) {
+      complex<int32> ori_mag[ori_stride] = {0};
+      for (size_t i = ori_scale; i; --i) {
+        for (size_t x = 0; x < ori_width; ++x) {
+          complex<int32> z(0);
+          for (size_t j = ori_scale; j; ++p0, ++p1, --j) {
+            int16 cur = int16(*p0) + *p1;
+            int16 v1 = x100(cur) + cur + x0(*p0);
+            int16 v2 = x102(v1) + v1;
+            v1 = x103(v2) + v2 + x10c(v1);
+            int16 v1x = x101(v1);
+            int16 v10 = v1x + v1;
+            v10 = x10(v10) - v10;
+            int16 v11 = v1x - v1;
+            v11 = x11(v11) + v11;
+
+            int16 v10x = x201(v10);
+            int16 v20 = v10x + v10;
+            v20 = x20(v20) - v20;
+            int16 v21 = v10x - v10;
+            v21 = x21(v21) + v21;
+            int16 v22 = x221(v11) - v11;
+            v22 = x22(v22) + v22;
+
+            int32 G20 = v20 + v22;
+            int32 G21 = v20 - v22;
+            int32 G22 = 2 * v21;
+            z += complex<int32>(G20 * G21, G20 * G22);
+          }
+          ori_mag[x] += z;
+        }
+      }
+      for (size_t x = 0; x < ori_width; ++x) {
+        ori_t o = oct_sign(dom(ori_mag[x]), 50000);
+        if (compute_footprint) footprint[x + y] = (o != ori_t(0)) ? 1 : 0;
+        if (ori)               ori[x + y] = o;
+      }
+    }
+    for (size_t x = ori_size - ori_width; x < ori_size; ++x) {
+      if (compute_footprint) footprint[x] = 0;
+      if (ori)               ori[x] = ori_t(0);
+    }
+  }
+
+  // Ridges of the given period and angle over a light background, plus noise
+  void MakeRidges(std::vector<uint8> & img, size_t width, size_t height, double period, double angle, uint8 noise) {
+    LFSR l;
+    img.resize(width * height);
+    const double c = cos(angle) * 2 * M_PI / period, s = sin(angle) * 2 * M_PI / period;
+    for (size_t y = 0; y < height; y++) {
+      for (size_t x = 0; x < width; x++) {
+        bool inside = x > width / 8 && x < width * 7 / 8 && y > height / 8 && y < height * 7 / 8;
+        int v = inside ? int(128 + 100 * sin(c * x + s * y)) : 255;
+        v += noise ? int(l.Next<uint8>() % noise) - noise / 2 : 0;
+        img[y * width + x] = uint8(v < 0 ? 0 : (v > 255 ? 255 : v));
+      }
+    }
+  }
+}
+
+class TestRawOrimap : public CxxTest::TestSuite {
+  static const size_t maxwidth = 256;
+  static const size_t ori_scale = 4;
+
+  size_t Compare(const std::vector<uint8> & img, size_t width) {
+    const size_t size = img.size();
+    const size_t ori_size = size / ori_scale / ori_scale;
+    std::vector<ori_t> ori(ori_size), ori_ref(ori_size);
+    std::vector<uint8> fp(ori_size), fp_ref(ori_size);
+    raw_orimap<maxwidth, ori_scale>(width, size, &img[0], true, &ori[0], &fp[0]);
+    reference_raw_orimap<maxwidth, ori_scale>(width, size, &img[0], true, &ori_ref[0], &fp_ref[0]);
+    size_t nonzero = 0;
+    for (size_t i = 0; i < ori_size; i++) {
+      TS_ASSERT_EQUALS(ori_ref[i].real(), ori[i].real());
+      TS_ASSERT_EQUALS(ori_ref[i].imag(), ori[i].imag());
+      TS_ASSERT_EQUALS(fp_ref[i], fp[i]);
+      nonzero += fp_ref[i];
+    }
+    return nonzero;
+  }
+
+public:
+  void testRidges_256x360() {
+    std::vector<uint8> img;
+    MakeRidges(img, 256, 360, 9.0, 0.3, 0);
+    TS_ASSERT_LESS_THAN(0u, Compare(img, 256));
+  }
+  void testNoisyRidges_200x300() {
+    std::vector<uint8> img;
+    MakeRidges(img, 200, 300, 8.0, 2.0, 60);
+    TS_ASSERT_LESS_THAN(0u, Compare(img, 200));
+  }
+  void testNoisyRidges_52x80() {
+    std::vector<uint8> img;
+    MakeRidges(img, 52, 80, 7.0, 1.2, 30);
+    Compare(img, 52);
+  }
+  void testRandom_128x128() {
+    LFSR l;
+    std::vector<uint8> img(128 * 128);
+    for (size_t i = 0; i < img.size(); i++) {
+      img[i] = l.Next<uint8>();
+    }
+    Compare(img, 128);
+  }
+};
+
+#endif // __TESTORIMAP_H
@@ -58,6 +58,7 @@ extern "C" {
 #define MINEX_RET_FAILURE_NULL_TEMPLATE 4
 #define MINEX_RET_FAILURE_BAD_VERIFICATION_TEMPLATE 5
 #define MINEX_RET_FAILURE_BAD_ENROLLMENT_TEMPLATE 6
+#define MINEX_RET_FAILURE_BAD_GALLERY 7
 
 // Minutiae Extraction interface
 int32_t FJFX_MNX_EXPORT create_template(
@@ -69,6 +70,44 @@ int32_t FJFX_MNX_EXPORT create_template(
 	const uint16_t width,
 	uint8_t *output_template);
 
+// Minutiae Matching interface
+// similarity is in [0, 1]; higher values are more likely to be mated
+int32_t FJFX_MNX_EXPORT match_templates(
+	const uint8_t *verification_template,
+	const uint8_t *enrollment_template,
+	float *similarity);
+
+// 1:N search of a gallery of enrollment templates
+typedef struct minex_gallery *MINEX_GALLERY;
+
+// Build a gallery file from count enrollment templates. The gallery holds
+// the minutiae in structure-of-arrays form and an index of minutiae
+// triplets used to shortlist candidates. Search results identify templates
+// by their index in templates.
+int32_t FJFX_MNX_EXPORT create_gallery(
+	const uint8_t *const *enrollment_templates,
+	const uint32_t count,
+	const char *path);
+
+// Open a gallery file. The file is memory-mapped where supported.
+int32_t FJFX_MNX_EXPORT open_gallery(
+	const char *path,
+	MINEX_GALLERY *gallery);
+
+// Search a gallery. *count is the capacity of ids and similarities on
+// input, and the number of candidates returned on output, most similar
+// first. threads is the number of threads used; 0 uses one per core.
+int32_t FJFX_MNX_EXPORT search_gallery(
+	MINEX_GALLERY gallery,
+	const uint8_t *verification_template,
+	const uint32_t threads,
+	uint32_t *count,
+	uint32_t *ids,
+	float *similarities);
+
+int32_t FJFX_MNX_EXPORT close_gallery(
+	MINEX_GALLERY gallery);
+
 // Misc functions
 
 int32_t FJFX_MNX_EXPORT get_pids(uint32_t *template_generator,uint32_t *template_matcher);
@@ -0,0 +1,370 @@
+/*
+    FingerJetFX OSE -- Fingerprint Feature Extractor, Open Source Edition
+
+    Copyright (c) 2019 by HID Global, Inc. All rights reserved.
+
+    HID Global, FingerJet, and FingerJetFX are registered trademarks
+    or trademarks of HID Global, Inc. in the United States and other
+    countries.
+
+    FingerJetFX OSE is open source software that you may modify and/or
+    redistribute under the terms of the GNU Lesser General Public License
+    as published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version, provided that the
+    conditions specified in the COPYRIGHT.txt file provided with this
+    software are met.
+
+    For more information, please visit digitalpersona.com/fingerjetfx.
+*/
+/*
+      BINARY: minexBench - Benchmark of the libMINEX 1:1 matcher and 1:N gallery search
+
+      Minutiae are extracted from the TestVectors images. Each synthetic
+      identity displaces the minutiae of one of these fingers, and each
+      impression of an identity applies a rigid transform, jitter, missed
+      and spurious minutiae. One impression of each identity is enrolled;
+      probes are a second impression of enrolled identities (mated) and
+      impressions of identities that were not enrolled (non-mated).
+
+      usage: minexBench [gallery size] [probes] [threads] [gallery file]
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "FRFXLL.h"
+#include "minex.h"
+
+#include "TestAnsiImage.h"
+#include "testRawImage.h"
+
+namespace {
+
+const double pi = 3.14159265358979;
+const int image_size = 512;     // synthetic impressions are this many pixels square
+const size_t template_size = 32 + 255 * 6;
+
+struct minutia {
+	double x, y, theta;         // pixels, radians in image coordinates
+	int type;
+};
+typedef std::vector<minutia> finger;
+
+double now() {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void put16(uint8_t *p, unsigned int v) {
+	p[0] = uint8_t(v >> 8);
+	p[1] = uint8_t(v);
+}
+
+unsigned int get16(const uint8_t *p) {
+	return (p[0] << 8) | p[1];
+}
+
+// ANSI 378-2004 template of a single view at 500 ppi
+std::vector<uint8_t> write_template(const finger &f) {
+	const size_t n = std::min<size_t>(f.size(), 255);
+	std::vector<uint8_t> t(32 + 6 * n, 0);
+	memcpy(&t[0], "FMR\0 20\0", 8);
+	put16(&t[8], unsigned(t.size()));
+	put16(&t[16], image_size);
+	put16(&t[18], image_size);
+	put16(&t[20], 197);
+	put16(&t[22], 197);
+	t[24] = 1;
+	t[29] = uint8_t(n);
+	for (size_t i = 0; i < n; i++) {
+		uint8_t *p = &t[30 + 6 * i];
+		put16(p, (unsigned(f[i].x + 0.5) & 0x3FFF) | (f[i].type << 14));
+		put16(p + 2, unsigned(f[i].y + 0.5) & 0x3FFF);
+		// counterclockwise, in 2 degree units
+		double a = fmod(-f[i].theta * 90 / pi, 180);
+		if (a < 0) a += 180;
+		p[4] = uint8_t(int(a + 0.5) % 180);
+		p[5] = 60;
+	}
+	return t;
+}
+
+finger read_template(const uint8_t *t) {
+	finger f;
+	const size_t n = t[29];
+	for (size_t i = 0; i < n; i++) {
+		const uint8_t *p = t + 30 + 6 * i;
+		minutia m;
+		m.x = get16(p) & 0x3FFF;
+		m.y = get16(p + 2) & 0x3FFF;
+		m.type = p[0] >> 6;
+		m.theta = -p[4] * pi / 90;
+		f.push_back(m);
+	}
+	return f;
+}
+
+bool export_template(FRFXLL_HANDLE ctx, FRFXLL_RESULT rc, FRFXLL_HANDLE fs, std::vector<uint8_t> &out) {
+	FRFXLLCloseHandle(&ctx);
+	if (rc != FRFXLL_OK) return false;
+
+	FRFXLL_OUTPUT_PARAM_ISO_ANSI params;
+	memset(&params, 0, sizeof(params));
+	params.length = sizeof(params);
+	params.resolutionX = params.resolutionY = 197;
+	params.imageSizeX = params.imageSizeY = FRFXLL_IMAGE_SIZE_NOT_SPECIFIED;
+	out.resize(template_size);
+	size_t esize = out.size();
+	rc = FRFXLLExport(fs, FRFXLL_DT_ANSI_FEATURE_SET, &params, &out[0], &esize);
+	FRFXLLCloseHandle(&fs);
+	out.resize(esize);
+	return rc == FRFXLL_OK;
+}
+
+bool extract(const unsigned char *data, size_t size, FRFXLL_DATA_TYPE type, std::vector<uint8_t> &out) {
+	FRFXLL_HANDLE ctx = nullptr, fs = nullptr;
+	if (FRFXLLCreateLibraryContext(&ctx) != FRFXLL_OK) return false;
+	FRFXLL_RESULT rc = FRFXLLCreateFeatureSet(ctx, data, size, type, 0, &fs);
+	return export_template(ctx, rc, fs, out);
+}
+
+bool extract_raw(const struct raw_image &img, std::vector<uint8_t> &out) {
+	FRFXLL_HANDLE ctx = nullptr, fs = nullptr;
+	if (FRFXLLCreateLibraryContext(&ctx) != FRFXLL_OK) return false;
+	FRFXLL_RESULT rc = FRFXLLCreateFeatureSetFromRaw(ctx, img.pixels, size_t(img.width) * img.height,
+	    img.width, img.height, img.resolution, 0, &fs);
+	return export_template(ctx, rc, fs, out);
+}
+
+// Minutiae centred in the synthetic image
+finger centre(finger f) {
+	double cx = 0, cy = 0;
+	for (const minutia &m : f) {
+		cx += m.x;
+		cy += m.y;
+	}
+	cx /= f.size();
+	cy /= f.size();
+	for (minutia &m : f) {
+		m.x += image_size / 2 - cx;
+		m.y += image_size / 2 - cy;
+	}
+	return f;
+}
+
+// A new identity: every minutia of a real finger displaced well beyond
+// matching tolerance
+finger make_identity(const finger &base, std::mt19937 &rng) {
+	std::uniform_real_distribution<double> angle(0, 2 * pi), shift(20, 40), turn(-pi / 3, pi / 3);
+	finger f = base;
+	for (minutia &m : f) {
+		const double a = angle(rng), r = shift(rng);
+		m.x += r * cos(a);
+		m.y += r * sin(a);
+		m.theta += turn(rng);
+	}
+	return f;
+}
+
+// An impression of an identity
+std::vector<uint8_t> make_impression(const finger &identity, std::mt19937 &rng) {
+	std::uniform_real_distribution<double> rotation(-pi / 6, pi / 6), translation(-30, 30);
+	std::uniform_real_distribution<double> unit(0, 1), position(32, image_size - 32), direction(0, 2 * pi);
+	std::normal_distribution<double> jitter(0, 2.5), turn(0, 0.08);
+
+	const double r = rotation(rng), c = cos(r), s = sin(r);
+	const double tx = translation(rng), ty = translation(rng);
+	const double half = image_size / 2;
+	finger f;
+	for (const minutia &m : identity) {
+		if (unit(rng) < 0.2) continue;
+		minutia o = m;
+		o.x = c * (m.x - half) - s * (m.y - half) + half + tx + jitter(rng);
+		o.y = s * (m.x - half) + c * (m.y - half) + half + ty + jitter(rng);
+		o.theta = m.theta + r + turn(rng);
+		if (o.x < 0 || o.y < 0 || o.x >= image_size || o.y >= image_size) continue;
+		f.push_back(o);
+	}
+	const size_t spurious = identity.size() / 10;
+	for (size_t i = 0; i < spurious; i++) {
+		minutia o = { position(rng), position(rng), direction(rng), 1 };
+		f.insert(f.begin() + size_t(unit(rng) * f.size()), o);
+	}
+	return write_template(f);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+	const uint32_t gallery_size = argc > 1 ? uint32_t(atoi(argv[1])) : 10000;
+	const uint32_t probes = argc > 2 ? uint32_t(atoi(argv[2])) : 200;
+	const uint32_t threads = argc > 3 ? uint32_t(atoi(argv[3])) : 0;
+	const char *path = argc > 4 ? argv[4] : "minexBench.gallery";
+
+	// Real fingers from the test vectors
+	struct source { const char *name; const unsigned char *data; size_t size; FRFXLL_DATA_TYPE type; };
+	const source sources[] = {
+		{ "TestAnsiImage", TestAnsiImage, TEST_IMAGE_SIZE, FRFXLL_DT_ANSI_381_SAMPLE },
+		{ "TestBrcmImage00", TestBrcmImage00, TEST_BRCM_IMAGE_SIZE, FRFXLL_DT_ANSI_381_SAMPLE },
+		{ "TestAuthentec01", TestAuthentec01, TEST_AUTHENTEC_IMAGE_01_SIZE, FRFXLL_DT_ANSI_381_SAMPLE },
+		{ "TestAuthentec02", TestAuthentec02, TEST_AUTHENTEC_IMAGE_02_SIZE, FRFXLL_DT_ANSI_381_SAMPLE },
+		{ "TestAnsiImageMartini", TestAnsiImageMartini, TEST_ANSI_IMAGE_MARTINI_SIZE, FRFXLL_DT_ANSI_381_SAMPLE },
+		{ "TestAnsiImageMartiniCE", TestAnsiImageMartiniCE, TEST_ANSI_IMAGE_MARTINI_CE_SIZE, FRFXLL_DT_ANSI_381_SAMPLE },
+		{ "TestAnsiImage300", TestAnsiImage300, TEST_ANSI_IMAGE_300_SIZE, FRFXLL_DT_ANSI_381_SAMPLE },
+		{ "TestAnsiImage1000", TestAnsiImage1000, TEST_ANSI_IMAGE_1000_SIZE, FRFXLL_DT_ANSI_381_SAMPLE },
+		{ "TestIsoImage", TestIsoImage, TEST_ISO_IMAGE_SIZE, FRFXLL_DT_ISO_19794_4_SAMPLE },
+	};
+
+	std::vector<std::vector<uint8_t> > real;
+	std::vector<const char *> names;
+	std::vector<uint8_t> t;
+	if (extract_raw(test_raw_image_500, t)) {
+		real.push_back(t);
+		names.push_back("test_raw_image_500");
+	}
+	if (extract_raw(test_raw_image_333, t)) {
+		real.push_back(t);
+		names.push_back("test_raw_image_333");
+	}
+	for (const source &s : sources) {
+		if (extract(s.data, s.size, s.type, t) && t[29] >= 12) {
+			real.push_back(t);
+			names.push_back(s.name);
+		}
+	}
+	if (real.empty()) {
+		printf("No minutiae extracted from the test vectors\n");
+		return 1;
+	}
+
+	// 1:1 similarity of the real fingers
+	printf("1:1 similarity of test vector templates\n");
+	for (size_t i = 0; i < real.size(); i++) {
+		printf("%-24s %3u ", names[i], real[i][29]);
+		for (size_t j = 0; j < real.size(); j++) {
+			float similarity = 0;
+			match_templates(&real[i][0], &real[j][0], &similarity);
+			printf(" %.2f", similarity);
+		}
+		printf("\n");
+	}
+
+	std::mt19937 rng(20191120);
+	std::vector<finger> bases;
+	for (const std::vector<uint8_t> &r : real) bases.push_back(centre(read_template(&r[0])));
+
+	// Enrolled identities, then identities used only as non-mated probes
+	const uint32_t non_mated = probes;
+	std::vector<finger> identities;
+	for (uint32_t i = 0; i < gallery_size + non_mated; i++) {
+		identities.push_back(make_identity(bases[i % bases.size()], rng));
+	}
+
+	std::vector<std::vector<uint8_t> > enrolled(gallery_size);
+	std::vector<const uint8_t *> pointers(gallery_size);
+	size_t minutiae = 0;
+	for (uint32_t i = 0; i < gallery_size; i++) {
+		enrolled[i] = make_impression(identities[i], rng);
+		pointers[i] = &enrolled[i][0];
+		minutiae += enrolled[i][29];
+	}
+
+	double start = now();
+	int32_t rc = create_gallery(pointers.data(), gallery_size, path);
+	if (rc != MINEX_RET_SUCCESS) {
+		printf("create_gallery failed: %d\n", rc);
+		return 1;
+	}
+	const double build = now() - start;
+
+	MINEX_GALLERY gallery = nullptr;
+	start = now();
+	rc = open_gallery(path, &gallery);
+	if (rc != MINEX_RET_SUCCESS) {
+		printf("open_gallery failed: %d\n", rc);
+		return 1;
+	}
+	const double open = now() - start;
+	FILE *f = fopen(path, "rb");
+	long file_size = 0;
+	if (f != nullptr) {
+		fseek(f, 0, SEEK_END);
+		file_size = ftell(f);
+		fclose(f);
+	}
+
+	printf("\ngallery: %u templates from %zu fingers, %.1f minutiae each\n",
+	    gallery_size, bases.size(), double(minutiae) / std::max<uint32_t>(1, gallery_size));
+	printf("  build %.2f s, open %.4f s, file %.1f MB\n", build, open, file_size / 1048576.0);
+
+	// Mated probes are second impressions of enrolled identities
+	std::uniform_int_distribution<uint32_t> pick(0, gallery_size > 0 ? gallery_size - 1 : 0);
+	std::vector<std::vector<uint8_t> > mated_probes, non_mated_probes;
+	std::vector<uint32_t> mates;
+	for (uint32_t p = 0; p < probes && gallery_size > 0; p++) {
+		mates.push_back(pick(rng));
+		mated_probes.push_back(make_impression(identities[mates.back()], rng));
+	}
+	for (uint32_t p = 0; p < non_mated; p++) {
+		non_mated_probes.push_back(make_impression(identities[gallery_size + p], rng));
+	}
+
+	const uint32_t capacity = 10;
+	uint32_t ids[capacity];
+	float similarities[capacity];
+	const unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+	std::vector<uint32_t> thread_counts;
+	thread_counts.push_back(1);
+	if ((threads != 0 ? threads : cores) > 1) thread_counts.push_back(threads != 0 ? threads : cores);
+
+	for (uint32_t n : thread_counts) {
+		uint32_t rank1 = 0, rank10 = 0;
+		std::vector<float> mated_scores, non_mated_scores;
+		start = now();
+		for (size_t p = 0; p < mated_probes.size(); p++) {
+			uint32_t count = capacity;
+			search_gallery(gallery, &mated_probes[p][0], n, &count, ids, similarities);
+			if (count > 0 && ids[0] == mates[p]) rank1++;
+			for (uint32_t c = 0; c < count; c++) {
+				if (ids[c] == mates[p]) {
+					rank10++;
+					mated_scores.push_back(similarities[c]);
+				}
+			}
+		}
+		for (size_t p = 0; p < non_mated_probes.size(); p++) {
+			uint32_t count = capacity;
+			search_gallery(gallery, &non_mated_probes[p][0], n, &count, ids, similarities);
+			non_mated_scores.push_back(count > 0 ? similarities[0] : 0);
+		}
+		const double elapsed = now() - start;
+		const size_t searches = mated_probes.size() + non_mated_probes.size();
+
+		std::sort(mated_scores.begin(), mated_scores.end());
+		std::sort(non_mated_scores.begin(), non_mated_scores.end());
+		printf("\nsearch with %u thread(s): %.2f ms per probe, %.1f probes/s\n",
+		    n, 1000 * elapsed / searches, searches / elapsed);
+		printf("  rank 1 %.1f%%, rank %u %.1f%% of %zu mated probes\n",
+		    100.0 * rank1 / std::max<size_t>(1, mated_probes.size()), capacity,
+		    100.0 * rank10 / std::max<size_t>(1, mated_probes.size()), mated_probes.size());
+		if (!mated_scores.empty()) {
+			printf("  mated similarity: median %.3f, 5th percentile %.3f\n",
+			    mated_scores[mated_scores.size() / 2], mated_scores[mated_scores.size() / 20]);
+		}
+		if (!non_mated_scores.empty()) {
+			printf("  best non-mated similarity: median %.3f, 95th percentile %.3f, max %.3f\n",
+			    non_mated_scores[non_mated_scores.size() / 2],
+			    non_mated_scores[non_mated_scores.size() * 19 / 20], non_mated_scores.back());
+		}
+	}
+
+	close_gallery(gallery);
+	return 0;
+}
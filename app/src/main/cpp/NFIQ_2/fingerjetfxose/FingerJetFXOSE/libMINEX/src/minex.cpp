@@ -20,6 +20,7 @@
 
 #include <string.h>
 #include "FRFXLL.h"
+#include "minex_match.h"
 
 #include <stdio.h>
 #include <random>
@@ -152,8 +153,21 @@ int32_t create_template(
 }
 
 int32_t match_templates(const uint8_t *verification_template, const uint8_t *enrollment_template, float *similarity) {
+	using namespace FingerJetFxOSE::Minex;
+
+	if (similarity==nullptr)	return MINEX_RET_FAILURE_UNSPECIFIED;
 	*similarity = -1;
-	return (0);
+	if (verification_template==nullptr || enrollment_template==nullptr)	return MINEX_RET_FAILURE_NULL_TEMPLATE;
+
+	minutiae verification, enrollment;
+	if (!parse_ansi378(verification_template, verification))	return MINEX_RET_FAILURE_BAD_VERIFICATION_TEMPLATE;
+	if (!parse_ansi378(enrollment_template, enrollment))	return MINEX_RET_FAILURE_BAD_ENROLLMENT_TEMPLATE;
+
+	probe p;
+	p.assign(verification.view());
+	scratch s;
+	*similarity = score(p, enrollment.view(), s);
+	return MINEX_RET_SUCCESS;
 }
 
 int32_t get_pids(
@@ -0,0 +1,368 @@
+/*
+    FingerJetFX OSE -- Fingerprint Feature Extractor, Open Source Edition
+
+    Copyright (c) 2019 by HID Global, Inc. All rights reserved.
+
+    HID Global, FingerJet, and FingerJetFX are registered trademarks
+    or trademarks of HID Global, Inc. in the United States and other
+    countries.
+
+    FingerJetFX OSE is open source software that you may modify and/or
+    redistribute under the terms of the GNU Lesser General Public License
+    as published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version, provided that the
+    conditions specified in the COPYRIGHT.txt file provided with this
+    software are met.
+
+    For more information, please visit digitalpersona.com/fingerjetfx.
+*/
+
+#include "minex.h"
+#include "minex_match.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace FingerJetFxOSE::Minex;
+
+// Gallery file layout, in host byte order. Arrays follow the header in this
+// order, so that every array is naturally aligned:
+//   uint32_t first[count + 1]         offset of each template's minutiae
+//   uint32_t key_first[keys + 1]      offset of each key's postings
+//   uint32_t postings[postings]       template indices, ascending per key
+//   int16_t  x[minutiae], y[minutiae]
+//   uint8_t  theta[minutiae]
+struct gallery_header {
+	char magic[4];
+	uint32_t version;
+	uint32_t count;
+	uint32_t minutiae;
+	uint32_t keys;
+	uint32_t postings;
+	uint32_t reserved[2];
+};
+
+namespace {
+
+const char gallery_magic[4] = { 'F', 'J', 'X', 'G' };
+const uint32_t gallery_version = 1;
+
+// Candidates shortlisted by the index and scored in full
+const size_t shortlist = 128;
+
+size_t gallery_size(const gallery_header &h) {
+	return sizeof(gallery_header)
+	    + 4 * (size_t(h.count) + 1)
+	    + 4 * (size_t(h.keys) + 1)
+	    + 4 * size_t(h.postings)
+	    + 5 * size_t(h.minutiae);
+}
+
+// Shortlisted candidate: more votes first, then lower index
+struct vote {
+	float votes;
+	uint32_t id;
+	bool operator < (const vote &o) const {
+		return votes != o.votes ? votes > o.votes : id < o.id;
+	}
+};
+
+struct result {
+	float similarity;
+	uint32_t id;
+	bool operator < (const result &o) const {
+		return similarity != o.similarity ? similarity > o.similarity : id < o.id;
+	}
+};
+
+// Run f(0) ... f(n - 1) on n threads, inline if threads can't be created
+template <class F>
+void run_parallel(unsigned int n, const F &f) {
+	std::vector<std::thread> threads;
+	unsigned int started = 0;
+	try {
+		for (; started + 1 < n; started++) {
+			threads.emplace_back(f, started);
+		}
+	} catch (const std::system_error &) {
+	}
+	for (unsigned int t = started; t < n; t++) {
+		f(t);
+	}
+	for (std::thread &t : threads) {
+		t.join();
+	}
+}
+
+} // namespace
+
+struct minex_gallery {
+	const uint8_t *base;
+	size_t size;
+	bool mapped;
+	std::vector<uint8_t> buffer;
+
+	gallery_header header;
+	const uint32_t *first;
+	const uint32_t *key_first;
+	const uint32_t *postings;
+	const int16_t *x;
+	const int16_t *y;
+	const uint8_t *theta;
+
+	minex_gallery() : base(nullptr), size(0), mapped(false) {}
+
+	~minex_gallery() {
+#ifndef _WIN32
+		if (mapped) munmap(const_cast<uint8_t *>(base), size);
+#endif
+	}
+
+	bool attach(const uint8_t *data, size_t length) {
+		base = data;
+		size = length;
+		if (size < sizeof(gallery_header)) return false;
+		memcpy(&header, base, sizeof(gallery_header));
+		if (memcmp(header.magic, gallery_magic, 4) != 0) return false;
+		if (header.version != gallery_version) return false;
+		if (header.keys != index_key_count) return false;
+		if (gallery_size(header) != size) return false;
+
+		const uint8_t *p = base + sizeof(gallery_header);
+		first = reinterpret_cast<const uint32_t *>(p);
+		p += 4 * (size_t(header.count) + 1);
+		key_first = reinterpret_cast<const uint32_t *>(p);
+		p += 4 * (size_t(header.keys) + 1);
+		postings = reinterpret_cast<const uint32_t *>(p);
+		p += 4 * size_t(header.postings);
+		x = reinterpret_cast<const int16_t *>(p);
+		p += 2 * size_t(header.minutiae);
+		y = reinterpret_cast<const int16_t *>(p);
+		p += 2 * size_t(header.minutiae);
+		theta = p;
+
+		// Offsets must be monotonic and in range
+		for (uint32_t i = 0; i < header.count; i++) {
+			if (first[i] > first[i + 1]) return false;
+		}
+		if (first[0] != 0 || first[header.count] != header.minutiae) return false;
+		if (key_first[0] != 0 || key_first[header.keys] != header.postings) return false;
+		for (uint32_t k = 0; k < header.keys; k++) {
+			if (key_first[k] > key_first[k + 1]) return false;
+		}
+		// The search indexes its vote window by posting, so postings must be
+		// template indices, strictly ascending within each key
+		for (uint32_t k = 0; k < header.keys; k++) {
+			for (uint32_t i = key_first[k]; i < key_first[k + 1]; i++) {
+				if (postings[i] >= header.count) return false;
+				if (i > key_first[k] && postings[i] <= postings[i - 1]) return false;
+			}
+		}
+		return true;
+	}
+
+	template_view view(uint32_t id) const {
+		const uint32_t b = first[id];
+		template_view v = { size_t(first[id + 1] - b), x + b, y + b, theta + b };
+		return v;
+	}
+};
+
+int32_t create_gallery(
+	const uint8_t *const *enrollment_templates,
+	const uint32_t count,
+	const char *path) {
+	if (path == nullptr) return MINEX_RET_FAILURE_UNSPECIFIED;
+	if (count > 0 && enrollment_templates == nullptr) return MINEX_RET_FAILURE_NULL_TEMPLATE;
+
+	gallery_header h;
+	memcpy(h.magic, gallery_magic, 4);
+	h.version = gallery_version;
+	h.count = count;
+	h.keys = index_key_count;
+	h.reserved[0] = h.reserved[1] = 0;
+
+	// Minutiae, and the number of postings for each key
+	std::vector<uint32_t> first(size_t(count) + 1, 0);
+	std::vector<uint32_t> key_first(size_t(h.keys) + 1, 0);
+	std::vector<int16_t> x, y;
+	std::vector<uint8_t> theta;
+	std::vector<uint32_t> keys;
+	minutiae m;
+	for (uint32_t i = 0; i < count; i++) {
+		if (enrollment_templates[i] == nullptr) return MINEX_RET_FAILURE_NULL_TEMPLATE;
+		if (!parse_ansi378(enrollment_templates[i], m)) return MINEX_RET_FAILURE_BAD_ENROLLMENT_TEMPLATE;
+		x.insert(x.end(), m.x.begin(), m.x.end());
+		y.insert(y.end(), m.y.begin(), m.y.end());
+		theta.insert(theta.end(), m.theta.begin(), m.theta.end());
+		first[i + 1] = uint32_t(x.size());
+		index_keys(m.view(), keys);
+		for (uint32_t k : keys) key_first[k + 1]++;
+	}
+	for (uint32_t k = 0; k < h.keys; k++) key_first[k + 1] += key_first[k];
+	h.minutiae = uint32_t(x.size());
+	h.postings = key_first[h.keys];
+
+	// Postings, in template order so that each list is sorted
+	std::vector<uint32_t> postings(h.postings);
+	std::vector<uint32_t> fill(key_first.begin(), key_first.end() - 1);
+	for (uint32_t i = 0; i < count; i++) {
+		template_view v = { size_t(first[i + 1] - first[i]), x.data() + first[i], y.data() + first[i], theta.data() + first[i] };
+		index_keys(v, keys);
+		for (uint32_t k : keys) postings[fill[k]++] = i;
+	}
+
+	FILE *f = fopen(path, "wb");
+	if (f == nullptr) return MINEX_RET_FAILURE_BAD_GALLERY;
+	bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+	ok = ok && fwrite(first.data(), 4, first.size(), f) == first.size();
+	ok = ok && fwrite(key_first.data(), 4, key_first.size(), f) == key_first.size();
+	ok = ok && fwrite(postings.data(), 4, postings.size(), f) == postings.size();
+	ok = ok && fwrite(x.data(), 2, x.size(), f) == x.size();
+	ok = ok && fwrite(y.data(), 2, y.size(), f) == y.size();
+	ok = ok && fwrite(theta.data(), 1, theta.size(), f) == theta.size();
+	ok = (fclose(f) == 0) && ok;
+	return ok ? MINEX_RET_SUCCESS : MINEX_RET_FAILURE_BAD_GALLERY;
+}
+
+int32_t open_gallery(
+	const char *path,
+	MINEX_GALLERY *gallery) {
+	if (path == nullptr || gallery == nullptr) return MINEX_RET_FAILURE_UNSPECIFIED;
+	*gallery = nullptr;
+
+	minex_gallery *g = new (std::nothrow) minex_gallery();
+	if (g == nullptr) return MINEX_RET_FAILURE_UNSPECIFIED;
+	bool ok = false;
+#ifndef _WIN32
+	int fd = open(path, O_RDONLY);
+	if (fd >= 0) {
+		struct stat st;
+		if (fstat(fd, &st) == 0 && st.st_size > 0) {
+			void *p = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+			if (p != MAP_FAILED) {
+				g->mapped = true;
+				ok = g->attach(static_cast<const uint8_t *>(p), size_t(st.st_size));
+			}
+		}
+		close(fd);
+	}
+#else
+	FILE *f = fopen(path, "rb");
+	if (f != nullptr) {
+		if (fseek(f, 0, SEEK_END) == 0) {
+			long length = ftell(f);
+			if (length > 0 && fseek(f, 0, SEEK_SET) == 0) {
+				g->buffer.resize(size_t(length));
+				if (fread(g->buffer.data(), 1, g->buffer.size(), f) == g->buffer.size()) {
+					ok = g->attach(g->buffer.data(), g->buffer.size());
+				}
+			}
+		}
+		fclose(f);
+	}
+#endif
+	if (!ok) {
+		delete g;
+		return MINEX_RET_FAILURE_BAD_GALLERY;
+	}
+	*gallery = g;
+	return MINEX_RET_SUCCESS;
+}
+
+int32_t search_gallery(
+	MINEX_GALLERY gallery,
+	const uint8_t *verification_template,
+	const uint32_t threads,
+	uint32_t *count,
+	uint32_t *ids,
+	float *similarities) {
+	if (gallery == nullptr || count == nullptr) return MINEX_RET_FAILURE_UNSPECIFIED;
+	if (*count > 0 && (ids == nullptr || similarities == nullptr)) return MINEX_RET_FAILURE_UNSPECIFIED;
+	if (verification_template == nullptr) return MINEX_RET_FAILURE_NULL_TEMPLATE;
+
+	minutiae m;
+	if (!parse_ansi378(verification_template, m)) return MINEX_RET_FAILURE_BAD_VERIFICATION_TEMPLATE;
+	std::vector<uint32_t> keys;
+	index_keys(m.view(), keys);
+	probe p;
+	p.assign(m.view());
+
+	const minex_gallery &g = *gallery;
+	const uint32_t n = g.header.count;
+	unsigned int shards = threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+	shards = std::max(1u, std::min<unsigned int>(shards, n));
+
+	// Each thread votes for the templates in its own range of indices and
+	// shortlists the most voted
+	std::vector<std::vector<vote> > voted(shards);
+	run_parallel(shards, [&](unsigned int t) {
+		const uint32_t lo = uint32_t(uint64_t(n) * t / shards);
+		const uint32_t hi = uint32_t(uint64_t(n) * (t + 1) / shards);
+		std::vector<float> votes(hi - lo, 0);
+		for (uint32_t k : keys) {
+			const uint32_t *begin = g.postings + g.key_first[k];
+			const uint32_t *end = g.postings + g.key_first[k + 1];
+			if (begin == end) continue;
+			// Keys shared by many templates say little about any of them
+			const float weight = logf(float(n) / float(end - begin));
+			for (const uint32_t *q = std::lower_bound(begin, end, lo); q != end && *q < hi; ++q) {
+				votes[*q - lo] += weight;
+			}
+		}
+		std::vector<vote> &out = voted[t];
+		for (uint32_t i = lo; i < hi; i++) {
+			if (votes[i - lo] > 0) out.push_back(vote{ votes[i - lo], i });
+		}
+		if (out.size() > shortlist) {
+			std::nth_element(out.begin(), out.begin() + shortlist, out.end());
+			out.resize(shortlist);
+		}
+	});
+
+	std::vector<vote> candidates;
+	for (const std::vector<vote> &v : voted) candidates.insert(candidates.end(), v.begin(), v.end());
+	if (candidates.size() > shortlist) {
+		std::nth_element(candidates.begin(), candidates.begin() + shortlist, candidates.end());
+		candidates.resize(shortlist);
+	}
+
+	// Score the shortlist in full
+	std::vector<result> results(candidates.size());
+	const unsigned int workers = std::max(1u, std::min<unsigned int>(shards, unsigned(candidates.size())));
+	run_parallel(workers, [&](unsigned int t) {
+		scratch s;
+		for (size_t c = t; c < candidates.size(); c += workers) {
+			results[c].id = candidates[c].id;
+			results[c].similarity = score(p, g.view(candidates[c].id), s);
+		}
+	});
+
+	const size_t returned = std::min<size_t>(*count, results.size());
+	std::partial_sort(results.begin(), results.begin() + returned, results.end());
+	for (size_t i = 0; i < returned; i++) {
+		ids[i] = results[i].id;
+		similarities[i] = results[i].similarity;
+	}
+	*count = uint32_t(returned);
+	return MINEX_RET_SUCCESS;
+}
+
+int32_t close_gallery(
+	MINEX_GALLERY gallery) {
+	delete gallery;
+	return MINEX_RET_SUCCESS;
+}
@@ -0,0 +1,425 @@
+/*
+    FingerJetFX OSE -- Fingerprint Feature Extractor, Open Source Edition
+
+    Copyright (c) 2019 by HID Global, Inc. All rights reserved.
+
+    HID Global, FingerJet, and FingerJetFX are registered trademarks
+    or trademarks of HID Global, Inc. in the United States and other
+    countries.
+
+    FingerJetFX OSE is open source software that you may modify and/or
+    redistribute under the terms of the GNU Lesser General Public License
+    as published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version, provided that the
+    conditions specified in the COPYRIGHT.txt file provided with this
+    software are met.
+
+    For more information, please visit digitalpersona.com/fingerjetfx.
+*/
+
+#include "minex_match.h"
+
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <limits>
+
+namespace FingerJetFxOSE {
+namespace Minex {
+
+namespace {
+
+const float pi = 3.14159265358979f;
+const float two_pi = 2 * pi;
+
+// ANSI 378 resolution in pixels per cm corresponding to 500 ppi
+const unsigned int ansi_ppcm_500 = 197;
+
+// Index: triplets of each minutia and pairs of its nearest neighbours
+const unsigned int triplet_neighbours = 4;
+const float triplet_length_bin = 16;          // pixels, 16 bins
+const unsigned int triplet_angle_bins = 16;   // angle between the two sides
+const unsigned int triplet_theta_bins = 8;    // minutia directions
+
+// Scoring: directed pairs of each minutia and its nearest neighbours
+const unsigned int pair_neighbours = 4;
+const float pair_min_length = 8;
+const float pair_length_tolerance = 6;        // pixels, plus ...
+const float pair_length_tolerance_rel = 0.08f; // ... this fraction of length
+const float pair_angle_tolerance = 0.4f;      // radians
+// Buckets of beta0 at least pair_angle_tolerance wide, so that similar
+// pairs are at most one bucket apart
+const unsigned int pair_buckets = (unsigned int)(two_pi / pair_angle_tolerance);
+
+// Alignment hypotheses are binned on rotation and translation
+const unsigned int rotation_bins = 32;
+const float translation_bin = 24;             // pixels, 64 bins each way
+const unsigned int alignments = 4;            // best bins verified
+
+// Aligned minutiae closer than this are considered to match
+const float match_distance = 16;              // pixels
+const float match_cos_angle = 0.82f;          // cos(35 degrees)
+
+inline uint16_t be16(const uint8_t *p) {
+	return uint16_t((p[0] << 8) | p[1]);
+}
+
+inline uint32_t be32(const uint8_t *p) {
+	return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+}
+
+// Wrap an angle to [0, 2pi)
+inline float wrap(float a) {
+	a = fmodf(a, two_pi);
+	return a < 0 ? a + two_pi : a;
+}
+
+// Absolute difference of two angles in [0, 2pi), in [0, pi]
+inline float angle_distance(float a, float b) {
+	float d = fabsf(a - b);
+	return d > pi ? two_pi - d : d;
+}
+
+inline unsigned int quantize(float a, unsigned int bins) {
+	unsigned int q = (unsigned int)(wrap(a) * (bins / two_pi));
+	return q < bins ? q : bins - 1;
+}
+
+// Indices of up to count nearest neighbours of minutia i at least
+// min_length away, nearest first. Returns the number found.
+template <class Coord>
+unsigned int nearest(const Coord *x, const Coord *y, size_t n, size_t i, float min_length,
+    unsigned int count, uint16_t *idx, float *d2) {
+	const float min_d2 = min_length * min_length;
+	unsigned int found = 0;
+	for (size_t j = 0; j < n; j++) {
+		if (j == i) continue;
+		const float dx = float(x[j]) - float(x[i]);
+		const float dy = float(y[j]) - float(y[i]);
+		const float dd = dx * dx + dy * dy;
+		if (dd < min_d2) continue;
+		if (found == count && dd >= d2[found - 1]) continue;
+		unsigned int k = found < count ? found++ : found - 1;
+		for (; k > 0 && d2[k - 1] > dd; k--) {
+			d2[k] = d2[k - 1];
+			idx[k] = idx[k - 1];
+		}
+		d2[k] = dd;
+		idx[k] = uint16_t(j);
+	}
+	return found;
+}
+
+void make_pairs(const float *x, const float *y, const float *theta, size_t n,
+    std::vector<scratch::pair> &pairs) {
+	pairs.clear();
+	uint16_t idx[pair_neighbours];
+	float d2[pair_neighbours];
+	for (size_t i = 0; i < n; i++) {
+		const unsigned int found = nearest(x, y, n, i, pair_min_length, pair_neighbours, idx, d2);
+		for (unsigned int k = 0; k < found; k++) {
+			const size_t j = idx[k];
+			scratch::pair p;
+			p.d = sqrtf(d2[k]);
+			p.alpha = wrap(atan2f(y[j] - y[i], x[j] - x[i]));
+			p.cos_alpha = (x[j] - x[i]) / p.d;
+			p.sin_alpha = (y[j] - y[i]) / p.d;
+			p.beta0 = wrap(theta[i] - p.alpha);
+			p.beta1 = wrap(theta[j] - p.alpha);
+			p.i0 = uint16_t(i);
+			p.i1 = uint16_t(j);
+			p.bucket = uint16_t(quantize(p.beta0, pair_buckets));
+			pairs.push_back(p);
+		}
+	}
+	std::sort(pairs.begin(), pairs.end(), [](const scratch::pair &a, const scratch::pair &b) {
+		return a.bucket != b.bucket ? a.bucket < b.bucket : a.d < b.d;
+	});
+}
+
+// Offsets of each bucket of pairs sorted by make_pairs()
+void bucket_offsets(const std::vector<scratch::pair> &pairs, std::vector<uint32_t> &offsets) {
+	offsets.assign(pair_buckets + 1, 0);
+	for (const scratch::pair &p : pairs) offsets[p.bucket + 1]++;
+	for (unsigned int b = 0; b < pair_buckets; b++) offsets[b + 1] += offsets[b];
+}
+
+inline bool shorter(const scratch::pair &p, float d) {
+	return p.d < d;
+}
+
+// Number of probe minutiae with a distinct gallery minutia within
+// match_distance and match_cos_angle after aligning the probe by a rotation
+// (c, sn) and translation (tx, ty). The distance loop is branch-free over
+// the gallery arrays so that it vectorizes.
+unsigned int count_matches(const probe &p, float c, float sn, float tx, float ty, scratch &s) {
+	const size_t np = p.size();
+	const size_t ng = s.gx.size();
+
+	const float *px = p.x.data(), *py = p.y.data();
+	const float *pc = p.cos_theta.data(), *ps = p.sin_theta.data();
+	float *qx = s.qx.data(), *qy = s.qy.data(), *qc = s.qcos.data(), *qs = s.qsin.data();
+	for (size_t i = 0; i < np; i++) {
+		qx[i] = c * px[i] - sn * py[i] + tx;
+		qy[i] = sn * px[i] + c * py[i] + ty;
+		qc[i] = pc[i] * c - ps[i] * sn;
+		qs[i] = ps[i] * c + pc[i] * sn;
+	}
+
+	const float r2 = match_distance * match_distance;
+	const float none = std::numeric_limits<float>::max();
+	const float *gx = s.gx.data(), *gy = s.gy.data(), *gc = s.gcos.data(), *gs = s.gsin.data();
+	float *cost = s.cost.data();
+	uint8_t *taken = s.taken.data();
+	std::fill(s.taken.begin(), s.taken.end(), 0);
+
+	unsigned int matches = 0;
+	for (size_t i = 0; i < np; i++) {
+		const float x = qx[i], y = qy[i], ci = qc[i], si = qs[i];
+		for (size_t j = 0; j < ng; j++) {
+			const float dx = gx[j] - x;
+			const float dy = gy[j] - y;
+			const float d2 = dx * dx + dy * dy;
+			const float ca = gc[j] * ci + gs[j] * si;
+			const bool close = (d2 < r2) & (ca > match_cos_angle) & (taken[j] == 0);
+			cost[j] = close ? d2 : none;
+		}
+		size_t best = ng;
+		float best_cost = none;
+		for (size_t j = 0; j < ng; j++) {
+			if (cost[j] < best_cost) {
+				best_cost = cost[j];
+				best = j;
+			}
+		}
+		if (best < ng) {
+			taken[best] = 1;
+			matches++;
+		}
+	}
+	return matches;
+}
+
+} // namespace
+
+bool parse_ansi378(const uint8_t *tmpl, minutiae &m) {
+	m.x.clear();
+	m.y.clear();
+	m.theta.clear();
+	if (tmpl == nullptr) return false;
+	if (memcmp(tmpl, "FMR\0", 4) != 0) return false;
+
+	// Record length is 2 bytes, or 0 followed by 4 bytes
+	size_t length = be16(tmpl + 8);
+	size_t shift = 0;
+	if (length == 0) {
+		length = be32(tmpl + 10);
+		shift = 4;
+	}
+	const size_t header = 26 + shift;
+	if (length < header) return false;
+
+	unsigned int res_x = be16(tmpl + 20 + shift);
+	unsigned int res_y = be16(tmpl + 22 + shift);
+	if (res_x == 0) res_x = ansi_ppcm_500;
+	if (res_y == 0) res_y = ansi_ppcm_500;
+	const unsigned int views = tmpl[24 + shift];
+	if (views == 0) return true;
+
+	// First view: position, view/impression, quality, count, minutiae
+	if (length < header + 4) return false;
+	const size_t count = tmpl[header + 3];
+	if (length < header + 4 + 6 * count + 2) return false;
+
+	const uint8_t *p = tmpl + header + 4;
+	for (size_t i = 0; i < count; i++, p += 6) {
+		const unsigned int x = be16(p) & 0x3FFF;
+		const unsigned int y = be16(p + 2) & 0x3FFF;
+		const unsigned int a = p[4];
+		if (a >= 180) return false;
+		// Scale to 500 ppi
+		m.x.push_back(int16_t((x * ansi_ppcm_500 + res_x / 2) / res_x));
+		m.y.push_back(int16_t((y * ansi_ppcm_500 + res_y / 2) / res_y));
+		// ANSI angles are counterclockwise in 2 degree units; image rows
+		// increase downwards, so the direction is negated.
+		m.theta.push_back(uint8_t(256 - (a * 256 + 90) / 180));
+	}
+	return true;
+}
+
+void index_keys(const template_view &m, std::vector<uint32_t> &keys) {
+	keys.clear();
+	uint16_t idx[triplet_neighbours];
+	float d2[triplet_neighbours];
+	for (size_t i = 0; i < m.size; i++) {
+		const unsigned int found = nearest(m.x, m.y, m.size, i, 0, triplet_neighbours, idx, d2);
+		float length[triplet_neighbours], alpha[triplet_neighbours];
+		for (unsigned int k = 0; k < found; k++) {
+			length[k] = sqrtf(d2[k]);
+			alpha[k] = atan2f(float(m.y[idx[k]] - m.y[i]), float(m.x[idx[k]] - m.x[i]));
+		}
+		const float theta = m.theta[i] * (two_pi / 256);
+		for (unsigned int a = 0; a < found; a++) {
+			const unsigned int q0 = std::min(15u, (unsigned int)(length[a] / triplet_length_bin));
+			const unsigned int beta = quantize(theta - alpha[a], triplet_theta_bins);
+			const unsigned int turn0 = ((m.theta[idx[a]] - m.theta[i]) & 0xFF) * triplet_theta_bins / 256;
+			for (unsigned int b = a + 1; b < found; b++) {
+				const unsigned int q1 = std::min(15u, (unsigned int)(length[b] / triplet_length_bin));
+				const unsigned int angle = quantize(alpha[b] - alpha[a], triplet_angle_bins);
+				const unsigned int turn1 = ((m.theta[idx[b]] - m.theta[i]) & 0xFF) * triplet_theta_bins / 256;
+				uint32_t key = q0;
+				key = key * 16 + q1;
+				key = key * triplet_angle_bins + angle;
+				key = key * triplet_theta_bins + beta;
+				key = key * triplet_theta_bins + turn0;
+				key = key * triplet_theta_bins + turn1;
+				keys.push_back(key);
+			}
+		}
+	}
+	std::sort(keys.begin(), keys.end());
+	keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+}
+
+void probe::assign(const template_view &m) {
+	x.resize(m.size);
+	y.resize(m.size);
+	theta.resize(m.size);
+	cos_theta.resize(m.size);
+	sin_theta.resize(m.size);
+	for (size_t i = 0; i < m.size; i++) {
+		x[i] = m.x[i];
+		y[i] = m.y[i];
+		theta[i] = m.theta[i] * (two_pi / 256);
+		cos_theta[i] = cosf(theta[i]);
+		sin_theta[i] = sinf(theta[i]);
+	}
+	make_pairs(x.data(), y.data(), theta.data(), m.size, pairs);
+}
+
+void load_gallery(const template_view &g, scratch &s) {
+	const size_t ng = g.size;
+	s.gx.resize(ng);
+	s.gy.resize(ng);
+	s.gtheta.resize(ng);
+	s.gcos.resize(ng);
+	s.gsin.resize(ng);
+	for (size_t j = 0; j < ng; j++) {
+		s.gx[j] = g.x[j];
+		s.gy[j] = g.y[j];
+		s.gtheta[j] = g.theta[j] * (two_pi / 256);
+		s.gcos[j] = cosf(s.gtheta[j]);
+		s.gsin[j] = sinf(s.gtheta[j]);
+	}
+	make_pairs(s.gx.data(), s.gy.data(), s.gtheta.data(), ng, s.gpairs);
+	bucket_offsets(s.gpairs, s.gbuckets);
+}
+
+bool similar(const scratch::pair &pp, const scratch::pair &gp) {
+	const float tolerance = pair_length_tolerance + pair_length_tolerance_rel * pp.d;
+	if (gp.d < pp.d - tolerance || gp.d > pp.d + tolerance) return false;
+	if (angle_distance(pp.beta0, gp.beta0) > pair_angle_tolerance) return false;
+	if (angle_distance(pp.beta1, gp.beta1) > pair_angle_tolerance) return false;
+	return true;
+}
+
+void find_candidates(const probe &p, scratch &s) {
+	// Every pair of similar pairs proposes an alignment. Gallery pairs are
+	// only searched in the buckets of beta0 within tolerance.
+	s.candidates.clear();
+	for (const scratch::pair &pp : p.pairs) {
+		const float tolerance = pair_length_tolerance + pair_length_tolerance_rel * pp.d;
+		for (unsigned int db = 0; db < 3; db++) {
+			const unsigned int bucket = (pp.bucket + pair_buckets - 1 + db) % pair_buckets;
+			const scratch::pair *begin = s.gpairs.data() + s.gbuckets[bucket];
+			const scratch::pair *end = s.gpairs.data() + s.gbuckets[bucket + 1];
+			const scratch::pair *gp = std::lower_bound(begin, end, pp.d - tolerance, shorter);
+			for (; gp != end && gp->d <= pp.d + tolerance; ++gp) {
+				if (!similar(pp, *gp)) continue;
+				// Rotation taking the probe pair onto the gallery pair
+				scratch::candidate c;
+				const float cr = gp->cos_alpha * pp.cos_alpha + gp->sin_alpha * pp.sin_alpha;
+				const float sr = gp->sin_alpha * pp.cos_alpha - gp->cos_alpha * pp.sin_alpha;
+				const float px = p.x[pp.i0], py = p.y[pp.i0];
+				c.cos_rotation = cr;
+				c.sin_rotation = sr;
+				c.tx = s.gx[gp->i0] - (cr * px - sr * py);
+				c.ty = s.gy[gp->i0] - (sr * px + cr * py);
+				const int bx = std::max(0, std::min(63, int(floorf(c.tx / translation_bin)) + 32));
+				const int by = std::max(0, std::min(63, int(floorf(c.ty / translation_bin)) + 32));
+				c.bin = (quantize(gp->alpha - pp.alpha, rotation_bins) * 64 + bx) * 64 + by;
+				s.candidates.push_back(c);
+			}
+		}
+	}
+}
+
+float score(const probe &p, const template_view &g, scratch &s) {
+	const size_t np = p.size();
+	const size_t ng = g.size;
+	if (np < 2 || ng < 2) return 0;
+
+	load_gallery(g, s);
+	find_candidates(p, s);
+	if (s.candidates.empty()) return 0;
+
+	// Bins with the most candidates. Only bins that were incremented are
+	// cleared, so the accumulator is not cleared in full for every template.
+	uint32_t top[alignments];
+	unsigned int top_count[alignments] = {};
+	unsigned int verified = 0;
+	s.votes.resize(size_t(rotation_bins) * 64 * 64);
+	for (const scratch::candidate &c : s.candidates) {
+		const unsigned int v = ++s.votes[c.bin];
+		unsigned int k = 0;
+		while (k < verified && top[k] != c.bin) k++;
+		if (k == verified) {
+			if (verified < alignments) {
+				verified++;
+			} else if (v <= top_count[alignments - 1]) {
+				continue;
+			} else {
+				k = alignments - 1;
+			}
+		}
+		for (; k > 0 && top_count[k - 1] < v; k--) {
+			top[k] = top[k - 1];
+			top_count[k] = top_count[k - 1];
+		}
+		top[k] = c.bin;
+		top_count[k] = v;
+	}
+	for (const scratch::candidate &c : s.candidates) {
+		s.votes[c.bin] = 0;
+	}
+
+	s.qx.resize(np);
+	s.qy.resize(np);
+	s.qcos.resize(np);
+	s.qsin.resize(np);
+	s.cost.resize(ng);
+	s.taken.resize(ng);
+
+	unsigned int best = 0;
+	for (unsigned int r = 0; r < verified; r++) {
+		// Mean alignment of the bin
+		float sum_cos = 0, sum_sin = 0, sum_tx = 0, sum_ty = 0;
+		for (const scratch::candidate &c : s.candidates) {
+			if (c.bin != top[r]) continue;
+			sum_cos += c.cos_rotation;
+			sum_sin += c.sin_rotation;
+			sum_tx += c.tx;
+			sum_ty += c.ty;
+		}
+		const float n = float(top_count[r]);
+		const float norm = sqrtf(sum_cos * sum_cos + sum_sin * sum_sin);
+		if (norm == 0) continue;
+		const unsigned int matches = count_matches(p, sum_cos / norm, sum_sin / norm, sum_tx / n, sum_ty / n, s);
+		best = std::max(best, matches);
+	}
+
+	return std::min(1.0f, float(best) * float(best) / (float(np) * float(ng)));
+}
+
+} // namespace Minex
+} // namespace FingerJetFxOSE
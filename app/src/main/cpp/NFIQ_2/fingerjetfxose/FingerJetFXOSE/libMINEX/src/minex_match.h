@@ -0,0 +1,117 @@
+/*
+    FingerJetFX OSE -- Fingerprint Feature Extractor, Open Source Edition
+
+    Copyright (c) 2019 by HID Global, Inc. All rights reserved.
+
+    HID Global, FingerJet, and FingerJetFX are registered trademarks
+    or trademarks of HID Global, Inc. in the United States and other
+    countries.
+
+    FingerJetFX OSE is open source software that you may modify and/or
+    redistribute under the terms of the GNU Lesser General Public License
+    as published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version, provided that the
+    conditions specified in the COPYRIGHT.txt file provided with this
+    software are met.
+
+    For more information, please visit digitalpersona.com/fingerjetfx.
+*/
+
+#ifndef __minex_match_h
+#define __minex_match_h
+
+#include <stddef.h>
+#include <vector>
+#include "stdint.h"
+
+namespace FingerJetFxOSE {
+namespace Minex {
+
+// Minutiae of one template, as stored in a gallery: positions in 500 ppi
+// pixels, directions in 256ths of a full turn.
+struct template_view {
+	size_t size;
+	const int16_t *x;
+	const int16_t *y;
+	const uint8_t *theta;
+};
+
+// Owning counterpart of template_view
+struct minutiae {
+	std::vector<int16_t> x;
+	std::vector<int16_t> y;
+	std::vector<uint8_t> theta;
+
+	template_view view() const {
+		template_view v = { x.size(), x.data(), y.data(), theta.data() };
+		return v;
+	}
+};
+
+// Parse the first view of an ANSI INCITS 378-2004 template.
+// Returns false if the record is not a valid ANSI 378 template.
+bool parse_ansi378(const uint8_t *tmpl, minutiae &m);
+
+// Number of distinct keys produced by index_keys()
+const uint32_t index_key_count = 1 << 21;
+
+// Coarse, rotation and translation invariant keys of the minutiae triplets
+// formed by each minutia and pairs of its nearest neighbours. Keys are
+// sorted and unique.
+void index_keys(const template_view &m, std::vector<uint32_t> &keys);
+
+// Buffers reused between calls to score(); one per thread
+struct scratch {
+	struct pair {
+		float d;          // length
+		float alpha;      // direction from first to second minutia
+		float cos_alpha, sin_alpha;
+		float beta0;      // direction of first minutia relative to alpha
+		float beta1;      // direction of second minutia relative to alpha
+		uint16_t i0, i1;  // minutia indices
+		uint16_t bucket;  // beta0, quantized
+	};
+	struct candidate {
+		float cos_rotation, sin_rotation, tx, ty;
+		uint32_t bin;
+	};
+	std::vector<float> qx, qy, qcos, qsin;          // aligned probe
+	std::vector<float> gx, gy, gtheta, gcos, gsin;  // gallery
+	std::vector<float> cost;
+	std::vector<uint8_t> taken;
+	std::vector<pair> gpairs;       // sorted by bucket, then length
+	std::vector<uint32_t> gbuckets; // offset of each bucket in gpairs
+	std::vector<candidate> candidates;
+	std::vector<uint16_t> votes;  // candidates per alignment bin
+};
+
+// Precomputed probe state, so that one probe can be scored against many
+// gallery templates without repeating work.
+struct probe {
+	std::vector<float> x, y, theta, cos_theta, sin_theta;
+	std::vector<scratch::pair> pairs;
+
+	void assign(const template_view &m);
+	size_t size() const { return x.size(); }
+};
+
+// Similarity of a probe and a gallery template, in [0, 1]
+float score(const probe &p, const template_view &g, scratch &s);
+
+// Steps of score(), exposed for testing
+
+// Load the minutiae and bucketed pairs of a gallery template into s
+void load_gallery(const template_view &g, scratch &s);
+
+// Whether a probe pair and a gallery pair have similar lengths and
+// relative directions
+bool similar(const scratch::pair &pp, const scratch::pair &gp);
+
+// Alignments proposed by each probe pair and every similar gallery pair
+// loaded by load_gallery(), in s.candidates
+void find_candidates(const probe &p, scratch &s);
+
+} // namespace Minex
+} // namespace FingerJetFxOSE
+
+#endif // __minex_match_h
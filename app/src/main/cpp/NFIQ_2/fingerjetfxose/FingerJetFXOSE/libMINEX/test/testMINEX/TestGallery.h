@@ -0,0 +1,99 @@
+/*
+    FingerJetFX OSE -- Fingerprint Feature Extractor, Open Source Edition
+
+    Copyright (c) 2019 by HID Global, Inc. All rights reserved.
+
+    HID Global, FingerJet, and FingerJetFX are registered trademarks
+    or trademarks of HID Global, Inc. in the United States and other
+    countries.
+
+    FingerJetFX OSE is open source software that you may modify and/or
+    redistribute under the terms of the GNU Lesser General Public License
+    as published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version, provided that the
+    conditions specified in the COPYRIGHT.txt file provided with this
+    software are met.
+
+    For more information, please visit digitalpersona.com/fingerjetfx.
+*/
+
+#ifndef __TestGallery_h
+#define __TestGallery_h
+
+#include "minex.h"
+#include "minex_match.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+using namespace FingerJetFxOSE::Minex;
+
+class TestGallery : public CxxTest::TestSuite {
+  static const char *path() { return "TestGallery.fjxg"; }
+
+  // Write a gallery of three templates, one minutia each, whose postings
+  // are all filed under key 5
+  static void write_gallery(const uint32_t (&postings)[3]) {
+    const uint32_t count = 3, minutiae = 3, keys = index_key_count;
+    std::vector<uint32_t> words;
+    words.push_back(0);  // magic, filled in below
+    words.push_back(1);  // version
+    words.push_back(count);
+    words.push_back(minutiae);
+    words.push_back(keys);
+    words.push_back(3);  // postings
+    words.push_back(0);
+    words.push_back(0);
+    for (uint32_t i = 0; i <= count; i++) {
+      words.push_back(i);
+    }
+    for (uint32_t k = 0; k <= keys; k++) {
+      words.push_back(k <= 5 ? 0 : 3);
+    }
+    words.insert(words.end(), postings, postings + 3);
+    memcpy(&words[0], "FJXG", 4);
+
+    const int16_t xy[6] = { 10, 20, 30, 40, 50, 60 };
+    const uint8_t theta[3] = { 0, 64, 128 };
+    FILE *f = fopen(path(), "wb");
+    TS_ASSERT(f != nullptr);
+    if (f == nullptr) return;
+    fwrite(words.data(), sizeof(uint32_t), words.size(), f);
+    fwrite(xy, sizeof(int16_t), 6, f);
+    fwrite(theta, 1, 3, f);
+    fclose(f);
+  }
+
+  static int32_t open(const uint32_t (&postings)[3]) {
+    write_gallery(postings);
+    MINEX_GALLERY g = nullptr;
+    int32_t ret = open_gallery(path(), &g);
+    if (g != nullptr) close_gallery(g);
+    remove(path());
+    return ret;
+  }
+
+public:
+  void testValidGallery() {
+    const uint32_t postings[3] = { 0, 1, 2 };
+    TS_ASSERT_EQUALS(open(postings), MINEX_RET_SUCCESS);
+  }
+
+  void testPostingOutOfRange() {
+    const uint32_t postings[3] = { 0, 1, 3 };
+    TS_ASSERT_EQUALS(open(postings), MINEX_RET_FAILURE_BAD_GALLERY);
+  }
+
+  void testPostingsDescending() {
+    const uint32_t postings[3] = { 0, 2, 1 };
+    TS_ASSERT_EQUALS(open(postings), MINEX_RET_FAILURE_BAD_GALLERY);
+  }
+
+  void testPostingsDuplicate() {
+    const uint32_t postings[3] = { 0, 1, 1 };
+    TS_ASSERT_EQUALS(open(postings), MINEX_RET_FAILURE_BAD_GALLERY);
+  }
+};
+
+#endif // __TestGallery_h
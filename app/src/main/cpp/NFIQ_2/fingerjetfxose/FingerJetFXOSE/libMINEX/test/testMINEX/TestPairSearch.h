@@ -0,0 +1,102 @@
+/*
+    FingerJetFX OSE -- Fingerprint Feature Extractor, Open Source Edition
+
+    Copyright (c) 2019 by HID Global, Inc. All rights reserved.
+
+    HID Global, FingerJet, and FingerJetFX are registered trademarks
+    or trademarks of HID Global, Inc. in the United States and other
+    countries.
+
+    FingerJetFX OSE is open source software that you may modify and/or
+    redistribute under the terms of the GNU Lesser General Public License
+    as published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version, provided that the
+    conditions specified in the COPYRIGHT.txt file provided with this
+    software are met.
+
+    For more information, please visit digitalpersona.com/fingerjetfx.
+*/
+
+#ifndef __TestPairSearch_h
+#define __TestPairSearch_h
+
+#include "minex_match.h"
+
+#include <random>
+
+using namespace FingerJetFxOSE::Minex;
+
+class TestPairSearch : public CxxTest::TestSuite {
+  std::mt19937 rng;
+
+  // Random minutiae in a 400 by 500 pixel image
+  minutiae random_template(size_t n) {
+    std::uniform_int_distribution<int> x(0, 399), y(0, 499), theta(0, 255);
+    minutiae m;
+    for (size_t i = 0; i < n; i++) {
+      m.x.push_back(int16_t(x(rng)));
+      m.y.push_back(int16_t(y(rng)));
+      m.theta.push_back(uint8_t(theta(rng)));
+    }
+    return m;
+  }
+
+  // Copy of m with positions moved by up to jitter pixels and directions
+  // turned by turn 256ths
+  minutiae distort(const minutiae &m, int jitter, int turn) {
+    std::uniform_int_distribution<int> d(-jitter, jitter);
+    minutiae q = m;
+    for (size_t i = 0; i < q.x.size(); i++) {
+      q.x[i] = int16_t(q.x[i] + d(rng));
+      q.y[i] = int16_t(q.y[i] + d(rng));
+      q.theta[i] = uint8_t(q.theta[i] + turn);
+    }
+    return q;
+  }
+
+  // Compare find_candidates() with a search of every gallery pair
+  void check(const minutiae &probe_minutiae, const minutiae &gallery) {
+    probe p;
+    p.assign(probe_minutiae.view());
+    scratch s;
+    load_gallery(gallery.view(), s);
+    find_candidates(p, s);
+
+    size_t expected = 0;
+    for (const scratch::pair &pp : p.pairs) {
+      for (const scratch::pair &gp : s.gpairs) {
+        if (similar(pp, gp)) expected++;
+      }
+    }
+    TS_ASSERT_EQUALS(s.candidates.size(), expected);
+  }
+
+public:
+  TestPairSearch() : rng(378) {}
+
+  void testUnrelatedTemplates() {
+    for (int i = 0; i < 50; i++) {
+      check(random_template(40), random_template(40));
+    }
+  }
+
+  void testDistortedTemplates() {
+    for (int i = 0; i < 50; i++) {
+      const minutiae m = random_template(60);
+      check(distort(m, 3, 0), m);
+    }
+  }
+
+  // Directions turned by 16/256 of a full turn, just inside
+  // pair_angle_tolerance, so that jitter leaves many pairs on either side
+  // of the tolerance
+  void testPairsAtTolerance() {
+    for (int i = 0; i < 50; i++) {
+      const minutiae m = random_template(60);
+      check(distort(m, 1, 16), m);
+      check(distort(m, 1, -16), m);
+    }
+  }
+};
+
+#endif // __TestPairSearch_h
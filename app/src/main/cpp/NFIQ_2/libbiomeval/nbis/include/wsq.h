@@ -216,6 +216,8 @@ extern int biomeval_nbis_read_wsq_frame_header(unsigned char *, const int, int *
 /* decoder.c */
 extern int biomeval_nbis_wsq_decode_mem(unsigned char **, int *, int *, int *, int *, int *,
                  unsigned char *, const int);
+extern int biomeval_nbis_wsq_decode_reduced_mem(unsigned char **, int *, int *,
+                 int *, int *, int *, unsigned char *, const int, const int);
 extern int biomeval_nbis_wsq_decode_file(unsigned char **, int *, int *, int *, int *,
                  int *, FILE *);
 extern int biomeval_nbis_huffman_decode_data_mem(short *, DTT_TABLE *, DQT_TABLE *,
@@ -327,6 +329,9 @@ extern void biomeval_nbis_get_lets(float *, float *, const int, const int, const
                  const int, float *, const int, float *, const int, const int);
 extern int biomeval_nbis_wsq_reconstruct(float *, const int, const int,
                  W_TREE biomeval_nbis_w_tree[], const int, const DTT_TABLE *);
+extern int biomeval_nbis_wsq_reconstruct_reduced(float *, const int, const int,
+                 W_TREE biomeval_nbis_w_tree[], const int, const DTT_TABLE *,
+                 const int, int *, int *);
 extern void  biomeval_nbis_join_lets(float *, float *, const int, const int,
                  const int, const int, float *, const int,
                  float *, const int, const int);
@@ -58,6 +58,9 @@ of the software.
 #cat: biomeval_nbis_wsq_decode_mem - Decodes a datastream of WSQ compressed bytes
 #cat:                  from a memory buffer, returning a lossy
 #cat:                  reconstructed pixmap.
+#cat: biomeval_nbis_wsq_decode_reduced_mem - Decodes a datastream of WSQ
+#cat:                  compressed bytes from a memory buffer, optionally
+#cat:                  returning the pixmap at half resolution.
 #cat: biomeval_nbis_wsq_decode_file - Decodes a datastream of WSQ compressed bytes
 #cat:                  from an open file, returning a lossy
 #cat:                  reconstructed pixmap.
@@ -91,11 +94,26 @@ of the software.
 /***************************************************************************/
 int biomeval_nbis_wsq_decode_mem(unsigned char **odata, int *ow, int *oh, int *od, int *oppi,
                    int *lossyflag, unsigned char *idata, const int ilen)
+{
+   return(biomeval_nbis_wsq_decode_reduced_mem(odata, ow, oh, od, oppi,
+                   lossyflag, idata, ilen, 0));
+}
+
+/***************************************************************************/
+/* WSQ Decoder routine.  Takes an WSQ compressed memory buffer and decodes */
+/* it, returning the reconstructed pixmap.  When reduce is 1, the final    */
+/* synthesis level is skipped and the lowpass subband is returned as a    */
+/* pixmap of half the width and height (rounded up).                      */
+/***************************************************************************/
+int biomeval_nbis_wsq_decode_reduced_mem(unsigned char **odata, int *ow, int *oh,
+                   int *od, int *oppi, int *lossyflag, unsigned char *idata,
+                   const int ilen, const int reduce)
 {
    int ret, i;
    unsigned short marker;         /* WSQ marker */
    int num_pix;                   /* image size and counter */
    int width, height, ppi;        /* image parameters */
+   int owidth, oheight;           /* reconstructed pixmap size */
    unsigned char *cdata;          /* image pointer */
    float *fdata;                  /* image pointers */
    short *qdata;                  /* image pointers */
@@ -192,8 +210,10 @@ int biomeval_nbis_wsq_decode_mem(unsigned char **odata, int *ow, int *oh, int *o
    /* Done with quantized wavelet subband data. */
    free(qdata);
 
-   if((ret = biomeval_nbis_wsq_reconstruct(fdata, width, height, biomeval_nbis_w_tree, W_TREELEN,
-                              &biomeval_nbis_dtt_table))){
+   if((ret = biomeval_nbis_wsq_reconstruct_reduced(fdata, width, height,
+                              biomeval_nbis_w_tree, W_TREELEN,
+                              &biomeval_nbis_dtt_table, reduce,
+                              &owidth, &oheight))){
       free(fdata);
       biomeval_nbis_free_wsq_decoder_resources();
       return(ret);
@@ -202,7 +222,7 @@ int biomeval_nbis_wsq_decode_mem(unsigned char **odata, int *ow, int *oh, int *o
    if(biomeval_nbis_debug > 0)
       fprintf(stderr, "WSQ reconstruction of image finished\n\n");
 
-   cdata = (unsigned char *)malloc(num_pix * sizeof(unsigned char));
+   cdata = (unsigned char *)malloc(owidth * oheight * sizeof(unsigned char));
    if(cdata == (unsigned char *)NULL) {
       free(fdata);
       biomeval_nbis_free_wsq_decoder_resources();
@@ -211,7 +231,7 @@ int biomeval_nbis_wsq_decode_mem(unsigned char **odata, int *ow, int *oh, int *o
    }
 
    /* Convert floating point pixels to unsigned char pixels. */
-   biomeval_nbis_conv_img_2_uchar(cdata, fdata, width, height,
+   biomeval_nbis_conv_img_2_uchar(cdata, fdata, owidth, oheight,
                       biomeval_nbis_frm_header_wsq.m_shift, biomeval_nbis_frm_header_wsq.r_scale);
 
    /* Done with floating point pixels. */
@@ -225,10 +245,10 @@ int biomeval_nbis_wsq_decode_mem(unsigned char **odata, int *ow, int *oh, int *o
 
    /* Assign reconstructed pixmap and attributes to output pointers. */
    *odata = cdata;
-   *ow = width;
-   *oh = height;
+   *ow = owidth;
+   *oh = oheight;
    *od = 8;
-   *oppi = ppi;
+   *oppi = ((reduce != 0) && (ppi > 0)) ? ppi / 2 : ppi;
    *lossyflag = 1;
 
    /* Return normally. */
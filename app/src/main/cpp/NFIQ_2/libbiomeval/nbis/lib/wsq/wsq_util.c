@@ -76,6 +76,8 @@ of the software.
 #cat:
 #cat: biomeval_nbis_wsq_reconstruct - Reconstructs a lossy floating point pixmap from
 #cat:                  a WSQ compressed datastream.
+#cat: biomeval_nbis_wsq_reconstruct_reduced - Reconstructs a lossy floating point
+#cat:                  pixmap, optionally at half resolution.
 #cat: biomeval_nbis_join_lets - Reconstruct the image from the wavelet subbands.
 #cat:
 #cat: biomeval_nbis_int_sign - Get the sign of the sythesis filter coefficients.
@@ -930,6 +932,97 @@ int biomeval_nbis_wsq_reconstruct(float *fdata, const int width, const int heigh
    return(0);
 }
 
+/************************************************************************/
+/* WSQ reconstructs the image, optionally skipping the final synthesis  */
+/* level.  When reduce is 1, only the subbands within the first lowpass */
+/* split are joined, and the lowpass subband, normalized by the filter  */
+/* gain, is returned packed at the start of "fdata".                    */
+/************************************************************************/
+int biomeval_nbis_wsq_reconstruct_reduced(float *fdata, const int width,
+                  const int height, W_TREE w_tree[], const int w_treelen,
+                  const DTT_TABLE *dtt_table, const int reduce,
+                  int *owidth, int *oheight)
+{
+   int ret, num_pix, node, r, c, i;
+   int lenx, leny;
+   float *fdata1, *fdata_bse;
+   float gain;
+
+   if(reduce == 0) {
+      if((ret = biomeval_nbis_wsq_reconstruct(fdata, width, height, w_tree,
+                                w_treelen, dtt_table)))
+         return(ret);
+      *owidth = width;
+      *oheight = height;
+      return(0);
+   }
+
+   if(reduce != 1) {
+      fprintf(stderr,
+      "ERROR: biomeval_nbis_wsq_reconstruct_reduced : reduce %d not supported\n",
+      reduce);
+      return(-98);
+   }
+   if(dtt_table->lodef != 1) {
+      fprintf(stderr,
+      "ERROR: biomeval_nbis_wsq_reconstruct_reduced : Lopass filter coefficients not defined\n");
+      return(-95);
+   }
+   if(dtt_table->hidef != 1) {
+      fprintf(stderr,
+      "ERROR: biomeval_nbis_wsq_reconstruct_reduced : Hipass filter coefficients not defined\n");
+      return(-96);
+   }
+
+   num_pix = width * height;
+   /* Allocate temporary floating point pixmap. */
+   if((fdata1 = (float *) malloc(num_pix*sizeof(float))) == NULL) {
+      fprintf(stderr,"ERROR : biomeval_nbis_wsq_reconstruct_reduced : malloc : fdata1\n");
+      return(-97);
+   }
+
+   /* Node 1 holds the lowpass subband of the first split. */
+   lenx = w_tree[1].lenx;
+   leny = w_tree[1].leny;
+
+   /* Reconstruct only the nodes that lie within the lowpass subband. */
+   for (node = w_treelen - 1; node >= 1; node--) {
+      if((w_tree[node].x + w_tree[node].lenx > lenx) ||
+         (w_tree[node].y + w_tree[node].leny > leny))
+         continue;
+
+      fdata_bse = fdata + (w_tree[node].y * width) + w_tree[node].x;
+      biomeval_nbis_join_lets(fdata1, fdata_bse, w_tree[node].lenx, w_tree[node].leny,
+                  1, width,
+                  dtt_table->hifilt, dtt_table->hisz,
+                  dtt_table->lofilt, dtt_table->losz,
+                  w_tree[node].inv_cl);
+      biomeval_nbis_join_lets(fdata_bse, fdata1, w_tree[node].leny, w_tree[node].lenx,
+                  width, 1,
+                  dtt_table->hifilt, dtt_table->hisz,
+                  dtt_table->lofilt, dtt_table->losz,
+                  w_tree[node].inv_rw);
+   }
+   free(fdata1);
+
+   /* Lowpass filtering rows and columns scales pixels by the square */
+   /* of the filter's DC gain.                                      */
+   gain = 0.0;
+   for(i = 0; i < dtt_table->losz; i++)
+      gain += dtt_table->lofilt[i];
+   gain *= gain;
+
+   /* Pack the subband rows; each destination precedes its source. */
+   for(r = 0; r < leny; r++)
+      for(c = 0; c < lenx; c++)
+         fdata[(r * lenx) + c] = fdata[(r * width) + c] / gain;
+
+   *owidth = lenx;
+   *oheight = leny;
+
+   return(0);
+}
+
 /****************************************************************/
 void  biomeval_nbis_join_lets(
    float *new,    /* image pointers for creating subband splits */
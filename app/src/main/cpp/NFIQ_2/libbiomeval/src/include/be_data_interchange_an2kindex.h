@@ -0,0 +1,201 @@
+/*
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ */
+
+#ifndef __BE_DATA_INTERCHANGE_AN2KINDEX__
+#define __BE_DATA_INTERCHANGE_AN2KINDEX__
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <be_data_interchange_an2k.h>
+#include <be_image.h>
+#include <be_image_image.h>
+#include <be_memory_autoarray.h>
+#include <be_view_an2kview.h>
+
+namespace BiometricEvaluation
+{
+	namespace DataInterchange
+	{
+		/**
+		 * @brief
+		 * Locations of the logical records of an ANSI/NIST
+		 * transaction, with fingerprint images read in place.
+		 * @details
+		 * Record boundaries are found in a single pass over the
+		 * buffer. Only the fields of Type-4 and Type-14 records
+		 * needed to decode their images are read, and image data
+		 * is not copied. Other records are skipped until
+		 * getRecord() parses the complete transaction.
+		 *
+		 * The buffer is not copied and must outlive this object.
+		 */
+		class AN2KIndex {
+		public:
+			/** Location of a logical record in the buffer */
+			struct RecordLocation {
+				/** Record type */
+				uint16_t type;
+				/** Offset of the record in the buffer */
+				uint64_t offset;
+				/** Length of the record, in bytes */
+				uint64_t length;
+			};
+
+			/** An image record, referring into the buffer */
+			struct ImageRecord {
+				/** Record type (Type_4 or Type_14) */
+				View::AN2KView::RecordType type;
+				/** Position among records of the same type */
+				uint32_t recordNumber;
+				/** Information designation character */
+				uint32_t idc;
+				/** First finger position, as encoded */
+				int fingerPosition;
+				/** Dimensions of the image */
+				Image::Size size;
+				/** Resolution of the image */
+				Image::Resolution resolution;
+				/** Bits per pixel */
+				uint32_t colorDepth;
+				/** Compression of imageData */
+				Image::CompressionAlgorithm compression;
+				/** Image data, within the buffer */
+				const uint8_t *imageData;
+				/** Size of imageData, in bytes */
+				uint64_t imageDataSize;
+			};
+
+			/**
+			 * @brief
+			 * Index an ANSI/NIST transaction.
+			 *
+			 * @param buf
+			 *	Buffer containing the transaction. Must
+			 *	outlive this object.
+			 *
+			 * @throw Error::DataError
+			 *	The record boundaries, or the fields of an
+			 *	image record, could not be read.
+			 */
+			AN2KIndex(
+			    const Memory::uint8Array &buf);
+
+			/**
+			 * @brief
+			 * Obtain the locations of all logical records.
+			 *
+			 * @return
+			 *	Locations of each record, Type-1 first.
+			 */
+			const std::vector<RecordLocation>&
+			getRecordLocations()
+			    const;
+
+			/**
+			 * @brief
+			 * Obtain the Type-14 variable-resolution finger
+			 * captures.
+			 *
+			 * @return
+			 *	Type-14 records, in transaction order.
+			 */
+			const std::vector<ImageRecord>&
+			getFingerCaptures()
+			    const;
+
+			/**
+			 * @brief
+			 * Obtain the Type-4 high-resolution grayscale
+			 * finger captures.
+			 *
+			 * @return
+			 *	Type-4 records, in transaction order.
+			 */
+			const std::vector<ImageRecord>&
+			getFingerFixedResolutionCaptures()
+			    const;
+
+			/**
+			 * @brief
+			 * Decode the image of an image record.
+			 *
+			 * @param record
+			 *	Image record from this index.
+			 * @param identifier
+			 *	Identifier given to the Image.
+			 *
+			 * @return
+			 *	The image. Compressed image data is copied
+			 *	by the Image; uncompressed data is copied
+			 *	into a Raw image.
+			 *
+			 * @throw Error::Exception
+			 *	The image could not be opened.
+			 */
+			static std::shared_ptr<Image::Image>
+			getImage(
+			    const ImageRecord &record,
+			    const std::string &identifier = "");
+
+			/**
+			 * @brief
+			 * Parse the complete transaction.
+			 *
+			 * @return
+			 *	AN2KRecord for the indexed buffer, parsed on
+			 *	the first call.
+			 *
+			 * @throw Error::Exception
+			 *	The transaction could not be parsed.
+			 */
+			std::shared_ptr<AN2KRecord>
+			getRecord()
+			    const;
+
+		private:
+			/**
+			 * Read the fields of a Type-14 record.
+			 */
+			ImageRecord
+			readTaggedImageRecord(
+			    const RecordLocation &location,
+			    uint32_t recordNumber)
+			    const;
+
+			/**
+			 * Read the header of a Type-4 record.
+			 */
+			ImageRecord
+			readBinaryImageRecord(
+			    const RecordLocation &location,
+			    uint32_t recordNumber)
+			    const;
+
+			/** The indexed buffer */
+			const Memory::uint8Array &_buf;
+			/** Native scanning resolution from Type-1, in PPMM */
+			double _nativeScanResolution{0};
+
+			/** Every logical record */
+			std::vector<RecordLocation> _records{};
+			/** Type-14 records */
+			std::vector<ImageRecord> _fingerCaptures{};
+			/** Type-4 records */
+			std::vector<ImageRecord> _fingerFixedResolution{};
+
+			/** Complete record, once parsed */
+			mutable std::shared_ptr<AN2KRecord> _record{};
+		};
+	}
+}
+
+#endif /* __BE_DATA_INTERCHANGE_AN2KINDEX__ */
@@ -239,6 +239,47 @@ namespace BiometricEvaluation
 			    uint8_t depth)
 			    const = 0;
 
+			/**
+			 * @brief
+			 * Decode at a reduced resolution.
+			 * @details
+			 * Wavelet-compressed images can be reconstructed at
+			 * a fraction of their encoded resolution without
+			 * first being decoded at full resolution. Each level
+			 * halves the dimensions (rounding up) and resolution
+			 * of this object, and of the raw data returned.
+			 *
+			 * @param[in] levels
+			 *	Number of resolution levels to discard, or 0
+			 *	to decode at full resolution.
+			 *
+			 * @throw Error::ParameterError
+			 *	levels exceeds
+			 *	getMaximumResolutionReduction().
+			 */
+			void
+			setResolutionReduction(
+			    uint8_t levels);
+
+			/**
+			 * @return
+			 *	Number of resolution levels discarded when
+			 *	decoding.
+			 */
+			uint8_t
+			getResolutionReduction()
+			    const;
+
+			/**
+			 * @return
+			 *	Number of resolution levels that may be
+			 *	discarded when decoding. 0 unless the
+			 *	compression algorithm supports it.
+			 */
+			virtual uint8_t
+			getMaximumResolutionReduction()
+			    const;
+
 			/**
 		 	 * @brief
 			 * Accessor for the dimensions of the image in pixels.
@@ -631,6 +672,13 @@ namespace BiometricEvaluation
 			/** Status callback */
 			statusCallback_t _statusCallback{
 			    Image::defaultStatusCallback};
+
+			/** Resolution levels discarded when decoding */
+			uint8_t _resolutionReduction{0};
+			/** Dimensions before any reduction */
+			Size _fullDimensions{};
+			/** Resolution before any reduction */
+			Resolution _fullResolution{};
 		};
 	}
 }
@@ -84,10 +84,49 @@ namespace BiometricEvaluation
 			    const uint8_t *data,
 			    uint64_t size);
 
+			/**
+			 * @return
+			 *	Number of resolution levels that may be
+			 *	discarded, as encoded in the codestream.
+			 */
+			uint8_t
+			getMaximumResolutionReduction()
+			    const;
+
+			/**
+			 * @brief
+			 * Set the number of threads that decodes may borrow.
+			 * @details
+			 * The budget is shared by every JPEG2000 object in
+			 * the process. Each decode borrows what is not in use
+			 * by other decodes for code-block and wavelet
+			 * parallelism, and returns it when finished. A pool
+			 * of N workers on a machine with C cores should set
+			 * a budget of C - N. The default, 0, decodes on the
+			 * calling thread only.
+			 *
+			 * @param[in] threads
+			 *	Number of additional threads.
+			 */
+			static void
+			setDecodeThreadBudget(
+			    uint32_t threads);
+
+			/**
+			 * @return
+			 *	Number of additional threads decodes may
+			 *	borrow.
+			 */
+			static uint32_t
+			getDecodeThreadBudget();
+
 		private:
 			/** JPEG2000 codec to use (from libopenjpeg) */
 			const int8_t _codecFormat;
 
+			/** Resolution levels in the codestream */
+			uint8_t _resolutionLevels{1};
+
 			/**
 			 * @brief
 			 * Parse CDEF box to check for an opacity component.
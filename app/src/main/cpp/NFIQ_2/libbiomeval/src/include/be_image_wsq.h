@@ -47,6 +47,15 @@ namespace BiometricEvaluation
 			getRawGrayscaleData(
 			    uint8_t depth) const;
 
+			/**
+			 * @return
+			 *	1. The lowpass subband of the first wavelet
+			 *	split can be reconstructed on its own.
+			 */
+			uint8_t
+			getMaximumResolutionReduction()
+			    const;
+
 			/**
 			 * Whether or not data is a WSQ image.
 			 *
@@ -165,6 +165,54 @@ namespace BiometricEvaluation
 			    const std::string &pathname)
 			    override;
 
+			/**
+			 * @brief
+			 * Default size of the blocks compressed in parallel.
+			 */
+			static const uint64_t DEFAULT_BLOCK_SIZE;
+
+			/**
+			 * @brief
+			 * Compress and decompress records on worker threads.
+			 * @details
+			 * With threads greater than 0, records are split into
+			 * blocks of blockSize bytes that are compressed
+			 * independently. insert() returns once the record has
+			 * been queued, and compressed records are written to
+			 * the backing store in insertion order. Blocks of a
+			 * record are decompressed in parallel by read().
+			 * Queued records are written before any other
+			 * operation that could observe them, including sync()
+			 * and destruction.
+			 *
+			 * Records written as blocks can be read without
+			 * parallel compression enabled, but not by versions
+			 * of this class that predate this method.
+			 *
+			 * @param[in] threads
+			 *	Number of worker threads, or 0 to compress each
+			 *	record as a single stream on the calling thread.
+			 * @param[in] blockSize
+			 *	Uncompressed bytes in each block.
+			 *
+			 * @throw Error::StrategyError
+			 *	blockSize is 0, or a queued record could not be
+			 *	written.
+			 */
+			void
+			setParallelCompression(
+			    uint32_t threads,
+			    uint64_t blockSize = DEFAULT_BLOCK_SIZE);
+
+			/**
+			 * @return
+			 *	Number of worker threads compressing and
+			 *	decompressing records.
+			 */
+			uint32_t
+			getCompressionThreads()
+			    const;
+
 			/**
 			 * @brief
 			 * Copy constructor (disabled).
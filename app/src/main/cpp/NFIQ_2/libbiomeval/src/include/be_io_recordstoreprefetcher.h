@@ -0,0 +1,125 @@
+/*
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ */
+
+#ifndef BE_IO_RECORDSTOREPREFETCHER_H_
+#define BE_IO_RECORDSTOREPREFETCHER_H_
+
+#include <cstdint>
+#include <memory>
+
+#include <be_io_recordstore.h>
+
+namespace BiometricEvaluation
+{
+	namespace IO
+	{
+		/**
+		 * @brief
+		 * Asynchronous, read-ahead sequencing of a RecordStore.
+		 * @details
+		 * Keys are obtained from the RecordStore's sequence cursor
+		 * and the associated records are read by a small pool of
+		 * I/O threads, each holding its own read-only handle to the
+		 * RecordStore. Up to `window' records are kept in flight or
+		 * buffered at any time. Records are always returned from
+		 * sequence() in the order of the underlying RecordStore's
+		 * sequence, regardless of the order in which reads complete.
+		 *
+		 * sequence() may be called concurrently from multiple
+		 * consumer threads.
+		 *
+		 * @note
+		 * The RecordStore passed to the constructor must not be
+		 * sequenced by any other means while the prefetcher exists.
+		 */
+		class RecordStorePrefetcher
+		{
+		public:
+			/** Default number of records to read ahead */
+			static const uint32_t DefaultWindow = 64;
+			/** Default number of I/O threads */
+			static const uint32_t DefaultIOThreads = 4;
+
+			/**
+			 * RecordStorePrefetcher constructor.
+			 *
+			 * @param recordStore
+			 * RecordStore whose sequence cursor will be used to
+			 * order records.
+			 * @param window
+			 * Maximum number of records in flight or awaiting
+			 * consumption.
+			 * @param ioThreads
+			 * Number of threads concurrently reading records.
+			 * @param cursor
+			 * Position of the first record returned, either
+			 * RecordStore::BE_RECSTORE_SEQ_START or
+			 * RecordStore::BE_RECSTORE_SEQ_NEXT (e.g., after
+			 * a call to RecordStore::setCursorAtKey()).
+			 *
+			 * @throw Error::ParameterError
+			 * window or ioThreads is 0, or cursor is invalid.
+			 * @throw Error::StrategyError
+			 * Could not open additional handles to recordStore.
+			 */
+			RecordStorePrefetcher(
+			    const std::shared_ptr<RecordStore> &recordStore,
+			    uint32_t window = DefaultWindow,
+			    uint32_t ioThreads = DefaultIOThreads,
+			    int cursor = RecordStore::BE_RECSTORE_SEQ_START);
+
+			/**
+			 * @brief
+			 * Obtain the next record in sequence.
+			 * @details
+			 * Blocks until the next record in sequence has been
+			 * read.
+			 *
+			 * @return
+			 * The next record in sequence.
+			 *
+			 * @throw Error::ObjectDoesNotExist
+			 * End of sequencing.
+			 * @throw Error::StrategyError
+			 * An error occurred when reading the record from the
+			 * underlying RecordStore.
+			 */
+			RecordStore::Record
+			sequence();
+
+			/** @return Maximum records in flight. */
+			uint32_t
+			getWindow()
+			    const;
+
+			/* Prevent copying of RecordStorePrefetcher objects */
+			RecordStorePrefetcher(const RecordStorePrefetcher&) =
+			    delete;
+			RecordStorePrefetcher& operator=(
+			    const RecordStorePrefetcher&) = delete;
+
+			/**
+			 * @brief
+			 * Destructor.
+			 * @details
+			 * Outstanding reads are allowed to complete and
+			 * their records are discarded.
+			 */
+			~RecordStorePrefetcher();
+
+		private:
+			class Impl;
+			/** Pointer to implementation */
+			std::unique_ptr<RecordStorePrefetcher::Impl> pimpl;
+		};
+	}
+}
+
+#endif /* BE_IO_RECORDSTOREPREFETCHER_H_ */
@@ -182,6 +182,8 @@ namespace BiometricEvaluation
 			 * @note
 			 * Exceptions are thrown after read() has been called
 			 * on all member RecordStores.
+			 * @note
+			 * Member RecordStores are read concurrently.
 			 */
 			std::map<const std::string,
 			BiometricEvaluation::Memory::uint8Array>
@@ -189,6 +191,65 @@ namespace BiometricEvaluation
 			    const std::string &key)
 			    const;
 
+			/**
+			 * @brief
+			 * Read a key from the first member RecordStore found
+			 * to contain it.
+			 *
+			 * @param key
+			 * The key to read.
+			 *
+			 * @return
+			 * Pair of the name of a RecordStore containing key
+			 * and the data read from said RecordStore.
+			 *
+ 			 * @throw Error::ObjectDoesNotExist
+			 * key does not exist in any member RecordStores.
+			 * @throw Error::StrategyError
+			 * Exceptions propagated from RecordStore, with the
+			 * exception of ObjectDoesNotExist, when no member
+			 * RecordStore returned key.
+			 *
+			 * @note
+			 * Member RecordStores are searched concurrently. Once
+			 * one contains key, searches that have not yet started
+			 * are skipped and the search returns when those in
+			 * progress finish, so when several members contain
+			 * key, any of them may be returned.
+			 */
+			std::pair<std::string,
+			BiometricEvaluation::Memory::uint8Array>
+			readFirst(
+			    const std::string &key)
+			    const;
+
+			/**
+			 * @brief
+			 * Read many keys from all member RecordStores.
+			 *
+			 * @param keys
+			 * The keys to read.
+			 *
+			 * @return
+			 * Map of key to a map of RecordStore name to data
+			 * read from said RecordStore. Keys that do not exist
+			 * in any member RecordStore are not included.
+			 *
+			 * @throw Error::StrategyError
+			 * Exceptions propagated from RecordStore, with the
+			 * exception of ObjectDoesNotExist.
+			 *
+			 * @note
+			 * Each member RecordStore reads every key in turn,
+			 * concurrently with the other members. Exceptions are
+			 * thrown after all keys have been read.
+			 */
+			std::map<const std::string, std::map<const std::string,
+			BiometricEvaluation::Memory::uint8Array>>
+			read(
+			    const std::vector<std::string> &keys)
+			    const;
+
 			/**
 			 * @brief
 			 * Retrieve the length of a key from all member
@@ -210,6 +271,8 @@ namespace BiometricEvaluation
 			 * @note
 			 * Exceptions are thrown after length() has been called
 			 * on all member RecordStores.
+			 * @note
+			 * Member RecordStores are queried concurrently.
 			 */
 			std::map<const std::string, uint64_t>
 			length(
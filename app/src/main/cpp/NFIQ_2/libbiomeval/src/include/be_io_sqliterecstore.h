@@ -97,6 +97,39 @@ namespace BiometricEvaluation
 			    const std::string &key)
 			    override;
 
+			/**
+			 * @brief
+			 * Group writes into transactions.
+			 * @details
+			 * When records is greater than 1, inserts and
+			 * removes are committed together once records of
+			 * them are pending, or when sync() or flush() is
+			 * called or the RecordStore is closed. The database
+			 * is switched to write-ahead log journaling, so
+			 * committing does not rewrite the database file.
+			 * Records written in an open transaction may be lost
+			 * if the process exits abnormally.
+			 *
+			 * @param records
+			 *	Number of writes to commit together. 0 or 1
+			 *	commits every write on its own (the default).
+			 *
+			 * @throw Error::StrategyError
+			 *	RecordStore was opened read-only, or error
+			 *	committing pending writes or changing
+			 *	journaling.
+			 */
+			void
+			setTransactionSize(
+			    uint64_t records);
+
+			/**
+			 * @return
+			 *	Number of writes committed together.
+			 */
+			uint64_t
+			getTransactionSize() const;
+
 			~SQLiteRecordStore();
 
 			SQLiteRecordStore(const SQLiteRecordStore&) = delete;
@@ -0,0 +1,431 @@
+/*
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+
+#include <be_data_interchange_an2kindex.h>
+#include <be_error_exception.h>
+#include <be_image_raw.h>
+extern "C" {
+#include <an2k.h>
+}
+
+namespace BE = BiometricEvaluation;
+
+/* Size of the fixed header of Type-3 through Type-6 records */
+static const uint64_t BINARY_HEADER_LENGTH{18};
+
+/******************************************************************************/
+/* Private functions.                                                         */
+/******************************************************************************/
+
+/*
+ * Parse an unsigned decimal number, requiring at least one digit.
+ */
+static uint64_t
+parseNumber(
+    const uint8_t *value,
+    const uint64_t size)
+{
+	if (size == 0)
+		throw BE::Error::DataError("Empty numeric field");
+
+	uint64_t number = 0;
+	for (uint64_t i = 0; i < size; i++) {
+		if ((value[i] < '0') || (value[i] > '9'))
+			throw BE::Error::DataError("Invalid numeric field");
+		number = (number * 10) + (value[i] - '0');
+	}
+	return (number);
+}
+
+/*
+ * Value of a field, up to the first item or subfield separator.
+ */
+static std::string
+firstItem(
+    const uint8_t *value,
+    const uint64_t size)
+{
+	uint64_t length = 0;
+	while ((length < size) && (value[length] != US_CHAR) &&
+	    (value[length] != RS_CHAR))
+		length++;
+	return (std::string(reinterpret_cast<const char *>(value), length));
+}
+
+/*
+ * Read the length of a tagged record from its leading "T.001:" field.
+ */
+static uint64_t
+readTaggedLength(
+    const uint8_t *record,
+    const uint64_t available)
+{
+	uint64_t pos = 0;
+	while ((pos < available) && (record[pos] != ':'))
+		pos++;
+	uint64_t start = ++pos;
+	while ((pos < available) && (record[pos] != GS_CHAR) &&
+	    (record[pos] != FS_CHAR))
+		pos++;
+	if (pos >= available)
+		throw BE::Error::DataError("Could not read record length");
+
+	return (parseNumber(record + start, pos - start));
+}
+
+/*
+ * Call fieldFn with the number and value of each field in a tagged record.
+ * The image field, which may contain separators, is always last.
+ */
+static void
+forEachTaggedField(
+    const uint8_t *record,
+    const uint64_t length,
+    const std::function<void(unsigned int, const uint8_t *, uint64_t)>
+    &fieldFn)
+{
+	uint64_t pos = 0;
+	while (pos < length) {
+		/* Tag: "<record type>.<field number>:" */
+		uint64_t dot = pos;
+		while ((dot < length) && (record[dot] != '.'))
+			dot++;
+		uint64_t colon = dot;
+		while ((colon < length) && (record[colon] != ':'))
+			colon++;
+		if (colon >= length)
+			throw BE::Error::DataError("Invalid field tag");
+		const unsigned int field = static_cast<unsigned int>(
+		    parseNumber(record + dot + 1, colon - dot - 1));
+
+		const uint64_t start = colon + 1;
+		if (field == IMAGE_FIELD) {
+			/* Image data runs to the record separator */
+			if ((start >= length) ||
+			    (record[length - 1] != FS_CHAR))
+				throw BE::Error::DataError("Invalid image "
+				    "field");
+			fieldFn(field, record + start, length - 1 - start);
+			return;
+		}
+
+		uint64_t end = start;
+		while ((end < length) && (record[end] != GS_CHAR) &&
+		    (record[end] != FS_CHAR))
+			end++;
+		if (end >= length)
+			throw BE::Error::DataError("Unterminated field");
+		fieldFn(field, record + start, end - start);
+		if (record[end] == FS_CHAR)
+			return;
+		pos = end + 1;
+	}
+}
+
+BiometricEvaluation::DataInterchange::AN2KIndex::ImageRecord
+BiometricEvaluation::DataInterchange::AN2KIndex::readTaggedImageRecord(
+    const RecordLocation &location,
+    uint32_t recordNumber)
+    const
+{
+	ImageRecord image{};
+	image.type = View::AN2KView::RecordType::Type_14;
+	image.recordNumber = recordNumber;
+
+	bool haveIDC{false}, haveHLL{false}, haveVLL{false}, haveSLC{false},
+	    haveHPS{false}, haveVPS{false}, haveCA{false}, haveBPX{false},
+	    haveFGP{false};
+	std::string ca;
+	uint64_t slc{0};
+	forEachTaggedField(this->_buf + location.offset, location.length,
+	    [&](unsigned int field, const uint8_t *value, uint64_t size) {
+		switch (field) {
+		case IDC_ID:
+			image.idc = static_cast<uint32_t>(parseNumber(
+			    value, size));
+			haveIDC = true;
+			break;
+		case HLL_ID:
+			image.size.xSize = static_cast<uint32_t>(parseNumber(
+			    value, size));
+			haveHLL = true;
+			break;
+		case VLL_ID:
+			image.size.ySize = static_cast<uint32_t>(parseNumber(
+			    value, size));
+			haveVLL = true;
+			break;
+		case SLC_ID:
+			slc = parseNumber(value, size);
+			haveSLC = true;
+			break;
+		case HPS_ID:
+			image.resolution.xRes = static_cast<double>(
+			    parseNumber(value, size));
+			haveHPS = true;
+			break;
+		case VPS_ID:
+			image.resolution.yRes = static_cast<double>(
+			    parseNumber(value, size));
+			haveVPS = true;
+			break;
+		case TAG_CA_ID:
+			ca = firstItem(value, size);
+			haveCA = true;
+			break;
+		case BPX_ID:
+			image.colorDepth = static_cast<uint32_t>(parseNumber(
+			    value, size));
+			haveBPX = true;
+			break;
+		case FGP3_ID: {
+			const std::string fgp = firstItem(value, size);
+			image.fingerPosition = static_cast<int>(parseNumber(
+			    reinterpret_cast<const uint8_t *>(fgp.data()),
+			    fgp.size()));
+			haveFGP = true;
+			break;
+		}
+		case IMAGE_FIELD:
+			image.imageData = value;
+			image.imageDataSize = size;
+			break;
+		}
+	});
+
+	if (!haveIDC)
+		throw Error::DataError("Field IDC not found");
+	if (!haveHLL || !haveVLL)
+		throw Error::DataError("Field HLL/VLL not found");
+	if (!haveSLC)
+		throw Error::DataError("Field SLC not found");
+	if (!haveHPS || !haveVPS)
+		throw Error::DataError("Field HPS/VPS not found");
+	if (!haveCA)
+		throw Error::DataError("Field TAG_CA not found");
+	if (!haveBPX)
+		throw Error::DataError("Field BPX not found");
+	if (!haveFGP)
+		throw Error::DataError("Field FGP not found");
+	if (image.imageData == nullptr)
+		throw Error::DataError("Field DAT2 not found");
+
+	switch (slc) {
+	case 0: image.resolution.units = Image::Resolution::Units::NA; break;
+	case 1: image.resolution.units = Image::Resolution::Units::PPI; break;
+	case 2: image.resolution.units = Image::Resolution::Units::PPCM; break;
+	}
+	image.compression = View::AN2KView::convertCompressionAlgorithm(
+	    TYPE_14_ID, reinterpret_cast<const unsigned char *>(ca.c_str()));
+
+	return (image);
+}
+
+BiometricEvaluation::DataInterchange::AN2KIndex::ImageRecord
+BiometricEvaluation::DataInterchange::AN2KIndex::readBinaryImageRecord(
+    const RecordLocation &location,
+    uint32_t recordNumber)
+    const
+{
+	if (location.length < BINARY_HEADER_LENGTH)
+		throw Error::DataError("Type-4 record too short");
+	const uint8_t *record = this->_buf + location.offset;
+
+	ImageRecord image{};
+	image.type = View::AN2KView::RecordType::Type_4;
+	image.recordNumber = recordNumber;
+	image.idc = record[4];
+	image.fingerPosition = record[6];
+	image.size.xSize = (record[13] << 8) | record[14];
+	image.size.ySize = (record[15] << 8) | record[16];
+	image.colorDepth = View::AN2KView::FixedResolutionBitDepth;
+
+	/* Resolution as in Finger::AN2KViewFixedResolution */
+	image.resolution.units = Image::Resolution::Units::PPMM;
+	image.resolution.xRes = image.resolution.yRes = (record[12] == 0) ?
+	    View::AN2KView::MinimumScanResolutionPPMM :
+	    this->_nativeScanResolution;
+
+	const std::string ca = std::to_string(record[17]);
+	image.compression = View::AN2KView::convertCompressionAlgorithm(
+	    TYPE_4_ID, reinterpret_cast<const unsigned char *>(ca.c_str()));
+
+	image.imageData = record + BINARY_HEADER_LENGTH;
+	image.imageDataSize = location.length - BINARY_HEADER_LENGTH;
+	return (image);
+}
+
+/******************************************************************************/
+/* Public functions.                                                          */
+/******************************************************************************/
+
+BiometricEvaluation::DataInterchange::AN2KIndex::AN2KIndex(
+    const Memory::uint8Array &buf) :
+    _buf(buf)
+{
+	const uint8_t *data = buf;
+	const uint64_t size = buf.size();
+
+	/* The Type-1 record lists the type of every other record */
+	if ((size < 2) || (data[0] != '1') || (data[1] != '.'))
+		throw Error::DataError("Invalid AN2K Record");
+	RecordLocation type1{TYPE_1_ID, 0, readTaggedLength(data, size)};
+	if (type1.length > size)
+		throw Error::DataError("Type-1 record exceeds buffer");
+	this->_records.push_back(type1);
+
+	std::vector<uint16_t> types;
+	forEachTaggedField(data, type1.length,
+	    [&](unsigned int field, const uint8_t *value, uint64_t length) {
+		switch (field) {
+		case CNT_ID: {
+			/* Subfields after the first are "type<US>IDC" */
+			uint64_t pos = 0;
+			bool first = true;
+			while (pos < length) {
+				uint64_t end = pos;
+				while ((end < length) &&
+				    (value[end] != RS_CHAR))
+					end++;
+				if (!first) {
+					const std::string type = firstItem(
+					    value + pos, end - pos);
+					types.push_back(static_cast<uint16_t>(
+					    parseNumber(reinterpret_cast<
+					    const uint8_t *>(type.data()),
+					    type.size())));
+				}
+				first = false;
+				pos = end + 1;
+			}
+			break;
+		}
+		case NSR_ID:
+			this->_nativeScanResolution = std::strtod(
+			    firstItem(value, length).c_str(), nullptr);
+			break;
+		}
+	});
+
+	uint64_t offset = type1.length;
+	uint32_t type4Count{0}, type14Count{0};
+	for (const auto type : types) {
+		if (offset >= size)
+			throw Error::DataError("Fewer records than listed in "
+			    "field CNT");
+
+		RecordLocation location{type, offset, 0};
+		switch (type) {
+		case TYPE_3_ID:
+		case TYPE_4_ID:
+		case TYPE_5_ID:
+		case TYPE_6_ID:
+		case TYPE_7_ID:
+		case TYPE_8_ID:
+			/* Binary records begin with a 4-byte length */
+			if (size - offset < 4)
+				throw Error::DataError("Truncated record");
+			location.length =
+			    (static_cast<uint64_t>(data[offset]) << 24) |
+			    (static_cast<uint64_t>(data[offset + 1]) << 16) |
+			    (static_cast<uint64_t>(data[offset + 2]) << 8) |
+			    static_cast<uint64_t>(data[offset + 3]);
+			break;
+		default:
+			location.length = readTaggedLength(data + offset,
+			    size - offset);
+			break;
+		}
+		if ((location.length == 0) ||
+		    (location.length > size - offset))
+			throw Error::DataError("Record length exceeds buffer");
+		this->_records.push_back(location);
+
+		switch (type) {
+		case TYPE_4_ID:
+			this->_fingerFixedResolution.push_back(
+			    this->readBinaryImageRecord(location,
+			    ++type4Count));
+			break;
+		case TYPE_14_ID:
+			this->_fingerCaptures.push_back(
+			    this->readTaggedImageRecord(location,
+			    ++type14Count));
+			break;
+		}
+		offset += location.length;
+	}
+}
+
+const std::vector<BiometricEvaluation::DataInterchange::AN2KIndex::
+    RecordLocation>&
+BiometricEvaluation::DataInterchange::AN2KIndex::getRecordLocations()
+    const
+{
+	return (this->_records);
+}
+
+const std::vector<BiometricEvaluation::DataInterchange::AN2KIndex::
+    ImageRecord>&
+BiometricEvaluation::DataInterchange::AN2KIndex::getFingerCaptures()
+    const
+{
+	return (this->_fingerCaptures);
+}
+
+const std::vector<BiometricEvaluation::DataInterchange::AN2KIndex::
+    ImageRecord>&
+BiometricEvaluation::DataInterchange::AN2KIndex::
+    getFingerFixedResolutionCaptures()
+    const
+{
+	return (this->_fingerFixedResolution);
+}
+
+std::shared_ptr<BiometricEvaluation::Image::Image>
+BiometricEvaluation::DataInterchange::AN2KIndex::getImage(
+    const ImageRecord &record,
+    const std::string &identifier)
+{
+	if (record.compression != Image::CompressionAlgorithm::None)
+		return (Image::Image::openImage(record.imageData,
+		    record.imageDataSize, identifier));
+
+	/* Bit depth as in View::View::getImage() */
+	const uint64_t pixels = static_cast<uint64_t>(record.size.xSize) *
+	    record.size.ySize;
+	uint16_t bitDepth{0};
+	if (record.imageDataSize == pixels * (record.colorDepth / 8))
+		bitDepth = 8;
+	else if (record.imageDataSize == pixels * (record.colorDepth / 16))
+		bitDepth = 16;
+	else
+		throw Error::NotImplemented("> 16-bit depth");
+
+	return (std::make_shared<Image::Raw>(record.imageData,
+	    record.imageDataSize, record.size, record.colorDepth, bitDepth,
+	    record.resolution, false, identifier));
+}
+
+std::shared_ptr<BiometricEvaluation::DataInterchange::AN2KRecord>
+BiometricEvaluation::DataInterchange::AN2KIndex::getRecord()
+    const
+{
+	if (this->_record == nullptr) {
+		Memory::uint8Array copy(this->_buf);
+		this->_record = std::make_shared<AN2KRecord>(copy);
+	}
+	return (this->_record);
+}
@@ -389,6 +389,45 @@ BiometricEvaluation::Image::Image::getStatusCallback()
 	return (this->_statusCallback);
 }
 
+void
+BiometricEvaluation::Image::Image::setResolutionReduction(
+    uint8_t levels)
+{
+	const uint8_t maximum = this->getMaximumResolutionReduction();
+	if (levels > maximum)
+		throw Error::ParameterError("Image can be reduced by at most " +
+		    std::to_string(maximum) + " levels");
+
+	if (this->_resolutionReduction == 0) {
+		this->_fullDimensions = this->getDimensions();
+		this->_fullResolution = this->getResolution();
+	}
+
+	const uint32_t scale = static_cast<uint32_t>(1) << levels;
+	this->setDimensions(Size(
+	    (this->_fullDimensions.xSize + scale - 1) / scale,
+	    (this->_fullDimensions.ySize + scale - 1) / scale));
+	this->setResolution(Resolution(
+	    this->_fullResolution.xRes / scale,
+	    this->_fullResolution.yRes / scale,
+	    this->_fullResolution.units));
+	this->_resolutionReduction = levels;
+}
+
+uint8_t
+BiometricEvaluation::Image::Image::getResolutionReduction()
+    const
+{
+	return (this->_resolutionReduction);
+}
+
+uint8_t
+BiometricEvaluation::Image::Image::getMaximumResolutionReduction()
+    const
+{
+	return (0);
+}
+
 std::string
 BiometricEvaluation::Image::Image::getIdentifier()
     const
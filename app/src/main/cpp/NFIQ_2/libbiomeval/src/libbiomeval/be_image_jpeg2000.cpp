@@ -10,7 +10,9 @@
 
 #include <openjpeg.h>
 
+#include <algorithm>
 #include <cmath>
+#include <mutex>
 #include <be_image_jpeg2000.h>
 #include <be_memory_mutableindexedbuffer.h>
 
@@ -73,6 +75,95 @@ struct OpenJPEG_StreamDeleter
 	}
 };
 
+/** Guards the decode thread budget */
+static std::mutex DecodeThreadMutex{};
+/** Threads that decodes may borrow */
+static uint32_t DecodeThreadBudget{0};
+/** Threads currently borrowed by decodes */
+static uint32_t DecodeThreadsInUse{0};
+
+/**
+ * @brief
+ * Threads borrowed from the decode thread budget for one decode.
+ *
+ * @details
+ * Borrows whatever part of the budget other decodes are not using, and
+ * returns it on destruction.
+ */
+struct OpenJPEG_ThreadLease
+{
+	OpenJPEG_ThreadLease()
+	{
+		std::lock_guard<std::mutex> lock(DecodeThreadMutex);
+		if (DecodeThreadBudget > DecodeThreadsInUse)
+			this->threads = DecodeThreadBudget - DecodeThreadsInUse;
+		DecodeThreadsInUse += this->threads;
+	}
+
+	~OpenJPEG_ThreadLease()
+	{
+		this->release();
+	}
+
+	/** Return the borrowed threads early */
+	void
+	release()
+	{
+		std::lock_guard<std::mutex> lock(DecodeThreadMutex);
+		DecodeThreadsInUse -= this->threads;
+		this->threads = 0;
+	}
+
+	OpenJPEG_ThreadLease(const OpenJPEG_ThreadLease&) = delete;
+	OpenJPEG_ThreadLease& operator=(const OpenJPEG_ThreadLease&) = delete;
+
+	/** Number of threads borrowed */
+	uint32_t threads{0};
+};
+
+/**
+ * @brief
+ * Error reported by a threaded decode.
+ *
+ * @details
+ * libopenjp2 reports errors from its worker threads, where exceptions
+ * cannot be thrown, so the first error is kept and thrown after
+ * decoding returns.
+ */
+struct OpenJPEG_DeferredError
+{
+	/** Image being decoded */
+	const BE::Image::JPEG2000 *image{nullptr};
+	/** Serializes reports from worker threads */
+	std::mutex mutex{};
+	/** First error reported */
+	std::string message{};
+};
+
+/**
+ * @brief
+ * Callback for error output from a threaded libopenjpeg decode.
+ *
+ * @param msg
+ * Error from libopenjpeg
+ * @param client_data
+ * Pointer to an OpenJPEG_DeferredError.
+ */
+static void
+openjpeg_deferred_error(
+    const char *msg,
+    void *client_data)
+{
+	OpenJPEG_DeferredError *error = static_cast<OpenJPEG_DeferredError*>(
+	    client_data);
+
+	std::lock_guard<std::mutex> lock(error->mutex);
+	error->image->getStatusCallback()({BE::Framework::Status::Type::Error,
+	    msg, error->image->getIdentifier()});
+	if (error->message.empty())
+		error->message = msg;
+}
+
 BiometricEvaluation::Image::JPEG2000::JPEG2000(
     const uint8_t *data,
     const uint64_t size,
@@ -105,6 +196,23 @@ BiometricEvaluation::Image::JPEG2000::JPEG2000(
 	if (image->numcomps <= 0)
 		throw Error::NotImplemented("No components");
 
+	/* Resolution levels available for reduced-resolution decoding */
+	opj_codestream_info_v2_t *info = opj_get_cstr_info(codec.get());
+	if (info != nullptr) {
+		if (info->m_default_tile_info.tccp_info != nullptr) {
+			OPJ_UINT32 levels{info->m_default_tile_info.
+			    tccp_info[0].numresolutions};
+			for (uint32_t c = 1; c < info->nbcomps; ++c)
+				levels = std::min(levels, info->
+				    m_default_tile_info.tccp_info[c].
+				    numresolutions);
+			this->_resolutionLevels = static_cast<uint8_t>(
+			    std::max<OPJ_UINT32>(1, std::min<OPJ_UINT32>(
+			    levels, UINT8_MAX)));
+		}
+		opj_destroy_cstr_info(&info);
+	}
+
 	if ((image->color_space != OPJ_CLRSPC_SRGB) &&
 	    (image->color_space != OPJ_CLRSPC_GRAY) &&
 	    (image->color_space != OPJ_CLRSPC_UNSPECIFIED))
@@ -182,6 +290,21 @@ BiometricEvaluation::Image::JPEG2000::getRawData()
 	    static_cast<opj_stream_t*>(this->getDecompressionStream()),
 	    OpenJPEG_StreamDeleter{});
 
+	/* Threads must be set before the header is read */
+	OpenJPEG_ThreadLease lease{};
+	OpenJPEG_DeferredError deferredError{};
+	deferredError.image = this;
+	if (lease.threads > 0) {
+		/* The calling thread waits, so it counts as one */
+		if (opj_codec_set_threads(codec.get(), static_cast<int>(
+		    lease.threads + 1)) == OPJ_TRUE)
+			opj_set_error_handler(codec.get(),
+			    openjpeg_deferred_error, &deferredError);
+		else
+			/* Without thread support, decode on this thread */
+			lease.release();
+	}
+
 	opj_image_t *imagePtr = nullptr;
 	if (opj_read_header(stream.get(), codec.get(), &imagePtr) == OPJ_FALSE)
 		throw Error::Exception("Could not read header");
@@ -195,8 +318,16 @@ BiometricEvaluation::Image::JPEG2000::getRawData()
 	if (image->comps[0].sgnd == 1)
 		throw Error::NotImplemented("Signed buffers");
 
-	if (opj_decode(codec.get(), stream.get(), image.get()) == OPJ_FALSE)
+	if ((this->getResolutionReduction() > 0) &&
+	    (opj_set_decoded_resolution_factor(codec.get(),
+	    this->getResolutionReduction()) == OPJ_FALSE))
+		throw Error::StrategyError("Could not reduce resolution");
+
+	if (opj_decode(codec.get(), stream.get(), image.get()) == OPJ_FALSE) {
+		if (!deferredError.message.empty())
+			throw Error::StrategyError(deferredError.message);
 		throw Error::StrategyError("Could not initialize decoding");
+	}
 
 	const uint32_t w = this->getDimensions().xSize;
 	const uint32_t h = this->getDimensions().ySize;
@@ -210,8 +341,7 @@ BiometricEvaluation::Image::JPEG2000::getRawData()
 			throw Error::NotImplemented("Non-equal components");
 	}
 
-	Memory::uint8Array rawData(image->numcomps * (bpc / 8) * image->x1 *
-	    image->y1);
+	Memory::uint8Array rawData(image->numcomps * (bpc / 8) * w * h);
 	Memory::MutableIndexedBuffer buffer(rawData);
 
 	const int32_t mask = (1 << image->comps[0].prec) - 1;
@@ -246,6 +376,28 @@ BiometricEvaluation::Image::JPEG2000::getRawGrayscaleData(
 	return (Image::getRawGrayscaleData(depth));
 }
 
+uint8_t
+BiometricEvaluation::Image::JPEG2000::getMaximumResolutionReduction()
+    const
+{
+	return (this->_resolutionLevels - 1);
+}
+
+void
+BiometricEvaluation::Image::JPEG2000::setDecodeThreadBudget(
+    uint32_t threads)
+{
+	std::lock_guard<std::mutex> lock(DecodeThreadMutex);
+	DecodeThreadBudget = threads;
+}
+
+uint32_t
+BiometricEvaluation::Image::JPEG2000::getDecodeThreadBudget()
+{
+	std::lock_guard<std::mutex> lock(DecodeThreadMutex);
+	return (DecodeThreadBudget);
+}
+
 bool
 BiometricEvaluation::Image::JPEG2000::isJPEG2000(
     const uint8_t *data,
@@ -109,9 +109,9 @@ BiometricEvaluation::Image::WSQ::getRawData()
 {
 	uint8_t *rawbuf = nullptr;
 	int32_t depth, height, lossy, ppi, rv, width;
-	if ((rv = biomeval_nbis_wsq_decode_mem(&rawbuf, &width, &height, &depth, &ppi,
-	    &lossy, (unsigned char *)this->getDataPointer(),
-	    this->getDataSize())))
+	if ((rv = biomeval_nbis_wsq_decode_reduced_mem(&rawbuf, &width, &height,
+	    &depth, &ppi, &lossy, (unsigned char *)this->getDataPointer(),
+	    this->getDataSize(), this->getResolutionReduction())))
 		throw Error::DataError("Could not convert WSQ to raw.");
 
 	/* rawbuf allocated within libwsq.  Copy to manage with AutoArray. */
@@ -131,6 +131,13 @@ BiometricEvaluation::Image::WSQ::getRawGrayscaleData(
 	return (Image::getRawGrayscaleData(depth));
 }
 
+uint8_t
+BiometricEvaluation::Image::WSQ::getMaximumResolutionReduction()
+    const
+{
+	return (1);
+}
+
 bool
 BiometricEvaluation::Image::WSQ::isWSQ(
     const uint8_t *data,
@@ -128,6 +128,24 @@ BiometricEvaluation::IO::CompressedRecordStore::sequenceKey(
 	return (this->pimpl->sequenceKey(cursor));
 }
 
+const uint64_t BiometricEvaluation::IO::CompressedRecordStore::
+    DEFAULT_BLOCK_SIZE{4 * 1024 * 1024};
+
+void
+BiometricEvaluation::IO::CompressedRecordStore::setParallelCompression(
+    uint32_t threads,
+    uint64_t blockSize)
+{
+	this->pimpl->setParallelCompression(threads, blockSize);
+}
+
+uint32_t
+BiometricEvaluation::IO::CompressedRecordStore::getCompressionThreads()
+    const
+{
+	return (this->pimpl->getCompressionThreads());
+}
+
 void 
 BiometricEvaluation::IO::CompressedRecordStore::setCursorAtKey(
     const std::string &key)
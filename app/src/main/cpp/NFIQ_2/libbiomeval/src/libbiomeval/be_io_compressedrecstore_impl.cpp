@@ -8,8 +8,11 @@
  * about its quality, reliability, or any other characteristic.
  */
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <cstring>
+#include <exception>
 #include <sstream>
 
 #include "be_io_compressedrecstore_impl.h"
@@ -24,6 +27,46 @@ const std::string BACKING_STORE{"theBackingStore"};
 const std::string COMPRESSOR_TYPE_KEY{"Compressor_Type"};
 const std::string METADATA_SUFFIX{"_md"};
 
+/*
+ * Records compressed as a single stream have metadata of only the
+ * uncompressed size. Records compressed in blocks append the block size
+ * and the compressed length of each block, separated by spaces, so that
+ * the uncompressed size can still be read with atoll().
+ */
+
+/* Records that may wait to be written, per worker thread */
+static const size_t PENDING_PER_WORKER{2};
+
+static BiometricEvaluation::Memory::uint8Array
+stringToBuffer(
+    const std::string &str)
+{
+	BiometricEvaluation::Memory::uint8Array buf(str.size());
+	buf.copy((uint8_t *)str.data(), str.size());
+	return (buf);
+}
+
+static void
+parseMetadata(
+    const BiometricEvaluation::Memory::uint8Array &buf,
+    uint64_t &size,
+    uint64_t &blockSize,
+    std::vector<uint64_t> &blockLengths)
+{
+	std::istringstream metadata(
+	    BiometricEvaluation::Memory::AutoArrayUtility::getString(
+	    buf, buf.size()));
+	metadata >> size;
+	blockSize = 0;
+	blockLengths.clear();
+	if (!(metadata >> blockSize))
+		return;
+
+	uint64_t blockLength;
+	while (metadata >> blockLength)
+		blockLengths.push_back(blockLength);
+}
+
 BiometricEvaluation::IO::CompressedRecordStore::Impl::Impl(
     const std::string &pathname,
     const std::string &description,
@@ -103,7 +146,13 @@ BiometricEvaluation::IO::CompressedRecordStore::Impl::Impl(
 
 BiometricEvaluation::IO::CompressedRecordStore::Impl::~Impl()
 {
-
+	try {
+		this->writePending(0);
+	} catch (const Error::Exception&) {}
+	try {
+		this->forgetDiscarded();
+	} catch (const Error::Exception&) {}
+	this->stopWorkers();
 }
 
 void
@@ -114,18 +163,61 @@ BiometricEvaluation::IO::CompressedRecordStore::Impl::insert(
 {
 	if (this->getMode() == Mode::ReadOnly)
 		throw Error::StrategyError(RSREADONLYERROR);
-		
-	Memory::uint8Array compressedData = _compressor->compress(
-	    static_cast<const uint8_t *const>(data), size);
-	_rs->insert(key, compressedData);
-
-	std::ostringstream sizeStr;
-	sizeStr << size;
-	Memory::uint8Array sizeBuf(sizeStr.str().size());
-	sizeBuf.copy((uint8_t *)sizeStr.str().data(), sizeStr.str().size());
-	_mdrs->insert(key, sizeBuf);
+	this->forgetDiscarded();
+
+	if (_workers.empty()) {
+		Memory::uint8Array compressedData = _compressor->compress(
+		    static_cast<const uint8_t *const>(data), size);
+		_rs->insert(key, compressedData);
+
+		std::ostringstream sizeStr;
+		sizeStr << size;
+		_mdrs->insert(key, stringToBuffer(sizeStr.str()));
 	
+		RecordStore::Impl::insert(key, data, size);
+		return;
+	}
+
+	/* Errors from the backing stores would otherwise be deferred */
+	if (!this->validateKeyString(key))
+		throw Error::StrategyError("Invalid key format");
+	bool exists = (_pendingKeys.count(key) != 0);
+	if (!exists) {
+		try {
+			_mdrs->length(key);
+			exists = true;
+		} catch (const Error::ObjectDoesNotExist&) {}
+	}
+	if (exists)
+		throw Error::ObjectExists(key);
+
+	PendingRecord record;
+	record.key = key;
+	record.data = std::make_shared<Memory::uint8Array>(size);
+	record.data->copy(static_cast<const uint8_t *>(data), size);
+
+	/* Compress every block, even if the record is empty */
+	const std::shared_ptr<const Memory::uint8Array> buffer = record.data;
+	const std::shared_ptr<const IO::Compressor> compressor = _compressor;
+	uint64_t offset = 0;
+	do {
+		const uint64_t blockLength = std::min(_blockSize,
+		    size - offset);
+		record.blocks.push_back(this->submit(
+		    [buffer, compressor, offset, blockLength]() ->
+		    Memory::uint8Array {
+			const uint8_t *start = *buffer;
+			return (compressor->compress(start + offset,
+			    blockLength));
+		    }));
+		offset += blockLength;
+	} while (offset < size);
+
+	_pending.push_back(std::move(record));
+	_pendingKeys.insert(key);
 	RecordStore::Impl::insert(key, data, size);
+
+	this->writePending(PENDING_PER_WORKER * _workers.size());
 }
 
 uint64_t
@@ -133,6 +225,12 @@ BiometricEvaluation::IO::CompressedRecordStore::Impl::length(
     const std::string &key)
     const
 {
+	if (_pendingKeys.count(key) != 0) {
+		for (const auto &record : _pending)
+			if (record.key == key)
+				return (record.data->size());
+	}
+
 	Memory::uint8Array buf = _mdrs->read(key);
 	return (static_cast<uint64_t>(atoll(
 	    Memory::AutoArrayUtility::getString(buf, buf.size()).c_str())));
@@ -143,10 +241,87 @@ BiometricEvaluation::IO::CompressedRecordStore::Impl::read(
     const std::string &key)
     const
 {
+	if (_pendingKeys.count(key) != 0) {
+		for (const auto &record : _pending)
+			if (record.key == key)
+				return (*record.data);
+	}
+
+	uint64_t size, blockSize;
+	std::vector<uint64_t> blockLengths;
+	parseMetadata(_mdrs->read(key), size, blockSize, blockLengths);
+
 	Memory::uint8Array compressedData = _rs->read(key);
-	
-	Memory::uint8Array decompressedData = _compressor->decompress(
-	    compressedData);
+	if (blockLengths.empty()) {
+		Memory::uint8Array decompressedData = _compressor->decompress(
+		    compressedData);
+		return (decompressedData);
+	}
+
+	/* Decompress each block directly into place */
+	Memory::uint8Array decompressedData(size);
+	const std::shared_ptr<const IO::Compressor> compressor = _compressor;
+	const uint8_t *compressedStart = compressedData;
+	uint8_t *decompressedStart = decompressedData;
+	std::vector<std::future<Memory::uint8Array>> blocks;
+	uint64_t compressedOffset = 0, offset = 0;
+	/* Blocks already submitted must finish before anything is thrown */
+	std::exception_ptr failure;
+	try {
+		for (const auto blockLength : blockLengths) {
+			if ((compressedOffset + blockLength >
+			    compressedData.size()) || (offset > size))
+				throw Error::StrategyError("Metadata for " +
+				    key + " does not match its data");
+
+			const uint8_t *source = compressedStart +
+			    compressedOffset;
+			uint8_t *destination = decompressedStart + offset;
+			const uint64_t expectedLength = std::min(blockSize,
+			    size - offset);
+			blocks.push_back(this->submit(
+			    [compressor, source, blockLength, destination,
+			    expectedLength]() -> Memory::uint8Array {
+				const Memory::uint8Array block =
+				    compressor->decompress(source, blockLength);
+				if (block.size() != expectedLength)
+					throw Error::StrategyError(
+					    "Decompressed block has an "
+					    "unexpected size");
+				std::memcpy(destination,
+				    static_cast<const uint8_t *>(block),
+				    block.size());
+				return (Memory::uint8Array());
+			    }));
+			compressedOffset += blockLength;
+			offset += expectedLength;
+		}
+	} catch (...) {
+		failure = std::current_exception();
+	}
+
+	/* Wait for every block, since they write into decompressedData */
+	std::string error;
+	for (auto &block : blocks) {
+		try {
+			block.get();
+		} catch (const Error::Exception &e) {
+			if (!failure && error.empty())
+				error = e.whatString();
+		} catch (...) {
+			if (!failure && error.empty())
+				failure = std::current_exception();
+		}
+	}
+	if (failure)
+		std::rethrow_exception(failure);
+	if (!error.empty())
+		throw Error::StrategyError("Could not decompress " + key +
+		    ": " + error);
+	if (offset != size)
+		throw Error::StrategyError("Metadata for " + key +
+		    " does not match its data");
+
 	return (decompressedData);
 }
 
@@ -155,6 +330,8 @@ BiometricEvaluation::IO::CompressedRecordStore::Impl::i_sequence(
     bool returnData,
     int cursor)
 {
+	this->writePending(0);
+
 	BE::IO::RecordStore::Record record;
 	/* Obtain the next key, but not data, since it is compressed */
 	record.key = _rs->sequenceKey(cursor);
@@ -186,6 +363,9 @@ BiometricEvaluation::IO::CompressedRecordStore::Impl::remove(
 {
 	if (this->getMode() == Mode::ReadOnly)
 		throw Error::StrategyError(RSREADONLYERROR);
+	if (_pendingKeys.count(key) != 0)
+		this->writePending(0);
+	this->forgetDiscarded();
 		
 	_rs->remove(key);
 	_mdrs->remove(key);
@@ -199,6 +379,7 @@ BiometricEvaluation::IO::CompressedRecordStore::Impl::sync()
 	if (this->getMode() == Mode::ReadOnly)
 		return;
 		
+	this->writePending(0);
 	_rs->sync();
 	_mdrs->sync();
 	RecordStore::Impl::sync();
@@ -210,6 +391,8 @@ BiometricEvaluation::IO::CompressedRecordStore::Impl::move(
 {
 	if (this->getMode() == Mode::ReadOnly)
 		throw Error::StrategyError(RSREADONLYERROR);
+	this->writePending(0);
+	this->forgetDiscarded();
 		
 	_rs.reset();	
 	_mdrs.reset();
@@ -226,6 +409,7 @@ void
 BiometricEvaluation::IO::CompressedRecordStore::Impl::setCursorAtKey(
     const std::string &key)
 {
+	this->writePending(0);
 	_rs->setCursorAtKey(key);
 }
     
@@ -233,6 +417,7 @@ uint64_t
 BiometricEvaluation::IO::CompressedRecordStore::Impl::getSpaceUsed()
     const
 {
+	this->writePending(0);
 	return (_rs->getSpaceUsed() + _mdrs->getSpaceUsed() + 
 	    RecordStore::Impl::getSpaceUsed());
 }
@@ -245,7 +430,159 @@ BiometricEvaluation::IO::CompressedRecordStore::Impl::flush(
 	if (this->getMode() == Mode::ReadOnly)
 		throw Error::StrategyError(RSREADONLYERROR);
 		
+	if (_pendingKeys.count(key) != 0)
+		this->writePending(0);
 	_rs->flush(key);
 	_mdrs->flush(key);
 }
 
+void
+BiometricEvaluation::IO::CompressedRecordStore::Impl::setParallelCompression(
+    uint32_t threads,
+    uint64_t blockSize)
+{
+	if (blockSize == 0)
+		throw Error::StrategyError("Block size must be positive");
+
+	this->writePending(0);
+	if (this->getMode() != Mode::ReadOnly)
+		this->forgetDiscarded();
+	this->stopWorkers();
+
+	_blockSize = blockSize;
+	for (uint32_t i = 0; i < threads; i++)
+		_workers.emplace_back(&CompressedRecordStore::Impl::work, this);
+}
+
+uint32_t
+BiometricEvaluation::IO::CompressedRecordStore::Impl::getCompressionThreads()
+    const
+{
+	return (static_cast<uint32_t>(_workers.size()));
+}
+
+void
+BiometricEvaluation::IO::CompressedRecordStore::Impl::work()
+{
+	for (;;) {
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(_taskMutex);
+			_taskAvailable.wait(lock, [this]() {
+			    return (_stopping || !_tasks.empty()); });
+			if (_tasks.empty())
+				return;
+			task = std::move(_tasks.front());
+			_tasks.pop_front();
+		}
+		task();
+	}
+}
+
+std::future<BiometricEvaluation::Memory::uint8Array>
+BiometricEvaluation::IO::CompressedRecordStore::Impl::submit(
+    const std::function<Memory::uint8Array()> &task)
+    const
+{
+	auto packagedTask = std::make_shared<
+	    std::packaged_task<Memory::uint8Array()>>(task);
+	std::future<Memory::uint8Array> result = packagedTask->get_future();
+
+	if (_workers.empty()) {
+		(*packagedTask)();
+	} else {
+		std::lock_guard<std::mutex> lock(_taskMutex);
+		_tasks.push_back([packagedTask]() { (*packagedTask)(); });
+		_taskAvailable.notify_one();
+	}
+	return (result);
+}
+
+void
+BiometricEvaluation::IO::CompressedRecordStore::Impl::stopWorkers()
+{
+	{
+		std::lock_guard<std::mutex> lock(_taskMutex);
+		_stopping = true;
+	}
+	_taskAvailable.notify_all();
+	for (auto &worker : _workers)
+		worker.join();
+	_workers.clear();
+	_stopping = false;
+}
+
+void
+BiometricEvaluation::IO::CompressedRecordStore::Impl::writePending(
+    size_t limit)
+    const
+{
+	while (!_pending.empty()) {
+		PendingRecord &record = _pending.front();
+		if (_pending.size() <= limit) {
+			bool compressed = true;
+			for (const auto &block : record.blocks)
+				if (block.wait_for(std::chrono::seconds(0)) !=
+				    std::future_status::ready)
+					compressed = false;
+			if (!compressed)
+				return;
+		}
+
+		const std::string key = record.key;
+		std::string error;
+		try {
+			std::ostringstream metadata;
+			metadata << record.data->size() << ' ' << _blockSize;
+
+			std::vector<Memory::uint8Array> blocks;
+			uint64_t compressedSize = 0;
+			for (auto &block : record.blocks) {
+				blocks.push_back(block.get());
+				compressedSize += blocks.back().size();
+				metadata << ' ' << blocks.back().size();
+			}
+
+			Memory::uint8Array compressedData(compressedSize);
+			uint8_t *compressedStart = compressedData;
+			uint64_t offset = 0;
+			for (const auto &block : blocks) {
+				std::memcpy(compressedStart + offset,
+				    static_cast<const uint8_t *>(block),
+				    block.size());
+				offset += block.size();
+			}
+
+			_rs->insert(key, compressedData);
+			try {
+				_mdrs->insert(key,
+				    stringToBuffer(metadata.str()));
+			} catch (const Error::Exception&) {
+				_rs->remove(key);
+				throw;
+			}
+		} catch (const Error::Exception &e) {
+			error = e.whatString();
+		} catch (const std::exception &e) {
+			error = e.what();
+		}
+
+		_pendingKeys.erase(key);
+		_pending.pop_front();
+		if (!error.empty()) {
+			_discardedKeys.push_back(key);
+			throw Error::StrategyError("Could not write " + key +
+			    ": " + error);
+		}
+	}
+}
+
+void
+BiometricEvaluation::IO::CompressedRecordStore::Impl::forgetDiscarded()
+{
+	while (!_discardedKeys.empty()) {
+		RecordStore::Impl::remove(_discardedKeys.back());
+		_discardedKeys.pop_back();
+	}
+}
+
@@ -11,6 +11,15 @@
 #ifndef __BE_IO_COMPRESSEDRECSTORE_IMPL_H__
 #define __BE_IO_COMPRESSEDRECSTORE_IMPL_H__
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
 #include <be_io_compressedrecstore.h>
 #include "be_io_recordstore_impl.h"
 
@@ -145,6 +154,15 @@ namespace BiometricEvaluation
 			move(
 			    const std::string &pathname);
 
+			void
+			setParallelCompression(
+			    uint32_t threads,
+			    uint64_t blockSize);
+
+			uint32_t
+			getCompressionThreads()
+			    const;
+
 			/**
 			 * @brief
 			 * Copy constructor (disabled).
@@ -185,6 +203,90 @@ namespace BiometricEvaluation
 			
 			/** Underlying Compressor */
 			std::shared_ptr<IO::Compressor> _compressor;
+
+			/** A record queued for compression */
+			struct PendingRecord
+			{
+				std::string key{};
+				/** Uncompressed data, until written */
+				std::shared_ptr<Memory::uint8Array> data{};
+				/** Compressed blocks, in order */
+				std::vector<std::future<Memory::uint8Array>>
+				    blocks{};
+			};
+
+			/** Uncompressed bytes in each block */
+			uint64_t _blockSize{DEFAULT_BLOCK_SIZE};
+			/** Records compressing, in insertion order */
+			mutable std::deque<PendingRecord> _pending{};
+			/** Keys of the records in _pending */
+			mutable std::set<std::string> _pendingKeys{};
+			/** Queued records that could not be written */
+			mutable std::vector<std::string> _discardedKeys{};
+
+			/** Compression worker threads */
+			std::vector<std::thread> _workers{};
+			/** Work waiting for a worker thread */
+			mutable std::deque<std::function<void()>> _tasks{};
+			/** Set when the workers should exit */
+			bool _stopping{false};
+			/** Protects _tasks and _stopping */
+			mutable std::mutex _taskMutex{};
+			/** Signals changes to _tasks and _stopping */
+			mutable std::condition_variable _taskAvailable{};
+
+			/**
+			 * Run work from _tasks until _stopping is set.
+			 */
+			void
+			work();
+
+			/**
+			 * @brief
+			 * Queue work for the worker threads.
+			 *
+			 * @param[in] task
+			 *	Work that returns a buffer.
+			 *
+			 * @return
+			 *	The buffer returned by task, or the exception
+			 *	it threw.
+			 */
+			std::future<Memory::uint8Array>
+			submit(
+			    const std::function<Memory::uint8Array()> &task)
+			    const;
+
+			/**
+			 * Stop and join the worker threads.
+			 */
+			void
+			stopWorkers();
+
+			/**
+			 * @brief
+			 * Write queued records to the backing stores.
+			 *
+			 * @param[in] limit
+			 *	Wait for records to be compressed until no
+			 *	more than limit remain queued, then write any
+			 *	others that are already compressed.
+			 *
+			 * @throw Error::StrategyError
+			 *	A record could not be compressed or written,
+			 *	and was discarded.
+			 */
+			void
+			writePending(
+			    size_t limit)
+			    const;
+
+			/**
+			 * Remove records discarded by writePending() from
+			 * the record count.
+			 */
+			void
+			forgetDiscarded();
 			
 			/**
 			 * Internal implementation of sequencing through a
@@ -0,0 +1,41 @@
+/*
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ */
+
+#include <be_io_recordstoreprefetcher.h>
+
+#include "be_io_recordstoreprefetcher_impl.h"
+
+BiometricEvaluation::IO::RecordStorePrefetcher::RecordStorePrefetcher(
+    const std::shared_ptr<RecordStore> &recordStore,
+    uint32_t window,
+    uint32_t ioThreads,
+    int cursor) :
+    pimpl{new BiometricEvaluation::IO::RecordStorePrefetcher::Impl(
+    recordStore, window, ioThreads, cursor)}
+{
+
+}
+
+BiometricEvaluation::IO::RecordStore::Record
+BiometricEvaluation::IO::RecordStorePrefetcher::sequence()
+{
+	return (this->pimpl->sequence());
+}
+
+uint32_t
+BiometricEvaluation::IO::RecordStorePrefetcher::getWindow()
+    const
+{
+	return (this->pimpl->getWindow());
+}
+
+BiometricEvaluation::IO::RecordStorePrefetcher::~RecordStorePrefetcher()
+{
+}
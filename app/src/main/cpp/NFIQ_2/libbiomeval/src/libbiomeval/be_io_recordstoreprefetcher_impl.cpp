@@ -0,0 +1,175 @@
+/*
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ */
+
+#include <be_error_exception.h>
+
+#include "be_io_recordstoreprefetcher_impl.h"
+
+namespace BE = BiometricEvaluation;
+
+BiometricEvaluation::IO::RecordStorePrefetcher::Impl::Impl(
+    const std::shared_ptr<RecordStore> &recordStore,
+    uint32_t window,
+    uint32_t ioThreads,
+    int cursor) :
+    _recordStore(recordStore),
+    _window(window),
+    _cursor(cursor)
+{
+	if (this->_recordStore == nullptr)
+		throw BE::Error::ParameterError("RecordStore is null");
+	if (window == 0)
+		throw BE::Error::ParameterError("Window must be at least 1");
+	if (ioThreads == 0)
+		throw BE::Error::ParameterError("At least one I/O thread "
+		    "is required");
+	if ((cursor != RecordStore::BE_RECSTORE_SEQ_START) &&
+	    (cursor != RecordStore::BE_RECSTORE_SEQ_NEXT))
+		throw BE::Error::ParameterError("Invalid cursor");
+
+	/*
+	 * RecordStore implementations are not safe for concurrent reads
+	 * through a single object, so each I/O thread opens its own
+	 * read-only handle. Handles are opened before any thread starts
+	 * so that failures are reported to the caller.
+	 */
+	std::vector<std::shared_ptr<RecordStore>> handles;
+	for (uint32_t i = 0; i < ioThreads; i++) {
+		try {
+			handles.push_back(RecordStore::openRecordStore(
+			    this->_recordStore->getPathname(),
+			    IO::Mode::ReadOnly));
+		} catch (const BE::Error::Exception &e) {
+			throw BE::Error::StrategyError("Could not open "
+			    "prefetch handle: " + e.whatString());
+		}
+	}
+
+	/* Threads already started must be joined if another fails */
+	try {
+		for (const auto &handle : handles)
+			this->_ioThreads.emplace_back(
+			    &RecordStorePrefetcher::Impl::readLoop, this,
+			    handle);
+	} catch (...) {
+		this->stopThreads();
+		throw;
+	}
+}
+
+void
+BiometricEvaluation::IO::RecordStorePrefetcher::Impl::readLoop(
+    std::shared_ptr<RecordStore> handle)
+{
+	for (;;) {
+		std::shared_ptr<Slot> slot;
+
+		/* Claim the next key in sequence while there is room */
+		{
+			std::unique_lock<std::mutex> lock(this->_mutex);
+			this->_windowAvailable.wait(lock, [&]() {
+				return (this->_stopping || this->_exhausted ||
+				    (this->_slots.size() < this->_window));
+			});
+			if (this->_stopping || this->_exhausted)
+				return;
+
+			slot = std::make_shared<Slot>();
+			try {
+				slot->key = this->_recordStore->sequenceKey(
+				    this->_cursor);
+				this->_cursor = RecordStore::BE_RECSTORE_SEQ_NEXT;
+			} catch (const BE::Error::ObjectDoesNotExist&) {
+				this->_exhausted = true;
+			} catch (const BE::Error::Exception &e) {
+				/* Surface the error in sequence, then stop */
+				slot->error = e.whatString();
+				slot->ready = true;
+				this->_slots.push_back(slot);
+				this->_exhausted = true;
+			}
+
+			if (this->_exhausted) {
+				lock.unlock();
+				this->_windowAvailable.notify_all();
+				this->_recordReady.notify_all();
+				return;
+			}
+			this->_slots.push_back(slot);
+		}
+
+		/* Read outside the lock so other threads can proceed */
+		Memory::uint8Array data;
+		std::string error;
+		try {
+			data = handle->read(slot->key);
+		} catch (const BE::Error::Exception &e) {
+			error = e.whatString() + " (" + slot->key + ")";
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(this->_mutex);
+			slot->data = std::move(data);
+			slot->error = error;
+			slot->ready = true;
+		}
+		this->_recordReady.notify_all();
+	}
+}
+
+BiometricEvaluation::IO::RecordStore::Record
+BiometricEvaluation::IO::RecordStorePrefetcher::Impl::sequence()
+{
+	std::shared_ptr<Slot> slot;
+	{
+		std::unique_lock<std::mutex> lock(this->_mutex);
+		this->_recordReady.wait(lock, [&]() {
+			return ((!this->_slots.empty() &&
+			    this->_slots.front()->ready) ||
+			    (this->_slots.empty() && this->_exhausted));
+		});
+		if (this->_slots.empty())
+			throw BE::Error::ObjectDoesNotExist("End of sequence");
+
+		slot = this->_slots.front();
+		this->_slots.pop_front();
+	}
+	this->_windowAvailable.notify_one();
+
+	if (!slot->error.empty())
+		throw BE::Error::StrategyError(slot->error);
+	return (RecordStore::Record(slot->key, slot->data));
+}
+
+uint32_t
+BiometricEvaluation::IO::RecordStorePrefetcher::Impl::getWindow()
+    const
+{
+	return (this->_window);
+}
+
+void
+BiometricEvaluation::IO::RecordStorePrefetcher::Impl::stopThreads()
+{
+	{
+		std::lock_guard<std::mutex> lock(this->_mutex);
+		this->_stopping = true;
+	}
+	this->_windowAvailable.notify_all();
+
+	for (auto &thread : this->_ioThreads)
+		if (thread.joinable())
+			thread.join();
+}
+
+BiometricEvaluation::IO::RecordStorePrefetcher::Impl::~Impl()
+{
+	this->stopThreads();
+}
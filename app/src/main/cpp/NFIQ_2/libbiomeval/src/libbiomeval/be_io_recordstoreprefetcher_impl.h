@@ -0,0 +1,110 @@
+/*
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ */
+
+#ifndef BE_IO_RECORDSTOREPREFETCHER_IMPL_H_
+#define BE_IO_RECORDSTOREPREFETCHER_IMPL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <be_io_recordstoreprefetcher.h>
+
+namespace BiometricEvaluation
+{
+	namespace IO
+	{
+		/** Implementation of RecordStorePrefetcher. */
+		class RecordStorePrefetcher::Impl
+		{
+		public:
+			/**
+			 * RecordStorePrefetcher::Impl constructor.
+			 *
+			 * @see RecordStorePrefetcher::RecordStorePrefetcher
+			 */
+			Impl(
+			    const std::shared_ptr<RecordStore> &recordStore,
+			    uint32_t window,
+			    uint32_t ioThreads,
+			    int cursor);
+
+			/** @see RecordStorePrefetcher::sequence */
+			RecordStore::Record
+			sequence();
+
+			/** @see RecordStorePrefetcher::getWindow */
+			uint32_t
+			getWindow()
+			    const;
+
+			/** Stop and join I/O threads */
+			~Impl();
+
+		private:
+			/** A record in flight, in sequence order */
+			struct Slot
+			{
+				/** Key obtained from the sequence cursor */
+				std::string key{};
+				/** Data read for key */
+				Memory::uint8Array data{};
+				/** Whether the read has completed */
+				bool ready{false};
+				/** Error message, if the read failed */
+				std::string error{};
+			};
+
+			/**
+			 * @brief
+			 * Body of each I/O thread.
+			 *
+			 * @param handle
+			 * Read-only handle to the RecordStore owned by this
+			 * thread.
+			 */
+			void
+			readLoop(
+			    std::shared_ptr<RecordStore> handle);
+
+			/** Stop and join any I/O threads that were started */
+			void
+			stopThreads();
+
+			/** RecordStore providing the sequence cursor */
+			const std::shared_ptr<RecordStore> _recordStore;
+			/** Maximum records in flight or awaiting consumption */
+			const uint32_t _window;
+			/** Cursor to pass to the next sequenceKey() call */
+			int _cursor;
+
+			/** Records in sequence order */
+			std::deque<std::shared_ptr<Slot>> _slots{};
+			/** Sequence cursor has reached the end */
+			bool _exhausted{false};
+			/** Destruction has been requested */
+			bool _stopping{false};
+
+			/** Protects all mutable members */
+			std::mutex _mutex{};
+			/** Signaled when room opens in the window */
+			std::condition_variable _windowAvailable{};
+			/** Signaled when a read completes */
+			std::condition_variable _recordReady{};
+
+			/** I/O threads */
+			std::vector<std::thread> _ioThreads{};
+		};
+	}
+}
+
+#endif /* BE_IO_RECORDSTOREPREFETCHER_IMPL_H_ */
@@ -97,6 +97,23 @@ BiometricEvaluation::IO::RecordStoreUnion::read(
 	return (this->pimpl->read(key));
 }
 
+std::pair<std::string, BiometricEvaluation::Memory::uint8Array>
+BiometricEvaluation::IO::RecordStoreUnion::readFirst(
+    const std::string &key)
+    const
+{
+	return (this->pimpl->readFirst(key));
+}
+
+std::map<const std::string, std::map<const std::string,
+BiometricEvaluation::Memory::uint8Array>>
+BiometricEvaluation::IO::RecordStoreUnion::read(
+    const std::vector<std::string> &keys)
+    const
+{
+	return (this->pimpl->read(keys));
+}
+
 std::map<const std::string, uint64_t>
 BiometricEvaluation::IO::RecordStoreUnion::length(
     const std::string &key)
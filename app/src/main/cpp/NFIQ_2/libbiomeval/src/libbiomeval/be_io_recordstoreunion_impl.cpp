@@ -8,6 +8,8 @@
  * about its quality, reliability, or any other characteristic.
  */
 
+#include <exception>
+
 #include <be_io_recordstore.h>
 
 #include "be_io_recordstoreunion_impl.h"
@@ -116,6 +118,110 @@ BiometricEvaluation::IO::RecordStoreUnion::Impl::getNames()
 	return (names);
 }
 
+BiometricEvaluation::IO::RecordStoreUnion::Impl::~Impl()
+{
+	for (auto &worker : this->_workers) {
+		{
+			std::lock_guard<std::mutex> lock(worker->mutex);
+			worker->stopping = true;
+		}
+		worker->taskAvailable.notify_one();
+	}
+	for (auto &worker : this->_workers)
+		worker->thread.join();
+}
+
+void
+BiometricEvaluation::IO::RecordStoreUnion::Impl::work(
+    MemberWorker &worker)
+{
+	for (;;) {
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(worker.mutex);
+			worker.taskAvailable.wait(lock, [&worker]() {
+			    return (worker.stopping || !worker.tasks.empty());
+			});
+			if (worker.tasks.empty())
+				return;
+			task = std::move(worker.tasks.front());
+			worker.tasks.pop_front();
+		}
+		task();
+	}
+}
+
+void
+BiometricEvaluation::IO::RecordStoreUnion::Impl::dispatch(
+    size_t member,
+    const std::function<void()> &task)
+    const
+{
+	if (this->_recordStores.size() <= 1) {
+		task();
+		return;
+	}
+
+	MemberWorker *worker;
+	{
+		std::lock_guard<std::mutex> lock(this->_workersMutex);
+		if (this->_workers.empty()) {
+			for (size_t i = 0; i < this->_recordStores.size(); i++) {
+				this->_workers.emplace_back(new MemberWorker());
+				this->_workers.back()->thread = std::thread(
+				    &Impl::work, std::ref(*this->_workers.back()));
+			}
+		}
+		worker = this->_workers.at(member).get();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(worker->mutex);
+		worker->tasks.push_back(task);
+	}
+	worker->taskAvailable.notify_one();
+}
+
+void
+BiometricEvaluation::IO::RecordStoreUnion::Impl::forEachMember(
+    const std::function<void(size_t, const std::string&,
+    BiometricEvaluation::IO::RecordStore&)> &operation)
+    const
+{
+	std::vector<std::exception_ptr> exceptions(this->_recordStores.size());
+	size_t remaining = this->_recordStores.size();
+	std::mutex mutex;
+	std::condition_variable finished;
+
+	size_t member = 0;
+	for (const auto &rsPair : this->_recordStores) {
+		const std::string *name = &rsPair.first;
+		BE::IO::RecordStore *rs = rsPair.second.get();
+		this->dispatch(member, [&, member, name, rs]() {
+			try {
+				operation(member, *name, *rs);
+			} catch (...) {
+				exceptions[member] = std::current_exception();
+			}
+
+			std::lock_guard<std::mutex> lock(mutex);
+			if (--remaining == 0)
+				finished.notify_one();
+		});
+		member++;
+	}
+
+	/* Operations refer to this frame, so wait for all of them */
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		finished.wait(lock, [&remaining]() { return (remaining == 0); });
+	}
+
+	for (const auto &exception : exceptions)
+		if (exception)
+			std::rethrow_exception(exception);
+}
+
 /*
  * Operations.
  */
@@ -125,59 +231,224 @@ BiometricEvaluation::IO::RecordStoreUnion::Impl::read(
     const std::string &key)
     const
 {
-	std::string exceptions;
-	std::map<const std::string,
-	    BiometricEvaluation::Memory::uint8Array> ret;
+	std::vector<std::string> exceptions(this->_recordStores.size());
+	std::vector<std::pair<bool, BiometricEvaluation::Memory::uint8Array>>
+	    data(this->_recordStores.size());
 
-	for (const auto &rsPair : this->_recordStores) {
+	this->forEachMember([&](size_t member, const std::string &name,
+	    BE::IO::RecordStore &rs) {
 		try {
-			ret.emplace(std::make_pair(rsPair.first,
-			    rsPair.second->read(key)));
+			data[member].second = rs.read(key);
+			data[member].first = true;
 		} catch (const BE::Error::ObjectDoesNotExist&) {
 			/* Swallow */
 		} catch (BE::Error::Exception &e) {
-			if (!exceptions.empty())
-				exceptions += '\n';
-			exceptions += e.whatString() + " (" + rsPair.first +
+			exceptions[member] = e.whatString() + " (" + name +
 			    ')';
 		}
+	});
+
+	std::string exception;
+	std::map<const std::string,
+	    BiometricEvaluation::Memory::uint8Array> ret;
+	size_t member = 0;
+	for (const auto &rsPair : this->_recordStores) {
+		if (data[member].first)
+			ret.emplace(std::make_pair(rsPair.first,
+			    std::move(data[member].second)));
+		if (!exceptions[member].empty()) {
+			if (!exception.empty())
+				exception += '\n';
+			exception += exceptions[member];
+		}
+		member++;
 	}
 
-	if (!exceptions.empty())
-		throw BE::Error::StrategyError(exceptions);
+	if (!exception.empty())
+		throw BE::Error::StrategyError(exception);
 	if (ret.size() == 0)
 		throw BE::Error::ObjectDoesNotExist(key);
 
 	return (ret);
 }
 
+std::pair<std::string, BiometricEvaluation::Memory::uint8Array>
+BiometricEvaluation::IO::RecordStoreUnion::Impl::readFirst(
+    const std::string &key)
+    const
+{
+	/* Shared with skipped searches, which may run after this call */
+	struct Search
+	{
+		std::mutex mutex{};
+		std::condition_variable changed{};
+		size_t remaining{0};
+		size_t reading{0};
+		bool found{false};
+		std::string name{};
+		BiometricEvaluation::Memory::uint8Array data{};
+		std::string exceptions{};
+	};
+	const auto search = std::make_shared<Search>();
+	search->remaining = this->_recordStores.size();
+
+	size_t member = 0;
+	for (const auto &rsPair : this->_recordStores) {
+		const std::string name = rsPair.first;
+		const std::shared_ptr<BE::IO::RecordStore> rs = rsPair.second;
+		this->dispatch(member++, [search, name, rs, key]() {
+			/* No read starts once key is found */
+			bool skip;
+			{
+				std::lock_guard<std::mutex> lock(search->mutex);
+				skip = search->found;
+				if (!skip)
+					search->reading++;
+			}
+
+			std::string exception;
+			if (!skip) {
+				try {
+					BE::Memory::uint8Array data =
+					    rs->read(key);
+					std::lock_guard<std::mutex> lock(
+					    search->mutex);
+					if (!search->found) {
+						search->found = true;
+						search->name = name;
+						search->data = std::move(data);
+					}
+				} catch (const BE::Error::ObjectDoesNotExist&) {
+					/* Swallow */
+				} catch (BE::Error::Exception &e) {
+					exception = e.whatString() + " (" +
+					    name + ')';
+				} catch (const std::exception &e) {
+					exception = std::string(e.what()) +
+					    " (" + name + ')';
+				}
+			}
+
+			std::lock_guard<std::mutex> lock(search->mutex);
+			if (!exception.empty()) {
+				if (!search->exceptions.empty())
+					search->exceptions += '\n';
+				search->exceptions += exception;
+			}
+			if (!skip)
+				search->reading--;
+			search->remaining--;
+			search->changed.notify_one();
+		});
+	}
+
+	/*
+	 * Wait for reads in progress on other members, so none is still
+	 * using a member RecordStore when the caller gets it back.
+	 */
+	std::unique_lock<std::mutex> lock(search->mutex);
+	search->changed.wait(lock, [&search]() {
+	    return ((search->found && (search->reading == 0)) ||
+	    (search->remaining == 0)); });
+
+	if (search->found)
+		return (std::make_pair(search->name, std::move(search->data)));
+	if (!search->exceptions.empty())
+		throw BE::Error::StrategyError(search->exceptions);
+	throw BE::Error::ObjectDoesNotExist(key);
+}
+
+std::map<const std::string, std::map<const std::string,
+BiometricEvaluation::Memory::uint8Array>>
+BiometricEvaluation::IO::RecordStoreUnion::Impl::read(
+    const std::vector<std::string> &keys)
+    const
+{
+	std::vector<std::string> exceptions(this->_recordStores.size());
+	std::vector<std::vector<std::pair<std::string,
+	    BiometricEvaluation::Memory::uint8Array>>>
+	    data(this->_recordStores.size());
+
+	/* Each member reads every key, so requests are not interleaved */
+	this->forEachMember([&](size_t member, const std::string &name,
+	    BE::IO::RecordStore &rs) {
+		for (const auto &key : keys) {
+			try {
+				data[member].emplace_back(key, rs.read(key));
+			} catch (const BE::Error::ObjectDoesNotExist&) {
+				/* Swallow */
+			} catch (BE::Error::Exception &e) {
+				if (!exceptions[member].empty())
+					exceptions[member] += '\n';
+				exceptions[member] += e.whatString() + " (" +
+				    name + ", " + key + ')';
+			}
+		}
+	});
+
+	std::string exception;
+	std::map<const std::string, std::map<const std::string,
+	    BiometricEvaluation::Memory::uint8Array>> ret;
+	size_t member = 0;
+	for (const auto &rsPair : this->_recordStores) {
+		for (auto &record : data[member])
+			ret[record.first].emplace(std::make_pair(rsPair.first,
+			    std::move(record.second)));
+		if (!exceptions[member].empty()) {
+			if (!exception.empty())
+				exception += '\n';
+			exception += exceptions[member];
+		}
+		member++;
+	}
+
+	if (!exception.empty())
+		throw BE::Error::StrategyError(exception);
+
+	return (ret);
+}
+
 std::map<const std::string, uint64_t>
 BiometricEvaluation::IO::RecordStoreUnion::Impl::length(
     const std::string &key)
     const
 {
-	std::string exceptions;
-	std::map<const std::string, uint64_t> ret;
+	std::vector<std::string> exceptions(this->_recordStores.size());
+	std::vector<std::pair<bool, uint64_t>> lengths(
+	    this->_recordStores.size());
 
-	for (const auto &rsPair : this->_recordStores) {
+	this->forEachMember([&](size_t member, const std::string &name,
+	    BE::IO::RecordStore &rs) {
 		try {
-			ret.emplace(std::make_pair(rsPair.first,
-			    rsPair.second->length(key)));
+			lengths[member].second = rs.length(key);
+			lengths[member].first = true;
 		} catch (const BE::Error::ObjectDoesNotExist&) {
 			/* Swallow */
 		} catch (BE::Error::Exception &e) {
-			if (!exceptions.empty())
-				exceptions += '\n';
-			exceptions += e.whatString() + " (" + rsPair.first +
+			exceptions[member] = e.whatString() + " (" + name +
 			    ')';
 		}
+	});
+
+	std::string exception;
+	std::map<const std::string, uint64_t> ret;
+	size_t member = 0;
+	for (const auto &rsPair : this->_recordStores) {
+		if (lengths[member].first)
+			ret.emplace(std::make_pair(rsPair.first,
+			    lengths[member].second));
+		if (!exceptions[member].empty()) {
+			if (!exception.empty())
+				exception += '\n';
+			exception += exceptions[member];
+		}
+		member++;
 	}
 
-	if (!exceptions.empty())
-		throw BE::Error::StrategyError(exceptions);
+	if (!exception.empty())
+		throw BE::Error::StrategyError(exception);
 	if (ret.size() == 0)
 		throw BE::Error::ObjectDoesNotExist(key);
 
 	return (ret);
 }
-
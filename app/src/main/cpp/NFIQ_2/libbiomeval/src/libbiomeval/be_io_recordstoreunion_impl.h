@@ -14,7 +14,11 @@
 #define BE_IO_RECORDSTOREUNION_IMPL_H_
 
 
+#include <condition_variable>
+#include <deque>
 #include <functional>
+#include <mutex>
+#include <thread>
 
 namespace BiometricEvaluation
 {
@@ -178,6 +182,52 @@ namespace BiometricEvaluation
 			    const std::string &key)
 			    const;
 
+			/**
+			 * @brief
+			 * Read a key from the first member RecordStore found
+			 * to contain it.
+			 *
+			 * @param key
+			 * The key to read.
+			 *
+			 * @return
+			 * Pair of the name of a RecordStore containing key
+			 * and the data read from said RecordStore.
+			 *
+ 			 * @throw Error::ObjectDoesNotExist
+			 * key does not exist in any member RecordStores.
+			 * @throw Error::StrategyError
+			 * Exceptions propagated from RecordStore, with the
+			 * exception of ObjectDoesNotExist, when no member
+			 * RecordStore returned key.
+			 */
+			std::pair<std::string,
+			BiometricEvaluation::Memory::uint8Array>
+			readFirst(
+			    const std::string &key)
+			    const;
+
+			/**
+			 * @brief
+			 * Read many keys from all member RecordStores.
+			 *
+			 * @param keys
+			 * The keys to read.
+			 *
+			 * @return
+			 * Map of key to a map of RecordStore name to data
+			 * read from said RecordStore.
+			 *
+			 * @throw Error::StrategyError
+			 * Exceptions propagated from RecordStore, with the
+			 * exception of ObjectDoesNotExist.
+			 */
+			std::map<const std::string, std::map<const std::string,
+			BiometricEvaluation::Memory::uint8Array>>
+			read(
+			    const std::vector<std::string> &keys)
+			    const;
+
 			/**
 			 * @brief
 			 * Retrieve the length of a key from all member
@@ -205,10 +255,77 @@ namespace BiometricEvaluation
 			    const std::string &key)
 			    const;
 
-			/** Default destructor */
-			~Impl() = default;
+			/** Destructor, stopping worker threads */
+			~Impl();
 
 		private:
+			/** Thread performing operations on one member */
+			struct MemberWorker
+			{
+				/** Operations waiting to run */
+				std::deque<std::function<void()>> tasks{};
+				/** Set when the thread should exit */
+				bool stopping{false};
+				/** Protects tasks and stopping */
+				std::mutex mutex{};
+				/** Signals changes to tasks and stopping */
+				std::condition_variable taskAvailable{};
+				/** The thread */
+				std::thread thread{};
+			};
+
+			/**
+			 * @brief
+			 * Run operations from a worker's queue until it is
+			 * stopped.
+			 *
+			 * @param worker
+			 * Worker whose queue to run.
+			 */
+			static void
+			work(
+			    MemberWorker &worker);
+
+			/**
+			 * @brief
+			 * Run an operation on the thread of a member
+			 * RecordStore.
+			 *
+			 * @param member
+			 * Position of the RecordStore in _recordStores.
+			 * @param task
+			 * Operation to run. Must not throw.
+			 *
+			 * @note
+			 * Worker threads are started on first use. Unions
+			 * with a single member run task on the calling
+			 * thread.
+			 */
+			void
+			dispatch(
+			    size_t member,
+			    const std::function<void()> &task)
+			    const;
+
+			/**
+			 * @brief
+			 * Run an operation on every member RecordStore
+			 * concurrently.
+			 *
+			 * @param operation
+			 * Operation to run, given the position, name, and
+			 * RecordStore of a member.
+			 *
+			 * @throw
+			 * The first exception thrown by operation, in member
+			 * order, after operation has run on every member.
+			 */
+			void
+			forEachMember(
+			    const std::function<void(size_t, const std::string&,
+			    BiometricEvaluation::IO::RecordStore&)> &operation)
+			    const;
+
 			/**
 			 * @brief
 			 * Check that RecordStore names passed to a method
@@ -249,6 +366,18 @@ namespace BiometricEvaluation
 			const std::map<const std::string, const std::shared_ptr<
 			    BiometricEvaluation::IO::RecordStore>>
 			    _recordStores;
+
+			/*
+			 * Each member RecordStore is only ever used by its
+			 * own worker, so members are read concurrently while
+			 * every RecordStore is used by one thread at a time.
+			 */
+
+			/** Workers, in _recordStores order */
+			mutable std::vector<std::unique_ptr<MemberWorker>>
+			    _workers{};
+			/** Protects starting _workers */
+			mutable std::mutex _workersMutex{};
 		};
 	}
 }
@@ -118,6 +118,20 @@ BiometricEvaluation::IO::SQLiteRecordStore::setCursorAtKey(
 	this->pimpl->setCursorAtKey(key);
 }
 
+void
+BiometricEvaluation::IO::SQLiteRecordStore::setTransactionSize(
+    uint64_t records)
+{
+	this->pimpl->setTransactionSize(records);
+}
+
+uint64_t
+BiometricEvaluation::IO::SQLiteRecordStore::getTransactionSize()
+    const
+{
+	return (this->pimpl->getTransactionSize());
+}
+
 unsigned int
 BiometricEvaluation::IO::SQLiteRecordStore::getCount()
     const
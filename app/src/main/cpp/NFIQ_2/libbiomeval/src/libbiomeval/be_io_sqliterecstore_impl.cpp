@@ -9,6 +9,7 @@
  */
 
 #include <cstdlib>
+#include <cstring>
 #include <sstream>
 
 #include "be_io_sqliterecstore_impl.h"
@@ -57,6 +58,33 @@ const std::string
  */
 static const uint64_t MAX_REC_SIZE = (uint64_t)1000000000U;
 
+namespace
+{
+	/*
+	 * Return a cached statement to its initial state when leaving
+	 * scope, so that it can be reused and does not hold locks.
+	 */
+	class StatementReset
+	{
+	public:
+		explicit StatementReset(sqlite3_stmt *statement) :
+		    _statement(statement)
+		{
+		}
+
+		~StatementReset()
+		{
+			sqlite3_reset(_statement);
+			sqlite3_clear_bindings(_statement);
+		}
+
+		StatementReset(const StatementReset&) = delete;
+		StatementReset& operator=(const StatementReset&) = delete;
+	private:
+		sqlite3_stmt *_statement;
+	};
+}
+
 BiometricEvaluation::IO::SQLiteRecordStore::Impl::Impl(
     const std::string &pathname,
     const std::string &description) :
@@ -64,7 +92,17 @@ BiometricEvaluation::IO::SQLiteRecordStore::Impl::Impl(
     _db(nullptr),
     _dbname(""),
     _sequencer(nullptr),
-    _sequenceEnd(false)
+    _sequenceEnd(false),
+    _sequenceAll(nullptr),
+    _sequenceFrom(nullptr),
+    _insertStatement{nullptr, nullptr},
+    _selectStatement{nullptr, nullptr},
+    _lengthStatement{nullptr, nullptr},
+    _deleteStatement{nullptr, nullptr},
+    _rowidStatement(nullptr),
+    _transactionSize(0),
+    _pendingWrites(0),
+    _inTransaction(false)
 {
 #ifdef	SQLITE_V2_SUPPORT
 	sqlite3_initialize();
@@ -96,7 +134,17 @@ BiometricEvaluation::IO::SQLiteRecordStore::Impl::Impl(
     _db(nullptr),
     _dbname(""),
     _sequencer(nullptr),
-    _sequenceEnd(false)
+    _sequenceEnd(false),
+    _sequenceAll(nullptr),
+    _sequenceFrom(nullptr),
+    _insertStatement{nullptr, nullptr},
+    _selectStatement{nullptr, nullptr},
+    _lengthStatement{nullptr, nullptr},
+    _deleteStatement{nullptr, nullptr},
+    _rowidStatement(nullptr),
+    _transactionSize(0),
+    _pendingWrites(0),
+    _inTransaction(false)
 {
 #ifdef	SQLITE_V2_SUPPORT
 	sqlite3_initialize();
@@ -185,8 +233,47 @@ BiometricEvaluation::IO::SQLiteRecordStore::Impl::getSpaceUsed()
     const
 {
 	this->sync();
+
+	uint64_t walSize = 0;
+	if (IO::Utility::fileExists(this->_dbname + "-wal"))
+		walSize = IO::Utility::getFileSize(this->_dbname + "-wal");
 	return (RecordStore::Impl::getSpaceUsed() + 
-	    IO::Utility::getFileSize(this->_dbname));
+	    IO::Utility::getFileSize(this->_dbname) + walSize);
+}
+
+void
+BiometricEvaluation::IO::SQLiteRecordStore::Impl::sync()
+    const
+{
+	this->commit();
+	RecordStore::Impl::sync();
+}
+
+void
+BiometricEvaluation::IO::SQLiteRecordStore::Impl::setTransactionSize(
+    uint64_t records)
+{
+	if (getMode() == Mode::ReadOnly)
+		throw Error::StrategyError("RecordStore was opened read-only");
+
+	std::lock_guard<std::recursive_mutex> lock(_statementMutex);
+	this->commit();
+	if (records > 1) {
+		/*
+		 * Journal mode cannot change inside a transaction, and
+		 * persists in the database file once changed.
+		 */
+		this->execute("PRAGMA journal_mode=WAL");
+		this->execute("PRAGMA synchronous=NORMAL");
+	}
+	_transactionSize = records;
+}
+
+uint64_t
+BiometricEvaluation::IO::SQLiteRecordStore::Impl::getTransactionSize()
+    const
+{
+	return (_transactionSize);
 }
 
 void
@@ -199,40 +286,22 @@ BiometricEvaluation::IO::SQLiteRecordStore::Impl::insert(
 		throw Error::StrategyError("RecordStore was opened read-only");
 	if (!validateKeyString(key))
 		throw Error::StrategyError("Invalid key format");
-	
-	/* Warn if key is already in database */
-	try {
-		this->length(key);
-		throw Error::ObjectExists(key);
-	} catch (const Error::ObjectDoesNotExist&) {}
-	
-	sqlite3_stmt *statement = nullptr;
-	std::string activeTable = PRIMARY_KV_TABLE;
+
+	std::lock_guard<std::recursive_mutex> lock(_statementMutex);
+	this->beginWrite();
+
+	int table = 0;
 	uint64_t segnum = 0;
 	uint64_t remSize = size, bindSize = 0;
-	uint8_t *bindData = (uint8_t *)data;
+	const uint8_t *bindData = static_cast<const uint8_t *>(data);
 	while ((remSize > 0) ||
 	    ((remSize == 0) && (segnum < KEY_SEGMENT_START))) {
-		std::string sqlCommand = "INSERT INTO " + activeTable + " " + 
-		    "VALUES ('" + genKeySegName(key, segnum) +
-		    "', $value)";
-	
-		/* Prepare the statement */
-#ifdef	SQLITE_V2_SUPPORT
-		int32_t rv = sqlite3_prepare_v2(_db, sqlCommand.c_str(),
-		    sqlCommand.length(), &statement, nullptr);
-#else
-		int32_t rv = sqlite3_prepare(_db, sqlCommand.c_str(),
-		    sqlCommand.length(), &statement, nullptr);
-#endif
-		if (rv != SQLITE_OK) {
-			sqlite3_finalize(statement);
-			sqliteError(rv);
-		}
-		if (statement == nullptr)
-			throw Error::StrategyError("SQLite: Could not allocate "
-			    "statement");
-	
+		sqlite3_stmt *statement = this->prepare(
+		    _insertStatement[table], "INSERT INTO " +
+		    (table == 0 ? PRIMARY_KV_TABLE : SUBORDINATE_KV_TABLE) +
+		    " VALUES (?1, ?2)");
+		StatementReset reset(statement);
+
 		/* Bind data to the statement, segmenting if necessary */
 		if (remSize < MAX_REC_SIZE) {
 			bindSize = remSize;
@@ -241,39 +310,42 @@ BiometricEvaluation::IO::SQLiteRecordStore::Impl::insert(
 			bindSize = MAX_REC_SIZE;
 			remSize -= MAX_REC_SIZE;
 		}
-		rv = sqlite3_bind_blob(statement,
-		    sqlite3_bind_parameter_index(statement, "$value"),
-		    bindData, bindSize, SQLITE_STATIC);
-		if (rv != SQLITE_OK) {
-			sqlite3_finalize(statement);
-			sqliteError(rv);
-		}
-			
-		/* Execute the statement */
-		rv = sqlite3_step(statement);
-		if (rv != SQLITE_DONE) {
-			sqlite3_finalize(statement);
+		const std::string segName = genKeySegName(key, segnum);
+		int32_t rv = sqlite3_bind_text(statement, 1, segName.c_str(),
+		    segName.length(), SQLITE_STATIC);
+		if (rv != SQLITE_OK)
 			sqliteError(rv);
-		}
-			
-		/* Free the statement */
-		rv = sqlite3_finalize(statement);
+		rv = sqlite3_bind_blob(statement, 2, bindData, bindSize,
+		    SQLITE_STATIC);
 		if (rv != SQLITE_OK)
 			sqliteError(rv);
-			
+
+		/*
+		 * Execute the statement. The key column is unique, so
+		 * inserting an existing key fails without first probing
+		 * for it.
+		 */
+		rv = sqlite3_step(statement);
+		if ((rv == SQLITE_CONSTRAINT) && (segnum == 0))
+			throw Error::ObjectExists(key);
+		if (rv != SQLITE_DONE)
+			sqliteError(rv);
+
 		/* Increment data position and segment */
 		bindData += bindSize;
 		switch (segnum) {
 		case 0:
 			segnum = KEY_SEGMENT_START;
-			activeTable = SUBORDINATE_KV_TABLE;
+			table = 1;
 			break;
 		default:
 			segnum++;
 			break;
 		}
 	}
-	
+
+	this->endWrite();
+
 	/* Propagate to parent class */
 	RecordStore::Impl::insert(key, data, size);
 }
@@ -287,43 +359,30 @@ BiometricEvaluation::IO::SQLiteRecordStore::Impl::remove(
 	if (!validateKeyString(key))
 		throw Error::StrategyError("Invalid key format");
 
-	sqlite3_stmt *statement;
-	std::string activeTable = PRIMARY_KV_TABLE;
+	std::lock_guard<std::recursive_mutex> lock(_statementMutex);
+	this->beginWrite();
+
+	int table = 0;
 	int64_t segnum = 0;
 	bool moreSegments = true;
 	while (moreSegments) {
-		std::string sqlCommand = "DELETE FROM " + activeTable + " " + 
-		    "WHERE " + KEY_COL + " = '" + genKeySegName(key, segnum) + 
-		    "'";
-		
-		/* Prepare the statement */
-#ifdef	SQLITE_V2_SUPPORT
-		int32_t rv = sqlite3_prepare_v2(_db, sqlCommand.c_str(),
-		    sqlCommand.length(), &statement, nullptr);
-#else
-		int32_t rv = sqlite3_prepare(_db, sqlCommand.c_str(),
-		    sqlCommand.length(), &statement, nullptr);
-#endif
-		if (rv != SQLITE_OK) {
-			sqlite3_finalize(statement);
+		sqlite3_stmt *statement = this->prepare(
+		    _deleteStatement[table], "DELETE FROM " +
+		    (table == 0 ? PRIMARY_KV_TABLE : SUBORDINATE_KV_TABLE) +
+		    " WHERE " + KEY_COL + " = ?1");
+		StatementReset reset(statement);
+
+		const std::string segName = genKeySegName(key, segnum);
+		int32_t rv = sqlite3_bind_text(statement, 1, segName.c_str(),
+		    segName.length(), SQLITE_STATIC);
+		if (rv != SQLITE_OK)
 			sqliteError(rv);
-		}
-		if (statement == nullptr)
-			throw Error::StrategyError("SQLite: Could not allocate "
-			    "statement");
-	
+
 		/* Execute the statement */
 		rv = sqlite3_step(statement);
-		if (rv != SQLITE_DONE) {
-			sqlite3_finalize(statement);
+		if (rv != SQLITE_DONE)
 			sqliteError(rv);
-		}
-		
-		/* Free the statement */
-		rv = sqlite3_finalize(statement);
-		if (rv != SQLITE_OK)
-			sqliteError(rv);
-		
+
 		/* Increment segment number */
 		switch (segnum) {
 		case 0:
@@ -332,7 +391,7 @@ BiometricEvaluation::IO::SQLiteRecordStore::Impl::remove(
 				throw Error::ObjectDoesNotExist(key);
 				
 			segnum = KEY_SEGMENT_START;
-			activeTable = SUBORDINATE_KV_TABLE;
+			table = 1;
 			break;
 		default:
 			/* Check if there could be more segments */
@@ -346,7 +405,9 @@ BiometricEvaluation::IO::SQLiteRecordStore::Impl::remove(
 			break;
 		}
 	}
-	
+
+	this->endWrite();
+
 	/* Propagate changes to parent */		
 	RecordStore::Impl::remove(key);
 }
@@ -356,6 +417,7 @@ BiometricEvaluation::IO::SQLiteRecordStore::Impl::read(
     const std::string &key)
     const
 {
+	std::lock_guard<std::recursive_mutex> lock(_statementMutex);
 	BiometricEvaluation::Memory::uint8Array data;
 	data.resize(this->length(key));
 	this->readSegments(key, data);
@@ -379,66 +441,61 @@ BiometricEvaluation::IO::SQLiteRecordStore::Impl::readSegments(
 	if (!validateKeyString(key))
 		throw Error::StrategyError("Invalid key format");
 
-	sqlite3_stmt *statement;
+	std::lock_guard<std::recursive_mutex> lock(_statementMutex);
+
+	/* Sizes are computed by SQLite without loading the record */
+	sqlite3_stmt **cache = (data == nullptr) ?
+	    _lengthStatement : _selectStatement;
+	const std::string column = (data == nullptr) ?
+	    "length(" + VALUE_COL + ")" : VALUE_COL;
+
+	int table = 0;
 	uint64_t segnum = 0;
-	uint64_t totalBytes = 0, segBytes;
-	std::string activeTable = PRIMARY_KV_TABLE;
+	uint64_t totalBytes = 0, segBytes = 0;
 	uint8_t *dataPtr = (uint8_t *)data;
 	bool moreSegments = true;
 	while (moreSegments) {
-		std::string sqlCommand = "SELECT " + VALUE_COL + " FROM " + 
-		    activeTable + " WHERE " + KEY_COL + " = '" + 
-		    genKeySegName(key, segnum) + "' LIMIT 1";
-		    
-		/* Prepare the statement */
-#ifdef	SQLITE_V2_SUPPORT
-		int32_t rv = sqlite3_prepare_v2(_db, sqlCommand.c_str(),
-		    sqlCommand.length(), &statement, nullptr);
-#else
-		int32_t rv = sqlite3_prepare(_db, sqlCommand.c_str(),
-		    sqlCommand.length(), &statement, nullptr);
-#endif
-		if (rv != SQLITE_OK) {
-			sqlite3_finalize(statement);
+		sqlite3_stmt *statement = this->prepare(cache[table],
+		    "SELECT " + column + " FROM " +
+		    (table == 0 ? PRIMARY_KV_TABLE : SUBORDINATE_KV_TABLE) +
+		    " WHERE " + KEY_COL + " = ?1 LIMIT 1");
+		StatementReset reset(statement);
+
+		const std::string segName = genKeySegName(key, segnum);
+		int32_t rv = sqlite3_bind_text(statement, 1, segName.c_str(),
+		    segName.length(), SQLITE_STATIC);
+		if (rv != SQLITE_OK)
 			sqliteError(rv);
-		}
-		if (statement == nullptr)
-			throw Error::StrategyError("SQLite: Could not allocate "
-			    "statement");
-			
+
 		/* Execute the statement */
 		rv = sqlite3_step(statement);
+		if ((rv != SQLITE_ROW) && (rv != SQLITE_DONE))
+			sqliteError(rv);
 		switch (segnum) {
 		case 0:
-			if (rv != SQLITE_ROW) {
-				sqlite3_finalize(statement);
+			if (rv != SQLITE_ROW)
 				throw Error::ObjectDoesNotExist(key);
-			}
 			/* FALLTHROUGH */
 		default:
-			segBytes = sqlite3_column_bytes(statement, 0);
-			totalBytes += segBytes;
-			
-			if (data != nullptr) {
-				memcpy(dataPtr,
+			if (data == nullptr) {
+				segBytes = sqlite3_column_int64(statement, 0);
+			} else {
+				segBytes = sqlite3_column_bytes(statement, 0);
+				std::memcpy(dataPtr,
 				    sqlite3_column_blob(statement, 0),
 				    segBytes);
 				dataPtr += segBytes;
-				break;
 			}
+			totalBytes += segBytes;
+			break;
 		}
 
-		/* Free the statement */
-		rv = sqlite3_finalize(statement);
-		if (rv != SQLITE_OK)
-			sqliteError(rv);
-			
 		/* Increment segment number if there's more data */
 		if (segBytes == MAX_REC_SIZE) {
 			switch (segnum) {
 			case 0:
 				segnum = KEY_SEGMENT_START;
-				activeTable = SUBORDINATE_KV_TABLE;
+				table = 1;
 				break;
 			default:
 				segnum++;
@@ -462,9 +519,10 @@ BiometricEvaluation::IO::SQLiteRecordStore::Impl::flush(
 
 	/* 
 	 * SQLite performs an fsync() at the end of every transaction and this
-	 * cannot be forced at other times.  We can create another transaction
-	 * and ensure the key exists by checking its length.
+	 * cannot be forced at other times.  We can commit batched writes, then
+	 * ensure the key exists by checking its length.
 	 */
+	this->commit();
 	this->length(key);
 }
 BiometricEvaluation::IO::RecordStore::Record
@@ -476,27 +534,16 @@ BiometricEvaluation::IO::SQLiteRecordStore::Impl::i_sequence(
 	    (cursor != BE_RECSTORE_SEQ_NEXT))
 		throw Error::StrategyError("Invalid cursor position as " 
 		    "argument");
-		    
+
+	std::lock_guard<std::recursive_mutex> lock(_statementMutex);
+
 	int32_t rv;
 	if ((cursor == BE_RECSTORE_SEQ_START) || (_sequencer == nullptr)) {
-		std::string sqlCommand = "SELECT *,ROWID FROM " + 
-		    PRIMARY_KV_TABLE + " " + "ORDER BY ROWID";
-		
-		/* Finalize previous statement */
-		rv = sqlite3_finalize(_sequencer);
-		if (rv != SQLITE_OK)
-			sqliteError(rv);
-		
-		/* Prepare the statement */
-#ifdef	SQLITE_V2_SUPPORT
-		rv = sqlite3_prepare_v2(_db, sqlCommand.c_str(),
-		    sqlCommand.length(), &_sequencer, nullptr);
-#else
-		rv = sqlite3_prepare(_db, sqlCommand.c_str(),
-		    sqlCommand.length(), &_sequencer, nullptr);
-#endif
-		if ((rv != SQLITE_OK) || (_sequencer == nullptr))
-			sqliteError(rv);
+		/* Restart sequencing from the first row */
+		if (_sequencer != nullptr)
+			sqlite3_reset(_sequencer);
+		_sequencer = this->prepare(_sequenceAll, "SELECT *,ROWID "
+		    "FROM " + PRIMARY_KV_TABLE + " ORDER BY ROWID");
 		_sequenceEnd = false;
 	}
 	
@@ -509,26 +556,13 @@ BiometricEvaluation::IO::SQLiteRecordStore::Impl::i_sequence(
 	 * modifying the database between setCursorAtKey() and sequence().
 	 */
 	if (_cursorRow != 0) {
-		/* Finalize previous sequence() SELECT */
-		rv = sqlite3_finalize(_sequencer);
-		if (rv != SQLITE_OK)
-			sqliteError(rv);
-	
-		std::stringstream sqlCommand;
-		sqlCommand << "SELECT *,ROWID FROM " <<
-		    PRIMARY_KV_TABLE << " " << "WHERE ROWID >= " << 
-		    _cursorRow << " ORDER BY ROWID";
+		sqlite3_reset(_sequencer);
+		_sequencer = this->prepare(_sequenceFrom, "SELECT *,ROWID "
+		    "FROM " + PRIMARY_KV_TABLE + " WHERE ROWID >= ?1 "
+		    "ORDER BY ROWID");
+		rv = sqlite3_bind_int64(_sequencer, 1, _cursorRow);
 		_cursorRow = 0;
-	
-		/* Prepare the statement */
-#ifdef	SQLITE_V2_SUPPORT
-		rv = sqlite3_prepare_v2(_db, sqlCommand.str().c_str(),
-		    sqlCommand.str().length(), &_sequencer, nullptr);
-#else
-		rv = sqlite3_prepare(_db, sqlCommand.str().c_str(),
-		    sqlCommand.str().length(), &_sequencer, nullptr);
-#endif
-		if ((rv != SQLITE_OK) || (_sequencer == nullptr))
+		if (rv != SQLITE_OK)
 			sqliteError(rv);
 	}
 	
@@ -541,8 +575,8 @@ BiometricEvaluation::IO::SQLiteRecordStore::Impl::i_sequence(
 	case SQLITE_ROW: {
 		record.key.assign(
 		    (const char *)sqlite3_column_text(_sequencer, 0));
-		uint64_t bytes = sqlite3_column_bytes(_sequencer, 1);
 		if (returnData) {
+			uint64_t bytes = sqlite3_column_bytes(_sequencer, 1);
 			record.data.resize(bytes);
 			record.data.copy(
 				(uint8_t *)sqlite3_column_blob(_sequencer, 1),
@@ -556,10 +590,10 @@ BiometricEvaluation::IO::SQLiteRecordStore::Impl::i_sequence(
 		/* Not reached */
 		break;
 	default:
-		/* Free the statement */
-		rv = sqlite3_finalize(_sequencer);
-		if (rv != SQLITE_OK)
-			sqliteError(rv);
+		/* Restart sequencing on the next call */
+		sqlite3_reset(_sequencer);
+		_sequencer = nullptr;
+		sqliteError(rv);
 		
 		/* Not reached */
 		break;
@@ -590,21 +624,15 @@ BiometricEvaluation::IO::SQLiteRecordStore::Impl::setCursorAtKey(
 	if (!validateKeyString(key))
 		throw Error::StrategyError("Invalid key format");
 
-	int32_t rv;
-	
-	sqlite3_stmt *statement;
-	std::string sqlCommand = "SELECT ROWID FROM " + PRIMARY_KV_TABLE + " " +
-	    "WHERE " + KEY_COL + " = '" + key + "'";
-	
-	/* Prepare the statement */
-#ifdef	SQLITE_V2_SUPPORT
-	rv = sqlite3_prepare_v2(_db, sqlCommand.c_str(), sqlCommand.length(),
-	    &statement, nullptr);
-#else
-	rv = sqlite3_prepare(_db, sqlCommand.c_str(), sqlCommand.length(),
-	    &statement, nullptr);
-#endif
-	if ((rv != SQLITE_OK) || (statement == nullptr))
+	std::lock_guard<std::recursive_mutex> lock(_statementMutex);
+
+	sqlite3_stmt *statement = this->prepare(_rowidStatement,
+	    "SELECT ROWID FROM " + PRIMARY_KV_TABLE + " WHERE " + KEY_COL +
+	    " = ?1");
+	StatementReset reset(statement);
+	int32_t rv = sqlite3_bind_text(statement, 1, key.c_str(), key.length(),
+	    SQLITE_STATIC);
+	if (rv != SQLITE_OK)
 		sqliteError(rv);
 	
 	/* Execute the statement */
@@ -612,27 +640,15 @@ BiometricEvaluation::IO::SQLiteRecordStore::Impl::setCursorAtKey(
 	
 	/* End of entries */
 	switch (rv) {
-	case SQLITE_ROW: {
-		_cursorRow = (uint64_t)strtoll(
-		    (const char *)sqlite3_column_text(statement, 0), nullptr, 
-		    10);
-
-    		rv = sqlite3_finalize(statement);
-		if (rv != SQLITE_OK)
-			sqliteError(rv);
+	case SQLITE_ROW:
+		_cursorRow = (uint64_t)sqlite3_column_int64(statement, 0);
 		break;
-	} case SQLITE_DONE:
-		rv = sqlite3_finalize(statement);
-		if (rv != SQLITE_OK)
-			sqliteError(rv);
+	case SQLITE_DONE:
 		throw Error::ObjectDoesNotExist();
 		
 		/* Not reached */
 		break;
 	default:
-    		rv = sqlite3_finalize(statement);
-		if (rv != SQLITE_OK)
-			sqliteError(rv);
 		throw Error::StrategyError();
 		
 		/* Not reached */
@@ -648,13 +664,31 @@ BiometricEvaluation::IO::SQLiteRecordStore::Impl::cleanup()
 {
 	int32_t rv;
 
-	/* Finalize sequencer */
-	rv = sqlite3_finalize(_sequencer);
-	if (rv != SQLITE_OK)
-		throw Error::StrategyError("SQLite: Could not finalize "
-		    "sequencer");
+	std::lock_guard<std::recursive_mutex> lock(_statementMutex);
+
+	/* Commit batched writes */
+	this->commit();
+
+	/* Finalize cached statements (including the sequencer) */
+	sqlite3_stmt **statements[] = {
+		&_sequenceAll, &_sequenceFrom,
+		&_insertStatement[0], &_insertStatement[1],
+		&_selectStatement[0], &_selectStatement[1],
+		&_lengthStatement[0], &_lengthStatement[1],
+		&_deleteStatement[0], &_deleteStatement[1],
+		&_rowidStatement
+	};
+	bool finalized = true;
+	for (auto statement : statements) {
+		if (sqlite3_finalize(*statement) != SQLITE_OK)
+			finalized = false;
+		*statement = nullptr;
+	}
 	_sequenceEnd = false;
 	_sequencer = nullptr;
+	if (!finalized)
+		throw Error::StrategyError("SQLite: Could not finalize "
+		    "statements");
 	
 	/* Close DB */
 	rv = sqlite3_close(_db);
@@ -663,6 +697,74 @@ BiometricEvaluation::IO::SQLiteRecordStore::Impl::cleanup()
 		    "free all statements?)");
 }
 
+sqlite3_stmt *
+BiometricEvaluation::IO::SQLiteRecordStore::Impl::prepare(
+    sqlite3_stmt *&statement,
+    const std::string &sqlCommand)
+    const
+{
+	if (statement != nullptr)
+		return (statement);
+
+#ifdef	SQLITE_V2_SUPPORT
+	int32_t rv = sqlite3_prepare_v2(_db, sqlCommand.c_str(),
+	    sqlCommand.length(), &statement, nullptr);
+#else
+	int32_t rv = sqlite3_prepare(_db, sqlCommand.c_str(),
+	    sqlCommand.length(), &statement, nullptr);
+#endif
+	if (rv != SQLITE_OK) {
+		sqlite3_finalize(statement);
+		statement = nullptr;
+		sqliteError(rv);
+	}
+	if (statement == nullptr)
+		throw Error::StrategyError("SQLite: Could not allocate "
+		    "statement");
+	return (statement);
+}
+
+void
+BiometricEvaluation::IO::SQLiteRecordStore::Impl::execute(
+    const std::string &sqlCommand)
+    const
+{
+	int32_t rv = sqlite3_exec(_db, sqlCommand.c_str(), nullptr, nullptr,
+	    nullptr);
+	if (rv != SQLITE_OK)
+		sqliteError(rv);
+}
+
+void
+BiometricEvaluation::IO::SQLiteRecordStore::Impl::beginWrite()
+{
+	if ((_transactionSize > 1) && !_inTransaction) {
+		this->execute("BEGIN IMMEDIATE");
+		_inTransaction = true;
+		_pendingWrites = 0;
+	}
+}
+
+void
+BiometricEvaluation::IO::SQLiteRecordStore::Impl::endWrite()
+{
+	if (_inTransaction && (++_pendingWrites >= _transactionSize))
+		this->commit();
+}
+
+void
+BiometricEvaluation::IO::SQLiteRecordStore::Impl::commit()
+    const
+{
+	std::lock_guard<std::recursive_mutex> lock(_statementMutex);
+	if (!_inTransaction)
+		return;
+
+	this->execute("COMMIT");
+	_inTransaction = false;
+	_pendingWrites = 0;
+}
+
 void
 BiometricEvaluation::IO::SQLiteRecordStore::Impl::sqliteError(
     int32_t errorNumber)
@@ -13,6 +13,8 @@
 
 #include <sqlite3.h>
 
+#include <mutex>
+
 #include "be_io_recordstore_impl.h"
 #include <be_io_sqliterecstore.h>
 
@@ -42,6 +44,16 @@ namespace BiometricEvaluation
 			uint64_t
 			getSpaceUsed() const;
 
+			void
+			sync() const;
+
+			void
+			setTransactionSize(
+			    uint64_t records);
+
+			uint64_t
+			getTransactionSize() const;
+
 			void
 			insert(
 			    const std::string &key,
@@ -184,17 +196,103 @@ namespace BiometricEvaluation
 			void
 			cleanup();
 
+			/**
+			 * @brief
+			 * Obtain a cached prepared statement, preparing
+			 * it on first use.
+			 *
+			 * @param statement
+			 *	Cache for the prepared statement.
+			 * @param sqlCommand
+			 *	SQL to prepare if statement is nullptr.
+			 *
+			 * @return
+			 *	statement, reset and ready to bind.
+			 *
+			 * @throw Error::StrategyError
+			 *	Error compiling SQL.
+			 */
+			sqlite3_stmt *
+			prepare(
+			    sqlite3_stmt *&statement,
+			    const std::string &sqlCommand) const;
+
+			/**
+			 * @brief
+			 * Execute SQL that returns no rows.
+			 *
+			 * @param sqlCommand
+			 *	SQL to execute.
+			 *
+			 * @throw Error::StrategyError
+			 *	Error executing SQL.
+			 */
+			void
+			execute(
+			    const std::string &sqlCommand) const;
+
+			/**
+			 * @brief
+			 * Open a transaction for a write if writes are
+			 * being batched.
+			 *
+			 * @throw Error::StrategyError
+			 *	Error executing SQL.
+			 */
+			void
+			beginWrite();
+
+			/**
+			 * @brief
+			 * Count a completed write, committing the open
+			 * transaction once it holds _transactionSize writes.
+			 *
+			 * @throw Error::StrategyError
+			 *	Error executing SQL.
+			 */
+			void
+			endWrite();
+
+			/**
+			 * @brief
+			 * Commit the open transaction, if any.
+			 *
+			 * @throw Error::StrategyError
+			 *	Error executing SQL.
+			 */
+			void
+			commit() const;
+
 		private:
 			/** SQLite database handle */
 			sqlite3 *_db;
 			/** The filename of the SQLite database */
 			std::string _dbname;
-			/** SQLite statement used for sequencing */
+			/** SQLite statement used for sequencing (not owned) */
 			sqlite3_stmt *_sequencer;
 			/** If _sequencer has reached the end */
 			bool _sequenceEnd;
 			/** Row for key in setCursorForKey() */
 			uint64_t _cursorRow;
+			/** Sequences every row */
+			sqlite3_stmt *_sequenceAll;
+			/** Sequences rows from a ROWID, for setCursorAtKey() */
+			sqlite3_stmt *_sequenceFrom;
+			/** Cached statements, indexed by table (0: primary) */
+			sqlite3_stmt *_insertStatement[2];
+			mutable sqlite3_stmt *_selectStatement[2];
+			mutable sqlite3_stmt *_lengthStatement[2];
+			sqlite3_stmt *_deleteStatement[2];
+			sqlite3_stmt *_rowidStatement;
+			/** Serializes use of the cached statements */
+			mutable std::recursive_mutex _statementMutex;
+
+			/** Writes grouped in each transaction (0: none) */
+			uint64_t _transactionSize;
+			/** Writes made in the open transaction */
+			mutable uint64_t _pendingWrites;
+			/** Whether a batched transaction is open */
+			mutable bool _inTransaction;
 			
 			/** Name given to the primate SQLite table */
 			static const std::string PRIMARY_KV_TABLE;
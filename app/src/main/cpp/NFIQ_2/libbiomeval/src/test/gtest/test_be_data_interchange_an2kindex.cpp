@@ -0,0 +1,294 @@
+/*
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include <be_data_interchange_an2kindex.h>
+#include <be_framework_enumeration.h>
+#include <be_io_recordstore.h>
+#include <be_io_utility.h>
+
+#include <gtest/gtest.h>
+
+namespace BE = BiometricEvaluation;
+
+static const std::string TYPE4FILE{"../test_data/type4-slaps.an2k"};
+/* Transactions of Type-14 records */
+static const std::string TYPE14RS{"../test_data/AN2KRecordStore"};
+static const std::string TYPE14KEY{"A001.AN2"};
+
+/* Separators, as in an2k.h */
+static const uint8_t FS{0x1C};
+static const uint8_t GS{0x1D};
+
+static BE::Memory::uint8Array
+readType14()
+{
+	return (BE::IO::RecordStore::openRecordStore(TYPE14RS)->read(
+	    TYPE14KEY));
+}
+
+/* Copy of the first length bytes of buf, so overreads are not masked */
+static BE::Memory::uint8Array
+prefix(
+    const BE::Memory::uint8Array &buf,
+    uint64_t length)
+{
+	BE::Memory::uint8Array copy(length);
+	copy.copy(buf, length);
+	return (copy);
+}
+
+/* Replace the value of the Type-1 field at tag, keeping 1.001 correct */
+static BE::Memory::uint8Array
+replaceType1Field(
+    const BE::Memory::uint8Array &buf,
+    const std::string &tag,
+    const std::string &value)
+{
+	const std::string text(reinterpret_cast<const char *>(
+	    static_cast<const uint8_t *>(buf)), buf.size());
+	const std::string::size_type start = text.find(tag) + tag.size();
+	const std::string::size_type end = text.find_first_of(
+	    std::string{static_cast<char>(GS), static_cast<char>(FS)},
+	    start);
+	const std::string::size_type type1End = text.find(
+	    static_cast<char>(FS)) + 1;
+
+	/* "1.001:" is first, and its length includes its own digits */
+	const std::string::size_type lengthEnd = text.find(
+	    static_cast<char>(GS));
+	std::string type1 = text.substr(0, start) + value +
+	    text.substr(end, type1End - end);
+	const std::string oldLength = text.substr(6, lengthEnd - 6);
+	std::string length = std::to_string(type1.size() - oldLength.size());
+	length = std::to_string(type1.size() - oldLength.size() +
+	    length.size());
+	type1 = "1.001:" + length + type1.substr(lengthEnd);
+
+	const std::string transaction = type1 + text.substr(type1End);
+	BE::Memory::uint8Array modified(transaction.size());
+	modified.copy(reinterpret_cast<const uint8_t *>(transaction.data()),
+	    transaction.size());
+	return (modified);
+}
+
+static void
+expectSameImage(
+    const std::shared_ptr<BE::Image::Image> &expected,
+    const std::shared_ptr<BE::Image::Image> &actual)
+{
+	const BE::Memory::uint8Array expectedPixels =
+	    expected->getRawGrayscaleData(8);
+	const BE::Memory::uint8Array actualPixels =
+	    actual->getRawGrayscaleData(8);
+	ASSERT_EQ(expectedPixels.size(), actualPixels.size());
+	EXPECT_EQ(0, std::memcmp(expectedPixels, actualPixels,
+	    expectedPixels.size()));
+}
+
+TEST(AN2KIndex, Type4MatchesRecord)
+{
+	const auto buffer = BE::IO::Utility::readFile(TYPE4FILE);
+	std::unique_ptr<BE::DataInterchange::AN2KIndex> index;
+	ASSERT_NO_THROW(index.reset(new BE::DataInterchange::AN2KIndex(
+	    buffer)));
+	BE::DataInterchange::AN2KRecord record(TYPE4FILE);
+
+	EXPECT_EQ(index->getFingerCaptures().size(), 0);
+	const auto &captures = index->getFingerFixedResolutionCaptures();
+	const auto views = record.getFingerFixedResolutionCaptures(
+	    BE::View::AN2KView::RecordType::Type_4);
+	ASSERT_EQ(captures.size(), views.size());
+	ASSERT_NE(captures.size(), 0);
+
+	for (size_t i = 0; i < captures.size(); i++) {
+		const auto &capture = captures[i];
+		const auto &view = views[i];
+		EXPECT_EQ(capture.type,
+		    BE::View::AN2KView::RecordType::Type_4);
+		EXPECT_EQ(capture.recordNumber, i + 1);
+
+		const auto positions = view.getPositions();
+		ASSERT_NE(positions.size(), 0);
+		EXPECT_EQ(capture.fingerPosition,
+		    BE::Framework::Enumeration::to_int_type(positions[0]));
+
+		EXPECT_EQ(capture.resolution.xRes,
+		    view.getImageResolution().xRes);
+		EXPECT_EQ(capture.resolution.yRes,
+		    view.getImageResolution().yRes);
+		EXPECT_EQ(capture.resolution.units,
+		    view.getImageResolution().units);
+		EXPECT_EQ(capture.size.xSize, view.getImageSize().xSize);
+		EXPECT_EQ(capture.size.ySize, view.getImageSize().ySize);
+		EXPECT_EQ(capture.compression,
+		    view.getCompressionAlgorithm());
+
+		expectSameImage(view.getImage(),
+		    BE::DataInterchange::AN2KIndex::getImage(capture));
+	}
+}
+
+TEST(AN2KIndex, Type14MatchesRecord)
+{
+	BE::Memory::uint8Array buffer;
+	ASSERT_NO_THROW(buffer = readType14());
+	std::unique_ptr<BE::DataInterchange::AN2KIndex> index;
+	ASSERT_NO_THROW(index.reset(new BE::DataInterchange::AN2KIndex(
+	    buffer)));
+	BE::DataInterchange::AN2KRecord record(buffer);
+
+	EXPECT_EQ(index->getFingerFixedResolutionCaptures().size(), 0);
+	const auto &captures = index->getFingerCaptures();
+	const auto views = record.getFingerCaptures();
+	ASSERT_EQ(captures.size(), views.size());
+	ASSERT_NE(captures.size(), 0);
+
+	for (size_t i = 0; i < captures.size(); i++) {
+		const auto &capture = captures[i];
+		const auto &view = views[i];
+		EXPECT_EQ(capture.type,
+		    BE::View::AN2KView::RecordType::Type_14);
+		EXPECT_EQ(capture.recordNumber, i + 1);
+		EXPECT_EQ(capture.fingerPosition,
+		    BE::Framework::Enumeration::to_int_type(
+		    view.getPosition()));
+
+		EXPECT_EQ(capture.resolution.xRes,
+		    view.getImageResolution().xRes);
+		EXPECT_EQ(capture.resolution.yRes,
+		    view.getImageResolution().yRes);
+		EXPECT_EQ(capture.resolution.units,
+		    view.getImageResolution().units);
+		EXPECT_EQ(capture.size.xSize, view.getImageSize().xSize);
+		EXPECT_EQ(capture.size.ySize, view.getImageSize().ySize);
+		EXPECT_EQ(capture.compression,
+		    view.getCompressionAlgorithm());
+
+		expectSameImage(view.getImage(),
+		    BE::DataInterchange::AN2KIndex::getImage(capture));
+	}
+}
+
+TEST(AN2KIndex, Truncated)
+{
+	for (const auto &buffer : {BE::IO::Utility::readFile(TYPE4FILE),
+	    readType14()}) {
+		const BE::DataInterchange::AN2KIndex index(buffer);
+		const uint64_t type1Length =
+		    index.getRecordLocations().front().length;
+
+		/* Every length through the Type-1 record and beyond */
+		for (uint64_t length = 0; length < type1Length + 64; length++)
+			EXPECT_THROW(BE::DataInterchange::AN2KIndex(prefix(
+			    buffer, length)), BE::Error::DataError) << length;
+
+		/* Within, and at the end of, each later record */
+		for (const auto &location : index.getRecordLocations()) {
+			for (const uint64_t length : {location.offset + 1,
+			    location.offset + 4, location.offset +
+			    (location.length / 2), location.offset +
+			    location.length - 1})
+				EXPECT_THROW(BE::DataInterchange::AN2KIndex(
+				    prefix(buffer, length)),
+				    BE::Error::DataError) << length;
+		}
+		EXPECT_NO_THROW(BE::DataInterchange::AN2KIndex(prefix(buffer,
+		    buffer.size())));
+	}
+}
+
+TEST(AN2KIndex, BadCNT)
+{
+	const auto buffer = BE::IO::Utility::readFile(TYPE4FILE);
+
+	/* The unchanged field, rewritten, still indexes */
+	const std::string text(reinterpret_cast<const char *>(
+	    static_cast<const uint8_t *>(buffer)), buffer.size());
+	const std::string::size_type start = text.find("1.003:") + 6;
+	const std::string cnt = text.substr(start,
+	    text.find(static_cast<char>(GS), start) - start);
+	EXPECT_NO_THROW(BE::DataInterchange::AN2KIndex(replaceType1Field(
+	    buffer, "1.003:", cnt)));
+
+	/* Non-numeric record type */
+	std::string badType = cnt;
+	badType[badType.find('\x1E') + 1] = 'X';
+	EXPECT_THROW(BE::DataInterchange::AN2KIndex(replaceType1Field(
+	    buffer, "1.003:", badType)), BE::Error::DataError);
+
+	/* Empty record type */
+	EXPECT_THROW(BE::DataInterchange::AN2KIndex(replaceType1Field(
+	    buffer, "1.003:", cnt + "\x1E\x1F" "1")), BE::Error::DataError);
+
+	/* More records than the transaction contains */
+	EXPECT_THROW(BE::DataInterchange::AN2KIndex(replaceType1Field(
+	    buffer, "1.003:", cnt + "\x1E" "4\x1F" "9")),
+	    BE::Error::DataError);
+	EXPECT_THROW(BE::DataInterchange::AN2KIndex(replaceType1Field(
+	    buffer, "1.003:", cnt + "\x1E" "14\x1F" "9")),
+	    BE::Error::DataError);
+}
+
+TEST(AN2KIndex, OversizedLength)
+{
+	/* Type-1 record, longer than the whole transaction */
+	const auto type4 = BE::IO::Utility::readFile(TYPE4FILE);
+	const std::string text(reinterpret_cast<const char *>(
+	    static_cast<const uint8_t *>(type4)), type4.size());
+	const std::string oversizedType1 = "1.001:" +
+	    std::to_string(type4.size() * 2) +
+	    text.substr(text.find(static_cast<char>(GS)));
+	BE::Memory::uint8Array buffer(oversizedType1.size());
+	buffer.copy(reinterpret_cast<const uint8_t *>(oversizedType1.data()),
+	    oversizedType1.size());
+	EXPECT_THROW(BE::DataInterchange::AN2KIndex{buffer},
+	    BE::Error::DataError);
+
+	/* Binary length of the last Type-4 record, one byte too long */
+	const BE::DataInterchange::AN2KIndex type4Index(type4);
+	auto last = type4Index.getRecordLocations().back();
+	buffer = type4;
+	const uint64_t type4Length = last.length + 1;
+	buffer[last.offset] = static_cast<uint8_t>(type4Length >> 24);
+	buffer[last.offset + 1] = static_cast<uint8_t>(type4Length >> 16);
+	buffer[last.offset + 2] = static_cast<uint8_t>(type4Length >> 8);
+	buffer[last.offset + 3] = static_cast<uint8_t>(type4Length);
+	EXPECT_THROW(BE::DataInterchange::AN2KIndex{buffer},
+	    BE::Error::DataError);
+	buffer[last.offset] = 0xFF;
+	EXPECT_THROW(BE::DataInterchange::AN2KIndex{buffer},
+	    BE::Error::DataError);
+
+	/* Tagged length of the last Type-14 record, one byte too long */
+	const auto type14 = readType14();
+	const BE::DataInterchange::AN2KIndex type14Index(type14);
+	last = type14Index.getRecordLocations().back();
+	const std::string record(reinterpret_cast<const char *>(
+	    static_cast<const uint8_t *>(type14)) + last.offset, last.length);
+	const std::string::size_type lengthEnd = record.find(
+	    static_cast<char>(GS));
+	for (const uint64_t length : {last.length + 1,
+	    static_cast<uint64_t>(UINT32_MAX) + 1}) {
+		const std::string oversized = record.substr(0, 7) +
+		    std::to_string(length) + record.substr(lengthEnd);
+		buffer = BE::Memory::uint8Array(last.offset +
+		    oversized.size());
+		buffer.copy(type14, last.offset);
+		std::memcpy(static_cast<uint8_t *>(buffer) + last.offset,
+		    oversized.data(), oversized.size());
+		EXPECT_THROW(BE::DataInterchange::AN2KIndex{buffer},
+		    BE::Error::DataError) << length;
+	}
+}
@@ -454,6 +454,252 @@ TEST(ArchiveRecordStore, vacuum)
 }
 #endif /* ARCHIVERECORDSTORETEST */
 
+#ifdef SQLITERECORDSTORETEST
+static const uint64_t TRANSACTIONSIZE = 10;
+
+class BatchedSQLiteRecordStore : public ::testing::Test {
+protected:
+	BatchedSQLiteRecordStore() :
+	    _rsname(rsname + "_batch")
+	{
+		EXPECT_NO_THROW(_rs.reset(new BE::IO::SQLiteRecordStore(
+		    _rsname, "Batched")));
+		EXPECT_NE(_rs.get(), nullptr);
+		EXPECT_NO_THROW(_rs->setTransactionSize(TRANSACTIONSIZE));
+		EXPECT_EQ(TRANSACTIONSIZE, _rs->getTransactionSize());
+	}
+
+	virtual ~BatchedSQLiteRecordStore()
+	{
+		_rs.reset();
+		EXPECT_NO_THROW(BE::IO::RecordStore::removeRecordStore(
+		    _rsname));
+	}
+
+	void
+	insertRecords(
+	    unsigned int first,
+	    unsigned int count)
+	{
+		char rdata[RDATASIZE];
+		for (unsigned int i = first; i < first + count; i++) {
+			bzero(rdata, RDATASIZE);
+			snprintf(rdata, RDATASIZE, "%u", i);
+			EXPECT_NO_THROW(this->_rs->insert("key" +
+			    std::to_string(i), rdata, RDATASIZE));
+		}
+	}
+
+	/* Check records inserted by insertRecords() with a new handle */
+	void
+	checkReopened(
+	    unsigned int count)
+	{
+		std::unique_ptr<BE::IO::SQLiteRecordStore> rs;
+		ASSERT_NO_THROW(rs.reset(new BE::IO::SQLiteRecordStore(
+		    this->_rsname, BE::IO::Mode::ReadOnly)));
+		EXPECT_EQ(count, rs->getCount());
+		for (unsigned int i = 0; i < count; i++) {
+			BE::Memory::uint8Array data;
+			EXPECT_NO_THROW(data = rs->read("key" +
+			    std::to_string(i)));
+			ASSERT_EQ(RDATASIZE, data.size());
+			EXPECT_STREQ(std::to_string(i).c_str(),
+			    BE::Memory::AutoArrayUtility::cstr(data));
+		}
+	}
+
+	const std::string _rsname;
+	std::shared_ptr<BE::IO::SQLiteRecordStore> _rs;
+};
+
+TEST_F(BatchedSQLiteRecordStore, duplicateInBatch)
+{
+	/* A committed batch, then a duplicate in the open batch */
+	this->insertRecords(0, TRANSACTIONSIZE + 2);
+	char rdata[RDATASIZE] = "duplicate";
+	EXPECT_THROW(this->_rs->insert("key" + std::to_string(
+	    TRANSACTIONSIZE + 1), rdata, RDATASIZE),
+	    BE::Error::ObjectExists);
+	EXPECT_THROW(this->_rs->insert("key0", rdata, RDATASIZE),
+	    BE::Error::ObjectExists);
+	EXPECT_EQ(TRANSACTIONSIZE + 2, this->_rs->getCount());
+
+	/* The failed insert leaves the batch open and intact */
+	this->insertRecords(TRANSACTIONSIZE + 2, 1);
+	EXPECT_NO_THROW(this->_rs->sync());
+	this->checkReopened(TRANSACTIONSIZE + 3);
+}
+
+TEST_F(BatchedSQLiteRecordStore, syncPartialBatch)
+{
+	/* Two full batches and part of a third */
+	const unsigned int count = (TRANSACTIONSIZE * 2) + 3;
+	this->insertRecords(0, count);
+
+	/* Visible to another handle once synced, while still open */
+	EXPECT_NO_THROW(this->_rs->sync());
+	this->checkReopened(count);
+
+	/* Removes are batched as well */
+	EXPECT_NO_THROW(this->_rs->remove("key" + std::to_string(count - 1)));
+	EXPECT_NO_THROW(this->_rs->sync());
+	this->checkReopened(count - 1);
+
+	/* Closing commits a partial batch */
+	this->insertRecords(count - 1, 2);
+	this->_rs.reset();
+	this->checkReopened(count + 1);
+}
+#endif /* SQLITERECORDSTORETEST */
+
+#ifdef COMPRESSEDRECORDSTORETEST
+static const uint64_t PARALLELBLOCKSIZE = 64;
+
+/* Record sizes around and on block boundaries, including empty */
+static const std::vector<uint64_t> PARALLELSIZES{0, 1, PARALLELBLOCKSIZE - 1,
+    PARALLELBLOCKSIZE, PARALLELBLOCKSIZE + 1, PARALLELBLOCKSIZE * 4,
+    PARALLELBLOCKSIZE * 16 + 7};
+
+static BE::Memory::uint8Array
+parallelRecord(
+    uint64_t size,
+    unsigned int seed)
+{
+	BE::Memory::uint8Array data(size);
+	for (uint64_t i = 0; i < size; i++)
+		data[i] = static_cast<uint8_t>((i / 3) + (seed * 31));
+	return (data);
+}
+
+class ParallelCompressedRecordStore : public ::testing::Test {
+protected:
+	ParallelCompressedRecordStore() :
+	    _rsname(rsname + "_parallel")
+	{
+		EXPECT_NO_THROW(_rs.reset(
+		    new BE::IO::CompressedRecordStore(_rsname, "Parallel",
+		    BE::IO::RecordStore::Kind::BerkeleyDB, "GZIP")));
+		EXPECT_NE(_rs.get(), nullptr);
+		EXPECT_NO_THROW(_rs->setParallelCompression(2,
+		    PARALLELBLOCKSIZE));
+	}
+
+	virtual ~ParallelCompressedRecordStore()
+	{
+		_rs.reset();
+		EXPECT_NO_THROW(BE::IO::RecordStore::removeRecordStore(
+		    _rsname));
+	}
+
+	/* Insert one record of each of PARALLELSIZES */
+	void
+	insertRecords()
+	{
+		for (size_t i = 0; i < PARALLELSIZES.size(); i++)
+			EXPECT_NO_THROW(this->_rs->insert("key" +
+			    std::to_string(i), parallelRecord(
+			    PARALLELSIZES[i], i)));
+	}
+
+	/* Check the records added by insertRecords() */
+	void
+	checkRecords(
+	    const std::shared_ptr<BE::IO::RecordStore> &rs)
+	{
+		ASSERT_EQ(PARALLELSIZES.size(), rs->getCount());
+		for (size_t i = 0; i < PARALLELSIZES.size(); i++) {
+			const std::string key = "key" + std::to_string(i);
+			BE::Memory::uint8Array data;
+			EXPECT_NO_THROW(data = rs->read(key));
+			EXPECT_EQ(PARALLELSIZES[i], data.size());
+			EXPECT_TRUE(data ==
+			    parallelRecord(PARALLELSIZES[i], i)) << key;
+			EXPECT_EQ(PARALLELSIZES[i], rs->length(key));
+		}
+	}
+
+	const std::string _rsname;
+	std::shared_ptr<BE::IO::CompressedRecordStore> _rs;
+};
+
+TEST_F(ParallelCompressedRecordStore, blockRoundTrip)
+{
+	this->insertRecords();
+
+	/* Read while records may still be queued, then once written */
+	this->checkRecords(this->_rs);
+	EXPECT_NO_THROW(this->_rs->sync());
+	this->checkRecords(this->_rs);
+}
+
+TEST_F(ParallelCompressedRecordStore, reopenWithoutParallel)
+{
+	this->insertRecords();
+
+	/* Destruction writes queued records */
+	this->_rs.reset();
+	std::shared_ptr<BE::IO::CompressedRecordStore> rs;
+	ASSERT_NO_THROW(rs.reset(new BE::IO::CompressedRecordStore(
+	    this->_rsname, BE::IO::Mode::ReadOnly)));
+	EXPECT_EQ(0, rs->getCompressionThreads());
+	this->checkRecords(rs);
+}
+
+TEST_F(ParallelCompressedRecordStore, duplicateQueuedKey)
+{
+	/* Large enough to still be compressing when reinserted */
+	const BE::Memory::uint8Array data = parallelRecord(
+	    PARALLELBLOCKSIZE * 4096, 1);
+	EXPECT_NO_THROW(this->_rs->insert("queued", data));
+	EXPECT_THROW(this->_rs->insert("queued", data),
+	    BE::Error::ObjectExists);
+	EXPECT_EQ(1, this->_rs->getCount());
+
+	EXPECT_NO_THROW(this->_rs->sync());
+	EXPECT_THROW(this->_rs->insert("queued", data),
+	    BE::Error::ObjectExists);
+	EXPECT_TRUE(this->_rs->read("queued") == data);
+}
+
+TEST_F(ParallelCompressedRecordStore, sequenceWhileQueued)
+{
+	this->insertRecords();
+
+	/* Sequencing writes queued records, in insertion order */
+	for (size_t i = 0; i < PARALLELSIZES.size(); i++) {
+		BE::IO::RecordStore::Record record;
+		EXPECT_NO_THROW(record = this->_rs->sequence(
+		    (i == 0) ? BE::IO::RecordStore::BE_RECSTORE_SEQ_START :
+		    BE::IO::RecordStore::BE_RECSTORE_SEQ_NEXT));
+		EXPECT_EQ("key" + std::to_string(i), record.key);
+		EXPECT_TRUE(record.data ==
+		    parallelRecord(PARALLELSIZES[i], i));
+	}
+	EXPECT_THROW(this->_rs->sequence(), BE::Error::ObjectDoesNotExist);
+}
+
+TEST_F(ParallelCompressedRecordStore, removeWhileQueued)
+{
+	this->insertRecords();
+
+	const std::string removed = "key" +
+	    std::to_string(PARALLELSIZES.size() - 1);
+	EXPECT_NO_THROW(this->_rs->remove(removed));
+	EXPECT_EQ(PARALLELSIZES.size() - 1, this->_rs->getCount());
+	EXPECT_THROW(this->_rs->read(removed),
+	    BE::Error::ObjectDoesNotExist);
+	EXPECT_THROW(this->_rs->length(removed),
+	    BE::Error::ObjectDoesNotExist);
+
+	/* The key can be reused, and the other records are intact */
+	EXPECT_NO_THROW(this->_rs->insert(removed, parallelRecord(
+	    PARALLELSIZES.back(), PARALLELSIZES.size() - 1)));
+	EXPECT_NO_THROW(this->_rs->sync());
+	this->checkRecords(this->_rs);
+}
+#endif /* COMPRESSEDRECORDSTORETEST */
+
 int
 main(
     int argc,
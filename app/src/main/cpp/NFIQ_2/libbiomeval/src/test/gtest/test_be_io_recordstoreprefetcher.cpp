@@ -0,0 +1,177 @@
+/*
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ */
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <be_io_filerecstore.h>
+#include <be_io_recordstoreprefetcher.h>
+#include <be_memory_autoarrayutility.h>
+
+#include <gtest/gtest.h>
+
+namespace BE = BiometricEvaluation;
+
+static const std::string RSNAME{"rsp_test"};
+static const int RECORDCOUNT = 100;
+
+/*
+ * Data for each record is its key, NUL-terminated. The expected order is
+ * whatever order the RecordStore itself sequences in.
+ */
+class RecordStorePrefetcherTest : public ::testing::Test {
+protected:
+	RecordStorePrefetcherTest()
+	{
+		EXPECT_NO_THROW(_rs.reset(new BE::IO::FileRecordStore(RSNAME,
+		    "RecordStorePrefetcher test")));
+		for (int i = 0; i < RECORDCOUNT; i++) {
+			const std::string key = "key" + std::to_string(i);
+			_rs->insert(key, key.c_str(), key.size() + 1);
+		}
+		_rs->sync();
+		_keys = sequenceKeys(
+		    BE::IO::RecordStore::BE_RECSTORE_SEQ_START);
+	}
+
+	virtual ~RecordStorePrefetcherTest()
+	{
+		_rs.reset();
+		EXPECT_NO_THROW(BE::IO::RecordStore::removeRecordStore(RSNAME));
+	}
+
+	/* Keys from the RecordStore's own cursor, from cursor to the end */
+	std::vector<std::string>
+	sequenceKeys(
+	    int cursor)
+	{
+		std::vector<std::string> keys;
+		try {
+			for (;;) {
+				keys.push_back(_rs->sequenceKey(cursor));
+				cursor =
+				    BE::IO::RecordStore::BE_RECSTORE_SEQ_NEXT;
+			}
+		} catch (const BE::Error::ObjectDoesNotExist&) {}
+		return (keys);
+	}
+
+	/* Check that prefetcher returns exactly keys, in order */
+	void
+	checkSequence(
+	    BE::IO::RecordStorePrefetcher &prefetcher,
+	    const std::vector<std::string> &keys)
+	{
+		for (const auto &key : keys) {
+			BE::IO::RecordStore::Record record;
+			ASSERT_NO_THROW(record = prefetcher.sequence());
+			EXPECT_EQ(record.key, key);
+			EXPECT_STREQ(key.c_str(),
+			    BE::Memory::AutoArrayUtility::cstr(record.data));
+		}
+		EXPECT_THROW(prefetcher.sequence(),
+		    BE::Error::ObjectDoesNotExist);
+	}
+
+	std::shared_ptr<BE::IO::RecordStore> _rs;
+	std::vector<std::string> _keys;
+};
+
+TEST_F(RecordStorePrefetcherTest, orderWithSeveralThreads)
+{
+	ASSERT_EQ(this->_keys.size(), RECORDCOUNT);
+	BE::IO::RecordStorePrefetcher prefetcher(this->_rs, 16, 4);
+	EXPECT_EQ(prefetcher.getWindow(), 16);
+	this->checkSequence(prefetcher, this->_keys);
+}
+
+TEST_F(RecordStorePrefetcherTest, windowOfOne)
+{
+	BE::IO::RecordStorePrefetcher prefetcher(this->_rs, 1, 4);
+	EXPECT_EQ(prefetcher.getWindow(), 1);
+	this->checkSequence(prefetcher, this->_keys);
+}
+
+TEST_F(RecordStorePrefetcherTest, cursorNext)
+{
+	const std::string first = this->_keys[RECORDCOUNT / 2];
+	this->_rs->setCursorAtKey(first);
+	const std::vector<std::string> keys = this->sequenceKeys(
+	    BE::IO::RecordStore::BE_RECSTORE_SEQ_NEXT);
+	ASSERT_FALSE(keys.empty());
+	EXPECT_EQ(keys.front(), first);
+
+	this->_rs->setCursorAtKey(first);
+	BE::IO::RecordStorePrefetcher prefetcher(this->_rs, 8, 2,
+	    BE::IO::RecordStore::BE_RECSTORE_SEQ_NEXT);
+	this->checkSequence(prefetcher, keys);
+}
+
+TEST_F(RecordStorePrefetcherTest, invalidParameters)
+{
+	EXPECT_THROW(BE::IO::RecordStorePrefetcher(nullptr),
+	    BE::Error::ParameterError);
+	EXPECT_THROW(BE::IO::RecordStorePrefetcher(this->_rs, 0),
+	    BE::Error::ParameterError);
+	EXPECT_THROW(BE::IO::RecordStorePrefetcher(this->_rs, 8, 0),
+	    BE::Error::ParameterError);
+	EXPECT_THROW(BE::IO::RecordStorePrefetcher(this->_rs, 8, 2, -1),
+	    BE::Error::ParameterError);
+}
+
+TEST_F(RecordStorePrefetcherTest, readErrorAtItsKey)
+{
+	/*
+	 * Give one record file a name that sequences normally but is not a
+	 * valid key, so only the read of that record fails.
+	 */
+	const std::size_t bad = RECORDCOUNT / 3;
+	const std::string badKey = " " + this->_keys[bad];
+	const std::string files = RSNAME + "/theFiles/";
+	ASSERT_EQ(std::rename((files + this->_keys[bad]).c_str(),
+	    (files + badKey).c_str()), 0);
+	std::vector<std::string> keys = this->sequenceKeys(
+	    BE::IO::RecordStore::BE_RECSTORE_SEQ_START);
+	ASSERT_EQ(keys.size(), RECORDCOUNT);
+
+	BE::IO::RecordStorePrefetcher prefetcher(this->_rs, 8, 4);
+	for (const auto &key : keys) {
+		if (key == badKey) {
+			EXPECT_THROW(prefetcher.sequence(),
+			    BE::Error::StrategyError);
+			continue;
+		}
+		BE::IO::RecordStore::Record record;
+		ASSERT_NO_THROW(record = prefetcher.sequence());
+		EXPECT_EQ(record.key, key);
+	}
+	EXPECT_THROW(prefetcher.sequence(), BE::Error::ObjectDoesNotExist);
+
+	ASSERT_EQ(std::rename((files + badKey).c_str(),
+	    (files + this->_keys[bad]).c_str()), 0);
+}
+
+TEST_F(RecordStorePrefetcherTest, destroyMidStream)
+{
+	for (int i = 0; i < 10; i++) {
+		BE::IO::RecordStorePrefetcher prefetcher(this->_rs, 8, 4);
+		for (int j = 0; j < i; j++) {
+			BE::IO::RecordStore::Record record;
+			ASSERT_NO_THROW(record = prefetcher.sequence());
+			EXPECT_EQ(record.key, this->_keys[j]);
+		}
+	}
+
+	/* The RecordStore is still usable */
+	BE::IO::RecordStorePrefetcher prefetcher(this->_rs, 8, 4);
+	this->checkSequence(prefetcher, this->_keys);
+}
@@ -0,0 +1,145 @@
+/*
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ */
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <be_io_filerecstore.h>
+#include <be_io_recordstoreunion.h>
+#include <be_memory_autoarrayutility.h>
+
+#include <gtest/gtest.h>
+
+namespace BE = BiometricEvaluation;
+
+static const std::vector<std::string> RSNAMES{"rsu_test1", "rsu_test2",
+    "rsu_test3"};
+static const int RECORDCOUNT = 50;
+
+/*
+ * Every member contains "keyN", "shared" is in the first and last members,
+ * and "only2" is only in the second member. Data records the member name,
+ * NUL-terminated for to_string().
+ */
+class RecordStoreUnionTest : public ::testing::Test {
+protected:
+	RecordStoreUnionTest()
+	{
+		std::map<const std::string,
+		    const std::shared_ptr<BE::IO::RecordStore>> members;
+		for (const auto &name : RSNAMES) {
+			std::shared_ptr<BE::IO::RecordStore> rs;
+			EXPECT_NO_THROW(rs.reset(new BE::IO::FileRecordStore(
+			    name, "RecordStoreUnion member")));
+			for (int i = 0; i < RECORDCOUNT; i++) {
+				const std::string data = name + " " +
+				    std::to_string(i);
+				rs->insert("key" + std::to_string(i),
+				    data.c_str(), data.size() + 1);
+			}
+			if (name != RSNAMES[1])
+				rs->insert("shared", name.c_str(),
+				    name.size() + 1);
+			else
+				rs->insert("only2", name.c_str(),
+				    name.size() + 1);
+			rs->sync();
+			members.emplace(name, rs);
+		}
+		_rsu.reset(new BE::IO::RecordStoreUnion(members));
+	}
+
+	virtual ~RecordStoreUnionTest()
+	{
+		_rsu.reset();
+		for (const auto &name : RSNAMES)
+			EXPECT_NO_THROW(BE::IO::RecordStore::removeRecordStore(
+			    name));
+	}
+
+	std::unique_ptr<BE::IO::RecordStoreUnion> _rsu;
+};
+
+TEST_F(RecordStoreUnionTest, readKeys)
+{
+	std::vector<std::string> keys{"shared", "only2", "absent"};
+	for (int i = 0; i < RECORDCOUNT; i++)
+		keys.push_back("key" + std::to_string(i));
+
+	std::map<const std::string, std::map<const std::string,
+	    BE::Memory::uint8Array>> records;
+	EXPECT_NO_THROW(records = this->_rsu->read(keys));
+
+	/* Keys in no member are left out */
+	EXPECT_EQ(records.size(), keys.size() - 1);
+	EXPECT_EQ(records.count("absent"), 0);
+
+	ASSERT_EQ(records.count("shared"), 1);
+	ASSERT_EQ(records["shared"].size(), 2);
+	EXPECT_EQ(to_string(records["shared"][RSNAMES[0]]), RSNAMES[0]);
+	EXPECT_EQ(to_string(records["shared"][RSNAMES[2]]), RSNAMES[2]);
+
+	ASSERT_EQ(records.count("only2"), 1);
+	ASSERT_EQ(records["only2"].size(), 1);
+	EXPECT_EQ(to_string(records["only2"][RSNAMES[1]]), RSNAMES[1]);
+
+	for (int i = 0; i < RECORDCOUNT; i++) {
+		const std::string key = "key" + std::to_string(i);
+		ASSERT_EQ(records[key].size(), RSNAMES.size());
+		for (const auto &name : RSNAMES)
+			EXPECT_EQ(to_string(records[key][name]),
+			    name + " " + std::to_string(i));
+	}
+}
+
+TEST_F(RecordStoreUnionTest, readFirstInSeveral)
+{
+	std::pair<std::string, BE::Memory::uint8Array> record;
+	EXPECT_NO_THROW(record = this->_rsu->readFirst("shared"));
+	EXPECT_TRUE((record.first == RSNAMES[0]) ||
+	    (record.first == RSNAMES[2]));
+	EXPECT_EQ(to_string(record.second), record.first);
+}
+
+TEST_F(RecordStoreUnionTest, readFirstInOne)
+{
+	std::pair<std::string, BE::Memory::uint8Array> record;
+	EXPECT_NO_THROW(record = this->_rsu->readFirst("only2"));
+	EXPECT_EQ(record.first, RSNAMES[1]);
+	EXPECT_EQ(to_string(record.second), RSNAMES[1]);
+}
+
+TEST_F(RecordStoreUnionTest, readFirstInNone)
+{
+	EXPECT_THROW(this->_rsu->readFirst("absent"),
+	    BE::Error::ObjectDoesNotExist);
+}
+
+TEST_F(RecordStoreUnionTest, readFirstThenUseMembers)
+{
+	/* No search may still be using a member once readFirst returns */
+	for (int i = 0; i < RECORDCOUNT; i++) {
+		const std::string key = "key" + std::to_string(i);
+		std::pair<std::string, BE::Memory::uint8Array> record;
+		EXPECT_NO_THROW(record = this->_rsu->readFirst(key));
+		EXPECT_EQ(to_string(record.second),
+		    record.first + " " + std::to_string(i));
+
+		for (const auto &name : RSNAMES) {
+			const auto rs = this->_rsu->getRecordStore(name);
+			EXPECT_NO_THROW(rs->sequence(
+			    BE::IO::RecordStore::BE_RECSTORE_SEQ_START));
+			EXPECT_EQ(to_string(rs->read(key)),
+			    name + " " + std::to_string(i));
+		}
+	}
+}
@@ -0,0 +1,391 @@
+// JNI bridge for com.example.myapplication.Nfiq2Scorer.
+//
+// A random forest model is loaded once per process and shared by every
+// scorer that asks for the same parameters. Each scorer owns a small pool of
+// native worker threads; images are queued from Java and scored on those
+// threads, and results are delivered to a Java callback from the worker.
+// Pixels are read in place from direct ByteBuffers or locked HardwareBuffers,
+// never copied into Java arrays.
+
+#include <jni.h>
+
+#include <nfiq2_algorithm.hpp>
+#include <nfiq2_exception.hpp>
+#include <nfiq2_qualityfeatures.hpp>
+
+#if __ANDROID_API__ >= 29
+#include <android/hardware_buffer.h>
+#include <android/hardware_buffer_jni.h>
+#endif
+
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+JavaVM *javaVM{};
+jclass stringClass{};
+jmethodID onScoreMethod{};
+jmethodID onErrorMethod{};
+
+// Models already loaded in this process, by path and hash
+std::mutex modelsMutex;
+std::map<std::string, std::weak_ptr<const NFIQ2::Algorithm>> models;
+
+std::shared_ptr<const NFIQ2::Algorithm>
+getModel(const std::string &path, const std::string &hash) {
+    std::lock_guard<std::mutex> lock(modelsMutex);
+    const std::string key = path + '\n' + hash;
+    std::shared_ptr<const NFIQ2::Algorithm> model = models[key].lock();
+    if (model == nullptr) {
+        if (path.empty()) {
+            // Throws if parameters were not compiled into the library
+            model = std::make_shared<NFIQ2::Algorithm>();
+        } else {
+            model = std::make_shared<NFIQ2::Algorithm>(path, hash);
+        }
+        models[key] = model;
+    }
+    return model;
+}
+
+// One image waiting to be scored
+struct Job {
+    // Keeps the ByteBuffer or HardwareBuffer alive until scored
+    jobject buffer{};
+    jobject callback{};
+    const uint8_t *pixels{};
+#if __ANDROID_API__ >= 29
+    AHardwareBuffer *hardwareBuffer{};
+#endif
+    uint32_t width{};
+    uint32_t height{};
+    uint32_t rowStride{};
+    uint8_t fingerPosition{};
+    uint16_t ppi{};
+};
+
+class Scorer {
+public:
+    Scorer(std::shared_ptr<const NFIQ2::Algorithm> model, unsigned int threads)
+            : model(std::move(model)) {
+        for (unsigned int i = 0; i < threads; i++)
+            workers.emplace_back(&Scorer::work, this);
+    }
+
+    // Scores images already queued, then stops the workers
+    ~Scorer() {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            stopping = true;
+        }
+        queueChanged.notify_all();
+        for (auto &worker : workers)
+            worker.join();
+    }
+
+    void enqueue(Job job) {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            queue.push_back(job);
+        }
+        queueChanged.notify_one();
+    }
+
+private:
+    void work() {
+        JNIEnv *env{};
+        JavaVMAttachArgs args{JNI_VERSION_1_6, "nfiq2-worker", nullptr};
+        if (javaVM->AttachCurrentThread(&env, &args) != JNI_OK)
+            return;
+
+        // Compacted rows of images whose stride exceeds their width
+        std::vector<uint8_t> scratch{};
+        for (;;) {
+            Job job{};
+            {
+                std::unique_lock<std::mutex> lock(queueMutex);
+                queueChanged.wait(lock, [this] {
+                    return (stopping || !queue.empty());
+                });
+                if (queue.empty())
+                    break;
+                job = queue.front();
+                queue.pop_front();
+            }
+            score(env, job, scratch);
+            env->DeleteGlobalRef(job.buffer);
+            env->DeleteGlobalRef(job.callback);
+        }
+
+        javaVM->DetachCurrentThread();
+    }
+
+    void score(JNIEnv *env, Job &job, std::vector<uint8_t> &scratch) const {
+        unsigned int score{};
+        std::unordered_map<std::string, double> feedback{};
+        std::string error{};
+
+#if __ANDROID_API__ >= 29
+        if (job.hardwareBuffer != nullptr) {
+            AHardwareBuffer_Planes planes{};
+            if (AHardwareBuffer_lockPlanes(job.hardwareBuffer,
+                    AHARDWAREBUFFER_USAGE_CPU_READ_OFTEN, -1, nullptr,
+                    &planes) != 0 || planes.planeCount < 1 ||
+                planes.planes[0].pixelStride != 1) {
+                error = "Could not lock the luma plane of the HardwareBuffer";
+            } else {
+                job.pixels = static_cast<const uint8_t *>(planes.planes[0].data);
+                job.rowStride = planes.planes[0].rowStride;
+                compute(job, scratch, score, feedback, error);
+                AHardwareBuffer_unlock(job.hardwareBuffer, nullptr);
+            }
+            AHardwareBuffer_release(job.hardwareBuffer);
+        } else
+#endif
+        {
+            compute(job, scratch, score, feedback, error);
+        }
+
+        if (error.empty()) {
+            const std::vector<std::string> ids =
+                    NFIQ2::QualityFeatures::getActionableQualityFeedbackIDs();
+            jobjectArray names = env->NewObjectArray(
+                    static_cast<jsize>(ids.size()), stringClass, nullptr);
+            jdoubleArray values = env->NewDoubleArray(
+                    static_cast<jsize>(ids.size()));
+            if (names != nullptr && values != nullptr) {
+                std::vector<jdouble> v(ids.size());
+                for (size_t i = 0; i < ids.size(); i++) {
+                    jstring name = env->NewStringUTF(ids[i].c_str());
+                    env->SetObjectArrayElement(names, static_cast<jsize>(i), name);
+                    env->DeleteLocalRef(name);
+                    v[i] = feedback[ids[i]];
+                }
+                env->SetDoubleArrayRegion(values, 0,
+                        static_cast<jsize>(v.size()), v.data());
+                env->CallVoidMethod(job.callback, onScoreMethod,
+                        static_cast<jint>(score), names, values);
+            }
+            env->DeleteLocalRef(names);
+            env->DeleteLocalRef(values);
+        } else {
+            jstring message = env->NewStringUTF(error.c_str());
+            env->CallVoidMethod(job.callback, onErrorMethod, message);
+            env->DeleteLocalRef(message);
+        }
+
+        // An exception thrown by the callback must not reach the next job
+        if (env->ExceptionCheck()) {
+            env->ExceptionDescribe();
+            env->ExceptionClear();
+        }
+    }
+
+    void compute(const Job &job, std::vector<uint8_t> &scratch,
+            unsigned int &score,
+            std::unordered_map<std::string, double> &feedback,
+            std::string &error) const {
+        try {
+            const uint8_t *pixels = job.pixels;
+            if (job.rowStride != job.width) {
+                scratch.resize(job.width * job.height);
+                for (uint32_t row = 0; row < job.height; row++) {
+                    std::memcpy(&scratch[row * job.width],
+                            job.pixels + (row * job.rowStride), job.width);
+                }
+                pixels = scratch.data();
+            }
+
+            const auto modules = NFIQ2::QualityFeatures::computeQualityModules(
+                    pixels, job.width, job.height, job.fingerPosition,
+                    job.ppi, {});
+            score = model->computeQualityScore(modules);
+            feedback = NFIQ2::QualityFeatures::getActionableQualityFeedback(
+                    modules);
+        } catch (const NFIQ2::Exception &e) {
+            error = e.getErrorMessage();
+        } catch (const std::exception &e) {
+            error = e.what();
+        }
+    }
+
+    std::shared_ptr<const NFIQ2::Algorithm> model;
+    std::vector<std::thread> workers{};
+    std::deque<Job> queue{};
+    bool stopping{false};
+    std::mutex queueMutex{};
+    std::condition_variable queueChanged{};
+};
+
+std::string
+toString(JNIEnv *env, jstring string) {
+    if (string == nullptr)
+        return "";
+    const char *chars = env->GetStringUTFChars(string, nullptr);
+    std::string result{chars == nullptr ? "" : chars};
+    env->ReleaseStringUTFChars(string, chars);
+    return result;
+}
+
+void
+throwJava(JNIEnv *env, const char *className, const std::string &message) {
+    jclass exceptionClass = env->FindClass(className);
+    if (exceptionClass != nullptr)
+        env->ThrowNew(exceptionClass, message.c_str());
+}
+
+bool
+checkImage(JNIEnv *env, jint width, jint height, jint fingerPosition,
+        jint ppi) {
+    if (width <= 0 || height <= 0 || fingerPosition < 0 ||
+        fingerPosition > 255 || ppi <= 0 || ppi > 65535) {
+        throwJava(env, "java/lang/IllegalArgumentException",
+                "Invalid image dimensions, finger position, or resolution");
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+extern "C" JNIEXPORT jint JNICALL
+JNI_OnLoad(JavaVM *vm, void * /* reserved */) {
+    JNIEnv *env{};
+    if (vm->GetEnv(reinterpret_cast<void **>(&env), JNI_VERSION_1_6) != JNI_OK)
+        return JNI_ERR;
+    javaVM = vm;
+
+    jclass localString = env->FindClass("java/lang/String");
+    jclass callback = env->FindClass(
+            "com/example/myapplication/Nfiq2Scorer$Callback");
+    if (localString == nullptr || callback == nullptr)
+        return JNI_ERR;
+    stringClass = static_cast<jclass>(env->NewGlobalRef(localString));
+    onScoreMethod = env->GetMethodID(callback, "onScore",
+            "(I[Ljava/lang/String;[D)V");
+    onErrorMethod = env->GetMethodID(callback, "onError",
+            "(Ljava/lang/String;)V");
+    if (onScoreMethod == nullptr || onErrorMethod == nullptr)
+        return JNI_ERR;
+
+    return JNI_VERSION_1_6;
+}
+
+extern "C" JNIEXPORT jlong JNICALL
+Java_com_example_myapplication_Nfiq2Scorer_nativeCreate(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jstring modelPath,
+        jstring modelHash,
+        jint threads) {
+    try {
+        std::shared_ptr<const NFIQ2::Algorithm> model = getModel(
+                toString(env, modelPath), toString(env, modelHash));
+        return reinterpret_cast<jlong>(new Scorer(model,
+                threads < 1 ? 1 : static_cast<unsigned int>(threads)));
+    } catch (const NFIQ2::Exception &e) {
+        throwJava(env, "java/lang/IllegalArgumentException",
+                e.getErrorMessage());
+    } catch (const std::exception &e) {
+        throwJava(env, "java/lang/RuntimeException", e.what());
+    }
+    return 0;
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_myapplication_Nfiq2Scorer_nativeDestroy(
+        JNIEnv * /* env */,
+        jclass /* clazz */,
+        jlong handle) {
+    delete reinterpret_cast<Scorer *>(handle);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_myapplication_Nfiq2Scorer_nativeScoreBuffer(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle,
+        jobject pixels,
+        jint width,
+        jint height,
+        jint rowStride,
+        jint fingerPosition,
+        jint ppi,
+        jobject callback) {
+    if (!checkImage(env, width, height, fingerPosition, ppi))
+        return;
+
+    const auto *address = static_cast<const uint8_t *>(
+            env->GetDirectBufferAddress(pixels));
+    const jlong capacity = env->GetDirectBufferCapacity(pixels);
+    if (address == nullptr || rowStride < width || capacity <
+            (static_cast<jlong>(rowStride) * (height - 1)) + width) {
+        throwJava(env, "java/lang/IllegalArgumentException",
+                "pixels must be a direct ByteBuffer holding height rows of "
+                "rowStride bytes");
+        return;
+    }
+
+    Job job{};
+    job.buffer = env->NewGlobalRef(pixels);
+    job.callback = env->NewGlobalRef(callback);
+    job.pixels = address;
+    job.width = static_cast<uint32_t>(width);
+    job.height = static_cast<uint32_t>(height);
+    job.rowStride = static_cast<uint32_t>(rowStride);
+    job.fingerPosition = static_cast<uint8_t>(fingerPosition);
+    job.ppi = static_cast<uint16_t>(ppi);
+    reinterpret_cast<Scorer *>(handle)->enqueue(job);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_myapplication_Nfiq2Scorer_nativeScoreHardwareBuffer(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle,
+        jobject frame,
+        jint fingerPosition,
+        jint ppi,
+        jobject callback) {
+#if __ANDROID_API__ >= 29
+    AHardwareBuffer *hardwareBuffer =
+            AHardwareBuffer_fromHardwareBuffer(env, frame);
+    AHardwareBuffer_Desc description{};
+    if (hardwareBuffer != nullptr)
+        AHardwareBuffer_describe(hardwareBuffer, &description);
+    if (hardwareBuffer == nullptr || !checkImage(env,
+            static_cast<jint>(description.width),
+            static_cast<jint>(description.height), fingerPosition, ppi))
+        return;
+
+    // Released by the worker once the frame has been scored
+    AHardwareBuffer_acquire(hardwareBuffer);
+
+    Job job{};
+    job.buffer = env->NewGlobalRef(frame);
+    job.callback = env->NewGlobalRef(callback);
+    job.hardwareBuffer = hardwareBuffer;
+    job.width = description.width;
+    job.height = description.height;
+    job.fingerPosition = static_cast<uint8_t>(fingerPosition);
+    job.ppi = static_cast<uint16_t>(ppi);
+    reinterpret_cast<Scorer *>(handle)->enqueue(job);
+#else
+    (void) handle;
+    (void) frame;
+    (void) fingerPosition;
+    (void) ppi;
+    (void) callback;
+    throwJava(env, "java/lang/UnsupportedOperationException",
+            "HardwareBuffer scoring requires building for API level 29");
+#endif
+}
@@ -0,0 +1,107 @@
+package com.example.myapplication;
+
+import android.hardware.HardwareBuffer;
+
+import androidx.annotation.RequiresApi;
+
+import java.nio.ByteBuffer;
+
+/**
+ * Scores fingerprint images with NFIQ 2 on native worker threads.
+ *
+ * The random forest model is loaded once per process and shared by every
+ * scorer created with the same parameters. Images are read in place from
+ * direct ByteBuffers or HardwareBuffers; the buffer must not be modified
+ * until its callback has run. Callbacks run on a native worker thread.
+ */
+public final class Nfiq2Scorer implements AutoCloseable {
+
+    static {
+        System.loadLibrary("native-lib");
+    }
+
+    /** Receives the outcome of one image. */
+    public interface Callback {
+        /**
+         * @param score NFIQ 2 quality score, 0 to 100.
+         * @param feedbackIds Actionable quality feedback identifiers.
+         * @param feedbackValues Value of each identifier in feedbackIds.
+         */
+        void onScore(int score, String[] feedbackIds, double[] feedbackValues);
+
+        /** @param message Why the image could not be scored. */
+        void onError(String message);
+    }
+
+    private long handle;
+
+    /**
+     * @param modelPath Random forest parameter file, or null for the
+     *                  parameters compiled into the library.
+     * @param modelHash MD5 checksum of modelPath.
+     * @param threads   Number of native worker threads.
+     */
+    public Nfiq2Scorer(String modelPath, String modelHash, int threads) {
+        handle = nativeCreate(modelPath, modelHash, threads);
+    }
+
+    /**
+     * Queue an 8-bit grayscale image for scoring.
+     *
+     * @param pixels    Direct buffer of height rows, rowStride bytes apart,
+     *                  such as the Y plane of a YUV_420_888 camera image.
+     * @param rowStride Bytes between the start of consecutive rows.
+     */
+    public synchronized void score(ByteBuffer pixels, int width, int height,
+                                   int rowStride, int fingerPosition, int ppi,
+                                   Callback callback) {
+        nativeScoreBuffer(checkOpen(), pixels, width, height, rowStride,
+                fingerPosition, ppi, callback);
+    }
+
+    /**
+     * Queue a camera frame for scoring, using its luma plane. Requires the
+     * native library to be built for API level 29 or later.
+     */
+    @RequiresApi(29)
+    public synchronized void score(HardwareBuffer frame, int fingerPosition,
+                                   int ppi, Callback callback) {
+        nativeScoreHardwareBuffer(checkOpen(), frame, fingerPosition, ppi,
+                callback);
+    }
+
+    /**
+     * Scores images already queued, then stops the worker threads. Must not
+     * be called from a callback.
+     */
+    @Override
+    public synchronized void close() {
+        if (handle != 0) {
+            nativeDestroy(handle);
+            handle = 0;
+        }
+    }
+
+    private long checkOpen() {
+        if (handle == 0)
+            throw new IllegalStateException("Nfiq2Scorer is closed");
+        return handle;
+    }
+
+    private static native long nativeCreate(String modelPath, String modelHash,
+                                            int threads);
+
+    private static native void nativeDestroy(long handle);
+
+    private static native void nativeScoreBuffer(long handle, ByteBuffer pixels,
+                                                 int width, int height,
+                                                 int rowStride,
+                                                 int fingerPosition, int ppi,
+                                                 Callback callback);
+
+    private static native void nativeScoreHardwareBuffer(long handle,
+                                                         HardwareBuffer frame,
+                                                         int fingerPosition,
+                                                         int ppi,
+                                                         Callback callback);
+}